@@ -1223,17 +1223,12 @@ void practical_examples() {
             std::cout << "\n";
         }
 
-        // 应用简单的模糊滤镜（3x3平均）
-        array2d<unsigned char> blurred_image = image;
+        // 应用简单的模糊滤镜（3x3平均），求和面积表使每个像素的窗口求和为O(1)
+        array2d<unsigned char>           blurred_image = image;
+        summed_area_table<unsigned char> sat(image);
         for (int i = 1; i < image.rows() - 1; ++i) {
             for (int j = 1; j < image.cols() - 1; ++j) {
-                int sum = 0;
-                for (int di = -1; di <= 1; ++di) {
-                    for (int dj = -1; dj <= 1; ++dj) {
-                        sum += image[i + di][j + dj];
-                    }
-                }
-                blurred_image[i][j] = static_cast<unsigned char>(sum / 9);
+                blurred_image[i][j] = static_cast<unsigned char>(sat.rect_sum(i - 1, j - 1, i + 2, j + 2) / 9);
             }
         }
 
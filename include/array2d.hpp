@@ -1,12 +1,20 @@
 #pragma once
 
+#include "array2d_allocator.hpp"
+#include "array2d_expr.hpp"
 #include "array2d_iterator.hpp"
+#include "array2d_parallel.hpp"
+#include "array2d_simd.hpp"
 #include <algorithm>
+#include <atomic>
 #include <bit>
 #include <concepts>
 #include <cstring>
-#include <execution>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <numeric>
 #include <optional>
 #include <span>
 #include <stdexcept>
@@ -28,6 +36,17 @@ namespace qm {
         Safe_max  = 0x3F /**< 安全的最大值模式 */
     };
 
+    /**
+     * @brief 求和方式枚举
+     *
+     * 在速度与舍入误差之间取舍。
+     */
+    enum class Array_sum_opt : std::int8_t {
+        Fast     = 0, /**< 多通道累加，允许重新结合，速度最快 */
+        Pairwise = 1, /**< 成对求和，误差随log(n)增长 */
+        Kahan    = 2  /**< Kahan补偿求和，误差与元素个数无关 */
+    };
+
     // ================================
     // 概念定义和类型特征
     // ================================
@@ -64,6 +83,83 @@ namespace qm {
             !std::is_same_v<Idx, bool> &&
             !std::is_same_v<Idx, char>;
 
+    // ================================
+    // 存储布局
+    // ================================
+
+    /**
+     * @brief 紧密行优先布局
+     *
+     * 行距等于列数，所有元素连续存储，迭代器为连续迭代器。
+     */
+    struct dense_layout {};
+
+    /**
+     * @brief 带行尾填充的行优先布局
+     *
+     * 行距（pitch）与列数相互独立，每行末尾可以有填充元素，迭代时自动跳过。
+     * 默认行距会把每行补齐到line_size（以及分配器对齐）的整数倍，若补齐后的
+     * 行字节数恰为conflict_stride的整数倍，则再额外增加一个line_size，
+     * 以避免按列访问时的4K别名和L1缓存组冲突。
+     */
+    struct pitched_layout {
+        static constexpr std::size_t line_size       = 64;   /**< 行补齐的字节粒度 */
+        static constexpr std::size_t conflict_stride = 1024; /**< 需要错开的行字节数粒度 */
+    };
+
+    /**
+     * @brief 二维数组存储布局概念
+     *
+     * @tparam L 待检验的布局类型
+     */
+    template<typename L>
+    concept Array2d_layout = std::same_as<L, dense_layout> || std::same_as<L, pitched_layout>;
+
+    /**
+     * @brief 显式指定行距的构造参数
+     *
+     * @par 示例:
+     * @code
+     * pitched_array2d<float> arr(1024, 1024, row_pitch{1040});
+     * @endcode
+     */
+    struct row_pitch {
+        std::size_t value; /**< 相邻行首之间的元素距离 */
+    };
+
+    /**
+     * @brief 不初始化元素的构造参数类型
+     */
+    struct uninitialized_t {
+        explicit uninitialized_t() = default;
+    };
+
+    /**
+     * @brief 不初始化元素的构造参数
+     *
+     * 仅适用于可平凡默认构造的元素类型，元素初值不确定，必须先写入再读取。
+     *
+     * @par 示例:
+     * @code
+     * array2d<double> scratch(16384, 16384, uninitialized);  // 省去清零遍历
+     * @endcode
+     */
+    inline constexpr uninitialized_t uninitialized{};
+
+    /**
+     * @brief 非拥有型二维数组视图的前置声明，定义见array2d_view.hpp
+     */
+    template<typename Ty, Array2d_index_type Idx>
+        requires Array2d_compatible<std::remove_const_t<Ty>>
+    class array2d_view;
+
+    /**
+     * @brief 原子访问视图的前置声明，定义见array2d_atomic.hpp
+     */
+    template<typename Ty, Array2d_index_type Idx>
+        requires std::is_trivially_copyable_v<Ty> && (!std::is_const_v<Ty>)
+    class array2d_atomic_view;
+
     // ================================
     // array2d 主类定义
     // ================================
@@ -76,11 +172,15 @@ namespace qm {
      *
      * @tparam Ty 元素类型，必须满足Array2d_compatible概念
      * @tparam Idx 索引类型，必须满足Array2d_index_type概念，默认为int
+     * @tparam Alloc 底层存储使用的分配器类型，默认为std::allocator<Ty>；
+     *               也可以是对齐存储选项（如aligned<64>），会被重绑定到Ty
+     * @tparam Layout 存储布局，dense_layout（默认）或pitched_layout
      *
      * @note 内部使用行优先存储（row-major order）
      * @note 提供了针对POD类型的内存操作优化
      */
-    template<Array2d_compatible Ty, Array2d_index_type Idx = int>
+    template<Array2d_compatible Ty, Array2d_index_type Idx = int, typename Alloc = std::allocator<Ty>,
+             Array2d_layout Layout = dense_layout>
     class array2d {
     public:
         // ================================
@@ -95,12 +195,44 @@ namespace qm {
         using const_pointer   = const Ty *;                /**< 常量指针类型 */
         using reference       = Ty &;                      /**< 引用类型 */
         using const_reference = const Ty &;                /**< 常量引用类型 */
+        using allocator_type  = typename std::allocator_traits<Alloc>::template rebind_alloc<Ty>; /**< 分配器类型 */
+        using layout_type     = Layout;                                                         /**< 存储布局类型 */
+
+        /**
+         * @brief 是否使用带行尾填充的布局
+         */
+        static constexpr bool is_pitched = std::same_as<Layout, pitched_layout>;
+
+        /**
+         * @brief 迭代器类型
+         *
+         * dense_layout下为连续迭代器，pitched_layout下为跳过填充元素的随机访问迭代器。
+         */
+        using iterator = std::conditional_t<is_pitched, Array2d_pitched_iterator<Ty>, Array2d_iterator<Ty>>;
+
+        /**
+         * @brief 常量迭代器类型
+         */
+        using const_iterator = std::conditional_t<is_pitched, Array2d_pitched_iterator<const Ty>, Array2d_iterator<const Ty>>;
 
-        using iterator               = Array2d_iterator<Ty>;                  /**< 迭代器类型 */
-        using const_iterator         = Array2d_iterator<const Ty>;            /**< 常量迭代器类型 */
         using reverse_iterator       = std::reverse_iterator<iterator>;       /**< 反向迭代器类型 */
         using const_reverse_iterator = std::reverse_iterator<const_iterator>; /**< 常量反向迭代器类型 */
 
+        /**
+         * @brief 底层存储首地址保证的对齐字节数
+         *
+         * 使用aligned<N>等对齐分配器时为N，否则为alignof(Ty)。
+         */
+        static constexpr std::size_t storage_alignment = allocator_alignment_v<allocator_type>;
+
+        /**
+         * @brief 底层存储类型
+         *
+         * 通过default_init_allocator包装allocator_type，使平凡类型可以跳过初始化；
+         * 需要值初始化的路径显式写入初值，行为与std::vector<Ty, allocator_type>一致。
+         */
+        using storage_type = std::vector<Ty, default_init_allocator<allocator_type>>;
+
         // ================================
         // 构造函数
         // ================================
@@ -110,13 +242,22 @@ namespace qm {
          *
          * 创建一个空的二维数组（0行0列）。
          */
-        constexpr array2d() noexcept = default;
+        constexpr array2d() noexcept(noexcept(allocator_type())) = default;
+
+        /**
+         * @brief 使用指定分配器构造空的二维数组
+         *
+         * @param alloc 底层存储使用的分配器
+         */
+        constexpr explicit array2d(const allocator_type &alloc) noexcept
+            : data_(alloc) {}
 
         /**
          * @brief 构造指定尺寸的二维数组
          *
          * @param rows 行数，必须非负
          * @param cols 列数，必须非负
+         * @param alloc 底层存储使用的分配器
          *
          * @throws std::invalid_argument 当行数或列数为负时
          * @throws std::overflow_error 当计算总大小溢出时
@@ -124,13 +265,41 @@ namespace qm {
          *
          * @note 元素使用默认构造函数初始化
          */
-        array2d(index_type rows, index_type cols)
+        array2d(index_type rows, index_type cols, const allocator_type &alloc = allocator_type())
             : rows_(validate_dimension(rows, "rows")),
-              cols_(validate_dimension(cols, "cols")) {
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(default_pitch(cols_)),
+              data_(alloc) {
 
             if (rows_ > 0 && cols_ > 0) {
-                const auto size = calculate_size(rows_, cols_);
-                data_.resize(size);
+                const auto size = calculate_size(rows_, pitch_);
+                resize_value_initialized(data_, size);
+            }
+        }
+
+        /**
+         * @brief 构造指定尺寸但不初始化元素的二维数组
+         *
+         * @param rows 行数，必须非负
+         * @param cols 列数，必须非负
+         * @param alloc 底层存储使用的分配器
+         *
+         * @throws std::invalid_argument 当行数或列数为负时
+         * @throws std::overflow_error 当计算总大小溢出时
+         * @throws std::bad_alloc 当内存分配失败时
+         *
+         * @note 仅适用于可平凡默认构造的元素类型，元素初值不确定
+         * @note 适合随后会被完整覆盖的大型临时矩阵，省去一次清零遍历
+         */
+        array2d(index_type rows, index_type cols, uninitialized_t, const allocator_type &alloc = allocator_type())
+            requires std::is_trivially_default_constructible_v<Ty>
+            : rows_(validate_dimension(rows, "rows")),
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(default_pitch(cols_)),
+              data_(alloc) {
+
+            if (rows_ > 0 && cols_ > 0) {
+                data_.resize(calculate_size(rows_, pitch_));
             }
         }
 
@@ -140,17 +309,99 @@ namespace qm {
          * @param rows 行数，必须非负
          * @param cols 列数，必须非负
          * @param val 用于初始化所有元素的值
+         * @param alloc 底层存储使用的分配器
          *
          * @throws std::invalid_argument 当行数或列数为负时
          * @throws std::overflow_error 当计算总大小溢出时
          * @throws std::bad_alloc 当内存分配失败时
          */
-        array2d(index_type rows, index_type cols, const Ty &val)
+        array2d(index_type rows, index_type cols, const Ty &val, const allocator_type &alloc = allocator_type())
             : rows_(validate_dimension(rows, "rows")),
-              cols_(validate_dimension(cols, "cols")) {
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(default_pitch(cols_)),
+              data_(alloc) {
 
             if (rows_ > 0 && cols_ > 0) {
-                const auto size = calculate_size(rows_, cols_);
+                const auto size = calculate_size(rows_, pitch_);
+                data_.resize(size, val);
+            }
+        }
+
+        /**
+         * @brief 构造指定尺寸和行距的二维数组（仅pitched_layout）
+         *
+         * @param rows 行数，必须非负
+         * @param cols 列数，必须非负
+         * @param pitch 相邻行首之间的元素距离，必须不小于列数
+         * @param alloc 底层存储使用的分配器
+         *
+         * @throws std::invalid_argument 当行数或列数为负，或行距小于列数时
+         * @throws std::overflow_error 当计算总大小溢出时
+         * @throws std::bad_alloc 当内存分配失败时
+         */
+        array2d(index_type rows, index_type cols, row_pitch pitch, const allocator_type &alloc = allocator_type())
+            requires is_pitched
+            : rows_(validate_dimension(rows, "rows")),
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(validate_pitch(pitch, cols_)),
+              data_(alloc) {
+
+            if (rows_ > 0 && cols_ > 0) {
+                const auto size = calculate_size(rows_, pitch_);
+                resize_value_initialized(data_, size);
+            }
+        }
+
+        /**
+         * @brief 构造指定尺寸和行距但不初始化元素的二维数组（仅pitched_layout）
+         *
+         * @param rows 行数，必须非负
+         * @param cols 列数，必须非负
+         * @param pitch 相邻行首之间的元素距离，必须不小于列数
+         * @param alloc 底层存储使用的分配器
+         *
+         * @throws std::invalid_argument 当行数或列数为负，或行距小于列数时
+         * @throws std::overflow_error 当计算总大小溢出时
+         * @throws std::bad_alloc 当内存分配失败时
+         *
+         * @note 仅适用于可平凡默认构造的元素类型，元素和填充元素的初值均不确定
+         */
+        array2d(index_type rows, index_type cols, row_pitch pitch, uninitialized_t,
+                const allocator_type &alloc = allocator_type())
+            requires is_pitched && std::is_trivially_default_constructible_v<Ty>
+            : rows_(validate_dimension(rows, "rows")),
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(validate_pitch(pitch, cols_)),
+              data_(alloc) {
+
+            if (rows_ > 0 && cols_ > 0) {
+                data_.resize(calculate_size(rows_, pitch_));
+            }
+        }
+
+        /**
+         * @brief 构造指定尺寸、行距和初值的二维数组（仅pitched_layout）
+         *
+         * @param rows 行数，必须非负
+         * @param cols 列数，必须非负
+         * @param pitch 相邻行首之间的元素距离，必须不小于列数
+         * @param val 用于初始化所有元素（包括填充元素）的值
+         * @param alloc 底层存储使用的分配器
+         *
+         * @throws std::invalid_argument 当行数或列数为负，或行距小于列数时
+         * @throws std::overflow_error 当计算总大小溢出时
+         * @throws std::bad_alloc 当内存分配失败时
+         */
+        array2d(index_type rows, index_type cols, row_pitch pitch, const Ty &val,
+                const allocator_type &alloc = allocator_type())
+            requires is_pitched
+            : rows_(validate_dimension(rows, "rows")),
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(validate_pitch(pitch, cols_)),
+              data_(alloc) {
+
+            if (rows_ > 0 && cols_ > 0) {
+                const auto size = calculate_size(rows_, pitch_);
                 data_.resize(size, val);
             }
         }
@@ -159,6 +410,7 @@ namespace qm {
          * @brief 从初始化列表构造二维数组
          *
          * @param init_list 嵌套的初始化列表，外层代表行，内层代表列
+         * @param alloc 底层存储使用的分配器
          *
          * @throws std::invalid_argument 当各行列数不一致时
          * @throws std::bad_alloc 当内存分配失败时
@@ -170,14 +422,17 @@ namespace qm {
          * array2d<int> arr{{1, 2, 3}, {4, 5, 6}};  // 2x3矩阵
          * @endcode
          */
-        array2d(std::initializer_list<std::initializer_list<Ty>> init_list) {
+        array2d(std::initializer_list<std::initializer_list<Ty>> init_list,
+                const allocator_type                             &alloc = allocator_type())
+            : data_(alloc) {
             if (init_list.size() == 0) {
                 rows_ = cols_ = 0;
                 return;
             }
 
-            rows_ = static_cast<index_type>(init_list.size());
-            cols_ = static_cast<index_type>(init_list.begin()->size());
+            rows_  = static_cast<index_type>(init_list.size());
+            cols_  = static_cast<index_type>(init_list.begin()->size());
+            pitch_ = default_pitch(cols_);
 
             // 验证所有行的列数相同
             for (const auto &row: init_list) {
@@ -186,11 +441,20 @@ namespace qm {
                 }
             }
 
-            const auto size = calculate_size(rows_, cols_);
-            data_.reserve(size);
+            if constexpr (is_pitched) {
+                resize_value_initialized(data_, calculate_size(rows_, pitch_));
 
-            for (const auto &row: init_list) {
-                data_.insert(data_.end(), row.begin(), row.end());
+                index_type i = 0;
+                for (const auto &row: init_list) {
+                    std::ranges::copy(row, data_.data() + calculate_offset(i++, 0));
+                }
+            } else {
+                const auto size = calculate_size(rows_, cols_);
+                data_.reserve(size);
+
+                for (const auto &row: init_list) {
+                    data_.insert(data_.end(), row.begin(), row.end());
+                }
             }
         }
 
@@ -201,6 +465,7 @@ namespace qm {
          * @param rows 行数，必须非负
          * @param cols 列数，必须非负
          * @param container 提供数据的容器
+         * @param alloc 底层存储使用的分配器
          *
          * @throws std::invalid_argument 当行数或列数为负，或容器大小与矩阵尺寸不匹配时
          * @throws std::overflow_error 当计算总大小溢出时
@@ -210,19 +475,32 @@ namespace qm {
          * @note 数据按行优先顺序复制
          */
         template<typename Container>
-        array2d(index_type rows, index_type cols, const Container &container)
+        array2d(index_type rows, index_type cols, const Container &container,
+                const allocator_type &alloc = allocator_type())
             requires std::ranges::range<Container> &&
                              std::convertible_to<std::ranges::range_value_t<Container>, Ty>
             : rows_(validate_dimension(rows, "rows")),
-              cols_(validate_dimension(cols, "cols")) {
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(default_pitch(cols_)),
+              data_(alloc) {
 
             const auto expected_size = calculate_size(rows_, cols_);
             if (std::ranges::size(container) != expected_size) {
                 throw std::invalid_argument("Container size doesn't match matrix dimensions");
             }
 
-            data_.reserve(expected_size);
-            std::ranges::copy(container, std::back_inserter(data_));
+            if constexpr (is_pitched) {
+                if (expected_size == 0) return;
+                resize_value_initialized(data_, calculate_size(rows_, pitch_));
+
+                auto src = std::ranges::begin(container);
+                for (index_type i = 0; i < rows_; ++i) {
+                    src = std::ranges::copy_n(src, cols_, data_.data() + calculate_offset(i, 0)).in;
+                }
+            } else {
+                data_.reserve(expected_size);
+                std::ranges::copy(container, std::back_inserter(data_));
+            }
         }
 
         /**
@@ -239,6 +517,67 @@ namespace qm {
          */
         array2d(array2d &&) noexcept = default;
 
+        /**
+         * @brief 使用指定分配器的拷贝构造函数
+         *
+         * @param other 源矩阵
+         * @param alloc 新矩阵使用的分配器
+         *
+         * @throws std::bad_alloc 当内存分配失败时
+         */
+        array2d(const array2d &other, const allocator_type &alloc)
+            : rows_(other.rows_),
+              cols_(other.cols_),
+              pitch_(other.pitch_),
+              data_(other.data_, alloc) {}
+
+        /**
+         * @brief 使用指定分配器的移动构造函数
+         *
+         * @param other 源矩阵
+         * @param alloc 新矩阵使用的分配器
+         *
+         * @throws std::bad_alloc 当分配器不相等且内存分配失败时
+         *
+         * @note 分配器相等时直接接管存储，否则逐元素移动到新分配的内存中
+         */
+        array2d(array2d &&other, const allocator_type &alloc)
+            : rows_(other.rows_),
+              cols_(other.cols_),
+              pitch_(other.pitch_),
+              data_(std::move(other.data_), alloc) {
+            other.rows_ = other.cols_ = other.pitch_ = 0;
+            other.data_.clear();
+        }
+
+        /**
+         * @brief 从逐元素表达式构造矩阵
+         *
+         * @tparam E 表达式类型
+         * @param expr 由array2d、视图和标量通过 + - * / min max abs clamp where 等组合的表达式
+         * @param alloc 分配器
+         *
+         * @throws std::bad_alloc 当内存分配失败时
+         *
+         * @note 整条表达式在一次遍历中求值，不产生中间矩阵
+         *
+         * @par 示例
+         * @code
+         * qm::array2d<double> score = a * 2.0 + b;
+         * @endcode
+         */
+        template<Array2d_expression_node E>
+            requires std::convertible_to<typename E::value_type, Ty>
+        array2d(const E &expr, const allocator_type &alloc = allocator_type())
+            : rows_(static_cast<index_type>(expr.rows())),
+              cols_(static_cast<index_type>(expr.cols())),
+              pitch_(default_pitch(cols_)),
+              data_(alloc) {
+            // 每个元素都会被覆盖，平凡类型不做初始化
+            data_.resize(static_cast<size_type>(calculate_size(rows_, pitch_)));
+            evaluate_expression(data_.data(), static_cast<std::size_t>(pitch()), expr);
+        }
+
         /**
          * @brief 拷贝赋值操作符
          *
@@ -253,6 +592,69 @@ namespace qm {
          */
         array2d &operator=(array2d &&) noexcept = default;
 
+        /**
+         * @brief 将逐元素表达式赋值给矩阵
+         *
+         * @tparam E 表达式类型
+         * @param expr 表达式
+         * @return 当前矩阵的引用
+         *
+         * @throws std::bad_alloc 当尺寸不同且内存分配失败时
+         *
+         * @note 尺寸相同时直接写入现有存储，不分配内存；表达式可以引用当前矩阵（如 a = a * 2 + b）
+         * @note 尺寸不同时先求值到新矩阵再替换
+         */
+        template<Array2d_expression_node E>
+            requires std::convertible_to<typename E::value_type, Ty>
+        array2d &operator=(const E &expr) {
+            if (expr.rows() == static_cast<std::size_t>(rows_) && expr.cols() == static_cast<std::size_t>(cols_)) {
+                evaluate_expression(data_.data(), static_cast<std::size_t>(pitch()), expr);
+            } else {
+                *this = array2d(expr, get_allocator());
+            }
+            return *this;
+        }
+
+        /**
+         * @brief 逐元素复合赋值：加上矩阵、表达式或标量
+         *
+         * @throws std::invalid_argument 当操作数形状不一致时
+         *
+         * @note 与其他复合赋值一样原地单次遍历完成
+         */
+        template<typename Rhs>
+            requires Array2d_expression_args<array2d, Rhs>
+        array2d &operator+=(const Rhs &rhs) {
+            return *this = *this + rhs;
+        }
+
+        /**
+         * @brief 逐元素复合赋值：减去矩阵、表达式或标量
+         */
+        template<typename Rhs>
+            requires Array2d_expression_args<array2d, Rhs>
+        array2d &operator-=(const Rhs &rhs) {
+            return *this = *this - rhs;
+        }
+
+        /**
+         * @brief 逐元素复合赋值：乘以矩阵、表达式或标量
+         */
+        template<typename Rhs>
+            requires Array2d_expression_args<array2d, Rhs>
+        array2d &operator*=(const Rhs &rhs) {
+            return *this = *this * rhs;
+        }
+
+        /**
+         * @brief 逐元素复合赋值：除以矩阵、表达式或标量
+         */
+        template<typename Rhs>
+            requires Array2d_expression_args<array2d, Rhs>
+        array2d &operator/=(const Rhs &rhs) {
+            return *this = *this / rhs;
+        }
+
         /**
          * @brief 析构函数
          *
@@ -362,7 +764,7 @@ namespace qm {
          * @return 指向首元素的迭代器
          */
         [[nodiscard]] constexpr iterator begin() noexcept {
-            return iterator(data_.data());
+            return make_iterator<iterator>(data_.data());
         }
 
         /**
@@ -370,7 +772,7 @@ namespace qm {
          * @return 指向首元素的常量迭代器
          */
         [[nodiscard]] constexpr const_iterator begin() const noexcept {
-            return const_iterator(data_.data());
+            return make_iterator<const_iterator>(data_.data());
         }
 
         /**
@@ -378,7 +780,7 @@ namespace qm {
          * @return 指向尾后元素的迭代器
          */
         [[nodiscard]] constexpr iterator end() noexcept {
-            return iterator(data_.data() + data_.size());
+            return make_iterator<iterator>(data_.data() + data_.size());
         }
 
         /**
@@ -386,7 +788,7 @@ namespace qm {
          * @return 指向尾后元素的常量迭代器
          */
         [[nodiscard]] constexpr const_iterator end() const noexcept {
-            return const_iterator(data_.data() + data_.size());
+            return make_iterator<const_iterator>(data_.data() + data_.size());
         }
 
         /**
@@ -449,8 +851,12 @@ namespace qm {
          * @brief 行迭代器包装器
          *
          * 提供对单行元素的迭代器访问。
+         *
+         * @note 行内元素总是连续的，因此即使在pitched_layout下也使用连续迭代器
          */
         struct row_iterator_wrapper {
+            using iterator = Array2d_iterator<Ty>; /**< 行内迭代器类型 */
+
             pointer   ptr_;  /**< 指向行首的指针 */
             size_type cols_; /**< 列数 */
 
@@ -480,6 +886,8 @@ namespace qm {
          * 提供对单行元素的常量迭代器访问。
          */
         struct const_row_iterator_wrapper {
+            using const_iterator = Array2d_iterator<const Ty>; /**< 行内常量迭代器类型 */
+
             const_pointer ptr_;  /**< 指向行首的常量指针 */
             size_type     cols_; /**< 列数 */
 
@@ -548,21 +956,45 @@ namespace qm {
          */
         [[nodiscard]] constexpr index_type cols() const noexcept { return cols_; }
 
+        /**
+         * @brief 获取行距
+         * @return 相邻行首之间的元素距离，dense_layout下恒等于cols()
+         */
+        [[nodiscard]] constexpr index_type pitch() const noexcept {
+            if constexpr (is_pitched) {
+                return pitch_;
+            } else {
+                return cols_;
+            }
+        }
+
         /**
          * @brief 获取总元素数
-         * @return 矩阵中元素的总数（rows * cols）
+         * @return 矩阵中元素的总数（rows * cols），不包含行尾填充元素
          */
-        [[nodiscard]] constexpr size_type size() const noexcept { return data_.size(); }
+        [[nodiscard]] constexpr size_type size() const noexcept {
+            if constexpr (is_pitched) {
+                return static_cast<size_type>(rows_) * static_cast<size_type>(cols_);
+            } else {
+                return data_.size();
+            }
+        }
 
         /**
          * @brief 检查矩阵是否为空
          * @return 如果矩阵为空（无元素）则返回true
          */
-        [[nodiscard]] constexpr bool empty() const noexcept { return data_.empty(); }
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            if constexpr (is_pitched) {
+                return rows_ == 0 || cols_ == 0;
+            } else {
+                return data_.empty();
+            }
+        }
 
         /**
          * @brief 获取当前容量
-         * @return 在不重新分配内存的情况下可容纳的元素数
+         * @return 在不重新分配内存的情况下可容纳的元素数（pitched_layout下包含填充元素）
          */
         [[nodiscard]] constexpr size_type capacity() const noexcept { return data_.capacity(); }
 
@@ -572,6 +1004,25 @@ namespace qm {
          */
         [[nodiscard]] constexpr bool is_square() const noexcept { return rows_ == cols_; }
 
+        /**
+         * @brief 获取底层存储使用的分配器
+         * @return 分配器的副本
+         */
+        [[nodiscard]] constexpr allocator_type get_allocator() const noexcept {
+            return static_cast<const allocator_type &>(data_.get_allocator());
+        }
+
+        /**
+         * @brief 检查每一行的首地址是否都满足storage_alignment对齐
+         * @return 当行距字节数是storage_alignment的整数倍时返回true
+         *
+         * @note 为true时row()、operator[]返回的行首指针均可按storage_alignment做对齐加载
+         * @note pitched_layout的默认行距总是满足该条件（元素大小能整除缓存行时）
+         */
+        [[nodiscard]] constexpr bool rows_aligned() const noexcept {
+            return (static_cast<std::size_t>(pitch()) * sizeof(Ty)) % storage_alignment == 0;
+        }
+
         /**
          * @brief 预留内存空间
          *
@@ -583,11 +1034,12 @@ namespace qm {
          * @throws std::bad_alloc 当内存分配失败时
          *
          * @note 只影响内存分配，不改变当前矩阵尺寸
+         * @note pitched_layout下按cols对应的默认行距计算容量
          */
         void reserve(index_type rows, index_type cols) {
             const auto new_capacity = calculate_size(
                     validate_dimension(rows, "rows"),
-                    validate_dimension(cols, "cols"));
+                    default_pitch(validate_dimension(cols, "cols")));
             data_.reserve(new_capacity);
         }
 
@@ -607,17 +1059,23 @@ namespace qm {
         /**
          * @brief 获取整个矩阵的span视图
          * @return 覆盖所有元素的span
+         *
+         * @note 仅dense_layout可用，pitched_layout的元素之间存在填充
          */
-        [[nodiscard]] constexpr std::span<Ty> as_span() noexcept {
-            return {data_.data(), data_.size()};
+        [[nodiscard]] constexpr std::span<Ty> as_span() noexcept
+            requires(!is_pitched)
+        {
+            return {std::assume_aligned<storage_alignment>(data_.data()), data_.size()};
         }
 
         /**
          * @brief 获取整个矩阵的常量span视图
          * @return 覆盖所有元素的常量span
          */
-        [[nodiscard]] constexpr std::span<const Ty> as_span() const noexcept {
-            return {data_.data(), data_.size()};
+        [[nodiscard]] constexpr std::span<const Ty> as_span() const noexcept
+            requires(!is_pitched)
+        {
+            return {std::assume_aligned<storage_alignment>(data_.data()), data_.size()};
         }
 
         /**
@@ -652,7 +1110,7 @@ namespace qm {
          * @param col 列索引
          * @return 包含指定列所有元素的vector
          *
-         * @note 由于列元素在内存中不连续，需要复制到新容器中
+         * @note 由于列元素在内存中不连续，需要复制到新容器中；只需遍历时请使用col_view()
          * @note 不进行边界检查（在调试模式下使用断言）
          */
         [[nodiscard]] std::vector<Ty> col(index_type col) const {
@@ -666,6 +1124,40 @@ namespace qm {
             return result;
         }
 
+        /**
+         * @brief 获取指定列的零拷贝视图
+         *
+         * @param col 列索引
+         * @return 按行距跨步访问该列的随机访问范围，写入会作用到矩阵
+         *
+         * @note 不分配内存；矩阵重新分配存储（如resize）后视图失效
+         * @note 不进行边界检查（在调试模式下使用断言）
+         *
+         * @par 示例:
+         * @code
+         * auto column = mat.col_view(2);
+         * auto total  = std::accumulate(column.begin(), column.end(), 0.0);
+         * std::ranges::sort(column);
+         * @endcode
+         */
+        [[nodiscard]] constexpr array2d_column<Ty> col_view(index_type col) noexcept {
+            assert_bounds(col, cols_);
+            return {data_.data() + col, static_cast<size_type>(rows_), pitch()};
+        }
+
+        /**
+         * @brief 获取指定列的只读零拷贝视图
+         *
+         * @param col 列索引
+         * @return 按行距跨步访问该列的只读随机访问范围
+         *
+         * @note 不进行边界检查（在调试模式下使用断言）
+         */
+        [[nodiscard]] constexpr array2d_column<const Ty> col_view(index_type col) const noexcept {
+            assert_bounds(col, cols_);
+            return {data_.data() + col, static_cast<size_type>(rows_), pitch()};
+        }
+
         /**
          * @brief 获取子矩阵的行优先span视图
          *
@@ -676,7 +1168,7 @@ namespace qm {
          * @return 子矩阵的span视图
          *
          * @note 只有当请求的是连续的完整行时才返回完整的连续span
-         * @note 否则只返回第一行的span
+         * @note 否则只返回第一行的span，任意矩形块请使用submatrix()
          * @note 不进行边界检查（在调试模式下使用断言）
          */
         [[nodiscard]] std::span<Ty> submatrix_row_major(
@@ -688,8 +1180,8 @@ namespace qm {
             assert_bounds(start_row + num_rows - 1, rows_);
             assert_bounds(start_col + num_cols - 1, cols_);
 
-            // 只有当请求的是连续行且占满整行时才能返回连续span
-            if (start_col == 0 && num_cols == cols_) {
+            // 只有当请求的是连续行且占满整行（且行间无填充）时才能返回连续span
+            if (start_col == 0 && num_cols == cols_ && pitch() == cols_) {
                 return {data_.data() + calculate_offset(start_row, 0),
                         static_cast<size_type>(num_rows * cols_)};
             }
@@ -699,40 +1191,100 @@ namespace qm {
                     static_cast<size_type>(num_cols)};
         }
 
-        // ================================
-        // 数据操作和填充
-        // ================================
-
         /**
-         * @brief 重置矩阵内容
+         * @brief 获取任意矩形子块的跨步视图
          *
-         * @param opt 重置选项，默认为All_bits0
+         * @param start_row 起始行索引
+         * @param start_col 起始列索引
+         * @param num_rows 行数
+         * @param num_cols 列数
+         * @return 引用子块的array2d_view，行距与本矩阵相同
          *
-         * @note 对POD类型使用高效的内存操作
-         * @note 对非POD类型使用标准算法
-         * @note 该操作不会抛出异常
+         * @throws std::out_of_range 当子块超出矩阵边界时
+         *
+         * @note 不拷贝任何数据，视图可以继续调用submatrix()得到嵌套子块
+         * @note 矩阵重新分配存储（如resize）后视图失效
+         *
+         * @par 示例:
+         * @code
+         * array2d<double> mat(1024, 1024);
+         * for (int i = 0; i < 1024; i += 64)
+         *     for (int j = 0; j < 1024; j += 64)
+         *         mat.submatrix(i, j, 64, 64).fill(0.0);
+         * @endcode
          */
-        void reset(Array_reset_opt opt = Array_reset_opt::All_bits0) noexcept {
-            if (data_.empty()) return;
+        [[nodiscard]] array2d_view<Ty, Idx> submatrix(index_type start_row, index_type start_col,
+                                                      index_type num_rows, index_type num_cols) {
+            check_block(start_row, start_col, num_rows, num_cols);
+            return {data_.data() + calculate_offset(start_row, start_col), num_rows, num_cols,
+                    row_pitch{static_cast<std::size_t>(pitch())}};
+        }
 
-            if constexpr (std::is_trivially_destructible_v<Ty> &&
+        /**
+         * @brief 获取任意矩形子块的只读跨步视图
+         *
+         * @param start_row 起始行索引
+         * @param start_col 起始列索引
+         * @param num_rows 行数
+         * @param num_cols 列数
+         * @return 引用子块的只读array2d_view
+         *
+         * @throws std::out_of_range 当子块超出矩阵边界时
+         */
+        [[nodiscard]] array2d_view<const Ty, Idx> submatrix(index_type start_row, index_type start_col,
+                                                            index_type num_rows, index_type num_cols) const {
+            check_block(start_row, start_col, num_rows, num_cols);
+            return {data_.data() + calculate_offset(start_row, start_col), num_rows, num_cols,
+                    row_pitch{static_cast<std::size_t>(pitch())}};
+        }
+
+        /**
+         * @brief 获取以原子操作访问元素的视图
+         *
+         * @return 引用整个矩阵的array2d_atomic_view，提供fetch_add、fetch_min、fetch_max、CAS等操作
+         *
+         * @throws std::invalid_argument 当元素不满足std::atomic_ref的对齐要求时
+         *
+         * @note 不拷贝任何数据；视图存在期间对元素的并发访问都必须经过原子视图
+         * @note 矩阵重新分配存储（如resize）后视图失效
+         *
+         * @par 示例:
+         * @code
+         * array2d<double> grid(512, 512, 0.0);
+         * auto acc = grid.atomic_view();
+         * acc.fetch_add(i, j, weight, std::memory_order_relaxed);   // 多线程scatter-add
+         * @endcode
+         */
+        [[nodiscard]] auto atomic_view()
+            requires std::is_trivially_copyable_v<Ty>
+        {
+            return array2d_atomic_view<Ty, Idx>(*this);
+        }
+
+        // ================================
+        // 数据操作和填充
+        // ================================
+
+        /**
+         * @brief 重置矩阵内容
+         *
+         * @param opt 重置选项，默认为All_bits0
+         *
+         * @note 对POD类型使用向量化的字节填充内核（运行时选择SSE2/AVX2/AVX-512）
+         * @note 写入量达到simd::streaming_threshold时使用非临时写入，避免冲刷缓存
+         * @note 对非POD类型使用标准算法
+         * @note 该操作不会抛出异常
+         * @note pitched_layout下行尾填充元素一并重置
+         */
+        void reset(Array_reset_opt opt = Array_reset_opt::All_bits0) noexcept {
+            if (data_.empty()) return;
+
+            if constexpr (std::is_trivially_destructible_v<Ty> &&
                           std::is_trivially_default_constructible_v<Ty> &&
                           std::is_standard_layout_v<Ty>) {
 
-                // 对于POD类型，使用更高效的内存操作
-                if (opt == Array_reset_opt::All_bits0) {
-                    // 使用特殊优化的零初始化
-                    if constexpr (sizeof(Ty) % sizeof(std::uint64_t) == 0) {
-                        // 8字节对齐的快速清零
-                        const auto count = data_.size() * sizeof(Ty) / sizeof(std::uint64_t);
-                        auto      *ptr   = reinterpret_cast<std::uint64_t *>(data_.data());
-                        std::fill_n(ptr, count, 0ULL);
-                    } else {
-                        std::memset(data_.data(), 0, data_.size() * sizeof(Ty));
-                    }
-                } else {
-                    std::memset(data_.data(), static_cast<int>(opt), data_.size() * sizeof(Ty));
-                }
+                // 对于POD类型，所有选项都是逐字节的模式
+                simd::fill_bytes(data_.data(), static_cast<unsigned char>(opt), data_.size() * sizeof(Ty));
             } else {
                 // 对于非POD类型，使用标准算法
                 if constexpr (std::is_nothrow_default_constructible_v<Ty>) {
@@ -751,14 +1303,15 @@ namespace qm {
          *
          * @param val 用于填充的值
          *
-         * @note 对单字节POD类型使用memset优化
+         * @note 对1/2/4/8/16字节的可平凡复制类型使用向量化的模式填充内核
+         * @note 写入量达到simd::streaming_threshold时使用非临时写入，避免冲刷缓存
          * @note 对其他类型使用std::fill
          * @note 异常安全性取决于元素类型的赋值操作
+         * @note pitched_layout下行尾填充元素一并填充，以保持单次连续写入
          */
         void fill(const Ty &val) noexcept(std::is_nothrow_copy_assignable_v<Ty>) {
-            if constexpr (std::is_trivially_copyable_v<Ty> && sizeof(Ty) == 1) {
-                // 对于单字节POD类型的优化
-                std::memset(data_.data(), *reinterpret_cast<const unsigned char *>(&val), data_.size());
+            if constexpr (simd::Fill_pattern_type<Ty>) {
+                simd::fill(data_.data(), data_.size(), val);
             } else {
                 std::fill(data_.begin(), data_.end(), val);
             }
@@ -769,18 +1322,209 @@ namespace qm {
          *
          * @param val 用于填充的值
          *
+         * @throws std::system_error 当首次使用默认线程池、创建线程失败时
+         *
          * @note 只对大矩阵（>10000元素）使用并行算法
          * @note 小矩阵使用普通fill以避免并行开销
-         * @note 异常安全性取决于元素类型的赋值操作
+         * @note 元素赋值抛出的异常会传播给调用者
          */
-        void fill_parallel(const Ty &val) noexcept(std::is_nothrow_copy_assignable_v<Ty>) {
+        void fill_parallel(const Ty &val) {
             if (data_.size() > 10000) {  // 只对大数组使用并行
-                std::fill(std::execution::par_unseq, data_.begin(), data_.end(), val);
+                // 分块边界对齐到缓存行，相邻线程不写同一缓存行
+                detail::parallel_chunks(data_.size(), std::max<std::size_t>(1, 64 / sizeof(Ty)),
+                                        [&](std::size_t first, std::size_t last) {
+                                            if constexpr (simd::Fill_pattern_type<Ty>) {
+                                                simd::fill(data_.data() + first, last - first, val);
+                                            } else {
+                                                std::fill(data_.begin() + first, data_.begin() + last, val);
+                                            }
+                                        });
             } else {
                 fill(val);
             }
         }
 
+        // ================================
+        // 归约操作
+        // ================================
+
+        /**
+         * @brief 求所有元素之和
+         *
+         * @param opt 求和方式，默认为Fast
+         * @return 所有元素之和，空矩阵返回Ty{}
+         *
+         * @note float/double在支持AVX2的CPU上使用向量化内核
+         * @note Fast会改变加法的结合顺序，结果可能与顺序累加有舍入差异
+         * @note pitched_layout下逐行归约，不读取行尾填充元素
+         *
+         * @par 示例
+         * @code
+         * qm::array2d<double> m(1000, 1000, 0.1);
+         * double s = m.sum(qm::Array_sum_opt::Kahan);
+         * @endcode
+         */
+        [[nodiscard]] Ty sum(Array_sum_opt opt = Array_sum_opt::Fast) const {
+            if constexpr (is_pitched) {
+                return sum_rows(0, rows_, opt);
+            } else {
+                return sum_segment(data_.data(), data_.size(), opt);
+            }
+        }
+
+        /**
+         * @brief 并行求所有元素之和
+         *
+         * @param opt 求和方式，默认为Fast
+         * @return 所有元素之和，空矩阵返回Ty{}
+         *
+         * @note 只对大矩阵（>10000元素）使用并行算法，小矩阵等同于sum()
+         * @note 各分块的部分和按opt指定的方式合并
+         */
+        [[nodiscard]] Ty sum_parallel(Array_sum_opt opt = Array_sum_opt::Fast) const {
+            const auto total = static_cast<std::size_t>(rows_) * static_cast<std::size_t>(cols_);
+            if (total <= 10000) return sum(opt);
+
+            // 稠密布局按元素分块，pitched_layout按行分块
+            const auto units  = is_pitched ? static_cast<std::size_t>(rows_) : total;
+            auto      &pool   = default_thread_pool();
+            const auto chunks = std::min<std::size_t>(units, pool.size() * 4);
+
+            std::vector<Ty> partial(chunks);
+            pool.run(chunks, [&](std::size_t chunk) {
+                Ty        &result        = partial[chunk];
+                const auto [first, last] = detail::chunk_bounds(units, chunk, chunks);
+                if constexpr (is_pitched) {
+                    result = sum_rows(static_cast<index_type>(first), static_cast<index_type>(last), opt);
+                } else {
+                    result = sum_segment(data_.data() + first, static_cast<size_type>(last - first), opt);
+                }
+            });
+            return sum_segment(partial.data(), static_cast<size_type>(partial.size()), opt);
+        }
+
+        /**
+         * @brief 求最小元素
+         *
+         * @return 最小元素的值
+         *
+         * @throws std::out_of_range 当矩阵为空时
+         *
+         * @note float/double在支持AVX2的CPU上使用向量化内核
+         * @note 含NaN时结果未指定
+         */
+        [[nodiscard]] Ty min() const {
+            return extremum<false>("min");
+        }
+
+        /**
+         * @brief 求最大元素
+         *
+         * @return 最大元素的值
+         *
+         * @throws std::out_of_range 当矩阵为空时
+         *
+         * @note float/double在支持AVX2的CPU上使用向量化内核
+         * @note 含NaN时结果未指定
+         */
+        [[nodiscard]] Ty max() const {
+            return extremum<true>("max");
+        }
+
+        /**
+         * @brief 求最小元素的位置
+         *
+         * @return 按行优先顺序第一个最小元素的(行, 列)
+         *
+         * @throws std::out_of_range 当矩阵为空时
+         *
+         * @note 按块求向量化最小值，只在块内出现更小值时定位，对内存只遍历一次
+         * @note 含NaN时结果未指定
+         *
+         * @par 示例
+         * @code
+         * auto [i, j] = cost.argmin();
+         * @endcode
+         */
+        [[nodiscard]] std::pair<index_type, index_type> argmin() const {
+            return arg_extremum<false>("argmin");
+        }
+
+        /**
+         * @brief 求最大元素的位置
+         *
+         * @return 按行优先顺序第一个最大元素的(行, 列)
+         *
+         * @throws std::out_of_range 当矩阵为空时
+         *
+         * @note 含NaN时结果未指定
+         */
+        [[nodiscard]] std::pair<index_type, index_type> argmax() const {
+            return arg_extremum<true>("argmax");
+        }
+
+        /**
+         * @brief 对每一行做归约
+         *
+         * @tparam T 结果类型
+         * @tparam BinaryOp 二元归约操作类型
+         * @param init 每行归约的初始值
+         * @param op 归约操作，以op(acc, element)的形式调用，默认为加法
+         * @return 长度为rows()的向量，第i个元素为第i行的归约结果
+         *
+         * @note T与Ty相同且op为std::plus时使用向量化的求和内核（允许重新结合）
+         *
+         * @par 示例
+         * @code
+         * auto row_sums = m.row_reduce(0.0);
+         * auto row_max  = m.row_reduce(-inf, [](double a, double b) { return std::max(a, b); });
+         * @endcode
+         */
+        template<typename T, typename BinaryOp = std::plus<>>
+        [[nodiscard]] std::vector<T> row_reduce(T init, BinaryOp op = {}) const {
+            constexpr bool vectorized_sum = std::same_as<T, Ty> &&
+                                            (std::same_as<BinaryOp, std::plus<>> || std::same_as<BinaryOp, std::plus<Ty>>);
+
+            std::vector<T> result;
+            result.reserve(static_cast<size_type>(rows_));
+            for (index_type i = 0; i < rows_; ++i) {
+                const Ty *row = data_.data() + calculate_offset(i, 0);
+                if constexpr (vectorized_sum) {
+                    result.push_back(init + simd::sum(row, static_cast<size_type>(cols_)));
+                } else {
+                    T acc = init;
+                    for (index_type j = 0; j < cols_; ++j) {
+                        acc = op(std::move(acc), row[j]);
+                    }
+                    result.push_back(std::move(acc));
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief 对每一列做归约
+         *
+         * @tparam T 结果类型
+         * @tparam BinaryOp 二元归约操作类型
+         * @param init 每列归约的初始值
+         * @param op 归约操作，以op(acc, element)的形式调用，默认为加法
+         * @return 长度为cols()的向量，第j个元素为第j列的归约结果
+         *
+         * @note 按行顺序访问内存，对整行累加器逐元素更新，各列互不依赖，便于编译器向量化
+         */
+        template<typename T, typename BinaryOp = std::plus<>>
+        [[nodiscard]] std::vector<T> col_reduce(T init, BinaryOp op = {}) const {
+            std::vector<T> result(static_cast<size_type>(cols_), init);
+            for (index_type i = 0; i < rows_; ++i) {
+                const Ty *row = data_.data() + calculate_offset(i, 0);
+                for (index_type j = 0; j < cols_; ++j) {
+                    result[j] = op(std::move(result[j]), row[j]);
+                }
+            }
+            return result;
+        }
+
         // ================================
         // 行操作
         // ================================
@@ -823,6 +1567,7 @@ namespace qm {
          * @param row2 第二行索引
          *
          * @note 如果两行索引相同，则不执行任何操作
+         * @note 对可平凡复制类型使用向量化的内存交换内核（simd::swap_bytes）
          * @note 不进行边界检查（在调试模式下使用断言）
          * @note 异常安全性取决于元素类型的交换操作
          */
@@ -837,303 +1582,1380 @@ namespace qm {
             const auto offset2   = calculate_offset(row2, 0);
             const auto swap_size = static_cast<size_type>(cols_);
 
-            for (size_type i = 0; i < swap_size; ++i) {
-                using std::swap;
-                swap(data_[offset1 + i], data_[offset2 + i]);
+            if constexpr (std::is_trivially_copyable_v<Ty>) {
+                simd::swap_bytes(data_.data() + offset1, data_.data() + offset2, swap_size * sizeof(Ty));
+            } else {
+                for (size_type i = 0; i < swap_size; ++i) {
+                    using std::swap;
+                    swap(data_[offset1 + i], data_[offset2 + i]);
+                }
+            }
+        }
+
+        /**
+         * @brief 用指定值填充一行
+         *
+         * @param row 行索引
+         * @param val 用于填充的值
+         *
+         * @note 不进行边界检查（在调试模式下使用断言）
+         * @note 异常安全性取决于元素类型的赋值操作
+         */
+        void fill_row(index_type row, const Ty &val) noexcept(std::is_nothrow_copy_assignable_v<Ty>) {
+
+            assert_bounds(row, rows_);
+            const auto offset = calculate_offset(row, 0);
+            std::fill_n(data_.data() + offset, cols_, val);
+        }
+
+        /**
+         * @brief 按排列重排所有行
+         *
+         * @param perm 长度为rows()的排列，重排后第i行为原来的第perm[i]行
+         *
+         * @throws std::invalid_argument 当perm不是[0, rows())的排列时
+         * @throws std::bad_alloc 当临时行缓冲区分配失败时
+         *
+         * @note 将排列分解为不相交的循环，每行只移动一次，每个循环额外使用一行缓冲区
+         * @note 长度为2的循环直接使用swap_rows()
+         * @note 参数检查和缓冲区分配在修改之前完成；元素移动操作抛出异常时矩阵内容未指定
+         *
+         * @par 示例
+         * @code
+         * // 按优先级重排
+         * std::vector<int> order = ...;  // order[i]为新第i行的原行号
+         * m.permute_rows(order);
+         * @endcode
+         */
+        void permute_rows(std::span<const index_type> perm) {
+            validate_permutation(perm, rows_, "permute_rows");
+
+            std::vector<Ty> buffer;
+            buffer.reserve(static_cast<size_type>(cols_));
+            std::vector<bool> done(static_cast<size_type>(rows_));
+
+            for (index_type start = 0; start < rows_; ++start) {
+                if (done[start] || perm[start] == start) continue;
+
+                if (perm[perm[start]] == start) {
+                    done[start] = done[perm[start]] = true;
+                    swap_rows(start, perm[start]);
+                    continue;
+                }
+
+                // 保存起始行，沿循环把每行的来源行移入，最后放回起始行
+                Ty *const first = data_.data() + calculate_offset(start, 0);
+                buffer.assign(std::make_move_iterator(first), std::make_move_iterator(first + cols_));
+                index_type cur = start;
+                while (perm[cur] != start) {
+                    done[cur] = true;
+                    relocate_row(perm[cur], cur);
+                    cur = perm[cur];
+                }
+                done[cur] = true;
+                std::move(buffer.begin(), buffer.end(), data_.data() + calculate_offset(cur, 0));
+            }
+        }
+
+        /**
+         * @brief 按排列重排所有列
+         *
+         * @param perm 长度为cols()的排列，重排后第j列为原来的第perm[j]列
+         *
+         * @throws std::invalid_argument 当perm不是[0, cols())的排列时
+         * @throws std::bad_alloc 当临时行缓冲区分配失败时
+         *
+         * @note 逐行把重排结果收集到一行缓冲区后写回，按行顺序访问内存
+         * @note 参数检查和缓冲区分配在修改之前完成；元素移动操作抛出异常时矩阵内容未指定
+         */
+        void permute_cols(std::span<const index_type> perm) {
+            validate_permutation(perm, cols_, "permute_cols");
+
+            std::vector<Ty> buffer;
+            buffer.reserve(static_cast<size_type>(cols_));
+            for (index_type i = 0; i < rows_; ++i) {
+                Ty *const row = data_.data() + calculate_offset(i, 0);
+                buffer.clear();
+                for (index_type j = 0; j < cols_; ++j) {
+                    buffer.push_back(std::move(row[perm[j]]));
+                }
+                std::move(buffer.begin(), buffer.end(), row);
             }
         }
 
+        // ================================
+        // 矩阵变换操作
+        // ================================
+
+        /**
+         * @brief 就地转置矩阵
+         *
+         * @throws std::bad_alloc 当非方阵所需的辅助位图分配失败时
+         *
+         * @note 方阵使用缓存友好的分块交换
+         * @note 非方阵使用循环跟随算法，交换rows()/cols()并在原存储上重排元素，
+         *       只额外占用每元素1位的已访问位图，无需分配第二个矩阵
+         * @note pitched_layout的非方阵先压缩为稠密排列，重排后再按新列数的默认行距展开；
+         *       展开后所需空间超过容量时会重新分配。元素的构造、拷贝或赋值可能抛出时
+         *       改为转置到新矩阵，失败时矩阵不变
+         * @note 元素移动操作抛出异常时矩阵保持有效，但内容未指定
+         *
+         * @par 示例
+         * @code
+         * qm::array2d<float> m(20000, 30000);
+         * m.transpose();  // 30000 x 20000，不分配第二个矩阵
+         * @endcode
+         */
+        void transpose() {
+            transpose_impl(false);
+        }
+
+        /**
+         * @brief 并行就地转置矩阵
+         *
+         * @throws std::bad_alloc 当非方阵所需的辅助位图分配失败时
+         *
+         * @note 方阵按块行并行交换；非方阵由各线程只旋转以自身为最小下标的循环，
+         *       已访问位图用原子操作更新
+         * @note 只对大矩阵（>10000元素）使用并行算法，小矩阵等同于transpose()
+         * @note 元素移动操作抛出的第一个异常传播给调用者，此时矩阵内容未指定
+         */
+        void transpose_parallel() {
+            transpose_impl(size() > 10000);
+        }
+
+        /**
+         * @brief 返回转置后的新矩阵
+         *
+         * @return 转置后的矩阵
+         *
+         * @note 支持任意尺寸的矩阵
+         * @note 使用缓存无关的递归分块算法（simd::transpose）
+         * @note 4/8字节的可平凡复制类型在块内使用SSE2/AVX2寄存器内转置微内核
+         * @note 不修改原矩阵
+         * @note 结果矩阵使用与原矩阵相同的分配器
+         */
+        [[nodiscard]] array2d transposed() const {
+            array2d result = make_transposed_result();
+            simd::transpose(data_.data(), static_cast<size_type>(pitch()), result.data_.data(),
+                            static_cast<size_type>(result.pitch()), static_cast<size_type>(rows_),
+                            static_cast<size_type>(cols_));
+            return result;
+        }
+
+        /**
+         * @brief 并行返回转置后的新矩阵
+         *
+         * @return 转置后的矩阵
+         *
+         * @note 沿较长的一维切分为若干条带，各条带分别用simd::transpose并行转置
+         * @note 只对大矩阵（>10000元素）使用并行算法，小矩阵等同于transposed()
+         *
+         * @par 示例
+         * @code
+         * qm::array2d<float> m(20000, 20000);
+         * auto t = m.transposed_parallel();
+         * @endcode
+         */
+        [[nodiscard]] array2d transposed_parallel() const {
+            if (size() <= 10000) return transposed();
+
+            array2d    result     = make_transposed_result();
+            const auto src_stride = static_cast<size_type>(pitch());
+            const auto dst_stride = static_cast<size_type>(result.pitch());
+            const auto rows       = static_cast<size_type>(rows_);
+            const auto cols       = static_cast<size_type>(cols_);
+
+            // 条带宽度为基本块边长的整数倍，使相邻条带不共享目标缓存行
+            constexpr size_type extent   = simd::detail::transpose_tile_extent<Ty>;
+            const bool          by_rows  = rows >= cols;
+            const auto          length   = by_rows ? rows : cols;
+            const auto          tiles    = (length + extent - 1) / extent;
+            auto               &pool     = default_thread_pool();
+            const auto          bands    = std::min<size_type>(tiles, pool.size() * 4);
+
+            pool.run(bands, [&](size_type band) {
+                const auto first = tiles * band / bands * extent;
+                const auto last  = std::min(tiles * (band + 1) / bands * extent, length);
+                if (by_rows) {
+                    simd::transpose(data_.data() + first * src_stride, src_stride, result.data_.data() + first,
+                                    dst_stride, last - first, cols);
+                } else {
+                    simd::transpose(data_.data() + first, src_stride, result.data_.data() + first * dst_stride,
+                                    dst_stride, rows, last - first);
+                }
+            });
+            return result;
+        }
+
+        // ================================
+        // 矩阵尺寸调整
+        // ================================
+
+        /**
+         * @brief 调整矩阵尺寸
+         *
+         * @param new_rows 新的行数
+         * @param new_cols 新的列数
+         *
+         * @throws std::invalid_argument 当行数或列数为负时
+         * @throws std::overflow_error 当计算总大小溢出时
+         * @throws std::bad_alloc 当内存分配失败时
+         *
+         * @note 保留原有数据（在新尺寸范围内）
+         * @note 新增元素使用默认构造
+         * @note pitched_layout下行距重新按新列数的默认行距计算
+         * @note 容量足够（如已调用reserve或缩小尺寸）时原地移动各行，不重新分配内存
+         */
+        void resize(index_type new_rows, index_type new_cols) {
+            resize_impl(new_rows, new_cols, std::nullopt);
+        }
+
+        /**
+         * @brief 调整矩阵尺寸并指定新元素的值
+         *
+         * @param new_rows 新的行数
+         * @param new_cols 新的列数
+         * @param val 新增元素的初始值
+         *
+         * @throws std::invalid_argument 当行数或列数为负时
+         * @throws std::overflow_error 当计算总大小溢出时
+         * @throws std::bad_alloc 当内存分配失败时
+         *
+         * @note 保留原有数据（在新尺寸范围内）
+         * @note 新增元素使用指定值初始化
+         */
+        void resize(index_type new_rows, index_type new_cols, const Ty &val) {
+            resize_impl(new_rows, new_cols, val);
+        }
+
+        /**
+         * @brief 调整矩阵尺寸但不初始化新增元素
+         *
+         * @param new_rows 新的行数
+         * @param new_cols 新的列数
+         *
+         * @throws std::invalid_argument 当行数或列数为负时
+         * @throws std::overflow_error 当计算总大小溢出时
+         * @throws std::bad_alloc 当内存分配失败时
+         *
+         * @note 仅适用于可平凡默认构造的元素类型
+         * @note 保留原有数据（在新尺寸范围内），新增元素的初值不确定
+         */
+        void resize_uninitialized(index_type new_rows, index_type new_cols)
+            requires std::is_trivially_default_constructible_v<Ty>
+        {
+            resize_impl(new_rows, new_cols, std::nullopt, false);
+        }
+
+        // ================================
+        // 行的追加、插入和删除
+        // ================================
+
+        /**
+         * @brief 在末尾追加一行
+         *
+         * @param row 新行的数据
+         *
+         * @throws std::invalid_argument 当矩阵非空且row的长度与列数不同时
+         * @throws std::overflow_error 当行数或总大小溢出时
+         * @throws std::bad_alloc 当内存分配失败时
+         *
+         * @note 矩阵没有行时以row的长度作为列数
+         * @note 容量按几何级数增长，逐行追加的均摊复杂度为O(cols)
+         * @note 抛出异常时矩阵保持不变
+         *
+         * @par 示例:
+         * @code
+         * array2d<double> table;
+         * table.reserve(1024, 8);
+         * for (const auto &record : records) table.push_back_row(record);
+         * @endcode
+         */
+        void push_back_row(std::span<const Ty> row) {
+            auto new_cols  = cols_;
+            auto new_pitch = pitch_;
+            if (rows_ == 0) {
+                if (row.size() > static_cast<std::size_t>(std::numeric_limits<index_type>::max())) [[unlikely]] {
+                    throw std::overflow_error("push_back_row: row is too long");
+                }
+                new_cols  = static_cast<index_type>(row.size());
+                new_pitch = default_pitch(new_cols);
+            } else if (row.size() != static_cast<std::size_t>(cols_)) [[unlikely]] {
+                throw std::invalid_argument("push_back_row: row size doesn't match matrix columns");
+            }
+
+            // row可能引用矩阵自身的元素，记录其偏移量以便扩容后重新定位
+            const auto first   = data_.data();
+            const bool aliased = !row.empty() && std::less_equal<>{}(first, row.data()) &&
+                                 std::less<>{}(row.data(), first + data_.size());
+            const auto offset  = aliased ? static_cast<std::size_t>(row.data() - first) : 0;
+
+            append_row(new_cols, new_pitch, [&] {
+                if (aliased) {
+                    // 容量已预留，逐个追加时源元素始终有效
+                    for (std::size_t i = 0; i < row.size(); ++i) data_.push_back(data_[offset + i]);
+                } else {
+                    data_.insert(data_.end(), row.begin(), row.end());
+                }
+                if constexpr (is_pitched) {
+                    resize_value_initialized(data_, data_.size() + static_cast<std::size_t>(new_pitch - new_cols));
+                }
+            });
+        }
+
+        /**
+         * @brief 在末尾追加一行，每个元素都由args构造
+         *
+         * @tparam Args 构造参数类型
+         * @param args 构造参数，为空时元素值初始化
+         * @return 新行的span，可直接在其中写入数据而无需先在别处暂存
+         *
+         * @throws std::overflow_error 当行数或总大小溢出时
+         * @throws std::bad_alloc 当内存分配失败时
+         *
+         * @note 容量按几何级数增长，逐行追加的均摊复杂度为O(cols)
+         * @note 元素值在扩容前构造，args可以引用矩阵自身的元素
+         * @note 抛出异常时矩阵保持不变
+         */
+        template<typename... Args>
+            requires std::constructible_from<Ty, Args...>
+        std::span<Ty> emplace_back_row(Args &&...args) {
+            if constexpr (sizeof...(Args) == 0) {
+                append_row(cols_, pitch_, [&] {
+                    resize_value_initialized(data_, data_.size() + static_cast<std::size_t>(pitch_));
+                });
+            } else {
+                const Ty value(std::forward<Args>(args)...);
+                append_row(cols_, pitch_, [&] { data_.resize(data_.size() + static_cast<std::size_t>(pitch_), value); });
+            }
+            return row(rows_ - 1);
+        }
+
+        /**
+         * @brief 在指定位置之前插入若干值初始化的行
+         *
+         * @param pos 插入位置，范围为[0, rows()]
+         * @param count 插入的行数
+         *
+         * @throws std::out_of_range 当pos超出范围时
+         * @throws std::invalid_argument 当count为负时
+         * @throws std::overflow_error 当行数或总大小溢出时
+         * @throws std::bad_alloc 当内存分配失败时
+         */
+        void insert_rows(index_type pos, index_type count) {
+            insert_rows(pos, count, Ty{});
+        }
+
+        /**
+         * @brief 在指定位置之前插入若干行并用指定值填充
+         *
+         * @param pos 插入位置，范围为[0, rows()]
+         * @param count 插入的行数
+         * @param val 新行元素的值
+         *
+         * @throws std::out_of_range 当pos超出范围时
+         * @throws std::invalid_argument 当count为负时
+         * @throws std::overflow_error 当行数或总大小溢出时
+         * @throws std::bad_alloc 当内存分配失败时
+         *
+         * @note 其后的各行整体后移一次，容量不足时按几何级数增长
+         */
+        void insert_rows(index_type pos, index_type count, const Ty &val) {
+            if (pos < 0 || pos > rows_) [[unlikely]] {
+                throw std::out_of_range("insert_rows: position " + std::to_string(pos) + " out of range [0, " +
+                                        std::to_string(rows_) + "]");
+            }
+            const auto new_rows = grown_rows(count);
+            if (count == 0) return;
+
+            if (cols_ > 0) {
+                insert_storage(calculate_offset(pos, 0), calculate_size(count, pitch_), val);
+            }
+            rows_ = new_rows;
+        }
+
+        /**
+         * @brief 删除从指定位置开始的若干行
+         *
+         * @param pos 第一个被删除的行
+         * @param count 删除的行数
+         *
+         * @throws std::out_of_range 当[pos, pos + count)超出行范围时
+         *
+         * @note 其后的各行整体前移一次，不释放容量
+         */
+        void erase_rows(index_type pos, index_type count) {
+            if (pos < 0 || count < 0 || pos > rows_ - count) [[unlikely]] {
+                throw std::out_of_range("erase_rows: rows [" + std::to_string(pos) + ", " +
+                                        std::to_string(pos) + " + " + std::to_string(count) + ") out of range [0, " +
+                                        std::to_string(rows_) + ")");
+            }
+            if (count == 0) return;
+
+            if (cols_ > 0) {
+                erase_storage(calculate_offset(pos, 0), calculate_size(count, pitch_));
+            }
+            rows_ -= count;
+        }
+
+        // ================================
+        // 列的插入和删除
+        // ================================
+
+        /**
+         * @brief 在指定位置之前插入若干值初始化的列
+         *
+         * @param pos 插入位置，范围为[0, cols()]
+         * @param count 插入的列数
+         *
+         * @throws std::out_of_range 当pos超出范围时
+         * @throws std::invalid_argument 当count为负时
+         * @throws std::overflow_error 当列数或总大小溢出时
+         * @throws std::bad_alloc 当内存分配失败时
+         */
+        void insert_cols(index_type pos, index_type count) {
+            insert_cols(pos, count, Ty{});
+        }
+
+        /**
+         * @brief 在指定位置之前插入若干列并用指定值填充
+         *
+         * @param pos 插入位置，范围为[0, cols()]
+         * @param count 插入的列数
+         * @param val 新列元素的值
+         *
+         * @throws std::out_of_range 当pos超出范围时
+         * @throws std::invalid_argument 当count为负时
+         * @throws std::overflow_error 当列数或总大小溢出时
+         * @throws std::bad_alloc 当内存分配失败时
+         *
+         * @note 只对数据做一次流式遍历：容量足够时原地移动各行，否则按几何级数
+         *       扩容并在复制到新存储的同时插入新列
+         * @note pitched_layout下行距按新列数的默认行距重新计算，行尾填充元素的值不确定
+         */
+        void insert_cols(index_type pos, index_type count, const Ty &val) {
+            if (pos < 0 || pos > cols_) [[unlikely]] {
+                throw std::out_of_range("insert_cols: position " + std::to_string(pos) + " out of range [0, " +
+                                        std::to_string(cols_) + "]");
+            }
+            validate_dimension(count, "count");
+            if (count > std::numeric_limits<index_type>::max() - cols_) [[unlikely]] {
+                throw std::overflow_error("Matrix column count overflow");
+            }
+            if (count == 0) return;
+
+            const auto new_cols  = static_cast<index_type>(cols_ + count);
+            const auto new_pitch = default_pitch(new_cols);
+            const auto new_size  = static_cast<std::size_t>(calculate_size(rows_, new_pitch));
+
+            if (rows_ > 0) {
+                bool in_place = false;
+                if constexpr (nothrow_element_ops) {
+                    in_place = new_size <= data_.capacity();
+                }
+
+                // val可能引用矩阵自身的元素，移动数据前先复制
+                const Ty fill = val;
+                if (in_place) {
+                    shift_cols_in_place(new_pitch, new_size, pos, 0, count, &fill);
+                } else {
+                    rebuild_cols(new_cols, new_pitch, std::max(new_size, data_.capacity() * 2), pos, 0, count, &fill);
+                }
+            }
+
+            cols_  = new_cols;
+            pitch_ = new_pitch;
+        }
+
+        /**
+         * @brief 删除从指定位置开始的若干列
+         *
+         * @param pos 第一个被删除的列
+         * @param count 删除的列数
+         *
+         * @throws std::out_of_range 当[pos, pos + count)超出列范围时
+         * @throws std::bad_alloc 当需要分配新存储而内存分配失败时
+         *
+         * @note 只对数据做一次流式遍历，原地压缩各行，不释放容量
+         * @note pitched_layout下新的默认行距可能大于原行距，容量不足时重新分配存储
+         */
+        void erase_cols(index_type pos, index_type count) {
+            if (pos < 0 || count < 0 || pos > cols_ - count) [[unlikely]] {
+                throw std::out_of_range("erase_cols: columns [" + std::to_string(pos) + ", " +
+                                        std::to_string(pos) + " + " + std::to_string(count) + ") out of range [0, " +
+                                        std::to_string(cols_) + ")");
+            }
+            if (count == 0) return;
+
+            const auto new_cols  = static_cast<index_type>(cols_ - count);
+            const auto new_pitch = default_pitch(new_cols);
+            const auto new_size  = static_cast<std::size_t>(calculate_size(rows_, new_pitch));
+
+            if (rows_ > 0) {
+                bool in_place = false;
+                if constexpr (nothrow_element_ops) {
+                    in_place = new_size <= data_.capacity();
+                }
+
+                if (in_place) {
+                    shift_cols_in_place(new_pitch, new_size, pos, count, 0, nullptr);
+                } else {
+                    rebuild_cols(new_cols, new_pitch, new_size, pos, count, 0, nullptr);
+                }
+            }
+
+            cols_  = new_cols;
+            pitch_ = new_pitch;
+        }
+
+        // ================================
+        // 数据访问和实用方法
+        // ================================
+
+        /**
+         * @brief 获取底层数据指针
+         * @return 指向底层数据数组的指针
+         * @note 数据按行优先顺序存储
+         * @note 首地址按storage_alignment字节对齐
+         */
+        [[nodiscard]] constexpr pointer data() noexcept {
+            return std::assume_aligned<storage_alignment>(data_.data());
+        }
+
+        /**
+         * @brief 获取底层数据常量指针
+         * @return 指向底层数据数组的常量指针
+         * @note 数据按行优先顺序存储
+         * @note 首地址按storage_alignment字节对齐
+         */
+        [[nodiscard]] constexpr const_pointer data() const noexcept {
+            return std::assume_aligned<storage_alignment>(data_.data());
+        }
+
+        /**
+         * @brief 与另一个矩阵交换内容
+         *
+         * @param other 要交换的矩阵
+         *
+         * @note 该操作不会抛出异常
+         * @note 交换后两个矩阵的内容（包括行距）完全互换
+         * @warning 分配器不传播且不相等时（如指向不同内存资源的pmr分配器）行为未定义
+         */
+        void swap(array2d &other) noexcept {
+            using std::swap;
+            swap(rows_, other.rows_);
+            swap(cols_, other.cols_);
+            swap(pitch_, other.pitch_);
+            swap(data_, other.data_);
+        }
+
+        /**
+         * @brief 获取底层数据容器的常量引用
+         * @return 底层storage_type（std::vector）的常量引用
+         * @note 主要用于调试和高级操作
+         * @note pitched_layout下包含行尾填充元素
+         * @note storage_type使用default_init_allocator，不能绑定到std::vector<Ty>&
+         */
+        [[nodiscard]] const auto &get_data() const noexcept { return data_; }
+
+        /**
+         * @brief 获取底层数据容器的引用
+         * @return 底层storage_type（std::vector）的引用
+         * @note 主要用于调试和高级操作
+         * @note storage_type使用default_init_allocator，不能绑定到std::vector<Ty>&
+         * @warning 直接修改底层vector可能导致数据不一致
+         */
+        [[nodiscard]] auto &get_vector() noexcept { return data_; }
+
+        // ================================
+        // 比较操作符
+        // ================================
+
+        /**
+         * @brief 相等比较操作符
+         *
+         * @param other 要比较的矩阵
+         * @return 如果两个矩阵尺寸相同且对应元素相等则返回true
+         *
+         * @note 异常安全性取决于元素类型的比较操作
+         */
+        [[nodiscard]] bool operator==(const array2d &other) const
+                noexcept(noexcept(std::declval<Ty>() == std::declval<Ty>())) {
+
+            if constexpr (is_pitched) {
+                return rows_ == other.rows_ &&
+                       cols_ == other.cols_ &&
+                       std::equal(begin(), end(), other.begin());
+            } else {
+                return rows_ == other.rows_ &&
+                       cols_ == other.cols_ &&
+                       data_ == other.data_;
+            }
+        }
+
+        /**
+         * @brief 三路比较操作符
+         *
+         * @param other 要比较的矩阵
+         * @return 比较结果
+         *
+         * @note 首先比较行数，然后列数，最后比较数据
+         * @note 要求元素类型支持三路比较
+         */
+        [[nodiscard]] auto operator<=>(const array2d &other) const
+            requires std::three_way_comparable<Ty>
+        {
+
+            if (auto cmp = rows_ <=> other.rows_; cmp != 0) return cmp;
+            if (auto cmp = cols_ <=> other.cols_; cmp != 0) return cmp;
+            if constexpr (is_pitched) {
+                return std::lexicographical_compare_three_way(begin(), end(), other.begin(), other.end());
+            } else {
+                return data_ <=> other.data_;
+            }
+        }
+
+    private:
+        // ================================
+        // 私有辅助方法
+        // ================================
+
+        /**
+         * @brief 验证维度参数的有效性
+         *
+         * @param dim 要验证的维度值
+         * @param name 维度名称（用于错误消息）
+         * @return 验证后的维度值
+         *
+         * @throws std::invalid_argument 当维度为负时
+         */
+        static constexpr index_type validate_dimension(index_type dim, const char *name) {
+            if (dim < 0) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + " must be non-negative");
+            }
+            return dim;
+        }
+
+        /**
+         * @brief 计算矩阵总大小并检查溢出
+         *
+         * @param rows 行数
+         * @param cols 列数
+         * @return 总元素数
+         *
+         * @throws std::overflow_error 当大小计算溢出时
+         */
+        static constexpr size_type calculate_size(index_type rows, index_type cols) {
+            const auto size = static_cast<size_type>(rows) * static_cast<size_type>(cols);
+
+            // 检查溢出
+            if (rows > 0 && cols > 0 && size / static_cast<size_type>(rows) != static_cast<size_type>(cols)) {
+                throw std::overflow_error("Matrix size calculation overflow");
+            }
+
+            return size;
+        }
+
+        /**
+         * @brief 计算指定列数对应的行距
+         *
+         * @param cols 列数
+         * @return dense_layout下为cols；pitched_layout下为补齐缓存行并错开冲突步长后的行距
+         *
+         * @throws std::overflow_error 当行距超出索引类型范围时
+         */
+        static constexpr index_type default_pitch(index_type cols) {
+            if constexpr (is_pitched) {
+                constexpr std::size_t line = std::max(pitched_layout::line_size, storage_alignment);
+                if constexpr (line % sizeof(Ty) != 0) {
+                    return cols;
+                } else {
+                    if (cols == 0) return cols;
+
+                    constexpr std::size_t per_line = line / sizeof(Ty);
+                    auto pitch = (static_cast<std::size_t>(cols) + per_line - 1) / per_line * per_line;
+                    if ((pitch * sizeof(Ty)) % pitched_layout::conflict_stride == 0) {
+                        pitch += per_line;
+                    }
+
+                    if (pitch > static_cast<std::size_t>(std::numeric_limits<index_type>::max())) [[unlikely]] {
+                        throw std::overflow_error("Matrix pitch calculation overflow");
+                    }
+                    return static_cast<index_type>(pitch);
+                }
+            } else {
+                return cols;
+            }
+        }
+
+        /**
+         * @brief 验证显式指定的行距
+         *
+         * @param pitch 行距
+         * @param cols 列数
+         * @return 验证后的行距
+         *
+         * @throws std::invalid_argument 当行距小于列数或超出索引类型范围时
+         */
+        static constexpr index_type validate_pitch(row_pitch pitch, index_type cols) {
+            if (pitch.value < static_cast<std::size_t>(cols) ||
+                pitch.value > static_cast<std::size_t>(std::numeric_limits<index_type>::max())) [[unlikely]] {
+                throw std::invalid_argument("pitch must not be smaller than cols");
+            }
+            return static_cast<index_type>(pitch.value);
+        }
+
+        /**
+         * @brief 计算二维索引对应的一维偏移量
+         *
+         * @param row 行索引
+         * @param col 列索引
+         * @return 在一维数组中的偏移量
+         *
+         * @note 使用行优先存储顺序，行首间距为pitch()
+         */
+        constexpr size_type calculate_offset(index_type row, index_type col) const noexcept {
+            return static_cast<size_type>(row) * static_cast<size_type>(pitch()) + static_cast<size_type>(col);
+        }
+
+        /**
+         * @brief 从存储指针构造迭代器
+         *
+         * @tparam It 迭代器类型
+         * @param ptr 迭代器位置对应的行首指针（尾后迭代器为存储末尾）
+         * @return 对应布局的迭代器
+         */
+        template<typename It, typename Ptr>
+        constexpr It make_iterator(Ptr ptr) const noexcept {
+            if constexpr (is_pitched) {
+                return It(ptr, 0, static_cast<std::ptrdiff_t>(cols_), static_cast<std::ptrdiff_t>(pitch_));
+            } else {
+                return It(ptr);
+            }
+        }
+
+        /**
+         * @brief transpose()/transpose_parallel()的实现
+         *
+         * @param parallel 是否并行
+         */
+        void transpose_impl(bool parallel) {
+            if (is_square()) {
+                transpose_square(parallel);
+                return;
+            }
+
+            if constexpr (is_pitched && !nothrow_element_ops) {
+                // 压缩和展开在原存储上移动元素，无法在中途失败后恢复，改为转置到新矩阵
+                *this = transposed();
+                return;
+            }
+
+            const auto count = static_cast<std::size_t>(rows_) * static_cast<std::size_t>(cols_);
+            // 先完成所有可能失败的分配，分配失败时矩阵不变
+            std::vector<std::uint64_t> visited((count + 63) / 64);
+            if constexpr (is_pitched) {
+                const auto new_pitch = default_pitch(rows_);
+                data_.reserve(static_cast<std::size_t>(calculate_size(cols_, new_pitch)));
+                resize_in_place(rows_, cols_, cols_, count, std::nullopt, false);
+            }
+
+            transpose_cycles(visited, parallel);
+            std::swap(rows_, cols_);
+            // 置换后存储是紧密的，dense_layout下pitch_同样需要跟随新列数
+            pitch_ = cols_;
+
+            if constexpr (is_pitched) {
+                const auto new_pitch = default_pitch(cols_);
+                resize_in_place(rows_, cols_, new_pitch, static_cast<std::size_t>(calculate_size(rows_, new_pitch)),
+                                std::nullopt, true);
+            }
+        }
+
+        /**
+         * @brief 方阵的分块就地转置
+         *
+         * @param parallel 是否按块行并行
+         */
+        void transpose_square(bool parallel) {
+            // 缓存友好的分块转置，元素大于缓存行时退化为逐元素
+            constexpr index_type block_size = std::max<index_type>(1, 64 / sizeof(Ty));  // 64字节缓存行
+
+            // 交换第i块行中位于对角线及其右侧的块与对称位置的块
+            const auto swap_block_row = [this](index_type i) {
+                const auto i_end = std::min(static_cast<index_type>(i + block_size), rows_);
+                for (index_type j = i; j < cols_; j += block_size) {
+                    const auto j_end = std::min(static_cast<index_type>(j + block_size), cols_);
+
+                    // 转置块内元素
+                    for (index_type bi = i; bi < i_end; ++bi) {
+                        const auto start_j = (i == j) ? bi + 1 : j;  // 避免重复交换对角线元素
+                        for (index_type bj = start_j; bj < j_end; ++bj) {
+                            using std::swap;
+                            swap((*this)[bi][bj], (*this)[bj][bi]);
+                        }
+                    }
+                }
+            };
+
+            if (parallel) {
+                default_thread_pool().run(static_cast<size_type>((rows_ + block_size - 1) / block_size),
+                                          [&](size_type k) { swap_block_row(static_cast<index_type>(k * block_size)); });
+            } else {
+                for (index_type i = 0; i < rows_; i += block_size) swap_block_row(i);
+            }
+        }
+
+        /**
+         * @brief 用循环跟随算法将稠密排列的rows_ x cols_矩阵重排为其转置
+         *
+         * 转置后位置d的元素来自原位置(d % rows_) * cols_ + d / rows_，该置换分解为若干
+         * 互不相交的循环，逐个沿循环拉取元素即可原地完成重排。
+         *
+         * @param visited 至少rows_ * cols_位的全零位图
+         * @param parallel 是否并行：各线程只旋转以自身为最小下标的循环
+         */
+        void transpose_cycles(std::vector<std::uint64_t> &visited, bool parallel) {
+            const auto rows  = static_cast<std::size_t>(rows_);
+            const auto cols  = static_cast<std::size_t>(cols_);
+            const auto count = rows * cols;
+            if (count < 3) return;
+
+            Ty        *p      = data_.data();
+            const auto source = [rows, cols](std::size_t d) { return (d % rows) * cols + d / rows; };
+
+            // 首尾元素位置不变，从leader开始沿循环拉取元素
+            const auto rotate = [&](std::size_t leader, auto mark) {
+                Ty          tmp = std::move(p[leader]);
+                std::size_t cur = leader;
+                for (;;) {
+                    mark(cur);
+                    const auto src = source(cur);
+                    if (src == leader) break;
+                    p[cur] = std::move(p[src]);
+                    cur    = src;
+                }
+                p[cur] = std::move(tmp);
+            };
+
+            if (!parallel) {
+                const auto mark = [&](std::size_t k) { visited[k / 64] |= std::uint64_t{1} << (k % 64); };
+                for (std::size_t k = 1; k + 1 < count; ++k) {
+                    if ((visited[k / 64] >> (k % 64)) & 1) continue;
+                    rotate(k, mark);
+                }
+                return;
+            }
+
+            const auto is_visited = [&](std::size_t k) {
+                return (std::atomic_ref<std::uint64_t>(visited[k / 64]).load(std::memory_order_relaxed) >> (k % 64)) & 1;
+            };
+            const auto mark = [&](std::size_t k) {
+                std::atomic_ref<std::uint64_t>(visited[k / 64]).fetch_or(std::uint64_t{1} << (k % 64),
+                                                                         std::memory_order_relaxed);
+            };
+
+            auto      &pool   = default_thread_pool();
+            const auto chunks = std::min<std::size_t>(count, pool.size() * 16);
+            pool.run(chunks, [&](std::size_t chunk) {
+                const auto [lo, hi] = detail::chunk_bounds(count, chunk, chunks);
+                const auto first    = std::max<std::size_t>(1, lo);
+                const auto last     = std::min(hi, count - 1);
+                for (std::size_t k = first; k < last; ++k) {
+                    if (is_visited(k)) continue;
+
+                    // 只有循环中的最小下标负责旋转，其他线程遇到更小的下标即放弃
+                    bool leader = true;
+                    for (auto s = source(k); s != k; s = source(s)) {
+                        if (s < k) {
+                            leader = false;
+                            break;
+                        }
+                    }
+                    if (leader) rotate(k, mark);
+                }
+            });
+        }
+
+        /**
+         * @brief 检查perm是否为[0, count)的排列
+         *
+         * @param perm 待检查的排列
+         * @param count 排列长度
+         * @param name 调用者名称（用于错误消息）
+         *
+         * @throws std::invalid_argument 当perm长度不符、越界或有重复元素时
+         */
+        static void validate_permutation(std::span<const index_type> perm, index_type count, const char *name) {
+            if (perm.size() != static_cast<size_type>(count)) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": permutation size mismatch");
+            }
+            std::vector<bool> seen(perm.size());
+            for (const auto index: perm) {
+                if (index < 0 || index >= count || seen[index]) [[unlikely]] {
+                    throw std::invalid_argument(std::string(name) + ": not a permutation");
+                }
+                seen[index] = true;
+            }
+        }
+
+        /**
+         * @brief 把src行移动到dst行
+         */
+        void relocate_row(index_type src, index_type dst) noexcept(std::is_nothrow_move_assignable_v<Ty>) {
+            Ty *const from = data_.data() + calculate_offset(src, 0);
+            Ty *const to   = data_.data() + calculate_offset(dst, 0);
+            if constexpr (std::is_trivially_copyable_v<Ty>) {
+                std::memcpy(to, from, static_cast<size_type>(cols_) * sizeof(Ty));
+            } else {
+                std::move(from, from + cols_, to);
+            }
+        }
+
+        /**
+         * @brief 构造转置结果矩阵，每个元素都会被覆盖，平凡类型无需先清零
+         */
+        array2d make_transposed_result() const {
+            if constexpr (std::is_trivially_default_constructible_v<Ty>) {
+                return array2d(cols_, rows_, uninitialized, get_allocator());
+            } else {
+                return array2d(cols_, rows_, get_allocator());
+            }
+        }
+
+        /**
+         * @brief 按指定方式对一段连续元素求和
+         */
+        static Ty sum_segment(const Ty *first, size_type count, Array_sum_opt opt) {
+            switch (opt) {
+                case Array_sum_opt::Pairwise:
+                    return simd::sum_pairwise(first, count);
+                case Array_sum_opt::Kahan:
+                    return simd::sum_kahan(first, count);
+                default:
+                    return simd::sum(first, count);
+            }
+        }
+
+        /**
+         * @brief 对[first, last)行求和，逐行求和后再按同样方式合并各行结果
+         */
+        Ty sum_rows(index_type first, index_type last, Array_sum_opt opt) const {
+            std::vector<Ty> row_sums;
+            row_sums.reserve(static_cast<size_type>(last - first));
+            for (index_type i = first; i < last; ++i) {
+                row_sums.push_back(sum_segment(data_.data() + calculate_offset(i, 0), static_cast<size_type>(cols_), opt));
+            }
+            return sum_segment(row_sums.data(), row_sums.size(), opt);
+        }
+
+        /**
+         * @brief min()/max()的实现
+         *
+         * @param name 调用者名称（用于错误消息）
+         */
+        template<bool Max>
+        Ty extremum(const char *name) const {
+            if (empty()) [[unlikely]] {
+                throw std::out_of_range(std::string(name) + ": matrix is empty");
+            }
+            if constexpr (is_pitched) {
+                const auto cols = static_cast<size_type>(cols_);
+                Ty         best = Max ? simd::max(data_.data(), cols) : simd::min(data_.data(), cols);
+                for (index_type i = 1; i < rows_; ++i) {
+                    const Ty *row   = data_.data() + calculate_offset(i, 0);
+                    const Ty  value = Max ? simd::max(row, cols) : simd::min(row, cols);
+                    if (Max ? best < value : value < best) best = value;
+                }
+                return best;
+            } else {
+                return Max ? simd::max(data_.data(), data_.size()) : simd::min(data_.data(), data_.size());
+            }
+        }
+
+        /**
+         * @brief argmin()/argmax()的实现
+         *
+         * @param name 调用者名称（用于错误消息）
+         */
+        template<bool Max>
+        std::pair<index_type, index_type> arg_extremum(const char *name) const {
+            if (empty()) [[unlikely]] {
+                throw std::out_of_range(std::string(name) + ": matrix is empty");
+            }
+            const auto locate = [](const Ty *first, size_type count) {
+                return Max ? simd::argmax(first, count) : simd::argmin(first, count);
+            };
+            if constexpr (is_pitched) {
+                const auto cols = static_cast<size_type>(cols_);
+                index_type best_row = 0;
+                auto       best_col = locate(data_.data(), cols);
+                for (index_type i = 1; i < rows_; ++i) {
+                    const Ty  *row = data_.data() + calculate_offset(i, 0);
+                    const auto j   = locate(row, cols);
+                    const Ty  &best = data_[calculate_offset(best_row, static_cast<index_type>(best_col))];
+                    if (Max ? best < row[j] : row[j] < best) {
+                        best_row = i;
+                        best_col = j;
+                    }
+                }
+                return {best_row, static_cast<index_type>(best_col)};
+            } else {
+                const auto index = locate(data_.data(), data_.size());
+                const auto cols  = static_cast<size_type>(cols_);
+                return {static_cast<index_type>(index / cols), static_cast<index_type>(index % cols)};
+            }
+        }
+
+        /**
+         * @brief 调试模式下的边界检查断言
+         *
+         * @param index 要检查的索引
+         * @param limit 索引的上限（不包含）
+         *
+         * @note 只在调试模式下生效
+         */
+        static constexpr void assert_bounds([[maybe_unused]] index_type index,
+                                            [[maybe_unused]] index_type limit) noexcept {
+#ifdef _DEBUG
+            assert(index >= 0 && index < limit);
+#endif
+        }
+
         /**
-         * @brief 用指定值填充一行
+         * @brief 格式化边界错误消息
          *
          * @param row 行索引
-         * @param val 用于填充的值
-         *
-         * @note 不进行边界检查（在调试模式下使用断言）
-         * @note 异常安全性取决于元素类型的赋值操作
+         * @param col 列索引
+         * @return 格式化的错误消息字符串
          */
-        void fill_row(index_type row, const Ty &val) noexcept(std::is_nothrow_copy_assignable_v<Ty>) {
-
-            assert_bounds(row, rows_);
-            const auto offset = calculate_offset(row, 0);
-            std::fill_n(data_.data() + offset, cols_, val);
+        std::string format_bounds_error(index_type row, index_type col) const {
+            return "array2d: index (" + std::to_string(row) + ", " + std::to_string(col) +
+                   ") out of range [0, " + std::to_string(rows_) + ") x [0, " + std::to_string(cols_) + ")";
         }
 
-        // ================================
-        // 矩阵变换操作
-        // ================================
-
         /**
-         * @brief 就地转置矩阵
+         * @brief 元素的构造、拷贝和赋值是否都不会抛出异常
          *
-         * @throws std::invalid_argument 当矩阵不是方阵时
-         *
-         * @note 只支持方阵的就地转置
-         * @note 使用缓存友好的分块算法
-         * @note 对于非方阵，请使用transposed()方法
+         * 满足时resize可以在现有容量内原地移动数据而不丢失强异常安全保证。
          */
-        void transpose() {
-            if (!is_square()) {
-                throw std::invalid_argument("transpose: matrix must be square for in-place transpose");
-            }
-
-            // 缓存友好的分块转置
-            constexpr size_type block_size = 64 / sizeof(Ty);  // 64字节缓存行
-
-            for (index_type i = 0; i < rows_; i += block_size) {
-                const auto i_end = std::min(i + static_cast<index_type>(block_size), rows_);
-
-                for (index_type j = i; j < cols_; j += block_size) {
-                    const auto j_end = std::min(j + static_cast<index_type>(block_size), cols_);
-
-                    // 转置块内元素
-                    for (index_type bi = i; bi < i_end; ++bi) {
-                        const auto start_j = (i == j) ? bi + 1 : j;  // 避免重复交换对角线元素
-                        for (index_type bj = start_j; bj < j_end; ++bj) {
-                            using std::swap;
-                            swap((*this)[bi][bj], (*this)[bj][bi]);
-                        }
-                    }
-                }
-            }
-        }
+        static constexpr bool nothrow_element_ops =
+                std::is_nothrow_default_constructible_v<Ty> && std::is_nothrow_copy_constructible_v<Ty> &&
+                std::is_nothrow_copy_assignable_v<Ty> && std::is_nothrow_move_assignable_v<Ty>;
 
         /**
-         * @brief 返回转置后的新矩阵
+         * @brief 在现有容量内原地调整尺寸
          *
-         * @return 转置后的矩阵
+         * @param new_rows 新的行数
+         * @param new_cols 新的列数
+         * @param new_pitch 新的行距
+         * @param new_size 新的存储元素数，不超过当前容量
+         * @param fill_value 新元素的填充值（可选）
+         * @param value_init 未指定fill_value时新元素是否值初始化
          *
-         * @note 支持任意尺寸的矩阵
-         * @note 使用缓存友好的分块算法
-         * @note 不修改原矩阵
+         * @note 行距增大时自后向前移动各行，行距减小时自前向后移动，保证不覆盖尚未移动的数据
+         * @note 只有位于旧存储范围内的新增位置需要重新写入，追加部分在扩大存储时已初始化
          */
-        [[nodiscard]] array2d transposed() const {
-            array2d result(cols_, rows_);
-
-            // 缓存友好的转置
-            constexpr size_type block_size = 64 / sizeof(Ty);
+        void resize_in_place(index_type new_rows, index_type new_cols, index_type new_pitch, std::size_t new_size,
+                             const std::optional<Ty> &fill_value, bool value_init) noexcept {
+            const auto old_size  = data_.size();
+            const auto copy_rows = std::min(rows_, new_rows);
+            const auto copy_cols = std::min(cols_, new_cols);
 
-            for (index_type i = 0; i < rows_; i += block_size) {
-                const auto i_end = std::min(i + static_cast<index_type>(block_size), rows_);
+            if (new_size > old_size) {
+                grow_storage(data_, new_size, fill_value, value_init);
+            }
 
-                for (index_type j = 0; j < cols_; j += block_size) {
-                    const auto j_end = std::min(j + static_cast<index_type>(block_size), cols_);
+            // 移动保留的各行，第0行的位置不变
+            const auto move_row = [&](index_type i) {
+                move_elements(data_.data() + calculate_offset(i, 0),
+                              data_.data() + static_cast<size_type>(i) * static_cast<size_type>(new_pitch), copy_cols);
+            };
+            if (copy_cols > 0 && new_pitch > pitch_) {
+                for (index_type i = copy_rows; i-- > 1;) move_row(i);
+            } else if (copy_cols > 0 && new_pitch < pitch_) {
+                for (index_type i = 1; i < copy_rows; ++i) move_row(i);
+            }
 
-                    for (index_type bi = i; bi < i_end; ++bi) {
-                        for (index_type bj = j; bj < j_end; ++bj) {
-                            result[bj][bi] = (*this)[bi][bj];
-                        }
+            // 重新写入位于旧存储范围内的新增位置（包括行尾填充）
+            if (fill_value || value_init) {
+                const Ty   val   = fill_value ? *fill_value : Ty{};
+                const auto limit = std::min(old_size, new_size);
+                const auto reset = [&](std::size_t first, std::size_t last) {
+                    last = std::min(last, limit);
+                    if (first < last) std::fill(data_.begin() + first, data_.begin() + last, val);
+                };
+                const auto stride = static_cast<std::size_t>(new_pitch);
+                if (copy_cols < new_pitch) {
+                    for (index_type i = 0; i < copy_rows; ++i) {
+                        reset(i * stride + static_cast<std::size_t>(copy_cols), (i + 1) * stride);
                     }
                 }
+                reset(static_cast<std::size_t>(copy_rows) * stride, new_size);
             }
 
-            return result;
+            if (new_size < old_size) {
+                data_.erase(data_.begin() + new_size, data_.end());
+            }
+            rows_  = new_rows;
+            cols_  = new_cols;
+            pitch_ = new_pitch;
         }
 
-        // ================================
-        // 矩阵尺寸调整
-        // ================================
-
         /**
-         * @brief 调整矩阵尺寸
-         *
-         * @param new_rows 新的行数
-         * @param new_cols 新的列数
+         * @brief 计算追加count行后的行数
          *
-         * @throws std::invalid_argument 当行数或列数为负时
-         * @throws std::overflow_error 当计算总大小溢出时
-         * @throws std::bad_alloc 当内存分配失败时
+         * @param count 追加的行数
+         * @return rows_ + count
          *
-         * @note 保留原有数据（在新尺寸范围内）
-         * @note 新增元素使用默认构造
+         * @throws std::invalid_argument 当count为负时
+         * @throws std::overflow_error 当行数超出索引类型范围时
          */
-        void resize(index_type new_rows, index_type new_cols) {
-            resize_impl(new_rows, new_cols, std::nullopt);
+        index_type grown_rows(index_type count) const {
+            validate_dimension(count, "count");
+            if (count > std::numeric_limits<index_type>::max() - rows_) [[unlikely]] {
+                throw std::overflow_error("Matrix row count overflow");
+            }
+            return static_cast<index_type>(rows_ + count);
         }
 
         /**
-         * @brief 调整矩阵尺寸并指定新元素的值
+         * @brief 确保容量足以容纳指定行数，不足时按几何级数扩容
          *
-         * @param new_rows 新的行数
-         * @param new_cols 新的列数
-         * @param val 新增元素的初始值
+         * @param rows 需要容纳的行数
+         * @param pitch 行距
          *
-         * @throws std::invalid_argument 当行数或列数为负时
          * @throws std::overflow_error 当计算总大小溢出时
          * @throws std::bad_alloc 当内存分配失败时
-         *
-         * @note 保留原有数据（在新尺寸范围内）
-         * @note 新增元素使用指定值初始化
          */
-        void resize(index_type new_rows, index_type new_cols, const Ty &val) {
-            resize_impl(new_rows, new_cols, val);
+        void reserve_rows(index_type rows, index_type pitch) {
+            const auto needed = static_cast<std::size_t>(calculate_size(rows, pitch));
+            if (needed > data_.capacity()) {
+                data_.reserve(std::max(needed, data_.capacity() * 2));
+            }
         }
 
-        // ================================
-        // 数据访问和实用方法
-        // ================================
-
-        /**
-         * @brief 获取底层数据指针
-         * @return 指向底层数据数组的指针
-         * @note 数据按行优先顺序存储
-         */
-        [[nodiscard]] constexpr pointer data() noexcept { return data_.data(); }
-
-        /**
-         * @brief 获取底层数据常量指针
-         * @return 指向底层数据数组的常量指针
-         * @note 数据按行优先顺序存储
-         */
-        [[nodiscard]] constexpr const_pointer data() const noexcept { return data_.data(); }
-
         /**
-         * @brief 与另一个矩阵交换内容
+         * @brief 在末尾追加一行存储
          *
-         * @param other 要交换的矩阵
+         * @param new_cols 追加后的列数，矩阵有行时必须等于cols_
+         * @param new_pitch 追加后的行距
+         * @param append 向data_末尾追加恰好new_pitch个元素的操作
          *
-         * @note 该操作不会抛出异常
-         * @note 交换后两个矩阵的内容完全互换
+         * @note 先预留容量，追加过程中不会重新分配；append抛出异常时截断回原大小
+         * @note 形状在追加成功后才提交，抛出异常时矩阵保持不变
          */
-        void swap(array2d &other) noexcept {
-            using std::swap;
-            swap(rows_, other.rows_);
-            swap(cols_, other.cols_);
-            swap(data_, other.data_);
+        template<typename Fn>
+        void append_row(index_type new_cols, index_type new_pitch, Fn &&append) {
+            const auto new_rows = grown_rows(1);
+            if (new_cols > 0) {
+                reserve_rows(new_rows, new_pitch);
+                const auto old_size = data_.size();
+                try {
+                    append();
+                } catch (...) {
+                    data_.erase(data_.begin() + old_size, data_.end());
+                    throw;
+                }
+            }
+            rows_  = new_rows;
+            cols_  = new_cols;
+            pitch_ = new_pitch;
         }
 
         /**
-         * @brief 获取底层数据容器的常量引用
-         * @return 底层std::vector的常量引用
-         * @note 主要用于调试和高级操作
-         */
-        [[nodiscard]] const auto &get_data() const noexcept { return data_; }
-
-        /**
-         * @brief 获取底层数据容器的引用
-         * @return 底层std::vector的引用
-         * @note 主要用于调试和高级操作
-         * @warning 直接修改底层vector可能导致数据不一致
+         * @brief 移动n个元素，源与目标区间可以重叠
+         *
+         * @param src 源区间首地址
+         * @param dst 目标区间首地址
+         * @param n 元素个数
          */
-        [[nodiscard]] auto &get_vector() noexcept { return data_; }
-
-        // ================================
-        // 比较操作符
-        // ================================
+        static void move_elements(pointer src, pointer dst, index_type n) noexcept {
+            if (n <= 0 || src == dst) return;
+            if constexpr (std::is_trivially_copyable_v<Ty>) {
+                std::memmove(dst, src, static_cast<size_type>(n) * sizeof(Ty));
+            } else if (dst > src) {
+                std::move_backward(src, src + n, dst + n);
+            } else {
+                std::move(src, src + n, dst);
+            }
+        }
 
         /**
-         * @brief 相等比较操作符
+         * @brief 在现有容量内一次遍历地移动各行，同时删除和插入列
          *
-         * @param other 要比较的矩阵
-         * @return 如果两个矩阵尺寸相同且对应元素相等则返回true
+         * @param new_pitch 新的行距
+         * @param new_size 新的存储元素数，不超过当前容量
+         * @param pos 删除/插入的位置
+         * @param erased 删除的列数
+         * @param inserted 插入的列数
+         * @param val 新列元素的值，inserted为0时可以为空，不能引用矩阵自身的元素
          *
-         * @note 异常安全性取决于元素类型的比较操作
+         * @note 与resize_in_place相同，行距增大时自后向前移动各行，否则自前向后，保证不覆盖尚未移动的数据；
+         *       行内先移动朝行首方向移动的部分
          */
-        [[nodiscard]] bool operator==(const array2d &other) const
-                noexcept(noexcept(std::declval<Ty>() == std::declval<Ty>())) {
+        void shift_cols_in_place(index_type new_pitch, std::size_t new_size, index_type pos, index_type erased,
+                                 index_type inserted, const Ty *val) noexcept {
+            if (new_size > data_.size()) {
+                resize_value_initialized(data_, new_size);
+            }
+
+            const auto tail     = static_cast<index_type>(cols_ - pos - erased);
+            const auto move_row = [&](index_type i) {
+                const auto src = data_.data() + calculate_offset(i, 0);
+                const auto dst = data_.data() + static_cast<size_type>(i) * static_cast<size_type>(new_pitch);
+                if (dst > src) {
+                    move_elements(src + pos + erased, dst + pos + inserted, tail);
+                    move_elements(src, dst, pos);
+                } else {
+                    move_elements(src, dst, pos);
+                    move_elements(src + pos + erased, dst + pos + inserted, tail);
+                }
+                if (inserted > 0) std::fill_n(dst + pos, inserted, *val);
+            };
+            if (new_pitch > pitch_) {
+                for (index_type i = rows_; i-- > 0;) move_row(i);
+            } else {
+                for (index_type i = 0; i < rows_; ++i) move_row(i);
+            }
 
-            return rows_ == other.rows_ &&
-                   cols_ == other.cols_ &&
-                   data_ == other.data_;
+            if (new_size < data_.size()) {
+                data_.erase(data_.begin() + static_cast<std::ptrdiff_t>(new_size), data_.end());
+            }
         }
 
         /**
-         * @brief 三路比较操作符
-         *
-         * @param other 要比较的矩阵
-         * @return 比较结果
+         * @brief 一次遍历地把各行复制到新存储，同时删除和插入列
          *
-         * @note 首先比较行数，然后列数，最后比较数据
-         * @note 要求元素类型支持三路比较
-         */
-        [[nodiscard]] auto operator<=>(const array2d &other) const
-            requires std::three_way_comparable<Ty>
-        {
-
-            if (auto cmp = rows_ <=> other.rows_; cmp != 0) return cmp;
-            if (auto cmp = cols_ <=> other.cols_; cmp != 0) return cmp;
-            return data_ <=> other.data_;
+         * @param new_cols 新的列数
+         * @param new_pitch 新的行距
+         * @param capacity 新存储预留的容量
+         * @param pos 删除/插入的位置
+         * @param erased 删除的列数
+         * @param inserted 插入的列数
+         * @param val 新列元素的值，inserted为0时可以为空
+         *
+         * @note 元素操作不抛异常时移动原有元素，否则拷贝，完成后才与原存储交换以保证强异常安全
+         */
+        void rebuild_cols(index_type new_cols, index_type new_pitch, std::size_t capacity, index_type pos,
+                          index_type erased, index_type inserted, const Ty *val) {
+            storage_type result(data_.get_allocator());
+            result.reserve(capacity);
+
+            const auto take = [](pointer p) {
+                if constexpr (nothrow_element_ops) {
+                    return std::make_move_iterator(p);
+                } else {
+                    return static_cast<const_pointer>(p);
+                }
+            };
+            for (index_type i = 0; i < rows_; ++i) {
+                const auto src = data_.data() + calculate_offset(i, 0);
+                result.insert(result.end(), take(src), take(src + pos));
+                if (inserted > 0) {
+                    result.insert(result.end(), static_cast<std::size_t>(inserted), *val);
+                }
+                result.insert(result.end(), take(src + pos + erased), take(src + cols_));
+                if constexpr (is_pitched) {
+                    resize_value_initialized(result, result.size() + static_cast<std::size_t>(new_pitch - new_cols));
+                }
+            }
+            data_.swap(result);
         }
 
-    private:
-        // ================================
-        // 私有辅助方法
-        // ================================
-
         /**
-         * @brief 验证维度参数的有效性
-         *
-         * @param dim 要验证的维度值
-         * @param name 维度名称（用于错误消息）
-         * @return 验证后的维度值
+         * @brief 在存储的指定偏移处插入count个val
          *
-         * @throws std::invalid_argument 当维度为负时
+         * @note 元素操作不抛异常时原地插入，否则复制到新存储后交换以保证强异常安全
          */
-        static constexpr index_type validate_dimension(index_type dim, const char *name) {
-            if (dim < 0) [[unlikely]] {
-                throw std::invalid_argument(std::string(name) + " must be non-negative");
+        void insert_storage(std::size_t offset, std::size_t count, const Ty &val) {
+            const auto pos = data_.begin() + static_cast<std::ptrdiff_t>(offset);
+            if constexpr (nothrow_element_ops) {
+                data_.insert(pos, count, val);
+            } else {
+                storage_type result(data_.get_allocator());
+                result.reserve(data_.size() + count);
+                result.insert(result.end(), data_.begin(), pos);
+                result.insert(result.end(), count, val);
+                result.insert(result.end(), pos, data_.end());
+                data_.swap(result);
             }
-            return dim;
         }
 
         /**
-         * @brief 计算矩阵总大小并检查溢出
-         *
-         * @param rows 行数
-         * @param cols 列数
-         * @return 总元素数
+         * @brief 删除存储中从指定偏移开始的count个元素
          *
-         * @throws std::overflow_error 当大小计算溢出时
+         * @note 元素操作不抛异常时原地删除，否则复制到新存储后交换以保证强异常安全
          */
-        static constexpr size_type calculate_size(index_type rows, index_type cols) {
-            const auto size = static_cast<size_type>(rows) * static_cast<size_type>(cols);
-
-            // 检查溢出
-            if (rows > 0 && cols > 0 && size / static_cast<size_type>(rows) != static_cast<size_type>(cols)) {
-                throw std::overflow_error("Matrix size calculation overflow");
+        void erase_storage(std::size_t offset, std::size_t count) {
+            const auto first = data_.begin() + static_cast<std::ptrdiff_t>(offset);
+            const auto last  = first + static_cast<std::ptrdiff_t>(count);
+            if constexpr (nothrow_element_ops) {
+                data_.erase(first, last);
+            } else {
+                storage_type result(data_.get_allocator());
+                result.reserve(data_.size() - count);
+                result.insert(result.end(), data_.begin(), first);
+                result.insert(result.end(), last, data_.end());
+                data_.swap(result);
             }
-
-            return size;
         }
 
         /**
-         * @brief 计算二维索引对应的一维偏移量
-         *
-         * @param row 行索引
-         * @param col 列索引
-         * @return 在一维数组中的偏移量
+         * @brief 将存储扩大到指定大小并初始化追加的元素
          *
-         * @note 使用行优先存储顺序
+         * @param storage 目标存储
+         * @param size 新的元素个数
+         * @param fill_value 追加元素的填充值（可选）
+         * @param value_init 未指定fill_value时追加元素是否值初始化
          */
-        constexpr size_type calculate_offset(index_type row, index_type col) const noexcept {
-            return static_cast<size_type>(row) * static_cast<size_type>(cols_) + static_cast<size_type>(col);
+        static void grow_storage(storage_type &storage, std::size_t size, const std::optional<Ty> &fill_value,
+                                 bool value_init) {
+            if (fill_value) {
+                storage.resize(size, *fill_value);
+            } else if (value_init) {
+                resize_value_initialized(storage, size);
+            } else {
+                storage.resize(size);
+            }
         }
 
         /**
-         * @brief 调试模式下的边界检查断言
+         * @brief 将存储调整为指定大小，新增元素值初始化
          *
-         * @param index 要检查的索引
-         * @param limit 索引的上限（不包含）
+         * @param storage 目标存储
+         * @param size 新的元素个数
          *
-         * @note 只在调试模式下生效
+         * @note storage_type对平凡类型的无参构造不写入任何值，这里显式写入Ty{}
          */
-        static constexpr void assert_bounds([[maybe_unused]] index_type index,
-                                            [[maybe_unused]] index_type limit) noexcept {
-#ifdef _DEBUG
-            assert(index >= 0 && index < limit);
-#endif
+        static void resize_value_initialized(storage_type &storage, std::size_t size) {
+            if constexpr (std::is_trivially_default_constructible_v<Ty> && std::is_copy_constructible_v<Ty>) {
+                storage.resize(size, Ty{});
+            } else {
+                storage.resize(size);
+            }
         }
 
         /**
-         * @brief 格式化边界错误消息
+         * @brief 检查矩形子块是否位于矩阵范围内
          *
-         * @param row 行索引
-         * @param col 列索引
-         * @return 格式化的错误消息字符串
+         * @param start_row 起始行索引
+         * @param start_col 起始列索引
+         * @param num_rows 行数
+         * @param num_cols 列数
+         *
+         * @throws std::out_of_range 当子块超出矩阵边界时
          */
-        std::string format_bounds_error(index_type row, index_type col) const {
-            return "array2d: index (" + std::to_string(row) + ", " + std::to_string(col) +
-                   ") out of range [0, " + std::to_string(rows_) + ") x [0, " + std::to_string(cols_) + ")";
+        void check_block(index_type start_row, index_type start_col,
+                         index_type num_rows, index_type num_cols) const {
+            if (start_row < 0 || start_col < 0 || num_rows < 0 || num_cols < 0 ||
+                start_row > rows_ - num_rows || start_col > cols_ - num_cols) [[unlikely]] {
+                throw std::out_of_range("array2d: block (" + std::to_string(start_row) + ", " +
+                                        std::to_string(start_col) + ") + " + std::to_string(num_rows) + "x" +
+                                        std::to_string(num_cols) + " out of range " + std::to_string(rows_) +
+                                        "x" + std::to_string(cols_));
+            }
         }
 
         /**
@@ -1173,39 +2995,47 @@ namespace qm {
          * @throws std::bad_alloc 当内存分配失败时
          *
          * @note 保留原有数据（在新尺寸范围内）
-         * @note 使用原子更新确保异常安全
+         * @note 容量足够且元素操作不抛异常时原地调整，否则分配新存储后原子更新确保异常安全
+         * @note 新存储使用当前矩阵的分配器
+         * @note value_init为false且未指定fill_value时新增元素只做默认初始化
          */
-        void resize_impl(index_type new_rows, index_type new_cols, std::optional<Ty> fill_value) {
+        void resize_impl(index_type new_rows, index_type new_cols, std::optional<Ty> fill_value,
+                         bool value_init = true) {
             new_rows = validate_dimension(new_rows, "new_rows");
             new_cols = validate_dimension(new_cols, "new_cols");
 
             if (new_rows == rows_ && new_cols == cols_) return;
 
-            const auto new_size = calculate_size(new_rows, new_cols);
+            const auto new_pitch = default_pitch(new_cols);
+            const auto new_size  = calculate_size(new_rows, new_pitch);
 
             if (new_size == 0) {
                 data_.clear();
-                rows_ = new_rows;
-                cols_ = new_cols;
+                rows_  = new_rows;
+                cols_  = new_cols;
+                pitch_ = new_pitch;
                 return;
             }
 
-            // 创建新的数据向量
-            std::vector<Ty> new_data;
-            if (fill_value) {
-                new_data.assign(new_size, *fill_value);
-            } else {
-                new_data.resize(new_size);
+            if constexpr (nothrow_element_ops) {
+                if (new_size <= data_.capacity()) {
+                    resize_in_place(new_rows, new_cols, new_pitch, new_size, fill_value, value_init);
+                    return;
+                }
             }
 
+            // 创建新的数据向量
+            storage_type new_data(data_.get_allocator());
+            grow_storage(new_data, new_size, fill_value, value_init);
+
             // 拷贝现有数据
             if (rows_ > 0 && cols_ > 0) {
                 const auto copy_rows = std::min(rows_, new_rows);
                 const auto copy_cols = std::min(cols_, new_cols);
 
                 for (index_type i = 0; i < copy_rows; ++i) {
-                    const auto old_offset = static_cast<size_type>(i) * static_cast<size_type>(cols_);
-                    const auto new_offset = static_cast<size_type>(i) * static_cast<size_type>(new_cols);
+                    const auto old_offset = calculate_offset(i, 0);
+                    const auto new_offset = static_cast<size_type>(i) * static_cast<size_type>(new_pitch);
 
                     if constexpr (std::is_trivially_copyable_v<Ty>) {
                         std::memcpy(new_data.data() + new_offset,
@@ -1218,15 +3048,17 @@ namespace qm {
             }
 
             // 原子更新
-            data_ = std::move(new_data);
-            rows_ = new_rows;
-            cols_ = new_cols;
+            data_  = std::move(new_data);
+            rows_  = new_rows;
+            cols_  = new_cols;
+            pitch_ = new_pitch;
         }
 
     protected:
-        index_type      rows_{}; /**< 矩阵行数 */
-        index_type      cols_{}; /**< 矩阵列数 */
-        std::vector<Ty> data_;   /**< 底层数据存储，按行优先顺序 */
+        index_type   rows_{};  /**< 矩阵行数 */
+        index_type   cols_{};  /**< 矩阵列数 */
+        index_type   pitch_{}; /**< 行距，dense_layout下与列数相同 */
+        storage_type data_;    /**< 底层数据存储，按行优先顺序 */
     };
 
     // ================================
@@ -1238,13 +3070,15 @@ namespace qm {
      *
      * @tparam Ty 元素类型
      * @tparam Idx 索引类型
+     * @tparam Alloc 分配器类型
+     * @tparam Layout 存储布局
      * @param lhs 第一个矩阵
      * @param rhs 第二个矩阵
      *
      * @note 该操作不会抛出异常
      */
-    template<Array2d_compatible Ty, Array2d_index_type Idx>
-    void swap(array2d<Ty, Idx> &lhs, array2d<Ty, Idx> &rhs) noexcept {
+    template<Array2d_compatible Ty, Array2d_index_type Idx, typename Alloc, Array2d_layout Layout>
+    void swap(array2d<Ty, Idx, Alloc, Layout> &lhs, array2d<Ty, Idx, Alloc, Layout> &rhs) noexcept {
         lhs.swap(rhs);
     }
 
@@ -1295,17 +3129,63 @@ namespace qm {
      *
      * 从现有矩阵推导出相同类型的矩阵。
      */
-    template<Array2d_compatible ValueType, Array2d_index_type IndexType>
-    array2d(const array2d<ValueType, IndexType> &) -> array2d<ValueType, IndexType>;
+    template<Array2d_compatible ValueType, Array2d_index_type IndexType, typename Alloc, Array2d_layout Layout>
+    array2d(const array2d<ValueType, IndexType, Alloc, Layout> &) -> array2d<ValueType, IndexType, Alloc, Layout>;
 
     /**
      * @brief 移动推导指引
      *
      * 从现有矩阵推导出相同类型的矩阵。
      */
-    template<Array2d_compatible ValueType, Array2d_index_type IndexType>
-    array2d(array2d<ValueType, IndexType> &&) -> array2d<ValueType, IndexType>;
+    template<Array2d_compatible ValueType, Array2d_index_type IndexType, typename Alloc, Array2d_layout Layout>
+    array2d(array2d<ValueType, IndexType, Alloc, Layout> &&) -> array2d<ValueType, IndexType, Alloc, Layout>;
+
+    // ================================
+    // 带行距布局别名
+    // ================================
+
+    /**
+     * @brief 使用pitched_layout的二维数组
+     *
+     * 行首按缓存行对齐并错开2的幂步长，适用于列数为2的幂的大矩阵。
+     *
+     * @par 示例:
+     * @code
+     * pitched_array2d<float> table(4096, 4096);  // pitch() == 4112
+     * @endcode
+     */
+    template<Array2d_compatible Ty, Array2d_index_type Idx = int, typename Alloc = std::allocator<Ty>>
+    using pitched_array2d = array2d<Ty, Idx, Alloc, pitched_layout>;
+
+    // ================================
+    // 多态分配器别名
+    // ================================
+
+    namespace pmr {
+        /**
+         * @brief 使用std::pmr::polymorphic_allocator的二维数组
+         *
+         * 允许将矩阵存储指向任意std::pmr::memory_resource，例如在每轮迭代后
+         * 整体释放的std::pmr::monotonic_buffer_resource，以避免频繁的全局堆分配。
+         *
+         * @par 示例:
+         * @code
+         * std::pmr::monotonic_buffer_resource arena;
+         * qm::pmr::array2d<int> delta(100, 100, &arena);
+         * @endcode
+         */
+        template<Array2d_compatible Ty, Array2d_index_type Idx = int>
+        using array2d = qm::array2d<Ty, Idx, std::pmr::polymorphic_allocator<Ty>>;
+    }  // namespace pmr
 
 }  // namespace qm
 
-#endif  // QM_ARRAY_RESET_OPT_DEFINED
\ No newline at end of file
+#endif  // QM_ARRAY_RESET_OPT_DEFINED
+
+#include "array2d_view.hpp"
+#include "array2d_linalg.hpp"
+#include "array2d_summed_area.hpp"
+#include "array2d_stencil.hpp"
+#include "array2d_double_buffer.hpp"
+#include "array2d_cow.hpp"
+#include "array2d_atomic.hpp"
\ No newline at end of file
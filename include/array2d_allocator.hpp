@@ -0,0 +1,207 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace qm {
+
+    // ================================
+    // 对齐分配器
+    // ================================
+
+    /**
+     * @brief 按指定字节边界对齐的分配器
+     *
+     * 所有分配都通过对齐版本的 operator new 完成，保证返回的首地址按
+     * max(Align, alignof(T)) 字节对齐，适用于需要缓存行或SIMD对齐的存储。
+     *
+     * @tparam T 元素类型
+     * @tparam Align 对齐字节数，必须是2的幂
+     *
+     * @note 无状态分配器，所有实例之间都相等
+     */
+    template<typename T, std::size_t Align>
+    class aligned_allocator {
+        static_assert(Align > 0 && (Align & (Align - 1)) == 0, "aligned_allocator: Align must be a power of two");
+
+    public:
+        using value_type                             = T;
+        using size_type                              = std::size_t;
+        using difference_type                        = std::ptrdiff_t;
+        using propagate_on_container_move_assignment = std::true_type;
+        using is_always_equal                        = std::true_type;
+
+        /**
+         * @brief 实际使用的对齐字节数
+         */
+        static constexpr std::size_t alignment = Align > alignof(T) ? Align : alignof(T);
+
+        /**
+         * @brief 重绑定到其他元素类型，保持相同的对齐要求
+         */
+        template<typename U>
+        struct rebind {
+            using other = aligned_allocator<U, Align>;
+        };
+
+        constexpr aligned_allocator() noexcept = default;
+
+        /**
+         * @brief 从其他元素类型的对齐分配器转换构造
+         */
+        template<typename U>
+        constexpr aligned_allocator(const aligned_allocator<U, Align> &) noexcept {}
+
+        /**
+         * @brief 分配n个元素的对齐内存
+         *
+         * @param n 元素个数
+         * @return 指向已对齐的未初始化内存的指针
+         *
+         * @throws std::bad_array_new_length 当请求大小溢出时
+         * @throws std::bad_alloc 当内存分配失败时
+         */
+        [[nodiscard]] T *allocate(size_type n) {
+            if (n > std::numeric_limits<size_type>::max() / sizeof(T)) [[unlikely]] {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{alignment}));
+        }
+
+        /**
+         * @brief 释放由allocate分配的内存
+         *
+         * @param p 待释放的指针
+         * @param n 分配时的元素个数
+         */
+        void deallocate(T *p, size_type n) noexcept {
+            ::operator delete(p, n * sizeof(T), std::align_val_t{alignment});
+        }
+
+        template<typename U>
+        [[nodiscard]] constexpr bool operator==(const aligned_allocator<U, Align> &) const noexcept {
+            return true;
+        }
+    };
+
+    /**
+     * @brief 对齐存储选项
+     *
+     * 作为array2d的第三个模板参数使用，array2d会将其重绑定到实际元素类型。
+     *
+     * @par 示例:
+     * @code
+     * array2d<float, int, aligned<64>> arr(100, 100);  // data() 按64字节对齐
+     * @endcode
+     */
+    template<std::size_t Align>
+    using aligned = aligned_allocator<std::byte, Align>;
+
+    // ================================
+    // 默认初始化分配器适配器
+    // ================================
+
+    /**
+     * @brief 对平凡类型执行默认初始化而非值初始化的分配器适配器
+     *
+     * 容器以无参形式构造元素（如std::vector::resize(n)）时，对可平凡默认构造的
+     * 类型只执行默认初始化（即不写入任何值），省去一次完整的清零遍历；
+     * 其余类型以及带参数的构造全部转发给被适配的分配器，行为不变。
+     *
+     * @tparam A 被适配的分配器类型
+     *
+     * @note 作为基类继承A，可以切片回A，分配、传播和相等性语义均与A一致
+     */
+    template<typename A>
+    class default_init_allocator : public A {
+        using traits = std::allocator_traits<A>;
+
+    public:
+        /**
+         * @brief 重绑定到其他元素类型，同时重绑定被适配的分配器
+         */
+        template<typename U>
+        struct rebind {
+            using other = default_init_allocator<typename traits::template rebind_alloc<U>>;
+        };
+
+        using A::A;
+
+        constexpr default_init_allocator() noexcept(noexcept(A())) = default;
+
+        /**
+         * @brief 从被适配的分配器构造
+         */
+        constexpr default_init_allocator(const A &alloc) noexcept : A(alloc) {}
+
+        /**
+         * @brief 从其他元素类型的适配器转换构造
+         */
+        template<typename B>
+        constexpr default_init_allocator(const default_init_allocator<B> &other) noexcept
+            : A(static_cast<const B &>(other)) {}
+
+        /**
+         * @brief 无参构造元素
+         *
+         * 可平凡默认构造的类型执行默认初始化，其余类型转发给被适配的分配器。
+         */
+        template<typename U>
+        void construct(U *p) noexcept(std::is_nothrow_default_constructible_v<U>) {
+            if constexpr (std::is_trivially_default_constructible_v<U>) {
+                ::new (static_cast<void *>(p)) U;
+            } else {
+                traits::construct(static_cast<A &>(*this), p);
+            }
+        }
+
+        /**
+         * @brief 带参数构造元素，转发给被适配的分配器
+         */
+        template<typename U, typename... Args>
+        void construct(U *p, Args &&...args) {
+            traits::construct(static_cast<A &>(*this), p, std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief 拷贝容器时选择新容器的分配器，保持适配器包装
+         */
+        [[nodiscard]] default_init_allocator select_on_container_copy_construction() const {
+            return default_init_allocator(traits::select_on_container_copy_construction(static_cast<const A &>(*this)));
+        }
+
+        [[nodiscard]] friend bool operator==(const default_init_allocator &lhs,
+                                             const default_init_allocator &rhs) noexcept {
+            return static_cast<const A &>(lhs) == static_cast<const A &>(rhs);
+        }
+    };
+
+    // ================================
+    // 分配器特征
+    // ================================
+
+    /**
+     * @brief 查询分配器保证的首地址对齐字节数
+     *
+     * 分配器提供静态成员alignment时使用该值，否则只保证alignof(value_type)。
+     */
+    template<typename Alloc>
+    struct allocator_alignment
+        : std::integral_constant<std::size_t, alignof(typename std::allocator_traits<Alloc>::value_type)> {};
+
+    template<typename Alloc>
+        requires requires { { Alloc::alignment } -> std::convertible_to<std::size_t>; }
+    struct allocator_alignment<Alloc> : std::integral_constant<std::size_t, Alloc::alignment> {};
+
+    /**
+     * @brief allocator_alignment 的便捷变量模板
+     */
+    template<typename Alloc>
+    inline constexpr std::size_t allocator_alignment_v = allocator_alignment<Alloc>::value;
+
+}  // namespace qm
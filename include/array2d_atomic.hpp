@@ -0,0 +1,409 @@
+#pragma once
+
+#include "array2d.hpp"
+#include "array2d_expr.hpp"
+#include "array2d_parallel.hpp"
+#include "array2d_view.hpp"
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace qm {
+
+    // ================================
+    // array2d_atomic_view 类定义
+    // ================================
+
+    /**
+     * @brief 以原子操作访问已有二维存储的视图
+     *
+     * 每次访问在对应元素上构造std::atomic_ref，多个线程可以通过同一个视图并发地读写
+     * 同一块存储（直方图、scatter-add等），不需要外部锁，也不复制数据。
+     *
+     * @tparam Ty 元素类型，必须可平凡复制
+     * @tparam Idx 索引类型，默认为int
+     *
+     * @note 视图存在期间，所有对被引用元素的并发访问都必须经过原子视图
+     * @note 冲突严重（大量线程集中更新少数元素）时考虑privatized_accumulator
+     * @note 计数类操作通常只需要std::memory_order_relaxed
+     *
+     * @par 示例:
+     * @code
+     * array2d<std::int64_t> hist(256, 256, 0);
+     * auto counts = hist.atomic_view();
+     * qm::parallel_for_rows(pixels.rows(), [&](int first, int last) {
+     *     for (int i = first; i < last; ++i)
+     *         for (int j = 0; j < pixels.cols(); ++j)
+     *             counts.fetch_add(a(i, j), b(i, j), 1, std::memory_order_relaxed);
+     * });
+     * @endcode
+     */
+    template<typename Ty, Array2d_index_type Idx = int>
+        requires std::is_trivially_copyable_v<Ty> && (!std::is_const_v<Ty>)
+    class array2d_atomic_view {
+    public:
+        using value_type = Ty;                  /**< 元素类型 */
+        using index_type = Idx;                 /**< 索引类型 */
+        using size_type  = std::size_t;         /**< 大小类型 */
+        using reference  = std::atomic_ref<Ty>; /**< 元素的原子引用类型 */
+
+        static constexpr size_type required_alignment = std::atomic_ref<Ty>::required_alignment; /**< 元素的对齐要求 */
+
+        // ================================
+        // 构造函数
+        // ================================
+
+        /**
+         * @brief 默认构造函数，创建0x0的空视图
+         */
+        constexpr array2d_atomic_view() noexcept = default;
+
+        /**
+         * @brief 从带行距的行优先缓冲区构造原子视图
+         *
+         * @param data 缓冲区首地址
+         * @param rows 行数，必须非负
+         * @param cols 列数，必须非负
+         * @param pitch 相邻行首之间的元素距离，必须不小于列数
+         *
+         * @throws std::invalid_argument 当尺寸非法，或元素不满足atomic_ref的对齐要求时
+         */
+        array2d_atomic_view(Ty *data, index_type rows, index_type cols, row_pitch pitch)
+            : data_(data), rows_(rows), cols_(cols), pitch_(static_cast<index_type>(pitch.value)) {
+            if (std::cmp_less(rows, 0) || std::cmp_less(cols, 0)) [[unlikely]] {
+                throw std::invalid_argument("array2d_atomic_view: dimensions must be non-negative");
+            }
+            if (std::cmp_less(pitch.value, cols)) [[unlikely]] {
+                throw std::invalid_argument("array2d_atomic_view: pitch must not be smaller than cols");
+            }
+            if (reinterpret_cast<std::uintptr_t>(data) % required_alignment != 0 ||
+                (rows > 1 && pitch.value * sizeof(Ty) % required_alignment != 0)) [[unlikely]] {
+                throw std::invalid_argument("array2d_atomic_view: elements are not aligned to " +
+                                            std::to_string(required_alignment) + " bytes");
+            }
+        }
+
+        /**
+         * @brief 从矩阵或视图构造原子视图
+         *
+         * @param matrix 被引用的矩阵（必须是左值）
+         *
+         * @throws std::invalid_argument 当元素不满足atomic_ref的对齐要求时
+         */
+        template<typename Matrix>
+            requires Array2d_matrix_operand<Matrix> && std::convertible_to<decltype(std::declval<Matrix &>().data()), Ty *>
+        explicit array2d_atomic_view(Matrix &matrix)
+            : array2d_atomic_view(matrix.data(), static_cast<index_type>(matrix.rows()),
+                                  static_cast<index_type>(matrix.cols()),
+                                  row_pitch{static_cast<std::size_t>(matrix.pitch())}) {}
+
+        // ================================
+        // 尺寸
+        // ================================
+
+        [[nodiscard]] constexpr index_type rows() const noexcept { return rows_; }
+        [[nodiscard]] constexpr index_type cols() const noexcept { return cols_; }
+        [[nodiscard]] constexpr index_type pitch() const noexcept { return pitch_; }
+        [[nodiscard]] constexpr Ty        *data() const noexcept { return data_; }
+
+        // ================================
+        // 元素访问
+        // ================================
+
+        /**
+         * @brief 获取元素的原子引用（不检查边界）
+         */
+        [[nodiscard]] reference operator()(index_type row, index_type col) const noexcept {
+            return reference(data_[static_cast<size_type>(row) * static_cast<size_type>(pitch_) +
+                                   static_cast<size_type>(col)]);
+        }
+
+        /**
+         * @brief 获取元素的原子引用（带边界检查）
+         *
+         * @throws std::out_of_range 当索引越界时
+         */
+        [[nodiscard]] reference at(index_type row, index_type col) const {
+            if (std::cmp_less(row, 0) || row >= rows_ || std::cmp_less(col, 0) || col >= cols_) [[unlikely]] {
+                throw std::out_of_range("array2d_atomic_view: index (" + std::to_string(row) + ", " +
+                                        std::to_string(col) + ") out of range");
+            }
+            return (*this)(row, col);
+        }
+
+        // ================================
+        // 原子操作
+        // ================================
+
+        /**
+         * @brief 原子读取元素
+         */
+        [[nodiscard]] Ty load(index_type row, index_type col,
+                              std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            return (*this)(row, col).load(order);
+        }
+
+        /**
+         * @brief 原子写入元素
+         */
+        void store(index_type row, index_type col, Ty value,
+                   std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            (*this)(row, col).store(value, order);
+        }
+
+        /**
+         * @brief 原子交换元素，返回旧值
+         */
+        Ty exchange(index_type row, index_type col, Ty value,
+                    std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            return (*this)(row, col).exchange(value, order);
+        }
+
+        /**
+         * @brief 比较并交换：元素等于expected时写入desired
+         *
+         * @param expected 期望值；失败时被更新为元素的当前值
+         * @return 是否成功写入
+         */
+        bool compare_exchange(index_type row, index_type col, Ty &expected, Ty desired,
+                              std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            return (*this)(row, col).compare_exchange_strong(expected, desired, order);
+        }
+
+        /**
+         * @brief 原子加法，返回旧值
+         *
+         * @note 浮点类型在没有原生指令时由标准库用CAS循环实现
+         */
+        Ty fetch_add(index_type row, index_type col, Ty value,
+                     std::memory_order order = std::memory_order_seq_cst) const noexcept
+            requires(std::integral<Ty> || std::floating_point<Ty>) && (!std::same_as<Ty, bool>)
+        {
+            return (*this)(row, col).fetch_add(value, order);
+        }
+
+        /**
+         * @brief 原子减法，返回旧值
+         */
+        Ty fetch_sub(index_type row, index_type col, Ty value,
+                     std::memory_order order = std::memory_order_seq_cst) const noexcept
+            requires(std::integral<Ty> || std::floating_point<Ty>) && (!std::same_as<Ty, bool>)
+        {
+            return (*this)(row, col).fetch_sub(value, order);
+        }
+
+        /**
+         * @brief 原子地取元素与value的较小者，返回旧值
+         *
+         * @note 用CAS循环实现，value不小于当前值时不写入
+         */
+        Ty fetch_min(index_type row, index_type col, Ty value,
+                     std::memory_order order = std::memory_order_seq_cst) const noexcept
+            requires std::totally_ordered<Ty>
+        {
+            return fetch_update(row, col, value, order, std::less<>{});
+        }
+
+        /**
+         * @brief 原子地取元素与value的较大者，返回旧值
+         *
+         * @note 用CAS循环实现，value不大于当前值时不写入
+         */
+        Ty fetch_max(index_type row, index_type col, Ty value,
+                     std::memory_order order = std::memory_order_seq_cst) const noexcept
+            requires std::totally_ordered<Ty>
+        {
+            return fetch_update(row, col, value, order, std::greater<>{});
+        }
+
+    private:
+        Ty        *data_  = nullptr;
+        index_type rows_  = 0;
+        index_type cols_  = 0;
+        index_type pitch_ = 0;
+
+        /**
+         * @brief value比当前值更优（better(value, current)）时写入，返回旧值
+         */
+        template<typename Better>
+        Ty fetch_update(index_type row, index_type col, Ty value, std::memory_order order, Better better) const noexcept {
+            auto ref     = (*this)(row, col);
+            Ty   current = ref.load(std::memory_order_relaxed);
+            while (better(value, current) && !ref.compare_exchange_weak(current, value, order, std::memory_order_relaxed)) {
+            }
+            return current;
+        }
+    };
+
+    /**
+     * @brief 从矩阵推导原子视图的元素类型和索引类型
+     */
+    template<typename Matrix>
+        requires requires { typename Matrix::index_type; }
+    array2d_atomic_view(Matrix &)
+            -> array2d_atomic_view<std::remove_pointer_t<decltype(std::declval<Matrix &>().data())>,
+                                   typename Matrix::index_type>;
+
+    // ================================
+    // privatized_accumulator 类定义
+    // ================================
+
+    /**
+     * @brief 按线程私有化的累加矩阵
+     *
+     * 每个线程第一次调用local()时得到一份自己的rows x cols累加矩阵，之后的累加是普通的
+     * 非原子写入，没有任何竞争；全部完成后merge_into()把各线程的副本逐元素合并到目标矩阵。
+     * 适合大量线程集中更新少数元素、原子操作冲突严重的场景（例如小直方图）。
+     *
+     * @tparam Ty 累加类型
+     * @tparam Idx 索引类型，默认为int
+     *
+     * @note local()需要加锁查找当前线程的副本，应在每个任务块开始时调用一次并保存引用，
+     *       而不是在每次累加时调用
+     * @note 内存占用为线程数 x rows x cols
+     *
+     * @par 示例:
+     * @code
+     * privatized_accumulator<std::int64_t> acc(256, 256);
+     * qm::parallel_for_rows(pixels.rows(), [&](int first, int last) {
+     *     auto &local = acc.local();
+     *     for (int i = first; i < last; ++i)
+     *         for (int j = 0; j < pixels.cols(); ++j) ++local(a(i, j), b(i, j));
+     * });
+     * acc.merge_into(hist);
+     * @endcode
+     */
+    template<typename Ty, Array2d_index_type Idx = int>
+        requires std::default_initializable<Ty> && std::copyable<Ty>
+    class privatized_accumulator {
+    public:
+        using value_type = Ty;                /**< 累加类型 */
+        using index_type = Idx;               /**< 索引类型 */
+        using array_type = array2d<Ty, Idx>;  /**< 私有副本类型 */
+
+        /**
+         * @brief 创建累加器，私有副本在各线程首次调用local()时才分配
+         *
+         * @param rows 行数
+         * @param cols 列数
+         * @param identity 私有副本的初始值（加法为0，乘法为1，最小值为最大可表示值等）
+         *
+         * @throws std::invalid_argument 当行数或列数为负时
+         */
+        privatized_accumulator(index_type rows, index_type cols, const Ty &identity = Ty{})
+            : rows_(rows), cols_(cols), identity_(identity) {
+            if (std::cmp_less(rows, 0) || std::cmp_less(cols, 0)) [[unlikely]] {
+                throw std::invalid_argument("privatized_accumulator: dimensions must be non-negative");
+            }
+        }
+
+        privatized_accumulator(const privatized_accumulator &)            = delete;
+        privatized_accumulator &operator=(const privatized_accumulator &) = delete;
+
+        [[nodiscard]] index_type rows() const noexcept { return rows_; }
+        [[nodiscard]] index_type cols() const noexcept { return cols_; }
+
+        /**
+         * @brief 获取当前线程的私有累加矩阵，首次调用时创建
+         *
+         * @return 只由当前线程访问的矩阵，所有元素初始为identity
+         *
+         * @throws std::bad_alloc 当内存分配失败时
+         *
+         * @note 返回的引用在clear()或累加器析构之前有效
+         */
+        [[nodiscard]] array_type &local() {
+            const auto      id = std::this_thread::get_id();
+            std::lock_guard lock(mutex_);
+            for (auto &[owner, copy]: copies_) {
+                if (owner == id) return *copy;
+            }
+            copies_.emplace_back(id, std::make_unique<array_type>(rows_, cols_, identity_));
+            return *copies_.back().second;
+        }
+
+        /**
+         * @brief 已创建的私有副本数
+         */
+        [[nodiscard]] std::size_t copies() const {
+            std::lock_guard lock(mutex_);
+            return copies_.size();
+        }
+
+        /**
+         * @brief 把所有私有副本逐元素合并到目标矩阵：target = op(target, copy)
+         *
+         * 按行并行合并，各线程写入互不重叠的行。
+         *
+         * @param target 目标矩阵，尺寸必须与累加器相同；原有内容参与合并
+         * @param op 合并操作，默认为加法
+         *
+         * @throws std::invalid_argument 当目标矩阵尺寸不匹配时
+         *
+         * @note 合并期间不能有线程调用local()或写入私有副本
+         */
+        template<typename Matrix, typename Op = std::plus<>>
+            requires Array2d_matrix_operand<Matrix> && std::convertible_to<decltype(std::declval<Matrix &>().data()), Ty *>
+        void merge_into(Matrix &target, Op op = {}) const {
+            if (static_cast<index_type>(target.rows()) != rows_ || static_cast<index_type>(target.cols()) != cols_)
+                    [[unlikely]] {
+                throw std::invalid_argument("privatized_accumulator: target shape does not match");
+            }
+            std::lock_guard lock(mutex_);
+            if (copies_.empty()) return;
+
+            const auto pitch = static_cast<std::size_t>(target.pitch());
+            const auto cols  = static_cast<std::size_t>(cols_);
+            Ty        *out   = target.data();
+            parallel_for_rows(rows_, [&](index_type first, index_type last) {
+                for (const auto &[owner, copy]: copies_) {
+                    for (auto i = first; i < last; ++i) {
+                        Ty       *dst = out + static_cast<std::size_t>(i) * pitch;
+                        const Ty *src = copy->data() + static_cast<std::size_t>(i) * static_cast<std::size_t>(copy->pitch());
+                        for (std::size_t j = 0; j < cols; ++j) dst[j] = op(dst[j], src[j]);
+                    }
+                }
+            });
+        }
+
+        /**
+         * @brief 合并所有私有副本，返回新的矩阵
+         *
+         * @param op 合并操作，默认为加法
+         * @return 以identity为初值合并后的矩阵
+         */
+        template<typename Op = std::plus<>>
+        [[nodiscard]] array_type merged(Op op = {}) const {
+            array_type result(rows_, cols_, identity_);
+            merge_into(result, op);
+            return result;
+        }
+
+        /**
+         * @brief 释放所有私有副本
+         */
+        void clear() {
+            std::lock_guard lock(mutex_);
+            copies_.clear();
+        }
+
+    private:
+        index_type         rows_;
+        index_type         cols_;
+        Ty                 identity_;
+        mutable std::mutex mutex_;
+        std::vector<std::pair<std::thread::id, std::unique_ptr<array_type>>> copies_;
+    };
+
+}  // namespace qm
@@ -0,0 +1,432 @@
+#pragma once
+
+#include "array2d.hpp"
+#include "array2d_expr.hpp"
+#include "array2d_view.hpp"
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace qm {
+
+    // ================================
+    // cow_array2d 类定义
+    // ================================
+
+    /**
+     * @brief 按块写时复制（copy-on-write）的二维数组
+     *
+     * 矩阵被切分为tile_rows x tile_cols的块，每个块是一个引用计数的独立分配。
+     * 复制（快照）只复制块指针，代价为O(块数)而与元素数无关；写入时只有被写的块
+     * 在仍被其他版本共享时才复制一份，未修改的块在各个版本之间一直共享。
+     * 适合检查点、回溯和束搜索等频繁分叉且各分支差异很小的场景。
+     *
+     * @tparam Ty 元素类型，必须可默认构造和复制赋值
+     * @tparam Idx 索引类型，默认为int
+     *
+     * @note 读访问operator()和at()不会复制；set()、modify()和可写的tile()会先把所在块变为独占
+     * @note 边缘块同样分配完整的tile_rows x tile_cols，超出矩阵的部分不可访问
+     * @note 不同的快照可以在不同线程中读写；同一个对象的并发访问需要调用者同步
+     * @note 块使用侵入式引用计数：独占判断是acquire读，释放是acq_rel递减，因此另一个线程
+     *       在释放快照之前对块的读取先行发生于本线程随后对该块的原地写入
+     *
+     * @par 示例:
+     * @code
+     * cow_array2d<float> state(array2d<float>(20000, 20000, 0.0f));
+     * auto fork = state.snapshot();   // O(块数)，不复制元素
+     * fork.set(10, 10, 1.0f);         // 只复制(10, 10)所在的一个块
+     * @endcode
+     */
+    template<Array2d_compatible Ty, Array2d_index_type Idx = int>
+        requires std::default_initializable<Ty> && std::copyable<Ty>
+    class cow_array2d {
+    public:
+        using value_type      = Ty;                          /**< 元素类型 */
+        using index_type      = Idx;                         /**< 索引类型 */
+        using size_type       = std::size_t;                 /**< 大小类型 */
+        using reference       = Ty &;                        /**< 引用类型 */
+        using const_reference = const Ty &;                  /**< 常量引用类型 */
+        using view_type       = array2d_view<Ty, Idx>;       /**< 块的可写视图类型 */
+        using const_view_type = array2d_view<const Ty, Idx>; /**< 块的只读视图类型 */
+
+        static constexpr index_type default_tile_extent = 64; /**< 默认块边长 */
+
+        // ================================
+        // 构造函数
+        // ================================
+
+        /**
+         * @brief 默认构造函数，创建0x0的空矩阵
+         */
+        cow_array2d() = default;
+
+        /**
+         * @brief 构造指定尺寸的矩阵，所有元素为value
+         *
+         * 所有块共享同一个填充好的块，构造只分配一个块；之后写到哪里才复制到哪里。
+         *
+         * @param rows 行数
+         * @param cols 列数
+         * @param value 初始值
+         * @param tile_rows 块的行数
+         * @param tile_cols 块的列数
+         *
+         * @throws std::invalid_argument 当行数或列数为负，或块的尺寸不大于0时
+         * @throws std::bad_alloc 当内存分配失败时
+         */
+        cow_array2d(index_type rows, index_type cols, const Ty &value = Ty{},
+                    index_type tile_rows = default_tile_extent, index_type tile_cols = default_tile_extent) {
+            reshape(rows, cols, tile_rows, tile_cols);
+            fill(value);
+        }
+
+        /**
+         * @brief 从矩阵复制元素构造
+         *
+         * @param src 源矩阵，可以是array2d、带行距的矩阵或视图
+         * @param tile_rows 块的行数
+         * @param tile_cols 块的列数
+         *
+         * @throws std::invalid_argument 当块的尺寸不大于0时
+         * @throws std::bad_alloc 当内存分配失败时
+         */
+        template<Array2d_matrix_operand M>
+            requires std::convertible_to<typename M::value_type, Ty>
+        explicit cow_array2d(const M &src, index_type tile_rows = default_tile_extent,
+                             index_type tile_cols = default_tile_extent) {
+            reshape(static_cast<index_type>(src.rows()), static_cast<index_type>(src.cols()), tile_rows, tile_cols);
+            const auto pitch = static_cast<size_type>(src.pitch());
+            for (size_type t = 0; t < tiles_.size(); ++t) {
+                auto       tile = make_tile();
+                const auto [r0, c0, height, width] = tile_extent(t);
+                for (size_type i = 0; i < height; ++i) {
+                    std::copy_n(src.data() + (r0 + i) * pitch + c0, width, tile.get() + i * tile_stride());
+                }
+                tiles_[t] = std::move(tile);
+            }
+        }
+
+        /**
+         * @brief 复制构造：与other共享全部块，代价为O(块数)
+         */
+        cow_array2d(const cow_array2d &)            = default;
+        cow_array2d(cow_array2d &&) noexcept        = default;
+        cow_array2d &operator=(const cow_array2d &) = default;
+        cow_array2d &operator=(cow_array2d &&) noexcept = default;
+
+        /**
+         * @brief 创建与当前矩阵共享全部块的快照
+         *
+         * @return 新的版本，此后双方的写入互不可见
+         *
+         * @note 时间复杂度O(块数)，不复制任何元素
+         */
+        [[nodiscard]] cow_array2d snapshot() const { return *this; }
+
+        // ================================
+        // 尺寸
+        // ================================
+
+        [[nodiscard]] index_type rows() const noexcept { return rows_; }
+        [[nodiscard]] index_type cols() const noexcept { return cols_; }
+        [[nodiscard]] bool       empty() const noexcept { return rows_ == 0 || cols_ == 0; }
+        [[nodiscard]] index_type tile_rows() const noexcept { return tile_rows_; }
+        [[nodiscard]] index_type tile_cols() const noexcept { return tile_cols_; }
+
+        /**
+         * @brief 块的行数（纵向块数）
+         */
+        [[nodiscard]] index_type tiles_down() const noexcept {
+            return tiles_across_ == 0 ? 0 : static_cast<index_type>(tiles_.size() / tiles_across_);
+        }
+
+        /**
+         * @brief 块的列数（横向块数）
+         */
+        [[nodiscard]] index_type tiles_across() const noexcept { return static_cast<index_type>(tiles_across_); }
+
+        // ================================
+        // 元素访问
+        // ================================
+
+        /**
+         * @brief 读取元素（不检查边界，不复制）
+         */
+        [[nodiscard]] const_reference operator()(index_type row, index_type col) const noexcept {
+            const auto [tile, offset] = locate(row, col);
+            return tiles_[tile][offset];
+        }
+
+        /**
+         * @brief 读取元素（带边界检查）
+         *
+         * @throws std::out_of_range 当索引越界时
+         */
+        [[nodiscard]] const_reference at(index_type row, index_type col) const {
+            check_bounds(row, col);
+            return (*this)(row, col);
+        }
+
+        /**
+         * @brief 获取元素的可写引用，所在块被共享时先复制
+         *
+         * @throws std::out_of_range 当索引越界时
+         * @throws std::bad_alloc 当复制块时内存分配失败
+         *
+         * @note 引用在本对象下一次复制或快照之前有效；之后的写入请重新调用modify()
+         */
+        [[nodiscard]] reference modify(index_type row, index_type col) {
+            check_bounds(row, col);
+            const auto [tile, offset] = locate(row, col);
+            return writable_tile(tile)[offset];
+        }
+
+        /**
+         * @brief 写入元素，所在块被共享时先复制
+         *
+         * @throws std::out_of_range 当索引越界时
+         * @throws std::bad_alloc 当复制块时内存分配失败
+         */
+        void set(index_type row, index_type col, const Ty &value) { modify(row, col) = value; }
+
+        // ================================
+        // 块访问
+        // ================================
+
+        /**
+         * @brief 获取第(tile_row, tile_col)块的只读视图
+         *
+         * @throws std::out_of_range 当块索引越界时
+         */
+        [[nodiscard]] const_view_type tile(index_type tile_row, index_type tile_col) const {
+            const auto t                  = tile_index(tile_row, tile_col);
+            const auto [r0, c0, h, w]     = tile_extent(t);
+            return const_view_type(tiles_[t].get(), static_cast<index_type>(h), static_cast<index_type>(w),
+                                   row_pitch{tile_stride()});
+        }
+
+        /**
+         * @brief 获取第(tile_row, tile_col)块的可写视图，块被共享时先复制
+         *
+         * 批量写入时按块取得视图比逐元素modify()快得多。
+         *
+         * @throws std::out_of_range 当块索引越界时
+         * @throws std::bad_alloc 当复制块时内存分配失败
+         */
+        [[nodiscard]] view_type tile(index_type tile_row, index_type tile_col) {
+            const auto t              = tile_index(tile_row, tile_col);
+            const auto [r0, c0, h, w] = tile_extent(t);
+            return view_type(writable_tile(t), static_cast<index_type>(h), static_cast<index_type>(w),
+                             row_pitch{tile_stride()});
+        }
+
+        /**
+         * @brief 第(tile_row, tile_col)块是否与其他版本共享
+         *
+         * @throws std::out_of_range 当块索引越界时
+         */
+        [[nodiscard]] bool tile_shared(index_type tile_row, index_type tile_col) const {
+            return tiles_[tile_index(tile_row, tile_col)].shared();
+        }
+
+        /**
+         * @brief 与其他版本（或同一矩阵的其他位置）共享的块数
+         */
+        [[nodiscard]] size_type shared_tiles() const noexcept {
+            return static_cast<size_type>(
+                    std::count_if(tiles_.begin(), tiles_.end(), [](const auto &tile) { return tile.shared(); }));
+        }
+
+        // ================================
+        // 整体操作
+        // ================================
+
+        /**
+         * @brief 把所有元素设为value
+         *
+         * 只分配一个填充好的块并让所有位置共享它，旧的块在不再被引用时释放。
+         *
+         * @throws std::bad_alloc 当内存分配失败时
+         */
+        void fill(const Ty &value) {
+            if (tiles_.empty()) return;
+            auto tile = make_tile();
+            std::fill_n(tile.get(), tile_size(), value);
+            std::fill(tiles_.begin(), tiles_.end(), tile);
+        }
+
+        /**
+         * @brief 复制出连续存储的array2d
+         *
+         * @throws std::bad_alloc 当内存分配失败时
+         */
+        [[nodiscard]] array2d<Ty, Idx> to_array2d() const {
+            array2d<Ty, Idx> result = [this] {
+                if constexpr (std::is_trivially_default_constructible_v<Ty>) {
+                    return array2d<Ty, Idx>(rows_, cols_, uninitialized);
+                } else {
+                    return array2d<Ty, Idx>(rows_, cols_);
+                }
+            }();
+            const auto pitch = static_cast<size_type>(result.pitch());
+            for (size_type t = 0; t < tiles_.size(); ++t) {
+                const auto [r0, c0, height, width] = tile_extent(t);
+                for (size_type i = 0; i < height; ++i) {
+                    std::copy_n(tiles_[t].get() + i * tile_stride(), width, result.data() + (r0 + i) * pitch + c0);
+                }
+            }
+            return result;
+        }
+
+    private:
+        struct tile_rect {
+            size_type row, col, height, width;
+        };
+
+        /**
+         * @brief 块的侵入式引用计数句柄
+         *
+         * std::shared_ptr::use_count()是relaxed读，不能作为原地写入的依据（C++20因此移除了unique()）。
+         */
+        class tile_ref {
+        public:
+            tile_ref() noexcept = default;
+            explicit tile_ref(size_type size) : block_(new block{{1}, std::make_unique<Ty[]>(size)}) {}
+
+            tile_ref(const tile_ref &other) noexcept : block_(other.block_) {
+                if (block_) block_->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+            tile_ref(tile_ref &&other) noexcept : block_(std::exchange(other.block_, nullptr)) {}
+            tile_ref &operator=(const tile_ref &other) noexcept {
+                tile_ref(other).swap(*this);
+                return *this;
+            }
+            tile_ref &operator=(tile_ref &&other) noexcept {
+                tile_ref(std::move(other)).swap(*this);
+                return *this;
+            }
+            ~tile_ref() {
+                if (block_ && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete block_;
+            }
+
+            void swap(tile_ref &other) noexcept { std::swap(block_, other.block_); }
+
+            [[nodiscard]] Ty *get() const noexcept { return block_ ? block_->elements.get() : nullptr; }
+            [[nodiscard]] Ty &operator[](size_type i) const noexcept { return block_->elements[i]; }
+
+            /**
+             * @brief 是否只被这一个句柄引用，与其他句柄的释放同步
+             */
+            [[nodiscard]] bool unique() const noexcept { return block_->refs.load(std::memory_order_acquire) == 1; }
+
+            /**
+             * @brief 是否被多个句柄引用（仅作统计，不建立同步）
+             */
+            [[nodiscard]] bool shared() const noexcept {
+                return block_ && block_->refs.load(std::memory_order_relaxed) > 1;
+            }
+
+        private:
+            struct block {
+                std::atomic<size_type> refs;
+                std::unique_ptr<Ty[]>  elements;
+            };
+
+            block *block_ = nullptr;
+        };
+
+        index_type                       rows_         = 0;
+        index_type                       cols_         = 0;
+        index_type                       tile_rows_    = default_tile_extent;
+        index_type                       tile_cols_    = default_tile_extent;
+        size_type                        tiles_across_ = 0;
+        std::vector<tile_ref>            tiles_;
+
+        [[nodiscard]] size_type tile_stride() const noexcept { return static_cast<size_type>(tile_cols_); }
+        [[nodiscard]] size_type tile_size() const noexcept {
+            return static_cast<size_type>(tile_rows_) * static_cast<size_type>(tile_cols_);
+        }
+
+        [[nodiscard]] tile_ref make_tile() const { return tile_ref(tile_size()); }
+
+        /**
+         * @brief 设置尺寸并分配块指针表（块本身由调用者创建）
+         */
+        void reshape(index_type rows, index_type cols, index_type tile_rows, index_type tile_cols) {
+            if (std::cmp_less(rows, 0) || std::cmp_less(cols, 0)) [[unlikely]] {
+                throw std::invalid_argument("cow_array2d: dimensions must be non-negative");
+            }
+            if (std::cmp_less_equal(tile_rows, 0) || std::cmp_less_equal(tile_cols, 0)) [[unlikely]] {
+                throw std::invalid_argument("cow_array2d: tile size must be positive");
+            }
+            rows_      = rows;
+            cols_      = cols;
+            tile_rows_ = tile_rows;
+            tile_cols_ = tile_cols;
+            if (empty()) {
+                tiles_across_ = 0;
+                tiles_.clear();
+                return;
+            }
+            const auto down = (static_cast<size_type>(rows) + tile_rows - 1) / static_cast<size_type>(tile_rows);
+            tiles_across_   = (static_cast<size_type>(cols) + tile_cols - 1) / static_cast<size_type>(tile_cols);
+            tiles_.assign(down * tiles_across_, tile_ref());
+        }
+
+        /**
+         * @brief 计算元素所在的块和块内偏移
+         */
+        [[nodiscard]] std::pair<size_type, size_type> locate(index_type row, index_type col) const noexcept {
+            const auto r = static_cast<size_type>(row), c = static_cast<size_type>(col);
+            const auto h = static_cast<size_type>(tile_rows_), w = static_cast<size_type>(tile_cols_);
+            return {r / h * tiles_across_ + c / w, r % h * w + c % w};
+        }
+
+        /**
+         * @brief 第t块在矩阵中的位置和有效尺寸
+         */
+        [[nodiscard]] tile_rect tile_extent(size_type t) const noexcept {
+            const auto row = t / tiles_across_ * static_cast<size_type>(tile_rows_);
+            const auto col = t % tiles_across_ * static_cast<size_type>(tile_cols_);
+            return {row, col, std::min(static_cast<size_type>(tile_rows_), static_cast<size_type>(rows_) - row),
+                    std::min(static_cast<size_type>(tile_cols_), static_cast<size_type>(cols_) - col)};
+        }
+
+        [[nodiscard]] size_type tile_index(index_type tile_row, index_type tile_col) const {
+            if (std::cmp_less(tile_row, 0) || std::cmp_greater_equal(tile_row, tiles_down()) ||
+                std::cmp_less(tile_col, 0) || std::cmp_greater_equal(tile_col, tiles_across_)) [[unlikely]] {
+                throw std::out_of_range("cow_array2d: tile (" + std::to_string(tile_row) + ", " +
+                                        std::to_string(tile_col) + ") out of range");
+            }
+            return static_cast<size_type>(tile_row) * tiles_across_ + static_cast<size_type>(tile_col);
+        }
+
+        void check_bounds(index_type row, index_type col) const {
+            if (std::cmp_less(row, 0) || row >= rows_ || std::cmp_less(col, 0) || col >= cols_) [[unlikely]] {
+                throw std::out_of_range("cow_array2d: index (" + std::to_string(row) + ", " + std::to_string(col) +
+                                        ") out of range");
+            }
+        }
+
+        /**
+         * @brief 使第t块成为本对象独占后返回其首地址
+         */
+        Ty *writable_tile(size_type t) {
+            auto &tile = tiles_[t];
+            if (!tile.unique()) {
+                auto copy = make_tile();
+                std::copy_n(tile.get(), tile_size(), copy.get());
+                tile = std::move(copy);
+            }
+            return tile.get();
+        }
+    };
+
+}  // namespace qm
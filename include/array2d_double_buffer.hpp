@@ -0,0 +1,268 @@
+#pragma once
+
+#include "array2d.hpp"
+#include "array2d_parallel.hpp"
+#include "array2d_view.hpp"
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+namespace qm {
+
+    // ================================
+    // double_buffered_array2d 类定义
+    // ================================
+
+    /**
+     * @brief 双缓冲矩阵：读取当前代的同时写入下一代
+     *
+     * 持有两个尺寸相同的array2d，front为已发布的当前代，back为正在计算的下一代。
+     * publish()原子地交换两者的角色，读线程通过read()取得一致的一代，整个过程不使用互斥锁：
+     * - 读线程在所读缓冲区的计数器上登记，登记后若发现代数已变化则撤销并重试；
+     * - 写线程在写入back之前等待仍在读取该缓冲区的旧读者离开。
+     *
+     * @tparam Ty 元素类型
+     * @tparam Idx 索引类型，默认为int
+     * @tparam Alloc 分配器类型
+     * @tparam Layout 存储布局
+     *
+     * @note 只能有一个写线程（调用back()、publish()、update()的线程），读线程数量不限
+     * @note 对象不可复制也不可移动，读者持有的read_guard引用其内部计数器
+     *
+     * @par 示例:
+     * @code
+     * double_buffered_array2d<std::uint8_t> life(1024, 1024);
+     * for (int step = 0; step < 1000; ++step) {
+     *     life.update_parallel([](auto cur, auto next, int first, int last) {
+     *         for (int i = first; i < last; ++i) evolve_row(cur, next, i);
+     *     });
+     * }
+     *
+     * // 其他线程
+     * auto guard = life.read();
+     * render(guard.view());   // 在guard析构前这一代不会被改写
+     * @endcode
+     */
+    template<Array2d_compatible Ty, Array2d_index_type Idx = int, typename Alloc = std::allocator<Ty>,
+             Array2d_layout Layout = dense_layout>
+    class double_buffered_array2d {
+        /**
+         * @brief 每个缓冲区的读者计数，独占缓存行以免读者之间伪共享
+         */
+        struct alignas(64) reader_slot {
+            std::atomic<std::size_t> count{0};
+        };
+
+    public:
+        using array_type      = array2d<Ty, Idx, Alloc, Layout>; /**< 缓冲区类型 */
+        using value_type      = Ty;                              /**< 元素类型 */
+        using index_type      = Idx;                             /**< 索引类型 */
+        using view_type       = array2d_view<Ty, Idx>;           /**< 可写视图类型 */
+        using const_view_type = array2d_view<const Ty, Idx>;     /**< 只读视图类型 */
+
+        // ================================
+        // 读取凭证
+        // ================================
+
+        /**
+         * @brief 读线程持有的一代数据
+         *
+         * 存在期间对应的缓冲区不会被写线程改写；析构时注销。
+         */
+        class read_guard {
+        public:
+            read_guard(const read_guard &)            = delete;
+            read_guard &operator=(const read_guard &) = delete;
+
+            read_guard(read_guard &&other) noexcept
+                : slot_(std::exchange(other.slot_, nullptr)), view_(other.view_), generation_(other.generation_) {}
+
+            read_guard &operator=(read_guard &&other) noexcept {
+                if (this != &other) {
+                    release();
+                    slot_       = std::exchange(other.slot_, nullptr);
+                    view_       = other.view_;
+                    generation_ = other.generation_;
+                }
+                return *this;
+            }
+
+            ~read_guard() { release(); }
+
+            /**
+             * @brief 获取这一代数据的只读视图
+             */
+            [[nodiscard]] const const_view_type &view() const noexcept { return view_; }
+
+            /**
+             * @brief 获取这一代的代数（每次publish()加1）
+             */
+            [[nodiscard]] std::uint64_t generation() const noexcept { return generation_; }
+
+            const const_view_type *operator->() const noexcept { return &view_; }
+
+        private:
+            friend class double_buffered_array2d;
+
+            reader_slot    *slot_;
+            const_view_type view_;
+            std::uint64_t   generation_;
+
+            read_guard(reader_slot &slot, const_view_type view, std::uint64_t generation) noexcept
+                : slot_(&slot), view_(view), generation_(generation) {}
+
+            void release() noexcept {
+                if (slot_) slot_->count.fetch_sub(1, std::memory_order_release);
+                slot_ = nullptr;
+            }
+        };
+
+        // ================================
+        // 构造函数
+        // ================================
+
+        /**
+         * @brief 创建两个rows x cols的缓冲区，元素都初始化为value
+         *
+         * @param rows 行数
+         * @param cols 列数
+         * @param value 初始值
+         *
+         * @throws std::invalid_argument 当行数或列数为负数时
+         * @throws std::bad_alloc 当内存分配失败时
+         */
+        double_buffered_array2d(index_type rows, index_type cols, const Ty &value = Ty{})
+            : buffers_{array_type(rows, cols, value), array_type(rows, cols, value)} {}
+
+        /**
+         * @brief 以initial作为第0代，back初始化为它的副本
+         *
+         * @param initial 初始数据
+         *
+         * @throws std::bad_alloc 当内存分配失败时
+         */
+        explicit double_buffered_array2d(array_type initial) : buffers_{std::move(initial), array_type{}} {
+            buffers_[1] = buffers_[0];
+        }
+
+        double_buffered_array2d(const double_buffered_array2d &)            = delete;
+        double_buffered_array2d &operator=(const double_buffered_array2d &) = delete;
+
+        // ================================
+        // 查询
+        // ================================
+
+        [[nodiscard]] index_type rows() const noexcept { return buffers_[0].rows(); }
+        [[nodiscard]] index_type cols() const noexcept { return buffers_[0].cols(); }
+
+        /**
+         * @brief 获取当前已发布的代数
+         */
+        [[nodiscard]] std::uint64_t generation() const noexcept { return generation_.load(std::memory_order_acquire); }
+
+        // ================================
+        // 读取
+        // ================================
+
+        /**
+         * @brief 取得当前一代的读取凭证，可在任意线程调用
+         *
+         * @return 持有当前一代的read_guard
+         *
+         * @note 无锁：只有与publish()恰好交错时才重试
+         * @note 长时间持有凭证会使写线程在第二次写入该缓冲区前等待
+         */
+        [[nodiscard]] read_guard read() const noexcept {
+            for (;;) {
+                const auto g    = generation_.load();
+                auto      &slot = readers_[g & 1];
+                slot.count.fetch_add(1);
+                // 登记之后代数未变，写线程在改写这个缓冲区之前一定能看到本次登记
+                if (generation_.load() == g) return read_guard(slot, const_view_type(buffers_[g & 1]), g);
+                slot.count.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief 获取当前一代的只读视图（不登记）
+         *
+         * @note 只能在写线程中使用，或者由调用者保证期间没有publish()
+         */
+        [[nodiscard]] const_view_type front() const noexcept {
+            return const_view_type(buffers_[generation_.load(std::memory_order_relaxed) & 1]);
+        }
+
+        // ================================
+        // 写入
+        // ================================
+
+        /**
+         * @brief 获取下一代的可写视图
+         *
+         * 等待仍在读取该缓冲区（上上一代）的读者离开后返回。
+         *
+         * @note 只能在写线程中调用
+         */
+        [[nodiscard]] view_type back() noexcept {
+            const auto next = (generation_.load(std::memory_order_relaxed) + 1) & 1;
+            while (readers_[next].count.load() != 0) std::this_thread::yield();
+            return view_type(buffers_[next]);
+        }
+
+        /**
+         * @brief 发布back作为新的一代，原来的front成为下一次的back
+         *
+         * @note 只能在写线程中调用；调用之后读者通过read()看到写入back的全部内容
+         */
+        void publish() noexcept { generation_.fetch_add(1); }
+
+        /**
+         * @brief 用当前一代计算下一代并发布
+         *
+         * @param fn 以(const_view_type front, view_type back)调用
+         *
+         * @throws fn抛出的异常，此时不发布
+         *
+         * @par 示例:
+         * @code
+         * values.update([&](auto cur, auto next) { bellman_backup(cur, next); });
+         * @endcode
+         */
+        template<typename Fn>
+            requires std::invocable<Fn &, const_view_type, view_type>
+        void update(Fn &&fn) {
+            auto next = back();
+            fn(front(), next);
+            publish();
+        }
+
+        /**
+         * @brief 按行并行计算下一代并发布
+         *
+         * 行区间通过parallel_for_rows分配给默认线程池（工作窃取调度）。
+         *
+         * @param fn 以(const_view_type front, view_type back, index_type first, index_type last)调用，
+         *           负责写入back的[first, last)行，可能在多个线程中同时调用
+         * @param grain 每次调用fn的最大行数，为0时自动选择
+         *
+         * @throws fn抛出的第一个异常，此时不发布
+         */
+        template<typename Fn>
+            requires std::invocable<Fn &, const_view_type, view_type, index_type, index_type>
+        void update_parallel(Fn &&fn, std::size_t grain = 0) {
+            const auto cur  = front();
+            const auto next = back();
+            parallel_for_rows(rows(), [&](index_type first, index_type last) { fn(cur, next, first, last); }, grain);
+            publish();
+        }
+
+    private:
+        array_type                 buffers_[2];
+        mutable reader_slot        readers_[2];
+        std::atomic<std::uint64_t> generation_{0};
+    };
+
+}  // namespace qm
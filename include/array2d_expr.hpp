@@ -0,0 +1,530 @@
+#pragma once
+
+#include "array2d_iterator.hpp"
+#include "array2d_simd.hpp"
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace qm {
+
+    // ================================
+    // 概念定义
+    // ================================
+
+    /**
+     * @brief 表达式节点的公共基类，仅用于识别表达式类型
+     */
+    struct array2d_expr_base {};
+
+    /**
+     * @brief 惰性表达式节点概念
+     */
+    template<typename E>
+    concept Array2d_expression_node = std::derived_from<std::remove_cvref_t<E>, array2d_expr_base>;
+
+    /**
+     * @brief 可作为表达式叶子的矩阵类型概念（array2d、array2d_view）
+     */
+    template<typename M>
+    concept Array2d_matrix_operand = !Array2d_expression_node<M> && requires(const M &m) {
+        typename M::value_type;
+        { m.data() } -> std::convertible_to<const typename M::value_type *>;
+        { m.rows() } -> std::integral;
+        { m.cols() } -> std::integral;
+        { m.pitch() } -> std::integral;
+    };
+
+    /**
+     * @brief 表达式操作数概念：表达式节点或矩阵
+     */
+    template<typename E>
+    concept Array2d_expression = Array2d_expression_node<E> || Array2d_matrix_operand<std::remove_cvref_t<E>>;
+
+    /**
+     * @brief 可以广播到每个元素的标量类型概念
+     */
+    template<typename S>
+    concept Array2d_scalar = std::is_arithmetic_v<std::remove_cvref_t<S>>;
+
+    // ================================
+    // 表达式节点
+    // ================================
+
+    /**
+     * @brief 引用矩阵存储的表达式叶子
+     *
+     * 只保存首地址、尺寸和行距，复制开销与指针相当。
+     *
+     * @tparam T 元素类型
+     */
+    template<typename T>
+    class array2d_expr_leaf {
+    public:
+        using value_type = T;
+
+        static constexpr bool is_scalar = false;
+
+        template<Array2d_matrix_operand M>
+        explicit array2d_expr_leaf(const M &matrix) noexcept
+            : data_(matrix.data()),
+              rows_(static_cast<std::size_t>(matrix.rows())),
+              cols_(static_cast<std::size_t>(matrix.cols())),
+              pitch_(static_cast<std::size_t>(matrix.pitch())) {}
+
+        [[nodiscard]] std::size_t rows() const noexcept { return rows_; }
+        [[nodiscard]] std::size_t cols() const noexcept { return cols_; }
+
+        /**
+         * @brief 所有行是否首尾相接，可以作为一行连续求值
+         */
+        [[nodiscard]] bool contiguous() const noexcept { return pitch_ == cols_ || rows_ <= 1; }
+
+        /**
+         * @brief 获取第i行的求值器（行首指针）
+         */
+        [[nodiscard]] QM_FORCEINLINE const T *row(std::size_t i) const noexcept { return data_ + i * pitch_; }
+
+    private:
+        const T    *data_;
+        std::size_t rows_;
+        std::size_t cols_;
+        std::size_t pitch_;
+    };
+
+    /**
+     * @brief 广播到每个元素的标量
+     *
+     * @tparam S 标量类型
+     */
+    template<typename S>
+    class array2d_expr_scalar {
+    public:
+        using value_type = S;
+
+        static constexpr bool is_scalar = true;
+
+        /**
+         * @brief 行求值器，任意下标都返回同一个值
+         */
+        struct row_evaluator {
+            S value;
+
+            QM_FORCEINLINE S operator[](std::size_t) const noexcept { return value; }
+        };
+
+        explicit array2d_expr_scalar(S value) noexcept : value_(value) {}
+
+        [[nodiscard]] static constexpr bool contiguous() noexcept { return true; }
+
+        [[nodiscard]] QM_FORCEINLINE row_evaluator row(std::size_t) const noexcept { return {value_}; }
+
+    private:
+        S value_;
+    };
+
+    namespace detail {
+
+        /**
+         * @brief 将操作数转换为表达式中保存的形式：节点按值保存，矩阵转为叶子，标量转为广播节点
+         */
+        template<typename E>
+        auto make_operand(const E &e) {
+            if constexpr (Array2d_expression_node<E>) {
+                return e;
+            } else if constexpr (Array2d_scalar<E>) {
+                return array2d_expr_scalar<E>(e);
+            } else {
+                return array2d_expr_leaf<typename E::value_type>(e);
+            }
+        }
+
+        template<typename E>
+        using operand_t = decltype(make_operand(std::declval<const E &>()));
+
+    }  // namespace detail
+
+    /**
+     * @brief 逐元素运算的惰性表达式节点
+     *
+     * 构造时只检查形状并保存操作数，不做任何计算；赋值给array2d时对每个元素
+     * 调用一次op，整条表达式在一次遍历中完成，不产生中间矩阵。
+     *
+     * @tparam Op 逐元素运算的函数对象类型
+     * @tparam Operands 操作数类型（叶子、标量或其他节点）
+     *
+     * @note 表达式只引用矩阵的存储，被引用的矩阵需在求值前保持有效且不改变尺寸
+     */
+    template<typename Op, typename... Operands>
+    class array2d_expr : public array2d_expr_base {
+    public:
+        using value_type = std::remove_cvref_t<std::invoke_result_t<const Op &, typename Operands::value_type...>>;
+
+        static constexpr bool is_scalar = false;
+
+        /**
+         * @brief 行求值器，对各操作数的行求值器逐元素应用op
+         */
+        template<typename... Rows>
+        struct row_evaluator {
+            Op                  op;
+            std::tuple<Rows...> rows;
+
+            QM_FORCEINLINE value_type operator[](std::size_t j) const {
+                return std::apply([&](const auto &...r) { return static_cast<value_type>(op(r[j]...)); }, rows);
+            }
+        };
+
+        /**
+         * @brief 构造表达式节点
+         *
+         * @throws std::invalid_argument 当非标量操作数的形状不一致时
+         */
+        explicit array2d_expr(Op op, Operands... operands)
+            : op_(std::move(op)), operands_(std::move(operands)...) {
+            bool has_shape = false;
+            const auto check = [&](const auto &operand) {
+                if constexpr (!std::remove_cvref_t<decltype(operand)>::is_scalar) {
+                    if (!has_shape) {
+                        rows_     = operand.rows();
+                        cols_     = operand.cols();
+                        has_shape = true;
+                    } else if (operand.rows() != rows_ || operand.cols() != cols_) [[unlikely]] {
+                        throw std::invalid_argument("array2d expression: operand shapes do not match");
+                    }
+                }
+            };
+            std::apply([&](const auto &...o) { (check(o), ...); }, operands_);
+        }
+
+        [[nodiscard]] std::size_t rows() const noexcept { return rows_; }
+        [[nodiscard]] std::size_t cols() const noexcept { return cols_; }
+
+        [[nodiscard]] bool contiguous() const noexcept {
+            return std::apply([](const auto &...o) { return (o.contiguous() && ...); }, operands_);
+        }
+
+        [[nodiscard]] QM_FORCEINLINE auto row(std::size_t i) const {
+            return std::apply(
+                    [&](const auto &...o) { return row_evaluator<decltype(o.row(i))...>{op_, {o.row(i)...}}; },
+                    operands_);
+        }
+
+    private:
+        Op                      op_;
+        std::tuple<Operands...> operands_;
+        std::size_t             rows_ = 0;
+        std::size_t             cols_ = 0;
+    };
+
+    // ================================
+    // 逐元素运算函数对象
+    // ================================
+
+    namespace detail {
+
+        struct expr_min {
+            template<typename A, typename B>
+            QM_FORCEINLINE auto operator()(const A &a, const B &b) const {
+                using R = std::common_type_t<A, B>;
+                return static_cast<R>(b) < static_cast<R>(a) ? static_cast<R>(b) : static_cast<R>(a);
+            }
+        };
+
+        struct expr_max {
+            template<typename A, typename B>
+            QM_FORCEINLINE auto operator()(const A &a, const B &b) const {
+                using R = std::common_type_t<A, B>;
+                return static_cast<R>(a) < static_cast<R>(b) ? static_cast<R>(b) : static_cast<R>(a);
+            }
+        };
+
+        struct expr_abs {
+            template<typename A>
+            QM_FORCEINLINE A operator()(const A &a) const {
+                if constexpr (std::is_unsigned_v<A>) {
+                    return a;
+                } else {
+                    return a < A{} ? static_cast<A>(-a) : a;
+                }
+            }
+        };
+
+        struct expr_clamp {
+            template<typename V, typename L, typename H>
+            QM_FORCEINLINE auto operator()(const V &v, const L &lo, const H &hi) const {
+                using R = std::common_type_t<V, L, H>;
+                const R x = static_cast<R>(v);
+                return x < static_cast<R>(lo) ? static_cast<R>(lo) : (static_cast<R>(hi) < x ? static_cast<R>(hi) : x);
+            }
+        };
+
+        struct expr_where {
+            template<typename C, typename A, typename B>
+            QM_FORCEINLINE auto operator()(const C &c, const A &a, const B &b) const {
+                using R = std::common_type_t<A, B>;
+                return c ? static_cast<R>(a) : static_cast<R>(b);
+            }
+        };
+
+        /**
+         * @brief 构造表达式节点，操作数统一转换为保存形式
+         */
+        template<typename Op, typename... Args>
+        auto make_expr(Op op, const Args &...args) {
+            return array2d_expr<Op, operand_t<Args>...>(std::move(op), make_operand(args)...);
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief 二元运算的参数约束：至少一个是表达式，另一个是表达式或标量
+     */
+    template<typename A, typename B>
+    concept Array2d_expression_args = (Array2d_expression<A> && (Array2d_expression<B> || Array2d_scalar<B>)) ||
+                                      (Array2d_scalar<A> && Array2d_expression<B>);
+
+    // ================================
+    // 算术运算符
+    // ================================
+
+    /**
+     * @brief 逐元素加法，操作数可以是矩阵、视图、表达式或标量
+     *
+     * @par 示例
+     * @code
+     * qm::array2d<double> score = a * 2.0 + b - c / 4.0;  // 一次遍历，无中间矩阵
+     * @endcode
+     */
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto operator+(const A &a, const B &b) {
+        return detail::make_expr(std::plus<>{}, a, b);
+    }
+
+    /**
+     * @brief 逐元素减法
+     */
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto operator-(const A &a, const B &b) {
+        return detail::make_expr(std::minus<>{}, a, b);
+    }
+
+    /**
+     * @brief 逐元素乘法（不是矩阵乘法）
+     */
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto operator*(const A &a, const B &b) {
+        return detail::make_expr(std::multiplies<>{}, a, b);
+    }
+
+    /**
+     * @brief 逐元素除法
+     */
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto operator/(const A &a, const B &b) {
+        return detail::make_expr(std::divides<>{}, a, b);
+    }
+
+    /**
+     * @brief 逐元素取负
+     */
+    template<Array2d_expression A>
+    [[nodiscard]] auto operator-(const A &a) {
+        return detail::make_expr(std::negate<>{}, a);
+    }
+
+    // ================================
+    // 逐元素函数
+    // ================================
+
+    /**
+     * @brief 逐元素最小值
+     */
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto min(const A &a, const B &b) {
+        return detail::make_expr(detail::expr_min{}, a, b);
+    }
+
+    /**
+     * @brief 逐元素最大值
+     */
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto max(const A &a, const B &b) {
+        return detail::make_expr(detail::expr_max{}, a, b);
+    }
+
+    /**
+     * @brief 两个操作数类型相同时的逐元素最小值
+     *
+     * array2d的模板参数含有std::allocator，std::min会经ADL参与重载决议；
+     * 提供同类型的受约束重载，使其比std::min(const T &, const T &)更特化。
+     */
+    template<Array2d_expression A>
+    [[nodiscard]] auto min(const A &a, const A &b) {
+        return detail::make_expr(detail::expr_min{}, a, b);
+    }
+
+    /**
+     * @brief 两个操作数类型相同时的逐元素最大值（原因同min）
+     */
+    template<Array2d_expression A>
+    [[nodiscard]] auto max(const A &a, const A &b) {
+        return detail::make_expr(detail::expr_max{}, a, b);
+    }
+
+    /**
+     * @brief 逐元素绝对值
+     */
+    template<Array2d_expression A>
+    [[nodiscard]] auto abs(const A &a) {
+        return detail::make_expr(detail::expr_abs{}, a);
+    }
+
+    /**
+     * @brief 逐元素限制到[lo, hi]
+     *
+     * @param v 表达式
+     * @param lo 下界，可以是标量或表达式
+     * @param hi 上界，可以是标量或表达式
+     */
+    template<Array2d_expression V, typename L, typename H>
+        requires(Array2d_expression<L> || Array2d_scalar<L>) && (Array2d_expression<H> || Array2d_scalar<H>)
+    [[nodiscard]] auto clamp(const V &v, const L &lo, const H &hi) {
+        return detail::make_expr(detail::expr_clamp{}, v, lo, hi);
+    }
+
+    /**
+     * @brief 三个操作数类型相同时的逐元素限制（原因同min）
+     */
+    template<Array2d_expression V>
+    [[nodiscard]] auto clamp(const V &v, const V &lo, const V &hi) {
+        return detail::make_expr(detail::expr_clamp{}, v, lo, hi);
+    }
+
+    /**
+     * @brief 逐元素选择：cond为真取a，否则取b
+     *
+     * @param cond 条件表达式，通常由less()/greater()等比较函数构造
+     * @param a 条件为真时的值，可以是标量或表达式
+     * @param b 条件为假时的值，可以是标量或表达式
+     *
+     * @par 示例
+     * @code
+     * m = qm::where(qm::less(m, 0.0), 0.0, m * 1.5);
+     * @endcode
+     */
+    template<Array2d_expression C, typename A, typename B>
+        requires(Array2d_expression<A> || Array2d_scalar<A>) && (Array2d_expression<B> || Array2d_scalar<B>)
+    [[nodiscard]] auto where(const C &cond, const A &a, const B &b) {
+        return detail::make_expr(detail::expr_where{}, cond, a, b);
+    }
+
+    // ================================
+    // 逐元素比较
+    // ================================
+
+    /**
+     * @brief 逐元素a < b，结果元素为bool
+     *
+     * @note 使用具名函数而非运算符，避免与array2d的字典序比较冲突
+     */
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto less(const A &a, const B &b) {
+        return detail::make_expr(std::less<>{}, a, b);
+    }
+
+    /**
+     * @brief 逐元素a <= b
+     */
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto less_equal(const A &a, const B &b) {
+        return detail::make_expr(std::less_equal<>{}, a, b);
+    }
+
+    /**
+     * @brief 逐元素a > b
+     */
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto greater(const A &a, const B &b) {
+        return detail::make_expr(std::greater<>{}, a, b);
+    }
+
+    /**
+     * @brief 逐元素a >= b
+     */
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto greater_equal(const A &a, const B &b) {
+        return detail::make_expr(std::greater_equal<>{}, a, b);
+    }
+
+    /**
+     * @brief 逐元素a == b
+     */
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto equal_to(const A &a, const B &b) {
+        return detail::make_expr(std::equal_to<>{}, a, b);
+    }
+
+    /**
+     * @brief 逐元素a != b
+     */
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto not_equal_to(const A &a, const B &b) {
+        return detail::make_expr(std::not_equal_to<>{}, a, b);
+    }
+
+    // ================================
+    // 求值
+    // ================================
+
+    /**
+     * @brief 将表达式逐元素求值写入目标存储
+     *
+     * 目标与所有操作数都连续时作为一行整体求值，否则逐行求值；内层循环中
+     * 每个元素只读取一次各操作数并写入一次目标。
+     *
+     * @param dst 目标首元素地址
+     * @param pitch 目标行距（元素）
+     * @param expr 表达式，形状即目标的形状
+     *
+     * @note 操作数可以与目标是同一块存储（如 a = a * 2 + b），但不能错位重叠
+     */
+    template<typename T, Array2d_expression_node E>
+    void evaluate_expression(T *dst, std::size_t pitch, const E &expr) {
+        const auto rows = expr.rows();
+        const auto cols = expr.cols();
+        if (rows == 0 || cols == 0) return;
+
+        const auto run = [](T *out, const auto &row, std::size_t count) {
+            QM_IVDEP
+            for (std::size_t j = 0; j < count; ++j) {
+                out[j] = static_cast<T>(row[j]);
+            }
+        };
+
+        if ((pitch == cols || rows == 1) && expr.contiguous()) {
+            run(dst, expr.row(0), rows * cols);
+        } else {
+            for (std::size_t i = 0; i < rows; ++i) {
+                run(dst + i * pitch, expr.row(i), cols);
+            }
+        }
+    }
+
+}  // namespace qm
@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <ranges>
 #include <type_traits>
 
 /**
@@ -339,6 +340,432 @@ namespace qm {
         return iter + offset;
     }
 
+    // ================================
+    // 带行距的行优先迭代器
+    // ================================
+
+    /**
+     * @brief 带行距（pitch）的二维数组行优先迭代器
+     *
+     * @tparam T 元素类型，必须满足 Array2d_iterator_compatible 概念
+     *
+     * 用于行首间距（pitch）大于列数的存储布局：按行优先顺序访问每行的前
+     * cols 个元素，并自动跳过行尾的填充元素。满足 std::random_access_iterator。
+     *
+     * @note 迭代器位置由行首指针和列号共同表示，尾后迭代器为最后一行之后的行首、列号为0
+     */
+    template<Array2d_iterator_compatible T>
+    class Array2d_pitched_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept  = std::random_access_iterator_tag;
+        using value_type        = std::remove_cv_t<T>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = T *;
+        using reference         = T &;
+
+        /**
+         * @brief 默认构造函数
+         */
+        constexpr Array2d_pitched_iterator() noexcept = default;
+
+        /**
+         * @brief 从行首指针和列号构造迭代器
+         *
+         * @param row 当前行首元素的指针
+         * @param col 当前列号
+         * @param cols 每行的有效元素数
+         * @param pitch 相邻行首之间的元素距离，必须不小于cols
+         */
+        constexpr Array2d_pitched_iterator(pointer row, difference_type col,
+                                           difference_type cols, difference_type pitch) noexcept
+            : row_(row), col_(col), cols_(cols), pitch_(pitch) {}
+
+        /**
+         * @brief 类型转换构造函数
+         *
+         * 支持 iterator -> const_iterator 的转换
+         *
+         * @tparam U 源迭代器的元素类型
+         * @param other 源迭代器
+         */
+        template<Array2d_iterator_compatible U>
+        constexpr explicit Array2d_pitched_iterator(const Array2d_pitched_iterator<U> &other) noexcept
+            requires std::convertible_to<U *, T *>
+            : row_(other.row_data()), col_(other.column()), cols_(other.columns()), pitch_(other.pitch()) {}
+
+        [[nodiscard]] QM_FORCEINLINE constexpr reference operator*() const noexcept {
+            return row_[col_];
+        }
+
+        [[nodiscard]] QM_FORCEINLINE constexpr pointer operator->() const noexcept {
+            return row_ + col_;
+        }
+
+        /**
+         * @brief 前置递增操作符
+         *
+         * 到达行尾时跳过填充元素，移动到下一行行首
+         */
+        QM_FORCEINLINE constexpr Array2d_pitched_iterator &operator++() noexcept {
+            if (++col_ == cols_) {
+                col_ = 0;
+                row_ += pitch_;
+            }
+            return *this;
+        }
+
+        QM_FORCEINLINE constexpr Array2d_pitched_iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        /**
+         * @brief 前置递减操作符
+         *
+         * 位于行首时移动到上一行的最后一个有效元素
+         */
+        QM_FORCEINLINE constexpr Array2d_pitched_iterator &operator--() noexcept {
+            if (col_ == 0) {
+                col_ = cols_;
+                row_ -= pitch_;
+            }
+            --col_;
+            return *this;
+        }
+
+        QM_FORCEINLINE constexpr Array2d_pitched_iterator operator--(int) noexcept {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        /**
+         * @brief 复合加法赋值操作符
+         *
+         * @param offset 按行优先顺序计算的逻辑偏移量（可以为负数）
+         * @return 操作后的迭代器引用
+         */
+        constexpr auto operator+=(const difference_type offset) noexcept -> Array2d_pitched_iterator & {
+            if (cols_ == 0) return *this;
+            auto linear   = col_ + offset;
+            auto row_step = linear / cols_;
+            linear %= cols_;
+            if (linear < 0) {
+                linear += cols_;
+                --row_step;
+            }
+            row_ += row_step * pitch_;
+            col_ = linear;
+            return *this;
+        }
+
+        [[nodiscard]] constexpr auto operator+(const difference_type offset) const noexcept -> Array2d_pitched_iterator {
+            auto tmp = *this;
+            return tmp += offset;
+        }
+
+        constexpr auto operator-=(const difference_type offset) noexcept -> Array2d_pitched_iterator & {
+            return *this += -offset;
+        }
+
+        [[nodiscard]] constexpr auto operator-(const difference_type offset) const noexcept -> Array2d_pitched_iterator {
+            auto tmp = *this;
+            return tmp -= offset;
+        }
+
+        /**
+         * @brief 迭代器距离计算
+         *
+         * @param other 另一个迭代器，必须来自同一个二维数组
+         * @return 两个迭代器之间的逻辑元素个数（不含填充元素）
+         */
+        [[nodiscard]] constexpr auto operator-(const Array2d_pitched_iterator &other) const noexcept -> difference_type {
+            const auto row_diff = pitch_ == 0 ? 0 : (row_ - other.row_) / pitch_;
+            return row_diff * cols_ + (col_ - other.col_);
+        }
+
+        [[nodiscard]] constexpr auto operator[](const difference_type offset) const noexcept -> reference {
+            return *(*this + offset);
+        }
+
+        [[nodiscard]] constexpr std::strong_ordering operator<=>(const Array2d_pitched_iterator &other) const noexcept {
+            if (auto cmp = row_ <=> other.row_; cmp != 0) return cmp;
+            return col_ <=> other.col_;
+        }
+
+        [[nodiscard]] QM_FORCEINLINE constexpr bool operator==(const Array2d_pitched_iterator &other) const noexcept {
+            return row_ == other.row_ && col_ == other.col_;
+        }
+
+        /**
+         * @brief 获取当前行首指针
+         */
+        [[nodiscard]] constexpr pointer row_data() const noexcept { return row_; }
+
+        /**
+         * @brief 获取当前列号
+         */
+        [[nodiscard]] constexpr difference_type column() const noexcept { return col_; }
+
+        /**
+         * @brief 获取每行的有效元素数
+         */
+        [[nodiscard]] constexpr difference_type columns() const noexcept { return cols_; }
+
+        /**
+         * @brief 获取行距（相邻行首之间的元素距离）
+         */
+        [[nodiscard]] constexpr difference_type pitch() const noexcept { return pitch_; }
+
+    private:
+        pointer         row_   = nullptr;  ///< 当前行首指针
+        difference_type col_   = 0;        ///< 当前列号
+        difference_type cols_  = 0;        ///< 每行有效元素数
+        difference_type pitch_ = 0;        ///< 行距
+    };
+
+    /**
+     * @brief 全局加法操作符（支持 offset + iterator）
+     */
+    template<Array2d_iterator_compatible T>
+    [[nodiscard]] constexpr Array2d_pitched_iterator<T> operator+(
+            typename Array2d_pitched_iterator<T>::difference_type offset,
+            const Array2d_pitched_iterator<T>                    &iter) noexcept {
+        return iter + offset;
+    }
+
+    // ================================
+    // 跨步迭代器
+    // ================================
+
+    /**
+     * @brief 按固定步长访问元素的随机访问迭代器
+     *
+     * @tparam T 元素类型，必须满足 Array2d_iterator_compatible 概念
+     *
+     * 每次递增跨过stride个元素，用于零拷贝地遍历二维数组的一列
+     * （步长为行距）。满足 std::random_access_iterator。
+     *
+     * @note 位置由序列首元素指针和下标表示，只在解引用时计算元素地址；
+     *       尾后迭代器不会形成超出底层存储的指针
+     */
+    template<Array2d_iterator_compatible T>
+    class Array2d_strided_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept  = std::random_access_iterator_tag;
+        using value_type        = std::remove_cv_t<T>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = T *;
+        using reference         = T &;
+
+        /**
+         * @brief 默认构造函数
+         */
+        constexpr Array2d_strided_iterator() noexcept = default;
+
+        /**
+         * @brief 从序列首元素指针、下标和步长构造迭代器
+         *
+         * @param first 序列首元素的指针
+         * @param index 当前元素在序列中的下标
+         * @param stride 相邻元素之间的距离（以元素为单位），必须大于0
+         */
+        constexpr Array2d_strided_iterator(pointer first, difference_type index, difference_type stride) noexcept
+            : first_(first), index_(index), stride_(stride) {}
+
+        /**
+         * @brief 从序列首元素指针和步长构造指向首元素的迭代器
+         *
+         * @param first 序列首元素的指针
+         * @param stride 相邻元素之间的距离（以元素为单位），必须大于0
+         */
+        constexpr Array2d_strided_iterator(pointer first, difference_type stride) noexcept
+            : Array2d_strided_iterator(first, 0, stride) {}
+
+        /**
+         * @brief 类型转换构造函数
+         *
+         * 支持 iterator -> const_iterator 的转换
+         *
+         * @tparam U 源迭代器的元素类型
+         * @param other 源迭代器
+         */
+        template<Array2d_iterator_compatible U>
+        constexpr Array2d_strided_iterator(const Array2d_strided_iterator<U> &other) noexcept
+            requires std::convertible_to<U *, T *>
+            : first_(other.first()), index_(other.index()), stride_(other.stride()) {}
+
+        [[nodiscard]] QM_FORCEINLINE constexpr reference operator*() const noexcept {
+            return first_[index_ * stride_];
+        }
+
+        [[nodiscard]] QM_FORCEINLINE constexpr pointer operator->() const noexcept {
+            return first_ + index_ * stride_;
+        }
+
+        QM_FORCEINLINE constexpr Array2d_strided_iterator &operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        QM_FORCEINLINE constexpr Array2d_strided_iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++index_;
+            return tmp;
+        }
+
+        QM_FORCEINLINE constexpr Array2d_strided_iterator &operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        QM_FORCEINLINE constexpr Array2d_strided_iterator operator--(int) noexcept {
+            auto tmp = *this;
+            --index_;
+            return tmp;
+        }
+
+        QM_FORCEINLINE constexpr auto operator+=(const difference_type offset) noexcept -> Array2d_strided_iterator & {
+            index_ += offset;
+            return *this;
+        }
+
+        [[nodiscard]] QM_FORCEINLINE constexpr auto operator+(const difference_type offset) const noexcept
+                -> Array2d_strided_iterator {
+            return {first_, index_ + offset, stride_};
+        }
+
+        QM_FORCEINLINE constexpr auto operator-=(const difference_type offset) noexcept -> Array2d_strided_iterator & {
+            index_ -= offset;
+            return *this;
+        }
+
+        [[nodiscard]] QM_FORCEINLINE constexpr auto operator-(const difference_type offset) const noexcept
+                -> Array2d_strided_iterator {
+            return {first_, index_ - offset, stride_};
+        }
+
+        /**
+         * @brief 迭代器距离计算
+         *
+         * @param other 另一个迭代器，必须来自同一序列
+         * @return 两个迭代器之间的元素个数
+         */
+        [[nodiscard]] QM_FORCEINLINE constexpr auto operator-(const Array2d_strided_iterator &other) const noexcept
+                -> difference_type {
+            return index_ - other.index_;
+        }
+
+        [[nodiscard]] QM_FORCEINLINE constexpr auto operator[](const difference_type offset) const noexcept -> reference {
+            return first_[(index_ + offset) * stride_];
+        }
+
+        [[nodiscard]] constexpr std::strong_ordering operator<=>(const Array2d_strided_iterator &other) const noexcept {
+            return index_ <=> other.index_;
+        }
+
+        [[nodiscard]] QM_FORCEINLINE constexpr bool operator==(const Array2d_strided_iterator &other) const noexcept {
+            return index_ == other.index_;
+        }
+
+        /**
+         * @brief 获取当前元素指针
+         *
+         * @note 只对可解引用的位置有效，不能对尾后迭代器调用
+         */
+        [[nodiscard]] constexpr pointer base() const noexcept { return first_ + index_ * stride_; }
+
+        /**
+         * @brief 获取序列首元素指针
+         */
+        [[nodiscard]] constexpr pointer first() const noexcept { return first_; }
+
+        /**
+         * @brief 获取当前元素在序列中的下标
+         */
+        [[nodiscard]] constexpr difference_type index() const noexcept { return index_; }
+
+        /**
+         * @brief 获取步长（相邻元素之间的元素距离）
+         */
+        [[nodiscard]] constexpr difference_type stride() const noexcept { return stride_; }
+
+    private:
+        pointer         first_  = nullptr;  ///< 序列首元素指针
+        difference_type index_  = 0;        ///< 当前下标
+        difference_type stride_ = 0;        ///< 步长
+    };
+
+    /**
+     * @brief 全局加法操作符（支持 offset + iterator）
+     */
+    template<Array2d_iterator_compatible T>
+    [[nodiscard]] constexpr Array2d_strided_iterator<T> operator+(
+            typename Array2d_strided_iterator<T>::difference_type offset,
+            const Array2d_strided_iterator<T>                    &iter) noexcept {
+        return iter + offset;
+    }
+
+    /**
+     * @brief 二维数组单列的零拷贝视图
+     *
+     * @tparam T 元素类型，const限定时为只读视图
+     *
+     * 由首元素指针、元素个数和步长组成的轻量范围，满足 std::ranges::random_access_range
+     * 和 std::ranges::sized_range，可直接用于 std::ranges 算法；写入会作用到原数组。
+     * operator[]、front()、back()、empty() 由 std::ranges::view_interface 提供。
+     */
+    template<Array2d_iterator_compatible T>
+    class array2d_column : public std::ranges::view_interface<array2d_column<T>> {
+    public:
+        using value_type      = std::remove_cv_t<T>;
+        using size_type       = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer         = T *;
+        using reference       = T &;
+        using iterator        = Array2d_strided_iterator<T>;
+
+        constexpr array2d_column() noexcept = default;
+
+        /**
+         * @brief 从首元素指针、元素个数和步长构造列视图
+         *
+         * @param first 首元素指针
+         * @param size 元素个数
+         * @param stride 相邻元素之间的距离（以元素为单位）
+         */
+        constexpr array2d_column(pointer first, size_type size, difference_type stride) noexcept
+            : first_(first), size_(size), stride_(stride) {}
+
+        /**
+         * @brief 类型转换构造函数，支持可写列视图到只读列视图的转换
+         */
+        template<Array2d_iterator_compatible U>
+        constexpr array2d_column(const array2d_column<U> &other) noexcept
+            requires std::convertible_to<U *, T *>
+            : first_(other.begin().first()), size_(other.size()), stride_(other.stride()) {}
+
+        [[nodiscard]] constexpr iterator begin() const noexcept { return {first_, 0, stride_}; }
+        [[nodiscard]] constexpr iterator end() const noexcept {
+            return {first_, static_cast<difference_type>(size_), stride_};
+        }
+
+        [[nodiscard]] constexpr size_type size() const noexcept { return size_; }
+
+        /**
+         * @brief 获取步长（相邻元素之间的元素距离）
+         */
+        [[nodiscard]] constexpr difference_type stride() const noexcept { return stride_; }
+
+    private:
+        pointer         first_  = nullptr;  ///< 首元素指针
+        size_type       size_   = 0;        ///< 元素个数
+        difference_type stride_ = 0;        ///< 步长
+    };
+
     // ================================
     // 类型特征和辅助模板
     // ================================
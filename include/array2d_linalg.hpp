@@ -0,0 +1,627 @@
+#pragma once
+
+#include "array2d.hpp"
+#include "array2d_expr.hpp"
+#include "array2d_parallel.hpp"
+#include "array2d_simd.hpp"
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace qm {
+
+    // ================================
+    // 概念定义
+    // ================================
+
+    /**
+     * @brief 可参与矩阵乘法的元素类型概念（除bool外的算术类型）
+     */
+    template<typename T>
+    concept Array2d_linalg_value = std::is_arithmetic_v<T> && !std::same_as<T, bool>;
+
+    /**
+     * @brief 可作为矩阵乘法输出的矩阵类型概念（array2d、可写的array2d_view）
+     *
+     * @tparam M 待检验的矩阵类型
+     * @tparam T 元素类型
+     */
+    template<typename M, typename T>
+    concept Array2d_writable_operand = Array2d_matrix_operand<M> && requires(M &m) {
+        { m.data() } -> std::same_as<T *>;
+    };
+
+    /**
+     * @brief 矩阵操作数的索引类型（rows()的返回类型）
+     */
+    template<Array2d_matrix_operand M>
+    using operand_index_t = std::remove_cvref_t<decltype(std::declval<const M &>().rows())>;
+
+    namespace detail {
+
+        /**
+         * @brief 创建rows x cols的未初始化结果矩阵
+         *
+         * @tparam Idx 结果的索引类型
+         * @param name 调用者名称，用于异常消息
+         *
+         * @throws std::overflow_error 当尺寸超出Idx的范围时
+         */
+        template<typename T, typename Idx, std::integral R, std::integral C>
+        array2d<T, Idx> make_result(R rows, C cols, const char *name) {
+            if (std::cmp_greater(rows, std::numeric_limits<Idx>::max()) ||
+                std::cmp_greater(cols, std::numeric_limits<Idx>::max())) [[unlikely]] {
+                throw std::overflow_error(std::string(name) + ": result dimensions overflow index type");
+            }
+            return array2d<T, Idx>(static_cast<Idx>(rows), static_cast<Idx>(cols), uninitialized);
+        }
+
+        // ================================
+        // GEMM 分块参数
+        // ================================
+
+        /**
+         * @brief 打包缓冲区的分块尺寸
+         *
+         * kc x nr的B条带驻留L1，mc x kc的A块驻留L2，kc x nc的B块驻留L3。
+         * mc和nc分别是所有微内核mr、nr的公倍数，保证只有矩阵边缘出现不完整的微块。
+         */
+        inline constexpr std::size_t gemm_kc = 256;
+        inline constexpr std::size_t gemm_mc = 96;
+        inline constexpr std::size_t gemm_nc = 2048;
+
+        /**
+         * @brief m * n * k不超过该值时直接用三重循环，打包和分块的开销大于计算本身
+         */
+        inline constexpr std::size_t gemm_small = 16 * 16 * 16;
+
+        /**
+         * @brief 矩阵乘法中一个矩阵的行优先存储描述
+         */
+        template<typename T>
+        struct gemm_operand {
+            T          *data;
+            std::size_t rows;
+            std::size_t cols;
+            std::size_t stride;
+        };
+
+        template<typename M>
+        auto make_gemm_operand(M &m) noexcept {
+            using pointer = std::remove_pointer_t<decltype(m.data())>;
+            return gemm_operand<pointer>{m.data(), static_cast<std::size_t>(m.rows()), static_cast<std::size_t>(m.cols()),
+                                         static_cast<std::size_t>(m.pitch())};
+        }
+
+        /**
+         * @brief 判断两个行优先存储的地址范围是否重叠
+         */
+        template<typename T, typename U>
+        bool gemm_overlaps(const gemm_operand<T> &x, const gemm_operand<U> &y) noexcept {
+            if (x.rows == 0 || x.cols == 0 || y.rows == 0 || y.cols == 0) return false;
+            const auto x_first = reinterpret_cast<std::uintptr_t>(x.data);
+            const auto y_first = reinterpret_cast<std::uintptr_t>(y.data);
+            const auto x_last  = reinterpret_cast<std::uintptr_t>(x.data + (x.rows - 1) * x.stride + x.cols);
+            const auto y_last  = reinterpret_cast<std::uintptr_t>(y.data + (y.rows - 1) * y.stride + y.cols);
+            return x_first < y_last && y_first < x_last;
+        }
+
+        /**
+         * @brief 将A的mc x kc块打包为mr行的条带，每个k连续存放mr个元素，不足mr行的部分补0
+         */
+        template<typename T>
+        void gemm_pack_a(const T *a, std::size_t lda, std::size_t mc, std::size_t kc, std::size_t mr, T *out) {
+            for (std::size_t i0 = 0; i0 < mc; i0 += mr) {
+                const auto height = std::min(mr, mc - i0);
+                for (std::size_t p = 0; p < kc; ++p) {
+                    for (std::size_t i = 0; i < height; ++i) {
+                        out[i] = a[(i0 + i) * lda + p];
+                    }
+                    std::fill(out + height, out + mr, T{});
+                    out += mr;
+                }
+            }
+        }
+
+        /**
+         * @brief 将B的kc x nc块打包为nr列的条带，每个k连续存放nr个元素，不足nr列的部分补0
+         */
+        template<typename T>
+        void gemm_pack_b(const T *b, std::size_t ldb, std::size_t kc, std::size_t nc, std::size_t nr, T *out) {
+            for (std::size_t j0 = 0; j0 < nc; j0 += nr) {
+                const auto width = std::min(nr, nc - j0);
+                for (std::size_t p = 0; p < kc; ++p) {
+                    const T *src = b + p * ldb + j0;
+                    std::copy(src, src + width, out);
+                    std::fill(out + width, out + nr, T{});
+                    out += nr;
+                }
+            }
+        }
+
+        /**
+         * @brief 对打包后的A块和B块调用微内核，更新C的mc x nc块
+         *
+         * 完整的微块直接写入C；矩阵边缘的微块先写入临时缓冲区，再合并有效部分。
+         */
+        template<typename T>
+        void gemm_macro_kernel(const simd::gemm_kernel<T> &micro, std::size_t mc, std::size_t nc, std::size_t kc,
+                               const T *packed_a, const T *packed_b, T *c, std::size_t ldc, T alpha, T beta) {
+            const auto mr = micro.mr;
+            const auto nr = micro.nr;
+            T          edge[16 * 16];
+
+            for (std::size_t jr = 0; jr < nc; jr += nr) {
+                const auto width = std::min(nr, nc - jr);
+                for (std::size_t ir = 0; ir < mc; ir += mr) {
+                    const auto height = std::min(mr, mc - ir);
+                    const T   *ap     = packed_a + ir * kc;
+                    const T   *bp     = packed_b + jr * kc;
+                    T         *dst    = c + ir * ldc + jr;
+
+                    if (height == mr && width == nr) [[likely]] {
+                        micro.kernel(kc, ap, bp, dst, ldc, alpha, beta);
+                        continue;
+                    }
+
+                    micro.kernel(kc, ap, bp, edge, nr, alpha, T{});
+                    for (std::size_t i = 0; i < height; ++i) {
+                        for (std::size_t j = 0; j < width; ++j) {
+                            T &out = dst[i * ldc + j];
+                            out    = beta == T{} ? edge[i * nr + j] : edge[i * nr + j] + beta * out;
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief C = beta * C，beta为0时直接清零（不传播C中的NaN）
+         */
+        template<typename T>
+        void gemm_scale(const gemm_operand<T> &c, T beta) {
+            for (std::size_t i = 0; i < c.rows; ++i) {
+                T *row = c.data + i * c.stride;
+                if (beta == T{}) {
+                    std::fill(row, row + c.cols, T{});
+                } else {
+                    std::transform(row, row + c.cols, row, [beta](T x) { return beta * x; });
+                }
+            }
+        }
+
+        /**
+         * @brief 小矩阵的直接乘法，语义与微内核相同：先累加A * B，再乘alpha并合并beta * C
+         */
+        template<typename T>
+        void gemm_small_kernel(const gemm_operand<const T> &a, const gemm_operand<const T> &b, const gemm_operand<T> &c,
+                               T alpha, T beta) {
+            for (std::size_t i = 0; i < a.rows; ++i) {
+                const T *a_row = a.data + i * a.stride;
+                T       *c_row = c.data + i * c.stride;
+                for (std::size_t j = 0; j < b.cols; ++j) {
+                    T acc{};
+                    for (std::size_t p = 0; p < a.cols; ++p) acc += a_row[p] * b.data[p * b.stride + j];
+                    c_row[j] = beta == T{} ? alpha * acc : alpha * acc + beta * c_row[j];
+                }
+            }
+        }
+
+        /**
+         * @brief 分块矩阵乘法的驱动：C = alpha * A * B + beta * C
+         *
+         * 按nc、kc、mc三层分块，B的kc x nc块打包一次后由所有A块共享；
+         * 并行时不同的mc行块写入C中互不相交的行，每个任务使用独立的A打包缓冲区。
+         */
+        template<typename T>
+        void gemm(const gemm_operand<const T> &a, const gemm_operand<const T> &b, const gemm_operand<T> &c, T alpha,
+                  T beta, bool parallel) {
+            const auto m = a.rows;
+            const auto n = b.cols;
+            const auto k = a.cols;
+            if (m == 0 || n == 0) return;
+            if (k == 0 || alpha == T{}) {
+                gemm_scale(c, beta);
+                return;
+            }
+
+            if (m * n <= gemm_small && m * n * k <= gemm_small) {
+                gemm_small_kernel(a, b, c, alpha, beta);
+                return;
+            }
+
+            const auto micro      = simd::select_gemm_kernel<T>();
+            const auto row_blocks = (m + gemm_mc - 1) / gemm_mc;
+            const auto round_up   = [](std::size_t x, std::size_t r) { return (x + r - 1) / r * r; };
+
+            // 缓冲区按问题尺寸分配；打包会写满每个位置，无需值初始化
+            const auto size_b   = std::min(k, gemm_kc) * round_up(std::min(n, gemm_nc), micro.nr);
+            const auto size_a   = round_up(std::min(m, gemm_mc), micro.mr) * std::min(k, gemm_kc);
+            const auto packed_b = std::make_unique_for_overwrite<T[]>(size_b);
+            const auto packed_a = std::make_unique_for_overwrite<T[]>(parallel ? 0 : size_a);
+
+            for (std::size_t jc = 0; jc < n; jc += gemm_nc) {
+                const auto nc = std::min(gemm_nc, n - jc);
+                for (std::size_t pc = 0; pc < k; pc += gemm_kc) {
+                    const auto kc = std::min(gemm_kc, k - pc);
+                    // 第一个k块应用用户的beta，之后的k块累加到已有结果上
+                    const T    beta_block = pc == 0 ? beta : T{1};
+                    gemm_pack_b(b.data + pc * b.stride + jc, b.stride, kc, nc, micro.nr, packed_b.get());
+
+                    const auto update_rows = [&](std::size_t block, T *buffer) {
+                        const auto ic = block * gemm_mc;
+                        const auto mc = std::min(gemm_mc, m - ic);
+                        gemm_pack_a(a.data + ic * a.stride + pc, a.stride, mc, kc, micro.mr, buffer);
+                        gemm_macro_kernel(micro, mc, nc, kc, buffer, packed_b.get(), c.data + ic * c.stride + jc,
+                                          c.stride, alpha, beta_block);
+                    };
+
+                    if (parallel) {
+                        // 线程池的线程常驻，每个线程的A打包缓冲区在多次调用间复用
+                        default_thread_pool().run(row_blocks, [&](std::size_t block) {
+                            thread_local std::vector<T> buffer;
+                            if (buffer.size() < size_a) buffer.resize(size_a);
+                            update_rows(block, buffer.data());
+                        });
+                    } else {
+                        for (std::size_t block = 0; block < row_blocks; ++block) {
+                            update_rows(block, packed_a.get());
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief 检查矩阵乘法的形状和别名约束
+         */
+        template<typename T>
+        void gemm_validate(const gemm_operand<const T> &a, const gemm_operand<const T> &b, const gemm_operand<T> &c,
+                           const char *name) {
+            if (a.cols != b.rows) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": inner dimensions do not match");
+            }
+            if (c.rows != a.rows || c.cols != b.cols) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": output shape does not match");
+            }
+            if (gemm_overlaps(c, a) || gemm_overlaps(c, b)) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": output must not alias an input");
+            }
+        }
+
+        template<typename A, typename B, typename C, typename T>
+        void matmul_impl(const A &a, const B &b, C &c, T alpha, T beta, bool parallel, const char *name) {
+            const auto lhs = make_gemm_operand(a);
+            const auto rhs = make_gemm_operand(b);
+            const auto out = make_gemm_operand(c);
+            const gemm_operand<const T> lhs_view{lhs.data, lhs.rows, lhs.cols, lhs.stride};
+            const gemm_operand<const T> rhs_view{rhs.data, rhs.rows, rhs.cols, rhs.stride};
+            gemm_validate(lhs_view, rhs_view, out, name);
+            gemm(lhs_view, rhs_view, out, alpha, beta, parallel);
+        }
+
+    }  // namespace detail
+
+    // ================================
+    // 矩阵乘法
+    // ================================
+
+    /**
+     * @brief 通用矩阵乘法：C = alpha * A * B + beta * C
+     *
+     * 采用分块打包的实现：A和B被打包为连续的条带，由寄存器分块的微内核计算，
+     * float/double在支持AVX2和FMA的CPU上使用FMA内核，int32使用AVX2内核，其他类型使用可移植内核。
+     * 操作数可以是array2d、带行距的矩阵或视图。
+     *
+     * @param a 左矩阵（m x k）
+     * @param b 右矩阵（k x n）
+     * @param c 输出矩阵（m x n），可以是array2d或可写视图
+     * @param alpha A * B的系数，默认为1
+     * @param beta C原有值的系数，默认为0；为0时不读取C的原有值
+     *
+     * @throws std::invalid_argument 当形状不匹配，或C与A、B的存储重叠时
+     *
+     * @note 整数类型按标量乘加的回绕语义计算，不检测溢出
+     *
+     * @par 示例:
+     * @code
+     * array2d<double> a(64, 32, 1.0), b(32, 16, 2.0), c(64, 16);
+     * matmul(a, b, c);                   // c = a * b
+     * matmul(a, b, c, 0.5, 1.0);         // c += 0.5 * a * b
+     * matmul(a.submatrix(0, 0, 8, 32), b, c.submatrix(0, 0, 8, 16));
+     * @endcode
+     */
+    template<Array2d_matrix_operand A, Array2d_matrix_operand B, typename C>
+        requires Array2d_linalg_value<typename A::value_type> &&
+                 std::same_as<typename A::value_type, typename B::value_type> &&
+                 Array2d_writable_operand<std::remove_reference_t<C>, typename A::value_type>
+    void matmul(const A &a, const B &b, C &&c, typename A::value_type alpha = 1, typename A::value_type beta = 0) {
+        detail::matmul_impl(a, b, c, alpha, beta, false, "matmul");
+    }
+
+    /**
+     * @brief 使用多线程的通用矩阵乘法：C = alpha * A * B + beta * C
+     *
+     * 与matmul()相同，但把C的行块分配给不同线程，B的打包块在线程之间共享。
+     *
+     * @throws std::invalid_argument 当形状不匹配，或C与A、B的存储重叠时
+     *
+     * @note 只对大矩阵（输出>10000元素）使用并行算法，小矩阵等同于matmul()
+     */
+    template<Array2d_matrix_operand A, Array2d_matrix_operand B, typename C>
+        requires Array2d_linalg_value<typename A::value_type> &&
+                 std::same_as<typename A::value_type, typename B::value_type> &&
+                 Array2d_writable_operand<std::remove_reference_t<C>, typename A::value_type>
+    void matmul_parallel(const A &a, const B &b, C &&c, typename A::value_type alpha = 1,
+                         typename A::value_type beta = 0) {
+        const auto elements = static_cast<std::size_t>(c.rows()) * static_cast<std::size_t>(c.cols());
+        detail::matmul_impl(a, b, c, alpha, beta, elements > 10000, "matmul_parallel");
+    }
+
+    /**
+     * @brief 计算矩阵乘积A * B并返回新矩阵
+     *
+     * @return m x n的紧密排列矩阵，索引类型与A相同
+     *
+     * @throws std::invalid_argument 当A的列数不等于B的行数时
+     * @throws std::overflow_error 当结果尺寸超出A的索引类型范围时
+     *
+     * @par 示例:
+     * @code
+     * auto c = matmul(a, b);
+     * @endcode
+     */
+    template<Array2d_matrix_operand A, Array2d_matrix_operand B>
+        requires Array2d_linalg_value<typename A::value_type> &&
+                 std::same_as<typename A::value_type, typename B::value_type>
+    [[nodiscard]] array2d<typename A::value_type, operand_index_t<A>> matmul(const A &a, const B &b) {
+        if (std::cmp_not_equal(a.cols(), b.rows())) [[unlikely]] {
+            throw std::invalid_argument("matmul: inner dimensions do not match");
+        }
+        auto c = detail::make_result<typename A::value_type, operand_index_t<A>>(a.rows(), b.cols(), "matmul");
+        matmul(a, b, c);
+        return c;
+    }
+
+    /**
+     * @brief 使用多线程计算矩阵乘积A * B并返回新矩阵
+     *
+     * @throws std::invalid_argument 当A的列数不等于B的行数时
+     * @throws std::overflow_error 当结果尺寸超出A的索引类型范围时
+     */
+    template<Array2d_matrix_operand A, Array2d_matrix_operand B>
+        requires Array2d_linalg_value<typename A::value_type> &&
+                 std::same_as<typename A::value_type, typename B::value_type>
+    [[nodiscard]] array2d<typename A::value_type, operand_index_t<A>> matmul_parallel(const A &a, const B &b) {
+        if (std::cmp_not_equal(a.cols(), b.rows())) [[unlikely]] {
+            throw std::invalid_argument("matmul_parallel: inner dimensions do not match");
+        }
+        auto c = detail::make_result<typename A::value_type, operand_index_t<A>>(a.rows(), b.cols(), "matmul_parallel");
+        matmul_parallel(a, b, c);
+        return c;
+    }
+
+    namespace detail {
+
+        // ================================
+        // 矩阵-向量乘法
+        // ================================
+
+        /**
+         * @brief gevm按列分块的宽度，使y的分块在遍历各行时驻留L1
+         */
+        inline constexpr std::size_t gevm_block = 1024;
+
+        /**
+         * @brief y[i] = alpha * dot(A的第i行, x) + beta * y[i]，i属于[first, last)
+         */
+        template<typename T>
+        void gemv_rows(const gemm_operand<const T> &a, const T *x, T *y, T alpha, T beta, std::size_t first,
+                       std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                const T d = simd::dot(a.data + i * a.stride, x, a.cols);
+                y[i]      = beta == T{} ? alpha * d : alpha * d + beta * y[i];
+            }
+        }
+
+        /**
+         * @brief y[j] = alpha * sum(x[i] * A(i, j)) + beta * y[j]，j属于[first, last)
+         *
+         * 逐行对y的列块做AXPY，每行读取的都是连续内存。
+         */
+        template<typename T>
+        void gevm_cols(const gemm_operand<const T> &a, const T *x, T *y, T alpha, T beta, std::size_t first,
+                       std::size_t last) {
+            if (beta == T{}) {
+                std::fill(y + first, y + last, T{});
+            } else if (beta != T{1}) {
+                std::transform(y + first, y + last, y + first, [beta](T v) { return beta * v; });
+            }
+            for (std::size_t j0 = first; j0 < last; j0 += gevm_block) {
+                const auto width = std::min(gevm_block, last - j0);
+                for (std::size_t i = 0; i < a.rows; ++i) {
+                    simd::axpy(static_cast<T>(alpha * x[i]), a.data + i * a.stride + j0, y + j0, width);
+                }
+            }
+        }
+
+        /**
+         * @brief 检查矩阵-向量乘法的长度和别名约束
+         */
+        template<typename T>
+        void gemv_validate(const gemm_operand<const T> &a, std::span<const T> x, std::span<T> y, std::size_t x_size,
+                           std::size_t y_size, const char *name) {
+            if (x.size() != x_size) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": input vector length does not match");
+            }
+            if (y.size() != y_size) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": output vector length does not match");
+            }
+            const gemm_operand<T>       out{y.data(), 1, y.size(), y.size()};
+            const gemm_operand<const T> in{x.data(), 1, x.size(), x.size()};
+            if (gemm_overlaps(out, a) || gemm_overlaps(out, in)) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": output must not alias an input");
+            }
+        }
+
+        template<typename A, typename T>
+        void gemv_impl(const A &a, std::span<const T> x, std::span<T> y, T alpha, T beta, bool parallel,
+                       const char *name) {
+            const auto m = make_gemm_operand(a);
+            const gemm_operand<const T> lhs{m.data, m.rows, m.cols, m.stride};
+            gemv_validate(lhs, x, y, lhs.cols, lhs.rows, name);
+            if (parallel) {
+                parallel_chunks(lhs.rows, 64 / sizeof(T), [&](std::size_t first, std::size_t last) {
+                    gemv_rows(lhs, x.data(), y.data(), alpha, beta, first, last);
+                });
+            } else {
+                gemv_rows(lhs, x.data(), y.data(), alpha, beta, 0, lhs.rows);
+            }
+        }
+
+        template<typename A, typename T>
+        void gevm_impl(std::span<const T> x, const A &a, std::span<T> y, T alpha, T beta, bool parallel,
+                       const char *name) {
+            const auto m = make_gemm_operand(a);
+            const gemm_operand<const T> rhs{m.data, m.rows, m.cols, m.stride};
+            gemv_validate(rhs, x, y, rhs.rows, rhs.cols, name);
+            if (parallel) {
+                parallel_chunks(rhs.cols, 64 / sizeof(T), [&](std::size_t first, std::size_t last) {
+                    gevm_cols(rhs, x.data(), y.data(), alpha, beta, first, last);
+                });
+            } else {
+                gevm_cols(rhs, x.data(), y.data(), alpha, beta, 0, rhs.cols);
+            }
+        }
+
+    }  // namespace detail
+
+    // ================================
+    // 矩阵-向量乘法
+    // ================================
+
+    /**
+     * @brief 矩阵-向量乘法：y = alpha * A * x + beta * y
+     *
+     * 对A的每一行与x做向量化点积，按行优先存储连续读取A。
+     * float/double在支持AVX2和FMA的CPU上使用FMA内核。
+     *
+     * @param a 矩阵（m x n），可以是array2d、带行距的矩阵或视图
+     * @param x 长度为n的输入向量
+     * @param y 长度为m的输出向量
+     * @param alpha A * x的系数，默认为1
+     * @param beta y原有值的系数，默认为0；为0时不读取y的原有值
+     *
+     * @throws std::invalid_argument 当向量长度不匹配，或y与A、x的存储重叠时
+     *
+     * @par 示例:
+     * @code
+     * array2d<double> a(rows, cols);
+     * std::vector<double> x(cols), y(rows);
+     * gemv(a, x, y);               // y = A x
+     * gemv(a, x, y, 1.0, 1.0);     // y += A x
+     * @endcode
+     */
+    template<Array2d_matrix_operand A>
+        requires Array2d_linalg_value<typename A::value_type>
+    void gemv(const A &a, std::span<const typename A::value_type> x, std::span<typename A::value_type> y,
+              typename A::value_type alpha = 1, typename A::value_type beta = 0) {
+        detail::gemv_impl(a, x, y, alpha, beta, false, "gemv");
+    }
+
+    /**
+     * @brief 按行并行的矩阵-向量乘法：y = alpha * A * x + beta * y
+     *
+     * @throws std::invalid_argument 当向量长度不匹配，或y与A、x的存储重叠时
+     *
+     * @note 只对大矩阵（>10000元素）使用并行算法，小矩阵等同于gemv()
+     */
+    template<Array2d_matrix_operand A>
+        requires Array2d_linalg_value<typename A::value_type>
+    void gemv_parallel(const A &a, std::span<const typename A::value_type> x, std::span<typename A::value_type> y,
+                       typename A::value_type alpha = 1, typename A::value_type beta = 0) {
+        const auto elements = static_cast<std::size_t>(a.rows()) * static_cast<std::size_t>(a.cols());
+        detail::gemv_impl(a, x, y, alpha, beta, elements > 10000, "gemv_parallel");
+    }
+
+    /**
+     * @brief 计算A * x并返回新向量
+     *
+     * @throws std::invalid_argument 当x的长度不等于A的列数时
+     */
+    template<Array2d_matrix_operand A>
+        requires Array2d_linalg_value<typename A::value_type>
+    [[nodiscard]] std::vector<typename A::value_type> gemv(const A &a, std::span<const typename A::value_type> x) {
+        std::vector<typename A::value_type> y(static_cast<std::size_t>(a.rows()));
+        gemv(a, x, std::span(y));
+        return y;
+    }
+
+    /**
+     * @brief 向量-矩阵乘法：y = alpha * x^T * A + beta * y
+     *
+     * 把x[i]倍的第i行累加（AXPY）到y上，列按块处理使y的分块驻留缓存，
+     * 无需转置A即可连续读取每一行。
+     *
+     * @param x 长度为m的输入向量
+     * @param a 矩阵（m x n），可以是array2d、带行距的矩阵或视图
+     * @param y 长度为n的输出向量
+     * @param alpha x^T * A的系数，默认为1
+     * @param beta y原有值的系数，默认为0；为0时不读取y的原有值
+     *
+     * @throws std::invalid_argument 当向量长度不匹配，或y与A、x的存储重叠时
+     *
+     * @par 示例:
+     * @code
+     * std::vector<double> w(rows), col_weighted(cols);
+     * gevm(w, a, col_weighted);    // 各行按w加权求和
+     * @endcode
+     */
+    template<Array2d_matrix_operand A>
+        requires Array2d_linalg_value<typename A::value_type>
+    void gevm(std::span<const typename A::value_type> x, const A &a, std::span<typename A::value_type> y,
+              typename A::value_type alpha = 1, typename A::value_type beta = 0) {
+        detail::gevm_impl(x, a, y, alpha, beta, false, "gevm");
+    }
+
+    /**
+     * @brief 按列块并行的向量-矩阵乘法：y = alpha * x^T * A + beta * y
+     *
+     * 每个线程负责y的一段连续列，线程之间不需要归约。
+     *
+     * @throws std::invalid_argument 当向量长度不匹配，或y与A、x的存储重叠时
+     *
+     * @note 只对大矩阵（>10000元素）使用并行算法，小矩阵等同于gevm()
+     */
+    template<Array2d_matrix_operand A>
+        requires Array2d_linalg_value<typename A::value_type>
+    void gevm_parallel(std::span<const typename A::value_type> x, const A &a, std::span<typename A::value_type> y,
+                       typename A::value_type alpha = 1, typename A::value_type beta = 0) {
+        const auto elements = static_cast<std::size_t>(a.rows()) * static_cast<std::size_t>(a.cols());
+        detail::gevm_impl(x, a, y, alpha, beta, elements > 10000, "gevm_parallel");
+    }
+
+    /**
+     * @brief 计算x^T * A并返回新向量
+     *
+     * @throws std::invalid_argument 当x的长度不等于A的行数时
+     */
+    template<Array2d_matrix_operand A>
+        requires Array2d_linalg_value<typename A::value_type>
+    [[nodiscard]] std::vector<typename A::value_type> gevm(std::span<const typename A::value_type> x, const A &a) {
+        std::vector<typename A::value_type> y(static_cast<std::size_t>(a.cols()));
+        gevm(x, a, std::span(y));
+        return y;
+    }
+
+}  // namespace qm
@@ -0,0 +1,528 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * @brief 默认线程池的线程数（包括调用线程）
+ *
+ * 为0时使用std::thread::hardware_concurrency()。可以在包含头文件之前定义该宏，
+ * 也可以在运行时调用configure_thread_pool()。
+ */
+#ifndef QM_ARRAY2D_THREADS
+#define QM_ARRAY2D_THREADS 0
+#endif
+
+namespace qm {
+
+    // ================================
+    // 线程池
+    // ================================
+
+    /**
+     * @brief 常驻的fork-join线程池
+     *
+     * 工作线程在构造时创建并一直等待任务，run()不创建线程也不分配内存：
+     * 调用线程发布任务后自己也参与执行，所有任务完成后返回。任务下标通过原子计数器领取，
+     * 执行较快的线程自动多领任务。
+     *
+     * @note 在任务内部再次调用run()（嵌套并行）时直接在当前线程串行执行，不会死锁
+     * @note 多个外部线程同时调用run()时，未获得线程池的调用在自身线程串行执行
+     *
+     * @par 示例:
+     * @code
+     * qm::thread_pool pool(8);
+     * pool.run(100, [&](std::size_t task) { process(task); });
+     * @endcode
+     */
+    class thread_pool {
+    public:
+        /**
+         * @brief 创建线程池
+         *
+         * @param threads 参与计算的线程数（包括调用线程），为0时使用硬件线程数
+         * @param pin_threads 是否把每个工作线程绑定到固定的CPU（仅Linux支持，其他平台忽略）
+         *
+         * @throws std::system_error 当线程创建失败时
+         */
+        explicit thread_pool(std::size_t threads = 0, bool pin_threads = false) : pinned_(pin_threads) {
+            if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+            workers_.reserve(threads - 1);
+            try {
+                for (std::size_t id = 1; id < threads; ++id) {
+                    workers_.emplace_back([this, id] { worker_loop(id); });
+                }
+            } catch (...) {
+                shutdown();
+                throw;
+            }
+        }
+
+        thread_pool(const thread_pool &)            = delete;
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        /**
+         * @brief 通知所有工作线程退出并等待其结束
+         *
+         * @note 析构时不能有正在执行的run()
+         */
+        ~thread_pool() { shutdown(); }
+
+        /**
+         * @brief 参与计算的线程数（工作线程数 + 调用线程）
+         */
+        [[nodiscard]] std::size_t size() const noexcept { return workers_.size() + 1; }
+
+        /**
+         * @brief 工作线程是否绑定到固定的CPU
+         */
+        [[nodiscard]] bool pinned() const noexcept { return pinned_; }
+
+        /**
+         * @brief 对[0, tasks)中的每个下标调用一次fn(task)，全部完成后返回
+         *
+         * @param tasks 任务数
+         * @param fn 任务函数，可能在多个线程中同时调用
+         *
+         * @throws 任务抛出的第一个异常；此后未开始的任务不再执行
+         */
+        template<typename Fn>
+        void run(std::size_t tasks, Fn &&fn) {
+            if (tasks == 0) return;
+
+            std::unique_lock submit(submit_, std::try_to_lock);
+            if (tasks == 1 || workers_.empty() || inside_ || !submit.owns_lock()) {
+                for (std::size_t task = 0; task < tasks; ++task) fn(task);
+                return;
+            }
+
+            using F = std::remove_reference_t<Fn>;
+            job work(&fn, [](void *ctx, std::size_t task) { (*static_cast<F *>(ctx))(task); }, tasks);
+            {
+                std::lock_guard lock(mutex_);
+                job_  = &work;
+                busy_ = workers_.size();
+                ++generation_;
+            }
+            wake_.notify_all();
+
+            execute(work);
+            {
+                std::unique_lock lock(mutex_);
+                done_.wait(lock, [this] { return busy_ == 0; });
+                job_ = nullptr;
+            }
+            if (work.error) std::rethrow_exception(work.error);
+        }
+
+    private:
+        /**
+         * @brief 一次run()发布的任务
+         */
+        struct job {
+            void *ctx;
+            void (*invoke)(void *, std::size_t);
+            std::size_t              tasks;
+            std::atomic<std::size_t> next{0};
+            std::exception_ptr       error;
+            std::mutex               error_mutex;
+
+            job(void *c, void (*f)(void *, std::size_t), std::size_t n) : ctx(c), invoke(f), tasks(n) {}
+        };
+
+        std::vector<std::thread> workers_;
+        std::mutex               mutex_;
+        std::condition_variable  wake_;
+        std::condition_variable  done_;
+        job                     *job_        = nullptr;
+        std::uint64_t            generation_ = 0;
+        std::size_t              busy_       = 0;
+        bool                     stop_       = false;
+        bool                     pinned_;
+        std::mutex               submit_;
+
+        static inline thread_local bool inside_ = false; /**< 当前线程正在执行线程池的任务 */
+
+        /**
+         * @brief 领取并执行任务直到没有剩余任务
+         */
+        static void execute(job &work) noexcept {
+            inside_ = true;
+            for (;;) {
+                const auto task = work.next.fetch_add(1, std::memory_order_relaxed);
+                if (task >= work.tasks) break;
+                try {
+                    work.invoke(work.ctx, task);
+                } catch (...) {
+                    std::lock_guard lock(work.error_mutex);
+                    if (!work.error) work.error = std::current_exception();
+                    work.next.store(work.tasks, std::memory_order_relaxed);
+                }
+            }
+            inside_ = false;
+        }
+
+        void worker_loop(std::size_t id) {
+            if (pinned_) pin_current_thread(id);
+
+            std::uint64_t seen = 0;
+            for (;;) {
+                job *work;
+                {
+                    std::unique_lock lock(mutex_);
+                    wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                    if (stop_) return;
+                    seen = generation_;
+                    work = job_;
+                }
+                execute(*work);
+                {
+                    std::lock_guard lock(mutex_);
+                    if (--busy_ == 0) done_.notify_one();
+                }
+            }
+        }
+
+        void shutdown() noexcept {
+            {
+                std::lock_guard lock(mutex_);
+                stop_ = true;
+            }
+            wake_.notify_all();
+            for (auto &worker: workers_) {
+                if (worker.joinable()) worker.join();
+            }
+            workers_.clear();
+        }
+
+        /**
+         * @brief 把当前线程绑定到第id个CPU（按CPU数取模）
+         */
+        static void pin_current_thread([[maybe_unused]] std::size_t id) noexcept {
+#if defined(__linux__)
+            const auto cpus = std::max(1u, std::thread::hardware_concurrency());
+            cpu_set_t  set;
+            CPU_ZERO(&set);
+            CPU_SET(id % cpus, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+        }
+    };
+
+    namespace detail {
+
+        inline std::mutex &default_thread_pool_mutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        inline std::unique_ptr<thread_pool> &default_thread_pool_storage() {
+            static std::unique_ptr<thread_pool> pool;
+            return pool;
+        }
+
+        inline std::atomic<thread_pool *> &default_thread_pool_pointer() {
+            static std::atomic<thread_pool *> pointer{nullptr};
+            return pointer;
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief 获取库内所有并行算法共用的线程池
+     *
+     * 首次调用时按QM_ARRAY2D_THREADS创建。
+     */
+    inline thread_pool &default_thread_pool() {
+        if (auto *pool = detail::default_thread_pool_pointer().load(std::memory_order_acquire)) [[likely]] {
+            return *pool;
+        }
+        std::lock_guard lock(detail::default_thread_pool_mutex());
+        auto           &storage = detail::default_thread_pool_storage();
+        if (!storage) {
+            storage = std::make_unique<thread_pool>(QM_ARRAY2D_THREADS);
+            detail::default_thread_pool_pointer().store(storage.get(), std::memory_order_release);
+        }
+        return *storage;
+    }
+
+    /**
+     * @brief 用新的线程数和绑核设置重建默认线程池
+     *
+     * @param threads 参与计算的线程数（包括调用线程），为0时使用硬件线程数
+     * @param pin_threads 是否把工作线程绑定到固定的CPU（仅Linux支持）
+     *
+     * @throws std::system_error 当线程创建失败时
+     *
+     * @note 调用时不能有正在执行的并行算法，也不能持有旧线程池的引用
+     *
+     * @par 示例:
+     * @code
+     * qm::configure_thread_pool(4, true);   // 4个线程，绑定CPU
+     * matrix.fill_parallel(0.0);
+     * @endcode
+     */
+    inline void configure_thread_pool(std::size_t threads, bool pin_threads = false) {
+        std::lock_guard lock(detail::default_thread_pool_mutex());
+        auto           &storage = detail::default_thread_pool_storage();
+        detail::default_thread_pool_pointer().store(nullptr, std::memory_order_release);
+        storage.reset();
+        storage = std::make_unique<thread_pool>(threads, pin_threads);
+        detail::default_thread_pool_pointer().store(storage.get(), std::memory_order_release);
+    }
+
+    // ================================
+    // 并行循环
+    // ================================
+
+    namespace detail {
+
+        /**
+         * @brief 把[0, units)均分为chunks块时第chunk块的区间[first, last)
+         *
+         * 在std::size_t中计算，units * chunks超过32位时也不会回绕。
+         */
+        inline std::pair<std::size_t, std::size_t> chunk_bounds(std::size_t units, std::size_t chunk,
+                                                                std::size_t chunks) noexcept {
+            return {units * chunk / chunks, units * (chunk + 1) / chunks};
+        }
+
+        /**
+         * @brief 把[0, total)分成若干连续块，在默认线程池中并行执行fn(first, last)
+         *
+         * 块数为线程数的4倍以平衡负载；块的边界对齐到align的整数倍，
+         * 使相邻块写入的数据不共享缓存行。
+         */
+        template<typename Fn>
+        void parallel_chunks(std::size_t total, std::size_t align, Fn &&fn) {
+            if (total == 0) return;
+            auto      &pool   = default_thread_pool();
+            const auto units  = (total + align - 1) / align;
+            const auto chunks = std::min<std::size_t>(units, pool.size() * 4);
+            pool.run(chunks, [&](std::size_t chunk) {
+                const auto [lo, hi] = chunk_bounds(units, chunk, chunks);
+                const auto first    = lo * align;
+                const auto last     = std::min(hi * align, total);
+                if (first < last) fn(first, last);
+            });
+        }
+
+        /**
+         * @brief 工作窃取调度中一个线程拥有的剩余区间[first, last)
+         *
+         * first和last只在持有锁时修改；不加锁的读取只用于挑选窃取对象。
+         */
+        struct alignas(64) steal_range {
+            std::mutex               mutex;
+            std::atomic<std::size_t> first{0};
+            std::atomic<std::size_t> last{0};
+
+            [[nodiscard]] std::size_t remaining() const noexcept {
+                const auto f = first.load(std::memory_order_relaxed);
+                const auto l = last.load(std::memory_order_relaxed);
+                return l > f ? l - f : 0;
+            }
+        };
+
+        /**
+         * @brief 默认粒度：每个线程初始区间约分成16段
+         */
+        inline std::size_t default_grain(std::size_t total, std::size_t threads) noexcept {
+            return std::max<std::size_t>(1, total / (threads * 16));
+        }
+
+        /**
+         * @brief 用工作窃取调度在默认线程池中执行fn(first, last)，覆盖[0, total)
+         *
+         * [0, total)先平均分给各线程。每个线程从自己区间的前端每次取grain个单位执行；
+         * 区间耗尽后选择剩余最多的线程，窃取其后一半（剩余不超过grain时整体取走），
+         * 被窃取的区间按需继续对半分裂（split-on-steal）。负载不均时空闲线程持续分走繁忙线程
+         * 尚未开始的工作，负载均匀时几乎不发生窃取，每个线程按顺序访问连续的单位。
+         *
+         * @param total 单位总数
+         * @param grain 每次调用fn的最大单位数，也是可继续分裂的最小区间，为0时自动选择
+         * @param fn 处理[first, last)的函数
+         *
+         * @throws 任务抛出的第一个异常；此后各线程不再领取新的工作
+         */
+        template<typename Fn>
+        void parallel_steal(std::size_t total, std::size_t grain, Fn &&fn) {
+            if (total == 0) return;
+            auto      &pool    = default_thread_pool();
+            const auto threads = std::min(pool.size(), total);
+            if (grain == 0) grain = default_grain(total, threads);
+            if (threads == 1 || grain >= total) {
+                for (std::size_t first = 0; first < total; first += grain) fn(first, std::min(first + grain, total));
+                return;
+            }
+
+            std::vector<steal_range> ranges(threads);
+            for (std::size_t t = 0; t < threads; ++t) {
+                ranges[t].first.store(total * t / threads, std::memory_order_relaxed);
+                ranges[t].last.store(total * (t + 1) / threads, std::memory_order_relaxed);
+            }
+            std::atomic<bool> failed{false};
+
+            // 从victim的区间取工作：自己的区间取前端grain个，别人的区间取后一半
+            const auto take = [&](std::size_t victim, bool own, std::size_t &first, std::size_t &last) {
+                auto           &range = ranges[victim];
+                std::lock_guard lock(range.mutex);
+                const auto      f = range.first.load(std::memory_order_relaxed);
+                const auto      l = range.last.load(std::memory_order_relaxed);
+                if (f >= l) return false;
+                if (own) {
+                    first = f;
+                    last  = std::min(l, f + grain);
+                    range.first.store(last, std::memory_order_relaxed);
+                } else {
+                    first = l - f > grain ? f + (l - f) / 2 : f;
+                    last  = l;
+                    range.last.store(first, std::memory_order_relaxed);
+                }
+                return true;
+            };
+
+            pool.run(threads, [&](std::size_t self) {
+                std::size_t first, last;
+                while (!failed.load(std::memory_order_relaxed)) {
+                    if (!take(self, true, first, last)) {
+                        // 自己的区间已空，窃取剩余最多的区间放入自己的区间
+                        std::size_t victim = self, most = 0;
+                        for (std::size_t t = 0; t < threads; ++t) {
+                            if (const auto rest = ranges[t].remaining(); t != self && rest > most) {
+                                victim = t;
+                                most   = rest;
+                            }
+                        }
+                        if (most == 0) break;
+                        if (!take(victim, false, first, last)) continue;
+
+                        std::lock_guard lock(ranges[self].mutex);
+                        ranges[self].first.store(std::min(last, first + grain), std::memory_order_relaxed);
+                        ranges[self].last.store(last, std::memory_order_relaxed);
+                        last = std::min(last, first + grain);
+                    }
+                    try {
+                        fn(first, last);
+                    } catch (...) {
+                        failed.store(true, std::memory_order_relaxed);
+                        throw;
+                    }
+                }
+            });
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief 把行区间[0, rows)分块，在默认线程池中用工作窃取调度执行fn(first, last)
+     *
+     * 各行的开销差异很大时（例如稀疏的前几行和稠密的后几行），空闲线程会窃取繁忙线程
+     * 尚未处理的一半行区间，不会因为静态划分而闲置。
+     *
+     * @param rows 行数
+     * @param fn 处理行区间[first, last)的函数，可能在多个线程中同时调用
+     * @param grain 每次调用fn的最大行数，为0时自动选择；开销小的行宜用较大的粒度
+     *
+     * @throws 任务抛出的第一个异常
+     *
+     * @par 示例:
+     * @code
+     * qm::parallel_for_rows(m.rows(), [&](int first, int last) {
+     *     for (int i = first; i < last; ++i) process(m.row(i));
+     * });
+     * @endcode
+     */
+    template<std::integral Idx, typename Fn>
+    void parallel_for_rows(Idx rows, Fn &&fn, std::size_t grain = 0) {
+        if (std::cmp_less_equal(rows, 0)) return;
+        detail::parallel_steal(static_cast<std::size_t>(rows), grain, [&](std::size_t first, std::size_t last) {
+            fn(static_cast<Idx>(first), static_cast<Idx>(last));
+        });
+    }
+
+    /**
+     * @brief 对矩阵的所有行用工作窃取调度并行执行fn(first, last)
+     *
+     * @param matrix 矩阵或视图，只使用其行数
+     * @param fn 处理行区间[first, last)的函数
+     * @param grain 每次调用fn的最大行数，为0时自动选择
+     *
+     * @throws 任务抛出的第一个异常
+     *
+     * @par 示例:
+     * @code
+     * qm::parallel_for_rows(table, [&](int first, int last) {
+     *     for (int i = first; i < last; ++i) solve_row(table.row(i));   // 各行开销不同
+     * }, 4);
+     * @endcode
+     */
+    template<typename M, typename Fn>
+        requires requires(const M &m) {
+            { m.rows() } -> std::integral;
+        }
+    void parallel_for_rows(const M &matrix, Fn &&fn, std::size_t grain = 0) {
+        parallel_for_rows(matrix.rows(), std::forward<Fn>(fn), grain);
+    }
+
+    /**
+     * @brief 把rows x cols的区域按tile_rows x tile_cols分块，在默认线程池中并行处理每个块
+     *
+     * 块按行优先顺序编号，以单个块为粒度做工作窃取调度，每个线程通常处理相邻的块。
+     *
+     * @param rows 行数
+     * @param cols 列数
+     * @param tile_rows 块的行数，必须大于0
+     * @param tile_cols 块的列数，必须大于0
+     * @param fn 处理块[row_first, row_last) x [col_first, col_last)的函数，
+     *           参数依次为row_first, row_last, col_first, col_last
+     *
+     * @throws std::invalid_argument 当块的尺寸不大于0时
+     * @throws 任务抛出的第一个异常
+     *
+     * @par 示例:
+     * @code
+     * qm::parallel_for_tiles(m.rows(), m.cols(), 64, 64, [&](int r0, int r1, int c0, int c1) {
+     *     process(m.submatrix(r0, c0, r1 - r0, c1 - c0));
+     * });
+     * @endcode
+     */
+    template<std::integral Idx, typename Fn>
+    void parallel_for_tiles(Idx rows, Idx cols, Idx tile_rows, Idx tile_cols, Fn &&fn) {
+        if (std::cmp_less_equal(tile_rows, 0) || std::cmp_less_equal(tile_cols, 0)) [[unlikely]] {
+            throw std::invalid_argument("parallel_for_tiles: tile size must be positive");
+        }
+        if (std::cmp_less_equal(rows, 0) || std::cmp_less_equal(cols, 0)) return;
+
+        const auto height       = static_cast<std::size_t>(tile_rows);
+        const auto width        = static_cast<std::size_t>(tile_cols);
+        const auto tiles_down   = (static_cast<std::size_t>(rows) + height - 1) / height;
+        const auto tiles_across = (static_cast<std::size_t>(cols) + width - 1) / width;
+        detail::parallel_steal(tiles_down * tiles_across, 1, [&](std::size_t first, std::size_t last) {
+            for (auto tile = first; tile < last; ++tile) {
+                const auto r0 = tile / tiles_across * height;
+                const auto c0 = tile % tiles_across * width;
+                fn(static_cast<Idx>(r0), static_cast<Idx>(std::min(r0 + height, static_cast<std::size_t>(rows))),
+                   static_cast<Idx>(c0), static_cast<Idx>(std::min(c0 + width, static_cast<std::size_t>(cols))));
+            }
+        });
+    }
+
+}  // namespace qm
@@ -0,0 +1,1511 @@
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if !defined(QM_ARRAY2D_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define QM_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+/**
+ * @brief 为单个函数启用指定指令集的宏
+ *
+ * GCC/Clang下使用target属性，使未以-mavx2等选项编译的程序也能包含对应内核；
+ * MSVC允许直接使用所有内建函数，无需标注。
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define QM_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define QM_SIMD_TARGET(isa)
+#endif
+
+/**
+ * @brief 声明循环各次迭代之间没有数据依赖的宏
+ *
+ * 逐元素赋值、整行乘加等循环中目标与操作数只在同一下标处可能重叠，不存在跨迭代的依赖，
+ * 告知编译器后可省去运行时的别名检查，直接生成向量化代码。
+ */
+#if defined(__clang__)
+#define QM_IVDEP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define QM_IVDEP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+#define QM_IVDEP __pragma(loop(ivdep))
+#else
+#define QM_IVDEP
+#endif
+
+/**
+ * @brief 切换为非临时（流式）写入的字节数阈值
+ *
+ * 写入量不小于该值时使用绕过缓存的流式写入，避免大矩阵的填充冲刷整个缓存层次。
+ * 可以在包含头文件之前定义该宏来调整，默认为8 MiB。
+ */
+#ifndef QM_ARRAY2D_STREAMING_THRESHOLD
+#define QM_ARRAY2D_STREAMING_THRESHOLD (std::size_t{8} << 20)
+#endif
+
+namespace qm::simd {
+
+    // ================================
+    // 指令集检测
+    // ================================
+
+    /**
+     * @brief 填充内核可以使用的指令集级别
+     */
+    enum class isa : std::uint8_t {
+        scalar, /**< 可移植的标量实现 */
+        sse2,   /**< 128位向量，x86-64的基线 */
+        avx2,   /**< 256位向量 */
+        avx512  /**< 512位向量（AVX-512F） */
+    };
+
+    /**
+     * @brief 流式写入阈值（字节）
+     */
+    inline constexpr std::size_t streaming_threshold = QM_ARRAY2D_STREAMING_THRESHOLD;
+
+    namespace detail {
+
+        /**
+         * @brief 查询CPU和操作系统共同支持的最高指令集
+         */
+        inline isa detect_isa() noexcept {
+#if defined(QM_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return isa::avx512;
+            if (__builtin_cpu_supports("avx2")) return isa::avx2;
+            return isa::sse2;
+#elif defined(QM_SIMD_X86)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) return isa::sse2;
+
+            __cpuid(info, 1);
+            const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+            if (!os_saves_ymm) return isa::sse2;
+
+            __cpuidex(info, 7, 0);
+            if ((info[1] & (1 << 16)) != 0 && (_xgetbv(0) & 0xE6) == 0xE6) return isa::avx512;
+            if ((info[1] & (1 << 5)) != 0) return isa::avx2;
+            return isa::sse2;
+#else
+            return isa::scalar;
+#endif
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief 获取运行时检测到的指令集级别
+     *
+     * 首次调用时检测并缓存结果；定义QM_ARRAY2D_NO_SIMD或非x86-64平台时总是scalar。
+     */
+    [[nodiscard]] inline isa detected_isa() noexcept {
+        static const isa level = detail::detect_isa();
+        return level;
+    }
+
+    /**
+     * @brief CPU是否支持FMA3融合乘加指令
+     *
+     * 首次调用时检测并缓存结果；定义QM_ARRAY2D_NO_SIMD或非x86-64平台时总是false。
+     */
+    [[nodiscard]] inline bool has_fma() noexcept {
+        static const bool supported = [] {
+#if defined(QM_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+            __builtin_cpu_init();
+            return detected_isa() >= isa::avx2 && __builtin_cpu_supports("fma");
+#elif defined(QM_SIMD_X86)
+            int info[4];
+            __cpuid(info, 1);
+            return detected_isa() >= isa::avx2 && (info[2] & (1 << 12)) != 0;
+#else
+            return false;
+#endif
+        }();
+        return supported;
+    }
+
+    // ================================
+    // 填充内核
+    // ================================
+
+    namespace detail {
+
+        /**
+         * @brief 重复模式的缓冲区大小，需覆盖最大向量宽度加最大模式相位
+         */
+        inline constexpr std::size_t pattern_block_size = 128;
+
+        /**
+         * @brief 向已按向量宽度对齐的地址写入chunks个完整向量的函数类型
+         *
+         * @param dst 已对齐的目标地址
+         * @param chunks 写入的向量个数
+         * @param src 一个向量宽度的源数据（不要求对齐）
+         * @param streaming 是否使用非临时写入
+         */
+        using fill_body_fn = void (*)(unsigned char *dst, std::size_t chunks, const unsigned char *src,
+                                      bool streaming) noexcept;
+
+        inline void fill_body_scalar(unsigned char *dst, std::size_t chunks, const unsigned char *src,
+                                     bool) noexcept {
+            for (std::size_t i = 0; i < chunks; ++i) {
+                std::memcpy(dst + i * 64, src, 64);
+            }
+        }
+
+#ifdef QM_SIMD_X86
+        QM_SIMD_TARGET("sse2")
+        inline void fill_body_sse2(unsigned char *dst, std::size_t chunks, const unsigned char *src,
+                                   bool streaming) noexcept {
+            const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+            auto         *out   = reinterpret_cast<__m128i *>(dst);
+            if (streaming) {
+                for (std::size_t i = 0; i < chunks; ++i) _mm_stream_si128(out + i, value);
+                _mm_sfence();
+            } else {
+                for (std::size_t i = 0; i < chunks; ++i) _mm_store_si128(out + i, value);
+            }
+        }
+
+        QM_SIMD_TARGET("avx2")
+        inline void fill_body_avx2(unsigned char *dst, std::size_t chunks, const unsigned char *src,
+                                   bool streaming) noexcept {
+            const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+            auto         *out   = reinterpret_cast<__m256i *>(dst);
+            if (streaming) {
+                for (std::size_t i = 0; i < chunks; ++i) _mm256_stream_si256(out + i, value);
+                _mm_sfence();
+            } else {
+                for (std::size_t i = 0; i < chunks; ++i) _mm256_store_si256(out + i, value);
+            }
+        }
+
+        QM_SIMD_TARGET("avx512f")
+        inline void fill_body_avx512(unsigned char *dst, std::size_t chunks, const unsigned char *src,
+                                     bool streaming) noexcept {
+            const __m512i value = _mm512_loadu_si512(src);
+            auto         *out   = reinterpret_cast<__m512i *>(dst);
+            if (streaming) {
+                for (std::size_t i = 0; i < chunks; ++i) _mm512_stream_si512(out + i, value);
+                _mm_sfence();
+            } else {
+                for (std::size_t i = 0; i < chunks; ++i) _mm512_store_si512(out + i, value);
+            }
+        }
+#endif
+
+        /**
+         * @brief 获取指定指令集的向量宽度（字节）和写入函数
+         */
+        inline void select_fill_body(isa level, std::size_t &width, fill_body_fn &body) noexcept {
+            switch (level) {
+#ifdef QM_SIMD_X86
+                case isa::avx512:
+                    width = 64;
+                    body  = fill_body_avx512;
+                    return;
+                case isa::avx2:
+                    width = 32;
+                    body  = fill_body_avx2;
+                    return;
+                case isa::sse2:
+                    width = 16;
+                    body  = fill_body_sse2;
+                    return;
+#endif
+                default:
+                    width = 64;
+                    body  = fill_body_scalar;
+                    return;
+            }
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief 用重复的字节模式填充内存，使用指定的指令集
+     *
+     * 目标地址只需按字节对齐：先写入到下一个向量边界为止的头部，再用对齐的向量
+     * 写入主体（向量内容按头部长度旋转模式相位），最后写入尾部。
+     *
+     * @param level 使用的指令集，不得高于detected_isa()
+     * @param dst 目标地址
+     * @param bytes 写入的字节数
+     * @param pattern 模式数据
+     * @param pattern_size 模式字节数，必须为1、2、4、8或16
+     * @param streaming 主体部分是否使用非临时写入
+     */
+    inline void fill_pattern(isa level, void *dst, std::size_t bytes, const void *pattern,
+                             std::size_t pattern_size, bool streaming) noexcept {
+        alignas(64) unsigned char block[detail::pattern_block_size];
+        for (std::size_t i = 0; i < detail::pattern_block_size; i += pattern_size) {
+            std::memcpy(block + i, pattern, pattern_size);
+        }
+
+        std::size_t          width;
+        detail::fill_body_fn body;
+        detail::select_fill_body(level, width, body);
+
+        auto *out  = static_cast<unsigned char *>(dst);
+        auto  head = (width - reinterpret_cast<std::uintptr_t>(out) % width) % width;
+        if (bytes <= head + width) {
+            // 不足一个对齐向量，逐块复制
+            for (std::size_t pos = 0; pos < bytes; pos += width) {
+                const auto n = bytes - pos < width ? bytes - pos : width;
+                std::memcpy(out + pos, block + pos % pattern_size, n);
+            }
+            return;
+        }
+
+        std::memcpy(out, block, head);
+        const auto chunks = (bytes - head) / width;
+        body(out + head, chunks, block + head % pattern_size, streaming);
+
+        const auto pos = head + chunks * width;
+        std::memcpy(out + pos, block + pos % pattern_size, bytes - pos);
+    }
+
+    /**
+     * @brief 用重复的字节模式填充内存，自动选择指令集
+     *
+     * @param dst 目标地址
+     * @param bytes 写入的字节数
+     * @param pattern 模式数据
+     * @param pattern_size 模式字节数，必须为1、2、4、8或16
+     * @param streaming 主体部分是否使用非临时写入
+     */
+    inline void fill_pattern(void *dst, std::size_t bytes, const void *pattern, std::size_t pattern_size,
+                             bool streaming) noexcept {
+        fill_pattern(detected_isa(), dst, bytes, pattern, pattern_size, streaming);
+    }
+
+    /**
+     * @brief 可以由填充内核按字节模式写入的元素类型
+     *
+     * 可平凡复制且大小为1、2、4、8或16字节。
+     */
+    template<typename T>
+    concept Fill_pattern_type = std::is_trivially_copyable_v<T> &&
+                                (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8 ||
+                                 sizeof(T) == 16);
+
+    /**
+     * @brief 用指定值填充count个元素
+     *
+     * @tparam T 元素类型，必须满足Fill_pattern_type概念
+     * @param dst 目标地址
+     * @param count 元素个数
+     * @param val 填充值
+     *
+     * @note 写入量达到streaming_threshold时自动使用非临时写入
+     */
+    template<Fill_pattern_type T>
+    void fill(T *dst, std::size_t count, const T &val) noexcept {
+        const auto bytes = count * sizeof(T);
+        fill_pattern(dst, bytes, &val, sizeof(T), bytes >= streaming_threshold);
+    }
+
+    /**
+     * @brief 用单个字节值填充内存
+     *
+     * @param dst 目标地址
+     * @param byte 字节值
+     * @param bytes 写入的字节数
+     *
+     * @note 写入量达到streaming_threshold时自动使用非临时写入
+     */
+    inline void fill_bytes(void *dst, unsigned char byte, std::size_t bytes) noexcept {
+        fill_pattern(dst, bytes, &byte, 1, bytes >= streaming_threshold);
+    }
+
+    // ================================
+    // 交换内核
+    // ================================
+
+    namespace detail {
+
+        /**
+         * @brief 交换两段不重叠内存的函数类型，处理bytes中向量宽度整数倍的部分
+         *
+         * @return 已交换的字节数
+         */
+        using swap_body_fn = std::size_t (*)(unsigned char *a, unsigned char *b, std::size_t bytes) noexcept;
+
+        inline std::size_t swap_body_scalar(unsigned char *a, unsigned char *b, std::size_t bytes) noexcept {
+            unsigned char tmp[64];
+            std::size_t   done = 0;
+            for (; done + sizeof(tmp) <= bytes; done += sizeof(tmp)) {
+                std::memcpy(tmp, a + done, sizeof(tmp));
+                std::memcpy(a + done, b + done, sizeof(tmp));
+                std::memcpy(b + done, tmp, sizeof(tmp));
+            }
+            return done;
+        }
+
+#ifdef QM_SIMD_X86
+        QM_SIMD_TARGET("sse2")
+        inline std::size_t swap_body_sse2(unsigned char *a, unsigned char *b, std::size_t bytes) noexcept {
+            std::size_t done = 0;
+            for (; done + 32 <= bytes; done += 32) {
+                auto *pa = reinterpret_cast<__m128i *>(a + done);
+                auto *pb = reinterpret_cast<__m128i *>(b + done);
+                const __m128i a0 = _mm_loadu_si128(pa), a1 = _mm_loadu_si128(pa + 1);
+                const __m128i b0 = _mm_loadu_si128(pb), b1 = _mm_loadu_si128(pb + 1);
+                _mm_storeu_si128(pa, b0);
+                _mm_storeu_si128(pa + 1, b1);
+                _mm_storeu_si128(pb, a0);
+                _mm_storeu_si128(pb + 1, a1);
+            }
+            return done;
+        }
+
+        QM_SIMD_TARGET("avx2")
+        inline std::size_t swap_body_avx2(unsigned char *a, unsigned char *b, std::size_t bytes) noexcept {
+            std::size_t done = 0;
+            for (; done + 64 <= bytes; done += 64) {
+                auto *pa = reinterpret_cast<__m256i *>(a + done);
+                auto *pb = reinterpret_cast<__m256i *>(b + done);
+                const __m256i a0 = _mm256_loadu_si256(pa), a1 = _mm256_loadu_si256(pa + 1);
+                const __m256i b0 = _mm256_loadu_si256(pb), b1 = _mm256_loadu_si256(pb + 1);
+                _mm256_storeu_si256(pa, b0);
+                _mm256_storeu_si256(pa + 1, b1);
+                _mm256_storeu_si256(pb, a0);
+                _mm256_storeu_si256(pb + 1, a1);
+            }
+            return done;
+        }
+#endif
+
+        /**
+         * @brief 获取当前CPU可用的交换函数
+         */
+        inline swap_body_fn select_swap_body() noexcept {
+#ifdef QM_SIMD_X86
+            if (detected_isa() >= isa::avx2) return swap_body_avx2;
+            if (detected_isa() >= isa::sse2) return swap_body_sse2;
+#endif
+            return swap_body_scalar;
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief 交换两段不重叠内存的内容
+     *
+     * 以向量寄存器为单位成块交换，剩余不足一块的字节逐字节交换。
+     *
+     * @param a 第一段内存
+     * @param b 第二段内存，不得与a重叠
+     * @param bytes 字节数
+     */
+    inline void swap_bytes(void *a, void *b, std::size_t bytes) noexcept {
+        auto *pa = static_cast<unsigned char *>(a);
+        auto *pb = static_cast<unsigned char *>(b);
+
+        static const detail::swap_body_fn body = detail::select_swap_body();
+        for (std::size_t i = body(pa, pb, bytes); i < bytes; ++i) {
+            const unsigned char tmp = pa[i];
+            pa[i]                   = pb[i];
+            pb[i]                   = tmp;
+        }
+    }
+
+    // ================================
+    // 归约内核
+    // ================================
+
+    /**
+     * @brief 有专用向量化归约内核的元素类型
+     */
+    template<typename T>
+    concept Reduce_simd_type = std::same_as<T, float> || std::same_as<T, double>;
+
+    namespace detail {
+
+        /**
+         * @brief 通用多累加器求和，整数类型可由编译器自动向量化
+         */
+        template<typename T>
+        T sum_generic(const T *p, std::size_t n) {
+            if constexpr (std::is_arithmetic_v<T>) {
+                T acc[4]{};
+                std::size_t i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    acc[0] += p[i];
+                    acc[1] += p[i + 1];
+                    acc[2] += p[i + 2];
+                    acc[3] += p[i + 3];
+                }
+                for (; i < n; ++i) acc[0] += p[i];
+                return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+            } else {
+                T acc{};
+                for (std::size_t i = 0; i < n; ++i) acc = acc + p[i];
+                return acc;
+            }
+        }
+
+        /**
+         * @brief 通用Kahan-Babuška（Neumaier）补偿求和
+         */
+        template<typename T>
+        T sum_kahan_generic(const T *p, std::size_t n) {
+            T sum{};
+            T comp{};
+            for (std::size_t i = 0; i < n; ++i) {
+                const T t = sum + p[i];
+                if (std::abs(sum) >= std::abs(p[i])) {
+                    comp += (sum - t) + p[i];
+                } else {
+                    comp += (p[i] - t) + sum;
+                }
+                sum = t;
+            }
+            return sum + comp;
+        }
+
+        /**
+         * @brief 通用最小值/最大值
+         */
+        template<bool Max, typename T>
+        T extremum_generic(const T *p, std::size_t n) {
+            T best = p[0];
+            for (std::size_t i = 1; i < n; ++i) {
+                if constexpr (Max) {
+                    best = best < p[i] ? p[i] : best;
+                } else {
+                    best = p[i] < best ? p[i] : best;
+                }
+            }
+            return best;
+        }
+
+#ifdef QM_SIMD_X86
+        /**
+         * @brief AVX2归约内核
+         *
+         * 每个内核使用4个独立的向量累加器隐藏加法延迟，最后做一次水平归约。
+         */
+        namespace avx2 {
+
+            QM_SIMD_TARGET("avx2") inline __m256d load(const double *p) noexcept { return _mm256_loadu_pd(p); }
+            QM_SIMD_TARGET("avx2") inline __m256 load(const float *p) noexcept { return _mm256_loadu_ps(p); }
+            QM_SIMD_TARGET("avx2") inline __m256d zero(double) noexcept { return _mm256_setzero_pd(); }
+            QM_SIMD_TARGET("avx2") inline __m256 zero(float) noexcept { return _mm256_setzero_ps(); }
+            QM_SIMD_TARGET("avx2") inline __m256d add(__m256d a, __m256d b) noexcept { return _mm256_add_pd(a, b); }
+            QM_SIMD_TARGET("avx2") inline __m256 add(__m256 a, __m256 b) noexcept { return _mm256_add_ps(a, b); }
+            QM_SIMD_TARGET("avx2") inline __m256d sub(__m256d a, __m256d b) noexcept { return _mm256_sub_pd(a, b); }
+            QM_SIMD_TARGET("avx2") inline __m256 sub(__m256 a, __m256 b) noexcept { return _mm256_sub_ps(a, b); }
+            QM_SIMD_TARGET("avx2") inline __m256d min(__m256d a, __m256d b) noexcept { return _mm256_min_pd(a, b); }
+            QM_SIMD_TARGET("avx2") inline __m256 min(__m256 a, __m256 b) noexcept { return _mm256_min_ps(a, b); }
+            QM_SIMD_TARGET("avx2") inline __m256d max(__m256d a, __m256d b) noexcept { return _mm256_max_pd(a, b); }
+            QM_SIMD_TARGET("avx2") inline __m256 max(__m256 a, __m256 b) noexcept { return _mm256_max_ps(a, b); }
+            QM_SIMD_TARGET("avx2") inline void store(double *p, __m256d v) noexcept { _mm256_storeu_pd(p, v); }
+            QM_SIMD_TARGET("avx2") inline void store(float *p, __m256 v) noexcept { _mm256_storeu_ps(p, v); }
+
+            /**
+             * @brief 一步向量化的Kahan补偿累加
+             */
+            template<typename V>
+            QM_SIMD_TARGET("avx2")
+            inline void kahan_step(V &sum, V &comp, V x) noexcept {
+                const V y = sub(x, comp);
+                const V t = add(sum, y);
+                comp      = sub(sub(t, sum), y);
+                sum       = t;
+            }
+
+            /**
+             * @brief 按Max选择逐通道的最大值或最小值
+             */
+            template<bool Max, typename V>
+            QM_SIMD_TARGET("avx2")
+            inline V pick(V a, V b) noexcept {
+                if constexpr (Max) {
+                    return max(a, b);
+                } else {
+                    return min(a, b);
+                }
+            }
+
+            /**
+             * @brief 求和内核
+             */
+            template<Reduce_simd_type T>
+            QM_SIMD_TARGET("avx2")
+            T sum(const T *p, std::size_t n) noexcept {
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                auto acc0 = zero(T{}), acc1 = zero(T{}), acc2 = zero(T{}), acc3 = zero(T{});
+                std::size_t i = 0;
+                for (; i + 4 * lanes <= n; i += 4 * lanes) {
+                    acc0 = add(acc0, load(p + i));
+                    acc1 = add(acc1, load(p + i + lanes));
+                    acc2 = add(acc2, load(p + i + 2 * lanes));
+                    acc3 = add(acc3, load(p + i + 3 * lanes));
+                }
+                for (; i + lanes <= n; i += lanes) acc0 = add(acc0, load(p + i));
+
+                alignas(32) T partial[lanes];
+                store(partial, add(add(acc0, acc1), add(acc2, acc3)));
+                T result{};
+                for (std::size_t k = 0; k < lanes; ++k) result += partial[k];
+                for (; i < n; ++i) result += p[i];
+                return result;
+            }
+
+            /**
+             * @brief Kahan补偿求和内核，每个通道独立补偿，最后用补偿求和合并各通道
+             */
+            template<Reduce_simd_type T>
+            QM_SIMD_TARGET("avx2")
+            T sum_kahan(const T *p, std::size_t n) noexcept {
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                auto sum0 = zero(T{}), sum1 = zero(T{}), comp0 = zero(T{}), comp1 = zero(T{});
+                std::size_t i = 0;
+                for (; i + 2 * lanes <= n; i += 2 * lanes) {
+                    kahan_step(sum0, comp0, load(p + i));
+                    kahan_step(sum1, comp1, load(p + i + lanes));
+                }
+
+                alignas(32) T partial[4 * lanes];
+                store(partial, sum0);
+                store(partial + lanes, sum1);
+                store(partial + 2 * lanes, comp0);
+                store(partial + 3 * lanes, comp1);
+                for (std::size_t k = 2 * lanes; k < 4 * lanes; ++k) partial[k] = -partial[k];
+                const auto tail = n - i;
+                return sum_kahan_generic(partial, 4 * lanes) + sum_kahan_generic(p + i, tail);
+            }
+
+            /**
+             * @brief 最小值/最大值内核，n必须大于0
+             */
+            template<bool Max, Reduce_simd_type T>
+            QM_SIMD_TARGET("avx2")
+            T extremum(const T *p, std::size_t n) noexcept {
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                if (n < 4 * lanes) return extremum_generic<Max>(p, n);
+
+                auto acc0 = load(p), acc1 = load(p + lanes), acc2 = load(p + 2 * lanes), acc3 = load(p + 3 * lanes);
+                std::size_t i = 4 * lanes;
+                for (; i + 4 * lanes <= n; i += 4 * lanes) {
+                    acc0 = pick<Max>(acc0, load(p + i));
+                    acc1 = pick<Max>(acc1, load(p + i + lanes));
+                    acc2 = pick<Max>(acc2, load(p + i + 2 * lanes));
+                    acc3 = pick<Max>(acc3, load(p + i + 3 * lanes));
+                }
+
+                alignas(32) T partial[lanes];
+                store(partial, pick<Max>(pick<Max>(acc0, acc1), pick<Max>(acc2, acc3)));
+                const T best = extremum_generic<Max>(partial, lanes);
+                if (i == n) return best;
+                const T rest = extremum_generic<Max>(p + i, n - i);
+                if constexpr (Max) {
+                    return best < rest ? rest : best;
+                } else {
+                    return rest < best ? rest : best;
+                }
+            }
+
+        }  // namespace avx2
+#endif
+
+        /**
+         * @brief 最小值/最大值的分派
+         */
+        template<bool Max, typename T>
+        T extremum(const T *p, std::size_t n) {
+#ifdef QM_SIMD_X86
+            if constexpr (Reduce_simd_type<T>) {
+                if (detected_isa() >= isa::avx2) return avx2::extremum<Max>(p, n);
+            }
+#endif
+            return extremum_generic<Max>(p, n);
+        }
+
+        /**
+         * @brief 最小值/最大值位置的实现
+         *
+         * 按块求极值，只有块极值优于当前结果时才在该块（仍位于L1缓存中）内定位，
+         * 整体只需对内存做一次遍历。返回第一个极值元素的下标。
+         */
+        template<bool Max, typename T>
+        std::size_t arg_extremum(const T *p, std::size_t n) {
+            constexpr std::size_t block = 1024;
+            const auto better = [](const T &a, const T &b) {
+                if constexpr (Max) {
+                    return b < a;
+                } else {
+                    return a < b;
+                }
+            };
+
+            std::size_t index = 0;
+            T           best  = p[0];
+            for (std::size_t first = 0; first < n; first += block) {
+                const auto count = n - first < block ? n - first : block;
+                const T    value = extremum<Max>(p + first, count);
+                if (first == 0 || better(value, best)) {
+                    best = value;
+                    for (std::size_t i = first; i < first + count; ++i) {
+                        if (!better(p[i], value) && !better(value, p[i])) {
+                            index = i;
+                            break;
+                        }
+                    }
+                }
+            }
+            return index;
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief 求和，允许重新结合（各通道独立累加）以便向量化
+     *
+     * @param p 首元素地址
+     * @param n 元素个数
+     * @return 所有元素之和，n为0时为T{}
+     */
+    template<typename T>
+    [[nodiscard]] T sum(const T *p, std::size_t n) {
+#ifdef QM_SIMD_X86
+        if constexpr (Reduce_simd_type<T>) {
+            if (detected_isa() >= isa::avx2) return detail::avx2::sum(p, n);
+        }
+#endif
+        return detail::sum_generic(p, n);
+    }
+
+    /**
+     * @brief Kahan补偿求和
+     *
+     * @param p 首元素地址
+     * @param n 元素个数
+     * @return 所有元素之和，误差与n无关
+     *
+     * @note 非浮点类型等同于sum()
+     */
+    template<typename T>
+    [[nodiscard]] T sum_kahan(const T *p, std::size_t n) {
+        if constexpr (std::is_floating_point_v<T>) {
+#ifdef QM_SIMD_X86
+            if constexpr (Reduce_simd_type<T>) {
+                if (detected_isa() >= isa::avx2) return detail::avx2::sum_kahan(p, n);
+            }
+#endif
+            return detail::sum_kahan_generic(p, n);
+        } else {
+            return sum(p, n);
+        }
+    }
+
+    /**
+     * @brief 成对（递归二分）求和
+     *
+     * @param p 首元素地址
+     * @param n 元素个数
+     * @return 所有元素之和，误差随log(n)增长
+     *
+     * @note 递归到256个元素以内时使用向量化的sum()
+     */
+    template<typename T>
+    [[nodiscard]] T sum_pairwise(const T *p, std::size_t n) {
+        if (n <= 256) return sum(p, n);
+        const auto half = n / 2;
+        return sum_pairwise(p, half) + sum_pairwise(p + half, n - half);
+    }
+
+    /**
+     * @brief 最小值，n必须大于0
+     *
+     * @note 含NaN时结果未指定
+     */
+    template<typename T>
+    [[nodiscard]] T min(const T *p, std::size_t n) {
+        return detail::extremum<false>(p, n);
+    }
+
+    /**
+     * @brief 最大值，n必须大于0
+     *
+     * @note 含NaN时结果未指定
+     */
+    template<typename T>
+    [[nodiscard]] T max(const T *p, std::size_t n) {
+        return detail::extremum<true>(p, n);
+    }
+
+    /**
+     * @brief 第一个最小值元素的下标，n必须大于0
+     */
+    template<typename T>
+    [[nodiscard]] std::size_t argmin(const T *p, std::size_t n) {
+        return detail::arg_extremum<false>(p, n);
+    }
+
+    /**
+     * @brief 第一个最大值元素的下标，n必须大于0
+     */
+    template<typename T>
+    [[nodiscard]] std::size_t argmax(const T *p, std::size_t n) {
+        return detail::arg_extremum<true>(p, n);
+    }
+
+    // ================================
+    // 转置内核
+    // ================================
+
+    namespace detail {
+
+        /**
+         * @brief 递归转置的基本块边长（元素）
+         *
+         * 源块与目标块合计约32 KiB以内，可同时驻留在L1缓存中。
+         */
+        template<typename T>
+        inline constexpr std::size_t transpose_tile_extent =
+                256 / sizeof(T) > 64 ? 64 : (256 / sizeof(T) < 4 ? 4 : 256 / sizeof(T));
+
+        /**
+         * @brief 标量块转置：dst[j][i] = src[i][j]
+         */
+        template<typename T>
+        void transpose_tile_scalar(const T *src, std::size_t src_stride, T *dst, std::size_t dst_stride,
+                                   std::size_t rows, std::size_t cols) {
+            for (std::size_t i = 0; i < rows; ++i) {
+                for (std::size_t j = 0; j < cols; ++j) {
+                    dst[j * dst_stride + i] = src[i * src_stride + j];
+                }
+            }
+        }
+
+#ifdef QM_SIMD_X86
+        /**
+         * @brief 4字节元素的4x4寄存器内转置
+         */
+        QM_SIMD_TARGET("sse2")
+        inline void transpose_4x4_32(const void *src, std::size_t src_stride, void *dst,
+                                     std::size_t dst_stride) noexcept {
+            const auto *in  = static_cast<const float *>(src);
+            auto       *out = static_cast<float *>(dst);
+            __m128      r0  = _mm_loadu_ps(in);
+            __m128      r1  = _mm_loadu_ps(in + src_stride);
+            __m128      r2  = _mm_loadu_ps(in + 2 * src_stride);
+            __m128      r3  = _mm_loadu_ps(in + 3 * src_stride);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(out, r0);
+            _mm_storeu_ps(out + dst_stride, r1);
+            _mm_storeu_ps(out + 2 * dst_stride, r2);
+            _mm_storeu_ps(out + 3 * dst_stride, r3);
+        }
+
+        /**
+         * @brief 8字节元素的2x2寄存器内转置
+         */
+        QM_SIMD_TARGET("sse2")
+        inline void transpose_2x2_64(const void *src, std::size_t src_stride, void *dst,
+                                     std::size_t dst_stride) noexcept {
+            const auto  *in  = static_cast<const double *>(src);
+            auto        *out = static_cast<double *>(dst);
+            const __m128d r0 = _mm_loadu_pd(in);
+            const __m128d r1 = _mm_loadu_pd(in + src_stride);
+            _mm_storeu_pd(out, _mm_unpacklo_pd(r0, r1));
+            _mm_storeu_pd(out + dst_stride, _mm_unpackhi_pd(r0, r1));
+        }
+
+        /**
+         * @brief 4字节元素的8x8寄存器内转置
+         */
+        QM_SIMD_TARGET("avx2")
+        inline void transpose_8x8_32(const void *src, std::size_t src_stride, void *dst,
+                                     std::size_t dst_stride) noexcept {
+            const auto *in  = static_cast<const float *>(src);
+            auto       *out = static_cast<float *>(dst);
+            __m256      r[8];
+            for (int k = 0; k < 8; ++k) r[k] = _mm256_loadu_ps(in + k * src_stride);
+
+            // 两两交错行内元素
+            const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+            const __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+            const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+            const __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+            const __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+            const __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+            const __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+            const __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+
+            // 组合为4x4子块
+            const __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+            // 交换128位半部
+            _mm256_storeu_ps(out, _mm256_permute2f128_ps(u0, u4, 0x20));
+            _mm256_storeu_ps(out + dst_stride, _mm256_permute2f128_ps(u1, u5, 0x20));
+            _mm256_storeu_ps(out + 2 * dst_stride, _mm256_permute2f128_ps(u2, u6, 0x20));
+            _mm256_storeu_ps(out + 3 * dst_stride, _mm256_permute2f128_ps(u3, u7, 0x20));
+            _mm256_storeu_ps(out + 4 * dst_stride, _mm256_permute2f128_ps(u0, u4, 0x31));
+            _mm256_storeu_ps(out + 5 * dst_stride, _mm256_permute2f128_ps(u1, u5, 0x31));
+            _mm256_storeu_ps(out + 6 * dst_stride, _mm256_permute2f128_ps(u2, u6, 0x31));
+            _mm256_storeu_ps(out + 7 * dst_stride, _mm256_permute2f128_ps(u3, u7, 0x31));
+        }
+
+        /**
+         * @brief 8字节元素的4x4寄存器内转置
+         */
+        QM_SIMD_TARGET("avx2")
+        inline void transpose_4x4_64(const void *src, std::size_t src_stride, void *dst,
+                                     std::size_t dst_stride) noexcept {
+            const auto  *in = static_cast<const double *>(src);
+            auto        *out = static_cast<double *>(dst);
+            const __m256d r0 = _mm256_loadu_pd(in);
+            const __m256d r1 = _mm256_loadu_pd(in + src_stride);
+            const __m256d r2 = _mm256_loadu_pd(in + 2 * src_stride);
+            const __m256d r3 = _mm256_loadu_pd(in + 3 * src_stride);
+
+            const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+            const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+            const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+            const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+            _mm256_storeu_pd(out, _mm256_permute2f128_pd(t0, t2, 0x20));
+            _mm256_storeu_pd(out + dst_stride, _mm256_permute2f128_pd(t1, t3, 0x20));
+            _mm256_storeu_pd(out + 2 * dst_stride, _mm256_permute2f128_pd(t0, t2, 0x31));
+            _mm256_storeu_pd(out + 3 * dst_stride, _mm256_permute2f128_pd(t1, t3, 0x31));
+        }
+
+        /**
+         * @brief 以寄存器内微内核转置一个块，不足一个微块的边缘部分使用标量代码
+         *
+         * SSE2版本对4字节元素使用4x4、对8字节元素使用2x2微内核。
+         */
+        template<typename T>
+        QM_SIMD_TARGET("sse2")
+        void transpose_tile_sse2(const T *src, std::size_t src_stride, T *dst, std::size_t dst_stride,
+                                 std::size_t rows, std::size_t cols) noexcept {
+            constexpr std::size_t k         = 16 / sizeof(T);
+            const auto            full_rows = rows - rows % k;
+            const auto            full_cols = cols - cols % k;
+            for (std::size_t i = 0; i < full_rows; i += k) {
+                for (std::size_t j = 0; j < full_cols; j += k) {
+                    if constexpr (sizeof(T) == 4) {
+                        transpose_4x4_32(src + i * src_stride + j, src_stride, dst + j * dst_stride + i, dst_stride);
+                    } else {
+                        transpose_2x2_64(src + i * src_stride + j, src_stride, dst + j * dst_stride + i, dst_stride);
+                    }
+                }
+            }
+            transpose_tile_scalar(src + full_cols, src_stride, dst + full_cols * dst_stride, dst_stride, rows,
+                                  cols - full_cols);
+            transpose_tile_scalar(src + full_rows * src_stride, src_stride, dst + full_rows, dst_stride,
+                                  rows - full_rows, full_cols);
+        }
+
+        /**
+         * @brief AVX2版本，对4字节元素使用8x8、对8字节元素使用4x4微内核
+         */
+        template<typename T>
+        QM_SIMD_TARGET("avx2")
+        void transpose_tile_avx2(const T *src, std::size_t src_stride, T *dst, std::size_t dst_stride,
+                                 std::size_t rows, std::size_t cols) noexcept {
+            constexpr std::size_t k         = 32 / sizeof(T);
+            const auto            full_rows = rows - rows % k;
+            const auto            full_cols = cols - cols % k;
+            for (std::size_t i = 0; i < full_rows; i += k) {
+                for (std::size_t j = 0; j < full_cols; j += k) {
+                    if constexpr (sizeof(T) == 4) {
+                        transpose_8x8_32(src + i * src_stride + j, src_stride, dst + j * dst_stride + i, dst_stride);
+                    } else {
+                        transpose_4x4_64(src + i * src_stride + j, src_stride, dst + j * dst_stride + i, dst_stride);
+                    }
+                }
+            }
+            transpose_tile_scalar(src + full_cols, src_stride, dst + full_cols * dst_stride, dst_stride, rows,
+                                  cols - full_cols);
+            transpose_tile_scalar(src + full_rows * src_stride, src_stride, dst + full_rows, dst_stride,
+                                  rows - full_rows, full_cols);
+        }
+#endif
+
+        /**
+         * @brief 转置基本块的函数类型
+         */
+        template<typename T>
+        using transpose_tile_fn = void (*)(const T *, std::size_t, T *, std::size_t, std::size_t, std::size_t);
+
+        /**
+         * @brief 缓存无关的递归转置
+         *
+         * 每次沿较长的一维对半分割（分割点对齐到8个元素，保持微内核对齐），
+         * 直到两维都不超过transpose_tile_extent，无论缓存层次的大小如何都能保持局部性。
+         */
+        template<typename T>
+        void transpose_recursive(const T *src, std::size_t src_stride, T *dst, std::size_t dst_stride,
+                                 std::size_t rows, std::size_t cols, transpose_tile_fn<T> tile) {
+            constexpr std::size_t extent = transpose_tile_extent<T>;
+            // 分割点向上对齐到8个元素，过小时退回到对半分割
+            const auto split = [](std::size_t n) {
+                const auto half = ((n / 2) + 7) & ~std::size_t{7};
+                return half < n ? half : n / 2;
+            };
+            while (rows > extent || cols > extent) {
+                if (rows >= cols) {
+                    const auto half = split(rows);
+                    transpose_recursive(src, src_stride, dst, dst_stride, half, cols, tile);
+                    src += half * src_stride;
+                    dst += half;
+                    rows -= half;
+                } else {
+                    const auto half = split(cols);
+                    transpose_recursive(src, src_stride, dst, dst_stride, rows, half, tile);
+                    src += half;
+                    dst += half * dst_stride;
+                    cols -= half;
+                }
+            }
+            tile(src, src_stride, dst, dst_stride, rows, cols);
+        }
+
+        /**
+         * @brief 选择元素类型可用的最快基本块内核
+         */
+        template<typename T>
+        transpose_tile_fn<T> select_transpose_tile() noexcept {
+#ifdef QM_SIMD_X86
+            if constexpr (std::is_trivially_copyable_v<T> && (sizeof(T) == 4 || sizeof(T) == 8)) {
+                if (detected_isa() >= isa::avx2) return transpose_tile_avx2<T>;
+                if (detected_isa() >= isa::sse2) return transpose_tile_sse2<T>;
+            }
+#endif
+            return transpose_tile_scalar<T>;
+        }
+
+    }  // namespace detail
+
+    /**
+     * @brief 矩阵转置：dst[j * dst_stride + i] = src[i * src_stride + j]
+     *
+     * 使用缓存无关的递归分块；4/8字节的可平凡复制类型在基本块内使用
+     * SSE2/AVX2寄存器内转置微内核，其他类型逐元素赋值。
+     *
+     * @param src 源矩阵首元素地址
+     * @param src_stride 源矩阵行距（元素）
+     * @param dst 目标矩阵首元素地址，不得与源矩阵重叠
+     * @param dst_stride 目标矩阵行距（元素）
+     * @param rows 源矩阵行数
+     * @param cols 源矩阵列数
+     */
+    template<typename T>
+    void transpose(const T *src, std::size_t src_stride, T *dst, std::size_t dst_stride, std::size_t rows,
+                   std::size_t cols) {
+        if (rows == 0 || cols == 0) return;
+        detail::transpose_recursive(src, src_stride, dst, dst_stride, rows, cols, detail::select_transpose_tile<T>());
+    }
+
+    // ================================
+    // 矩阵乘法微内核
+    // ================================
+
+    /**
+     * @brief 矩阵乘法微内核
+     *
+     * 计算 C = alpha * Ap * Bp + beta * C 的一个mr x nr块，其中Ap为打包后按列排列的
+     * mr行条带（每个k连续存放mr个元素），Bp为打包后按行排列的nr列条带。
+     * beta为0时不读取C。
+     *
+     * @tparam T 元素类型
+     */
+    template<typename T>
+    struct gemm_kernel {
+        using fn = void (*)(std::size_t kc, const T *ap, const T *bp, T *c, std::size_t ldc, T alpha, T beta);
+
+        std::size_t mr;     /**< 微块行数 */
+        std::size_t nr;     /**< 微块列数 */
+        fn          kernel; /**< 内核函数 */
+    };
+
+    namespace detail {
+
+        /**
+         * @brief 可移植的微内核，累加器为定长数组，便于编译器展开和向量化
+         */
+        template<typename T, std::size_t MR, std::size_t NR>
+        void gemm_kernel_generic(std::size_t kc, const T *ap, const T *bp, T *c, std::size_t ldc, T alpha, T beta) {
+            T acc[MR][NR]{};
+            for (std::size_t p = 0; p < kc; ++p) {
+                for (std::size_t i = 0; i < MR; ++i) {
+                    for (std::size_t j = 0; j < NR; ++j) {
+                        acc[i][j] += ap[i] * bp[j];
+                    }
+                }
+                ap += MR;
+                bp += NR;
+            }
+            for (std::size_t i = 0; i < MR; ++i) {
+                for (std::size_t j = 0; j < NR; ++j) {
+                    c[i * ldc + j] = beta == T{} ? alpha * acc[i][j] : alpha * acc[i][j] + beta * c[i * ldc + j];
+                }
+            }
+        }
+
+#ifdef QM_SIMD_X86
+        /**
+         * @brief 微内核的写回：row = alpha * acc (+ beta * row)
+         */
+        QM_SIMD_TARGET("avx2,fma")
+        inline void gemm_store_f64(double *row, __m256d acc, __m256d va, __m256d vb, bool accumulate) noexcept {
+            const __m256d scaled = _mm256_mul_pd(va, acc);
+            _mm256_storeu_pd(row, accumulate ? _mm256_fmadd_pd(vb, _mm256_loadu_pd(row), scaled) : scaled);
+        }
+
+        QM_SIMD_TARGET("avx2,fma")
+        inline void gemm_store_f32(float *row, __m256 acc, __m256 va, __m256 vb, bool accumulate) noexcept {
+            const __m256 scaled = _mm256_mul_ps(va, acc);
+            _mm256_storeu_ps(row, accumulate ? _mm256_fmadd_ps(vb, _mm256_loadu_ps(row), scaled) : scaled);
+        }
+
+        QM_SIMD_TARGET("avx2")
+        inline void gemm_store_i32(std::int32_t *row, __m256i acc, __m256i va, __m256i vb, bool accumulate) noexcept {
+            auto         *out    = reinterpret_cast<__m256i *>(row);
+            const __m256i scaled = _mm256_mullo_epi32(va, acc);
+            _mm256_storeu_si256(out, accumulate ? _mm256_add_epi32(scaled, _mm256_mullo_epi32(vb, _mm256_loadu_si256(out)))
+                                                : scaled);
+        }
+
+        /**
+         * @brief double的6x8 AVX2/FMA微内核，12个累加器常驻寄存器
+         */
+        QM_SIMD_TARGET("avx2,fma")
+        inline void gemm_kernel_avx2_f64(std::size_t kc, const double *ap, const double *bp, double *c,
+                                         std::size_t ldc, double alpha, double beta) {
+            __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+            __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+            __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+            __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+            __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+            __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+            for (std::size_t p = 0; p < kc; ++p) {
+                const __m256d b0 = _mm256_loadu_pd(bp);
+                const __m256d b1 = _mm256_loadu_pd(bp + 4);
+                __m256d       a  = _mm256_broadcast_sd(ap);
+                c00 = _mm256_fmadd_pd(a, b0, c00);
+                c01 = _mm256_fmadd_pd(a, b1, c01);
+                a   = _mm256_broadcast_sd(ap + 1);
+                c10 = _mm256_fmadd_pd(a, b0, c10);
+                c11 = _mm256_fmadd_pd(a, b1, c11);
+                a   = _mm256_broadcast_sd(ap + 2);
+                c20 = _mm256_fmadd_pd(a, b0, c20);
+                c21 = _mm256_fmadd_pd(a, b1, c21);
+                a   = _mm256_broadcast_sd(ap + 3);
+                c30 = _mm256_fmadd_pd(a, b0, c30);
+                c31 = _mm256_fmadd_pd(a, b1, c31);
+                a   = _mm256_broadcast_sd(ap + 4);
+                c40 = _mm256_fmadd_pd(a, b0, c40);
+                c41 = _mm256_fmadd_pd(a, b1, c41);
+                a   = _mm256_broadcast_sd(ap + 5);
+                c50 = _mm256_fmadd_pd(a, b0, c50);
+                c51 = _mm256_fmadd_pd(a, b1, c51);
+                ap += 6;
+                bp += 8;
+            }
+
+            const __m256d va         = _mm256_set1_pd(alpha);
+            const __m256d vb         = _mm256_set1_pd(beta);
+            const bool    accumulate = beta != 0.0;
+            gemm_store_f64(c, c00, va, vb, accumulate);
+            gemm_store_f64(c + 4, c01, va, vb, accumulate);
+            gemm_store_f64(c + ldc, c10, va, vb, accumulate);
+            gemm_store_f64(c + ldc + 4, c11, va, vb, accumulate);
+            gemm_store_f64(c + 2 * ldc, c20, va, vb, accumulate);
+            gemm_store_f64(c + 2 * ldc + 4, c21, va, vb, accumulate);
+            gemm_store_f64(c + 3 * ldc, c30, va, vb, accumulate);
+            gemm_store_f64(c + 3 * ldc + 4, c31, va, vb, accumulate);
+            gemm_store_f64(c + 4 * ldc, c40, va, vb, accumulate);
+            gemm_store_f64(c + 4 * ldc + 4, c41, va, vb, accumulate);
+            gemm_store_f64(c + 5 * ldc, c50, va, vb, accumulate);
+            gemm_store_f64(c + 5 * ldc + 4, c51, va, vb, accumulate);
+        }
+
+        /**
+         * @brief float的6x16 AVX2/FMA微内核
+         */
+        QM_SIMD_TARGET("avx2,fma")
+        inline void gemm_kernel_avx2_f32(std::size_t kc, const float *ap, const float *bp, float *c,
+                                         std::size_t ldc, float alpha, float beta) {
+            __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+            __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+            __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+            __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+            __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+            __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+            for (std::size_t p = 0; p < kc; ++p) {
+                const __m256 b0 = _mm256_loadu_ps(bp);
+                const __m256 b1 = _mm256_loadu_ps(bp + 8);
+                __m256       a  = _mm256_broadcast_ss(ap);
+                c00 = _mm256_fmadd_ps(a, b0, c00);
+                c01 = _mm256_fmadd_ps(a, b1, c01);
+                a   = _mm256_broadcast_ss(ap + 1);
+                c10 = _mm256_fmadd_ps(a, b0, c10);
+                c11 = _mm256_fmadd_ps(a, b1, c11);
+                a   = _mm256_broadcast_ss(ap + 2);
+                c20 = _mm256_fmadd_ps(a, b0, c20);
+                c21 = _mm256_fmadd_ps(a, b1, c21);
+                a   = _mm256_broadcast_ss(ap + 3);
+                c30 = _mm256_fmadd_ps(a, b0, c30);
+                c31 = _mm256_fmadd_ps(a, b1, c31);
+                a   = _mm256_broadcast_ss(ap + 4);
+                c40 = _mm256_fmadd_ps(a, b0, c40);
+                c41 = _mm256_fmadd_ps(a, b1, c41);
+                a   = _mm256_broadcast_ss(ap + 5);
+                c50 = _mm256_fmadd_ps(a, b0, c50);
+                c51 = _mm256_fmadd_ps(a, b1, c51);
+                ap += 6;
+                bp += 16;
+            }
+
+            const __m256 va         = _mm256_set1_ps(alpha);
+            const __m256 vb         = _mm256_set1_ps(beta);
+            const bool   accumulate = beta != 0.0f;
+            gemm_store_f32(c, c00, va, vb, accumulate);
+            gemm_store_f32(c + 8, c01, va, vb, accumulate);
+            gemm_store_f32(c + ldc, c10, va, vb, accumulate);
+            gemm_store_f32(c + ldc + 8, c11, va, vb, accumulate);
+            gemm_store_f32(c + 2 * ldc, c20, va, vb, accumulate);
+            gemm_store_f32(c + 2 * ldc + 8, c21, va, vb, accumulate);
+            gemm_store_f32(c + 3 * ldc, c30, va, vb, accumulate);
+            gemm_store_f32(c + 3 * ldc + 8, c31, va, vb, accumulate);
+            gemm_store_f32(c + 4 * ldc, c40, va, vb, accumulate);
+            gemm_store_f32(c + 4 * ldc + 8, c41, va, vb, accumulate);
+            gemm_store_f32(c + 5 * ldc, c50, va, vb, accumulate);
+            gemm_store_f32(c + 5 * ldc + 8, c51, va, vb, accumulate);
+        }
+
+        /**
+         * @brief int32的4x16 AVX2微内核（乘法取低32位，与标量回绕语义一致）
+         */
+        QM_SIMD_TARGET("avx2")
+        inline void gemm_kernel_avx2_i32(std::size_t kc, const std::int32_t *ap, const std::int32_t *bp,
+                                         std::int32_t *c, std::size_t ldc, std::int32_t alpha, std::int32_t beta) {
+            __m256i c00 = _mm256_setzero_si256(), c01 = _mm256_setzero_si256();
+            __m256i c10 = _mm256_setzero_si256(), c11 = _mm256_setzero_si256();
+            __m256i c20 = _mm256_setzero_si256(), c21 = _mm256_setzero_si256();
+            __m256i c30 = _mm256_setzero_si256(), c31 = _mm256_setzero_si256();
+            for (std::size_t p = 0; p < kc; ++p) {
+                const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bp));
+                const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bp + 8));
+                __m256i       a  = _mm256_set1_epi32(ap[0]);
+                c00 = _mm256_add_epi32(c00, _mm256_mullo_epi32(a, b0));
+                c01 = _mm256_add_epi32(c01, _mm256_mullo_epi32(a, b1));
+                a   = _mm256_set1_epi32(ap[1]);
+                c10 = _mm256_add_epi32(c10, _mm256_mullo_epi32(a, b0));
+                c11 = _mm256_add_epi32(c11, _mm256_mullo_epi32(a, b1));
+                a   = _mm256_set1_epi32(ap[2]);
+                c20 = _mm256_add_epi32(c20, _mm256_mullo_epi32(a, b0));
+                c21 = _mm256_add_epi32(c21, _mm256_mullo_epi32(a, b1));
+                a   = _mm256_set1_epi32(ap[3]);
+                c30 = _mm256_add_epi32(c30, _mm256_mullo_epi32(a, b0));
+                c31 = _mm256_add_epi32(c31, _mm256_mullo_epi32(a, b1));
+                ap += 4;
+                bp += 16;
+            }
+
+            const __m256i va         = _mm256_set1_epi32(alpha);
+            const __m256i vb         = _mm256_set1_epi32(beta);
+            const bool    accumulate = beta != 0;
+            gemm_store_i32(c, c00, va, vb, accumulate);
+            gemm_store_i32(c + 8, c01, va, vb, accumulate);
+            gemm_store_i32(c + ldc, c10, va, vb, accumulate);
+            gemm_store_i32(c + ldc + 8, c11, va, vb, accumulate);
+            gemm_store_i32(c + 2 * ldc, c20, va, vb, accumulate);
+            gemm_store_i32(c + 2 * ldc + 8, c21, va, vb, accumulate);
+            gemm_store_i32(c + 3 * ldc, c30, va, vb, accumulate);
+            gemm_store_i32(c + 3 * ldc + 8, c31, va, vb, accumulate);
+        }
+#endif
+
+    }  // namespace detail
+
+    /**
+     * @brief 选择元素类型在当前CPU上最快的矩阵乘法微内核
+     *
+     * float/double在支持AVX2和FMA时使用6x16/6x8内核，int32在支持AVX2时使用4x16内核，
+     * 其他情况使用4x8的可移植内核。
+     */
+    template<typename T>
+    [[nodiscard]] gemm_kernel<T> select_gemm_kernel() noexcept {
+#ifdef QM_SIMD_X86
+        if constexpr (std::same_as<T, double>) {
+            if (has_fma()) return {6, 8, detail::gemm_kernel_avx2_f64};
+        } else if constexpr (std::same_as<T, float>) {
+            if (has_fma()) return {6, 16, detail::gemm_kernel_avx2_f32};
+        } else if constexpr (std::same_as<T, std::int32_t>) {
+            if (detected_isa() >= isa::avx2) return {4, 16, detail::gemm_kernel_avx2_i32};
+        }
+#endif
+        return {4, 8, detail::gemm_kernel_generic<T, 4, 8>};
+    }
+
+    // ================================
+    // 点积和AXPY内核
+    // ================================
+
+    namespace detail {
+
+        /**
+         * @brief 通用多累加器点积
+         */
+        template<typename T>
+        T dot_generic(const T *a, const T *b, std::size_t n) {
+            T           acc[4]{};
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                acc[0] += a[i] * b[i];
+                acc[1] += a[i + 1] * b[i + 1];
+                acc[2] += a[i + 2] * b[i + 2];
+                acc[3] += a[i + 3] * b[i + 3];
+            }
+            for (; i < n; ++i) acc[0] += a[i] * b[i];
+            return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+        }
+
+        /**
+         * @brief 通用AXPY：y += alpha * x
+         */
+        template<typename T>
+        void axpy_generic(T alpha, const T *x, T *y, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) y[i] += alpha * x[i];
+        }
+
+#ifdef QM_SIMD_X86
+        /**
+         * @brief AVX2/FMA点积和AXPY内核
+         */
+        namespace fma {
+
+            QM_SIMD_TARGET("avx2,fma") inline __m256d load(const double *p) noexcept { return _mm256_loadu_pd(p); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256 load(const float *p) noexcept { return _mm256_loadu_ps(p); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256d zero(double) noexcept { return _mm256_setzero_pd(); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256 zero(float) noexcept { return _mm256_setzero_ps(); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256d broadcast(double x) noexcept { return _mm256_set1_pd(x); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256 broadcast(float x) noexcept { return _mm256_set1_ps(x); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256d add(__m256d a, __m256d b) noexcept { return _mm256_add_pd(a, b); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256 add(__m256 a, __m256 b) noexcept { return _mm256_add_ps(a, b); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256d fmadd(__m256d a, __m256d b, __m256d c) noexcept {
+                return _mm256_fmadd_pd(a, b, c);
+            }
+            QM_SIMD_TARGET("avx2,fma") inline __m256 fmadd(__m256 a, __m256 b, __m256 c) noexcept {
+                return _mm256_fmadd_ps(a, b, c);
+            }
+            QM_SIMD_TARGET("avx2,fma") inline void store(double *p, __m256d v) noexcept { _mm256_storeu_pd(p, v); }
+            QM_SIMD_TARGET("avx2,fma") inline void store(float *p, __m256 v) noexcept { _mm256_storeu_ps(p, v); }
+
+            /**
+             * @brief 点积内核，4个独立累加器隐藏FMA延迟
+             */
+            template<Reduce_simd_type T>
+            QM_SIMD_TARGET("avx2,fma")
+            T dot(const T *a, const T *b, std::size_t n) noexcept {
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                auto acc0 = zero(T{}), acc1 = zero(T{}), acc2 = zero(T{}), acc3 = zero(T{});
+                std::size_t i = 0;
+                for (; i + 4 * lanes <= n; i += 4 * lanes) {
+                    acc0 = fmadd(load(a + i), load(b + i), acc0);
+                    acc1 = fmadd(load(a + i + lanes), load(b + i + lanes), acc1);
+                    acc2 = fmadd(load(a + i + 2 * lanes), load(b + i + 2 * lanes), acc2);
+                    acc3 = fmadd(load(a + i + 3 * lanes), load(b + i + 3 * lanes), acc3);
+                }
+                for (; i + lanes <= n; i += lanes) acc0 = fmadd(load(a + i), load(b + i), acc0);
+
+                alignas(32) T partial[lanes];
+                store(partial, add(add(acc0, acc1), add(acc2, acc3)));
+                T result{};
+                for (std::size_t k = 0; k < lanes; ++k) result += partial[k];
+                for (; i < n; ++i) result += a[i] * b[i];
+                return result;
+            }
+
+            /**
+             * @brief AXPY内核：y += alpha * x
+             */
+            template<Reduce_simd_type T>
+            QM_SIMD_TARGET("avx2,fma")
+            void axpy(T alpha, const T *x, T *y, std::size_t n) noexcept {
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                const auto            va    = broadcast(alpha);
+                std::size_t           i     = 0;
+                for (; i + 2 * lanes <= n; i += 2 * lanes) {
+                    store(y + i, fmadd(va, load(x + i), load(y + i)));
+                    store(y + i + lanes, fmadd(va, load(x + i + lanes), load(y + i + lanes)));
+                }
+                for (; i + lanes <= n; i += lanes) store(y + i, fmadd(va, load(x + i), load(y + i)));
+                for (; i < n; ++i) y[i] += alpha * x[i];
+            }
+
+        }  // namespace fma
+#endif
+
+    }  // namespace detail
+
+    /**
+     * @brief 点积
+     *
+     * float/double在支持AVX2和FMA时使用向量化内核，各通道独立累加（允许重新结合）。
+     *
+     * @param a 第一个向量的首地址
+     * @param b 第二个向量的首地址
+     * @param n 元素个数
+     * @return sum(a[i] * b[i])，n为0时为T{}
+     */
+    template<typename T>
+    [[nodiscard]] T dot(const T *a, const T *b, std::size_t n) {
+#ifdef QM_SIMD_X86
+        if constexpr (Reduce_simd_type<T>) {
+            if (has_fma()) return detail::fma::dot(a, b, n);
+        }
+#endif
+        return detail::dot_generic(a, b, n);
+    }
+
+    /**
+     * @brief AXPY：y += alpha * x
+     *
+     * @param alpha 系数
+     * @param x 输入向量的首地址
+     * @param y 输出向量的首地址，不能与x部分重叠
+     * @param n 元素个数
+     */
+    template<typename T>
+    void axpy(T alpha, const T *x, T *y, std::size_t n) {
+#ifdef QM_SIMD_X86
+        if constexpr (Reduce_simd_type<T>) {
+            if (has_fma()) {
+                detail::fma::axpy(alpha, x, y, n);
+                return;
+            }
+        }
+#endif
+        detail::axpy_generic(alpha, x, y, n);
+    }
+
+    // ================================
+    // 模板运算内核
+    // ================================
+
+    namespace detail {
+
+        /**
+         * @brief 通用的多行互相关，逐个抽头对整行做乘加，内层循环可由编译器自动向量化
+         */
+        template<typename T>
+        void correlate_rows_generic(const T *const *rows, std::size_t row_count, const T *weights, std::size_t taps,
+                                    T *out, std::size_t n, bool accumulate) {
+            if (!accumulate) {
+                for (std::size_t j = 0; j < n; ++j) out[j] = T{};
+            }
+            for (std::size_t u = 0; u < row_count; ++u) {
+                for (std::size_t v = 0; v < taps; ++v) {
+                    const T  w = weights[u * taps + v];
+                    const T *p = rows[u] + v;
+                    QM_IVDEP
+                    for (std::size_t j = 0; j < n; ++j) out[j] += w * p[j];
+                }
+            }
+        }
+
+#ifdef QM_SIMD_X86
+        namespace fma {
+
+            /**
+             * @brief 多行互相关内核，每次输出两个向量，所有抽头的乘加都在寄存器中完成
+             */
+            template<Reduce_simd_type T>
+            QM_SIMD_TARGET("avx2,fma")
+            void correlate_rows(const T *const *rows, std::size_t row_count, const T *weights, std::size_t taps,
+                                T *out, std::size_t n, bool accumulate) noexcept {
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                std::size_t           j     = 0;
+                for (; j + 2 * lanes <= n; j += 2 * lanes) {
+                    auto s0 = accumulate ? load(out + j) : zero(T{});
+                    auto s1 = accumulate ? load(out + j + lanes) : zero(T{});
+                    for (std::size_t u = 0; u < row_count; ++u) {
+                        const T *p = rows[u] + j;
+                        const T *w = weights + u * taps;
+                        for (std::size_t v = 0; v < taps; ++v) {
+                            const auto wv = broadcast(w[v]);
+                            s0            = fmadd(wv, load(p + v), s0);
+                            s1            = fmadd(wv, load(p + v + lanes), s1);
+                        }
+                    }
+                    store(out + j, s0);
+                    store(out + j + lanes, s1);
+                }
+                for (; j + lanes <= n; j += lanes) {
+                    auto s0 = accumulate ? load(out + j) : zero(T{});
+                    for (std::size_t u = 0; u < row_count; ++u) {
+                        const T *p = rows[u] + j;
+                        const T *w = weights + u * taps;
+                        for (std::size_t v = 0; v < taps; ++v) s0 = fmadd(broadcast(w[v]), load(p + v), s0);
+                    }
+                    store(out + j, s0);
+                }
+                for (; j < n; ++j) {
+                    T acc = accumulate ? out[j] : T{};
+                    for (std::size_t u = 0; u < row_count; ++u) {
+                        for (std::size_t v = 0; v < taps; ++v) acc += weights[u * taps + v] * rows[u][j + v];
+                    }
+                    out[j] = acc;
+                }
+            }
+
+        }  // namespace fma
+#endif
+
+    }  // namespace detail
+
+    /**
+     * @brief 多行互相关：out[j] (+)= sum(weights[u * taps + v] * rows[u][j + v])
+     *
+     * 模板运算的核心内核。每个输出向量的全部row_count * taps次乘加都在寄存器中累加，
+     * 每个输出元素只写入一次。float/double在支持AVX2和FMA时使用向量化内核。
+     *
+     * @param rows row_count个输入行的首地址，每行至少有n + taps - 1个元素
+     * @param row_count 输入行数
+     * @param weights row_count x taps的权重，行优先排列
+     * @param taps 每行的抽头数
+     * @param out 输出的首地址，不能与输入重叠
+     * @param n 输出元素个数
+     * @param accumulate 为true时累加到out的原有值上，否则覆盖
+     */
+    template<typename T>
+    void correlate_rows(const T *const *rows, std::size_t row_count, const T *weights, std::size_t taps, T *out,
+                        std::size_t n, bool accumulate = false) {
+#ifdef QM_SIMD_X86
+        if constexpr (Reduce_simd_type<T>) {
+            if (has_fma()) {
+                detail::fma::correlate_rows(rows, row_count, weights, taps, out, n, accumulate);
+                return;
+            }
+        }
+#endif
+        detail::correlate_rows_generic(rows, row_count, weights, taps, out, n, accumulate);
+    }
+
+}  // namespace qm::simd
@@ -0,0 +1,489 @@
+#pragma once
+
+#include "array2d.hpp"
+#include "array2d_expr.hpp"
+#include "array2d_linalg.hpp"
+#include "array2d_parallel.hpp"
+#include "array2d_simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace qm {
+
+    /**
+     * @brief 模板运算（卷积）越过矩阵边界时的取值方式
+     */
+    enum class Array_border_opt : std::int8_t {
+        Clamp    = 0, /**< 取最近的边界元素：aaa|abcd|ddd */
+        Wrap     = 1, /**< 周期延拓：bcd|abcd|abc */
+        Reflect  = 2, /**< 以边界元素为轴镜像（不重复边界元素）：dcb|abcd|cba */
+        Constant = 3  /**< 使用给定的常数 */
+    };
+
+    namespace detail {
+
+        /**
+         * @brief 整数累加类型放宽到足以容纳乘积之和，避免在饱和之前回绕
+         */
+        template<typename T>
+        using stencil_widen_t =
+                std::conditional_t<!std::is_integral_v<T> || sizeof(T) >= sizeof(std::int64_t), T,
+                                   std::conditional_t<sizeof(T) == 1, std::int32_t, std::int64_t>>;
+
+    }  // namespace detail
+
+    /**
+     * @brief 模板运算的累加类型：源元素类型与权重类型的公共类型，窄整数放宽为int32_t/int64_t
+     */
+    template<typename T, typename W>
+    using stencil_acc_t = detail::stencil_widen_t<std::common_type_t<T, W>>;
+
+    namespace detail {
+
+        // ================================
+        // 边界处理
+        // ================================
+
+        /**
+         * @brief 把越界的下标映射回[0, n)，Constant模式下越界时返回-1
+         */
+        inline std::ptrdiff_t border_index(std::ptrdiff_t i, std::ptrdiff_t n, Array_border_opt mode) noexcept {
+            if (i >= 0 && i < n) [[likely]] return i;
+            switch (mode) {
+                case Array_border_opt::Clamp:
+                    return i < 0 ? 0 : n - 1;
+                case Array_border_opt::Wrap: {
+                    const auto r = i % n;
+                    return r < 0 ? r + n : r;
+                }
+                case Array_border_opt::Reflect: {
+                    if (n == 1) return 0;
+                    const auto period = 2 * (n - 1);
+                    auto       r      = i % period;
+                    if (r < 0) r += period;
+                    return r < n ? r : period - r;
+                }
+                default:
+                    return -1;
+            }
+        }
+
+        /**
+         * @brief 把累加结果转换为输出类型
+         *
+         * 浮点结果写入整数输出时四舍五入，整数输出在其取值范围内饱和。
+         */
+        template<typename D, typename Acc>
+        D stencil_cast(Acc v) noexcept {
+            if constexpr (std::is_integral_v<D> && std::is_floating_point_v<Acc>) {
+                v = std::nearbyint(v);
+                if (!(v > static_cast<Acc>(std::numeric_limits<D>::lowest()))) return std::numeric_limits<D>::lowest();
+                if (v >= static_cast<Acc>(std::numeric_limits<D>::max())) return std::numeric_limits<D>::max();
+                return static_cast<D>(v);
+            } else if constexpr (std::is_integral_v<D> && std::is_integral_v<Acc>) {
+                if (std::cmp_less(v, std::numeric_limits<D>::lowest())) return std::numeric_limits<D>::lowest();
+                if (std::cmp_greater(v, std::numeric_limits<D>::max())) return std::numeric_limits<D>::max();
+                return static_cast<D>(v);
+            } else {
+                return static_cast<D>(v);
+            }
+        }
+
+        /**
+         * @brief 模板运算的源矩阵，负责按边界模式读取任意逻辑行的一段
+         */
+        template<typename T, typename Acc>
+        struct stencil_source {
+            const T         *data;
+            std::ptrdiff_t   rows;
+            std::ptrdiff_t   cols;
+            std::size_t      stride;
+            Array_border_opt mode;
+            Acc              border;
+
+            /**
+             * @brief 获取逻辑行r中列[first, first + count)的值
+             *
+             * 内部区域且元素类型与累加类型相同时直接返回源存储的指针；
+             * 否则把这一段转换并补齐边界后写入buffer。只有越界的边缘列逐个映射下标。
+             */
+            const Acc *row(std::ptrdiff_t r, std::ptrdiff_t first, std::size_t count, Acc *buffer) const {
+                const auto last   = first + static_cast<std::ptrdiff_t>(count);
+                const auto mapped = border_index(r, rows, mode);
+                if (mapped < 0) {
+                    std::fill(buffer, buffer + count, border);
+                    return buffer;
+                }
+
+                const T *p = data + static_cast<std::size_t>(mapped) * stride;
+                if constexpr (std::same_as<T, Acc>) {
+                    if (first >= 0 && last <= cols) return p + first;
+                }
+
+                const auto lo = std::clamp<std::ptrdiff_t>(first, 0, cols);
+                const auto hi = std::clamp<std::ptrdiff_t>(last, lo, cols);
+                for (auto c = first; c < lo; ++c) {
+                    const auto m       = border_index(c, cols, mode);
+                    buffer[c - first] = m < 0 ? border : static_cast<Acc>(p[m]);
+                }
+                Acc *middle = buffer + (lo - first);
+                QM_IVDEP
+                for (std::ptrdiff_t c = 0; c < hi - lo; ++c) {
+                    middle[c] = static_cast<Acc>(p[lo + c]);
+                }
+                for (auto c = hi; c < last; ++c) {
+                    const auto m       = border_index(c, cols, mode);
+                    buffer[c - first] = m < 0 ? border : static_cast<Acc>(p[m]);
+                }
+                return buffer;
+            }
+        };
+
+        /**
+         * @brief 列分块的宽度，使一个任务的行缓冲区约占256 KiB（L2缓存）
+         */
+        template<typename Acc>
+        std::size_t stencil_tile_width(std::size_t ring_rows, std::size_t kw, std::size_t cols) noexcept {
+            constexpr std::size_t budget = (std::size_t{256} << 10) / sizeof(Acc);
+            const auto            per_row = budget / (ring_rows + 2);
+            const auto            tile    = per_row > kw + 256 ? per_row - kw : 256;
+            return std::max<std::size_t>(1, std::min(tile, cols));
+        }
+
+        /**
+         * @brief 行槽位：逻辑行r存放在r mod n号槽位中，连续的n行互不冲突
+         */
+        inline std::size_t stencil_slot(std::ptrdiff_t r, std::size_t n) noexcept {
+            const auto m = r % static_cast<std::ptrdiff_t>(n);
+            return static_cast<std::size_t>(m < 0 ? m + static_cast<std::ptrdiff_t>(n) : m);
+        }
+
+        /**
+         * @brief 计算一段输出：输出类型与累加类型相同时直接写入目标行，否则经缓冲区转换
+         */
+        template<typename D, typename Acc, typename Fn>
+        void stencil_emit(D *out, Acc *buffer, std::size_t n, Fn compute) {
+            if constexpr (std::same_as<D, Acc>) {
+                compute(out);
+            } else {
+                compute(buffer);
+                for (std::size_t j = 0; j < n; ++j) out[j] = stencil_cast<D>(buffer[j]);
+            }
+        }
+
+        /**
+         * @brief KxK模板运算：计算输出的[row_first, row_last)行
+         *
+         * 按列分块处理，每个分块内用环形缓冲区缓存kh个补齐边界后的源行，每个源行只读取和转换一次。
+         * 每个输出行由多行互相关内核一次算出，所有乘加在寄存器中累加，内层循环没有分支。
+         */
+        template<typename T, typename Acc, typename D>
+        void stencil_rows(const stencil_source<T, Acc> &src, const Acc *weights, std::size_t kh, std::size_t kw,
+                          D *dst, std::size_t dst_stride, std::size_t row_first, std::size_t row_last) {
+            const auto ah    = static_cast<std::ptrdiff_t>(kh / 2);
+            const auto aw    = static_cast<std::ptrdiff_t>(kw / 2);
+            const auto cols  = static_cast<std::size_t>(src.cols);
+            const auto tile  = stencil_tile_width<Acc>(kh, kw, cols);
+            const auto width = tile + kw - 1;
+
+            std::vector<Acc>            ring(kh * width);
+            std::vector<const Acc *>    slot_data(kh);
+            std::vector<std::ptrdiff_t> slot_row(kh);
+            std::vector<const Acc *>    taps(kh);
+            std::vector<Acc>            acc(tile);
+
+            for (std::size_t j0 = 0; j0 < cols; j0 += tile) {
+                const auto tw    = std::min(tile, cols - j0);
+                const auto first = static_cast<std::ptrdiff_t>(j0) - aw;
+                std::fill(slot_row.begin(), slot_row.end(), std::numeric_limits<std::ptrdiff_t>::min());
+
+                for (auto i = row_first; i < row_last; ++i) {
+                    for (std::size_t u = 0; u < kh; ++u) {
+                        const auto r    = static_cast<std::ptrdiff_t>(i + u) - ah;
+                        const auto slot = stencil_slot(r, kh);
+                        if (slot_row[slot] != r) {
+                            slot_data[slot] = src.row(r, first, tw + kw - 1, ring.data() + slot * width);
+                            slot_row[slot]  = r;
+                        }
+                        taps[u] = slot_data[slot];
+                    }
+
+                    stencil_emit(dst + i * dst_stride + j0, acc.data(), tw, [&](Acc *target) {
+                        simd::correlate_rows(taps.data(), kh, weights, kw, target, tw);
+                    });
+                }
+            }
+        }
+
+        /**
+         * @brief 可分离模板运算：计算输出的[row_first, row_last)行
+         *
+         * 环形缓冲区缓存kh个已做水平滤波的行，每个源行只做一次水平滤波；
+         * 输出行是这些行的加权和，每个元素只需kh + kw次乘加。
+         */
+        template<typename T, typename Acc, typename D>
+        void stencil_separable_rows(const stencil_source<T, Acc> &src, const Acc *row_kernel, std::size_t kw,
+                                    const Acc *col_kernel, std::size_t kh, D *dst, std::size_t dst_stride,
+                                    std::size_t row_first, std::size_t row_last) {
+            const auto ah   = static_cast<std::ptrdiff_t>(kh / 2);
+            const auto aw   = static_cast<std::ptrdiff_t>(kw / 2);
+            const auto cols = static_cast<std::size_t>(src.cols);
+            const auto tile = stencil_tile_width<Acc>(kh + 1, kw, cols);
+
+            std::vector<Acc>            ring(kh * tile);
+            std::vector<std::ptrdiff_t> slot_row(kh);
+            std::vector<Acc>            padded(tile + kw - 1);
+            std::vector<const Acc *>    lines(kh);
+            std::vector<Acc>            acc(tile);
+
+            for (std::size_t j0 = 0; j0 < cols; j0 += tile) {
+                const auto tw    = std::min(tile, cols - j0);
+                const auto first = static_cast<std::ptrdiff_t>(j0) - aw;
+                std::fill(slot_row.begin(), slot_row.end(), std::numeric_limits<std::ptrdiff_t>::min());
+
+                for (auto i = row_first; i < row_last; ++i) {
+                    for (std::size_t u = 0; u < kh; ++u) {
+                        const auto r    = static_cast<std::ptrdiff_t>(i + u) - ah;
+                        const auto slot = stencil_slot(r, kh);
+                        Acc       *line = ring.data() + slot * tile;
+                        if (slot_row[slot] != r) {
+                            const Acc *source = src.row(r, first, tw + kw - 1, padded.data());
+                            simd::correlate_rows(&source, 1, row_kernel, kw, line, tw);
+                            slot_row[slot] = r;
+                        }
+                        lines[u] = line;
+                    }
+                    stencil_emit(dst + i * dst_stride + j0, acc.data(), tw, [&](Acc *target) {
+                        simd::correlate_rows(lines.data(), kh, col_kernel, 1, target, tw);
+                    });
+                }
+            }
+        }
+
+        /**
+         * @brief 把输出行分块，串行或并行地调用fn(first, last)
+         */
+        template<typename Fn>
+        void stencil_dispatch(std::size_t rows, bool parallel, Fn fn) {
+            if (parallel) {
+                parallel_chunks(rows, 1, fn);
+            } else {
+                fn(std::size_t{0}, rows);
+            }
+        }
+
+        /**
+         * @brief 检查输出形状和别名约束
+         */
+        template<typename T, typename D>
+        void stencil_validate(const gemm_operand<const T> &src, const gemm_operand<D> &dst, const char *name) {
+            if (dst.rows != src.rows || dst.cols != src.cols) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": output shape does not match");
+            }
+            if (gemm_overlaps(dst, src)) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": output must not alias the source");
+            }
+        }
+
+        template<typename Acc, typename S, typename D, typename K>
+        void stencil_impl(const S &src, D &dst, const K &kernel, Array_border_opt border,
+                          typename S::value_type border_value, bool parallel, const char *name) {
+            using T        = typename S::value_type;
+            const auto in  = make_gemm_operand(src);
+            const auto out = make_gemm_operand(dst);
+            if (kernel.rows() <= 0 || kernel.cols() <= 0) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": kernel is empty");
+            }
+            stencil_validate(gemm_operand<const T>{in.data, in.rows, in.cols, in.stride}, out, name);
+            if (in.rows == 0 || in.cols == 0) return;
+
+            const auto       kh = static_cast<std::size_t>(kernel.rows());
+            const auto       kw = static_cast<std::size_t>(kernel.cols());
+            std::vector<Acc> weights(kh * kw);
+            for (std::size_t u = 0; u < kh; ++u) {
+                const auto *row = kernel.data() + u * static_cast<std::size_t>(kernel.pitch());
+                std::transform(row, row + kw, weights.begin() + static_cast<std::ptrdiff_t>(u * kw),
+                               [](const auto &w) { return static_cast<Acc>(w); });
+            }
+
+            const stencil_source<T, Acc> source{in.data,
+                                                static_cast<std::ptrdiff_t>(in.rows),
+                                                static_cast<std::ptrdiff_t>(in.cols),
+                                                in.stride,
+                                                border,
+                                                static_cast<Acc>(border_value)};
+            stencil_dispatch(in.rows, parallel, [&](std::size_t first, std::size_t last) {
+                stencil_rows(source, weights.data(), kh, kw, out.data, out.stride, first, last);
+            });
+        }
+
+        template<typename Acc, typename S, typename D, typename R, typename C>
+        void stencil_separable_impl(const S &src, D &dst, const R &row_kernel, const C &col_kernel,
+                                    Array_border_opt border, typename S::value_type border_value, bool parallel,
+                                    const char *name) {
+            using T        = typename S::value_type;
+            const auto in  = make_gemm_operand(src);
+            const auto out = make_gemm_operand(dst);
+            if (std::ranges::empty(row_kernel) || std::ranges::empty(col_kernel)) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": kernel is empty");
+            }
+            stencil_validate(gemm_operand<const T>{in.data, in.rows, in.cols, in.stride}, out, name);
+            if (in.rows == 0 || in.cols == 0) return;
+
+            std::vector<Acc> horizontal(std::ranges::size(row_kernel));
+            std::vector<Acc> vertical(std::ranges::size(col_kernel));
+            std::ranges::transform(row_kernel, horizontal.begin(), [](const auto &w) { return static_cast<Acc>(w); });
+            std::ranges::transform(col_kernel, vertical.begin(), [](const auto &w) { return static_cast<Acc>(w); });
+
+            const stencil_source<T, Acc> source{in.data,
+                                                static_cast<std::ptrdiff_t>(in.rows),
+                                                static_cast<std::ptrdiff_t>(in.cols),
+                                                in.stride,
+                                                border,
+                                                static_cast<Acc>(border_value)};
+            stencil_dispatch(in.rows, parallel, [&](std::size_t first, std::size_t last) {
+                stencil_separable_rows(source, horizontal.data(), horizontal.size(), vertical.data(), vertical.size(),
+                                       out.data, out.stride, first, last);
+            });
+        }
+
+    }  // namespace detail
+
+    // ================================
+    // 模板运算（卷积）
+    // ================================
+
+    /**
+     * @brief 对矩阵应用任意kh x kw的模板（互相关，不翻转核）
+     *
+     * dst(i, j) = sum(kernel(u, v) * src(i + u - kh / 2, j + v - kw / 2))，越界的源元素按border取值。
+     * 边界处理只发生在读取补齐后的源行时，计算循环对整行做无分支的向量化乘加；
+     * 列按缓存大小分块，每个源行在一个分块内只读取和转换一次。
+     *
+     * @param src 源矩阵，可以是array2d、带行距的矩阵或视图
+     * @param dst 输出矩阵，形状与src相同，可以是array2d或可写视图
+     * @param kernel 权重矩阵，锚点为(kh / 2, kw / 2)
+     * @param border 边界模式，默认为Clamp
+     * @param border_value Constant模式下越界元素的值
+     *
+     * @throws std::invalid_argument 当核为空、输出形状不同或输出与源的存储重叠时
+     *
+     * @note 累加类型为源元素类型与权重类型的公共类型；输出为整数时四舍五入并饱和
+     *
+     * @par 示例:
+     * @code
+     * array2d<float> sobel_x{{-1, 0, 1}, {-2, 0, 2}, {-1, 0, 1}};
+     * array2d<float> gx(image.rows(), image.cols());
+     * stencil(image, gx, sobel_x, Array_border_opt::Reflect);
+     * @endcode
+     */
+    template<Array2d_matrix_operand S, typename D, Array2d_matrix_operand K>
+        requires Array2d_linalg_value<typename S::value_type> && Array2d_linalg_value<typename K::value_type> &&
+                 Array2d_writable_operand<std::remove_reference_t<D>, typename std::remove_reference_t<D>::value_type>
+    void stencil(const S &src, D &&dst, const K &kernel, Array_border_opt border = Array_border_opt::Clamp,
+                 typename S::value_type border_value = {}) {
+        using Acc = stencil_acc_t<typename S::value_type, typename K::value_type>;
+        detail::stencil_impl<Acc>(src, dst, kernel, border, border_value, false, "stencil");
+    }
+
+    /**
+     * @brief 使用多线程对矩阵应用kh x kw的模板
+     *
+     * 输出行被划分给不同线程，每个线程使用独立的行缓冲区。
+     *
+     * @throws std::invalid_argument 当核为空、输出形状不同或输出与源的存储重叠时
+     *
+     * @note 只对大矩阵（>10000元素）使用并行算法，小矩阵等同于stencil()
+     */
+    template<Array2d_matrix_operand S, typename D, Array2d_matrix_operand K>
+        requires Array2d_linalg_value<typename S::value_type> && Array2d_linalg_value<typename K::value_type> &&
+                 Array2d_writable_operand<std::remove_reference_t<D>, typename std::remove_reference_t<D>::value_type>
+    void stencil_parallel(const S &src, D &&dst, const K &kernel, Array_border_opt border = Array_border_opt::Clamp,
+                          typename S::value_type border_value = {}) {
+        using Acc           = stencil_acc_t<typename S::value_type, typename K::value_type>;
+        const auto elements = static_cast<std::size_t>(src.rows()) * static_cast<std::size_t>(src.cols());
+        detail::stencil_impl<Acc>(src, dst, kernel, border, border_value, elements > 10000, "stencil_parallel");
+    }
+
+    /**
+     * @brief 对矩阵应用kh x kw的模板并返回新矩阵
+     *
+     * @return 与src形状、元素类型和索引类型相同的紧密排列矩阵
+     *
+     * @throws std::invalid_argument 当核为空时
+     */
+    template<Array2d_matrix_operand S, Array2d_matrix_operand K>
+        requires Array2d_linalg_value<typename S::value_type> && Array2d_linalg_value<typename K::value_type>
+    [[nodiscard]] array2d<typename S::value_type, operand_index_t<S>> stencil(
+            const S &src, const K &kernel, Array_border_opt border = Array_border_opt::Clamp,
+            typename S::value_type border_value = {}) {
+        auto dst = detail::make_result<typename S::value_type, operand_index_t<S>>(src.rows(), src.cols(), "stencil");
+        stencil(src, dst, kernel, border, border_value);
+        return dst;
+    }
+
+    /**
+     * @brief 应用可分离的模板：先用row_kernel做水平滤波，再用col_kernel做竖直滤波
+     *
+     * 等价于核为col_kernel * row_kernel^T的stencil()，每个元素只需kh + kw次乘加。
+     * 水平滤波后的行在环形缓冲区中复用，不产生完整的中间矩阵。
+     *
+     * @param src 源矩阵
+     * @param dst 输出矩阵，形状与src相同
+     * @param row_kernel 水平方向的权重（长度kw，锚点kw / 2）
+     * @param col_kernel 竖直方向的权重（长度kh，锚点kh / 2）
+     * @param border 边界模式，默认为Clamp
+     * @param border_value Constant模式下越界元素的值
+     *
+     * @throws std::invalid_argument 当核为空、输出形状不同或输出与源的存储重叠时
+     *
+     * @par 示例:
+     * @code
+     * std::vector<float> gauss{0.0625f, 0.25f, 0.375f, 0.25f, 0.0625f};
+     * stencil_separable(frame, blurred, gauss, gauss, Array_border_opt::Reflect);
+     * @endcode
+     */
+    template<Array2d_matrix_operand S, typename D, std::ranges::contiguous_range R, std::ranges::contiguous_range C>
+        requires Array2d_linalg_value<typename S::value_type> &&
+                 Array2d_linalg_value<std::ranges::range_value_t<R>> &&
+                 std::same_as<std::ranges::range_value_t<R>, std::ranges::range_value_t<C>> &&
+                 Array2d_writable_operand<std::remove_reference_t<D>, typename std::remove_reference_t<D>::value_type>
+    void stencil_separable(const S &src, D &&dst, const R &row_kernel, const C &col_kernel,
+                           Array_border_opt border = Array_border_opt::Clamp, typename S::value_type border_value = {}) {
+        using Acc = stencil_acc_t<typename S::value_type, std::ranges::range_value_t<R>>;
+        detail::stencil_separable_impl<Acc>(src, dst, row_kernel, col_kernel, border, border_value, false,
+                                            "stencil_separable");
+    }
+
+    /**
+     * @brief 使用多线程应用可分离的模板
+     *
+     * @throws std::invalid_argument 当核为空、输出形状不同或输出与源的存储重叠时
+     *
+     * @note 只对大矩阵（>10000元素）使用并行算法，小矩阵等同于stencil_separable()
+     */
+    template<Array2d_matrix_operand S, typename D, std::ranges::contiguous_range R, std::ranges::contiguous_range C>
+        requires Array2d_linalg_value<typename S::value_type> &&
+                 Array2d_linalg_value<std::ranges::range_value_t<R>> &&
+                 std::same_as<std::ranges::range_value_t<R>, std::ranges::range_value_t<C>> &&
+                 Array2d_writable_operand<std::remove_reference_t<D>, typename std::remove_reference_t<D>::value_type>
+    void stencil_separable_parallel(const S &src, D &&dst, const R &row_kernel, const C &col_kernel,
+                                    Array_border_opt border       = Array_border_opt::Clamp,
+                                    typename S::value_type border_value = {}) {
+        using Acc           = stencil_acc_t<typename S::value_type, std::ranges::range_value_t<R>>;
+        const auto elements = static_cast<std::size_t>(src.rows()) * static_cast<std::size_t>(src.cols());
+        detail::stencil_separable_impl<Acc>(src, dst, row_kernel, col_kernel, border, border_value, elements > 10000,
+                                            "stencil_separable_parallel");
+    }
+
+}  // namespace qm
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "array2d.hpp"
+#include "array2d_expr.hpp"
+#include "array2d_parallel.hpp"
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace qm {
+
+    /**
+     * @brief 求和表默认的累加类型
+     *
+     * 整数累加到64位整数（保持符号性），避免小整数类型的前缀和溢出；
+     * 浮点累加到至少double的精度，减小前缀相减时的抵消误差。
+     *
+     * @tparam Ty 源矩阵的元素类型
+     */
+    template<typename Ty>
+    using summed_area_sum_t = std::conditional_t<std::is_floating_point_v<Ty>, std::common_type_t<Ty, double>,
+                                                 std::conditional_t<std::is_signed_v<Ty>, std::int64_t, std::uint64_t>>;
+
+    // ================================
+    // summed_area_table 类定义
+    // ================================
+
+    /**
+     * @brief 求和面积表（二维前缀和）
+     *
+     * 保存(rows + 1) x (cols + 1)的前缀和，首行和首列为0，任意矩形区域之和只需4次查表。
+     * 构建时先做行内前缀和，再把上一行逐元素累加到当前行（可向量化）；
+     * 并行构建时行前缀按行分块、列累加按列分块，两个阶段都没有跨线程写入。
+     *
+     * @tparam Ty 源矩阵的元素类型
+     * @tparam Sum 累加类型，默认为summed_area_sum_t<Ty>
+     * @tparam Idx 索引类型，默认为int
+     *
+     * @par 示例:
+     * @code
+     * array2d<int> counts(1000, 1000);
+     * summed_area_table<int> sat(counts);
+     * auto window = sat.rect_sum(10, 20, 42, 52);   // [10, 42) x [20, 52)之和，O(1)
+     * @endcode
+     */
+    template<typename Ty, typename Sum = summed_area_sum_t<Ty>, Array2d_index_type Idx = int>
+    class summed_area_table {
+    public:
+        using source_type = Ty;                        /**< 源元素类型 */
+        using value_type  = Sum;                       /**< 累加类型 */
+        using index_type  = Idx;                       /**< 索引类型 */
+        using size_type   = std::make_unsigned_t<Idx>; /**< 大小类型 */
+        using table_type  = array2d<Sum, Idx>;         /**< 前缀和存储类型 */
+
+        // ================================
+        // 构造函数
+        // ================================
+
+        /**
+         * @brief 默认构造函数，创建对应0x0矩阵的空表
+         */
+        summed_area_table() : table_(1, 1, Sum{}) {}
+
+        /**
+         * @brief 从矩阵构建求和表
+         *
+         * @param src 源矩阵，可以是array2d、带行距的矩阵或视图
+         *
+         * @throws std::overflow_error 当表的尺寸溢出索引类型时
+         * @throws std::bad_alloc 当内存分配失败时
+         */
+        template<Array2d_matrix_operand M>
+            requires std::convertible_to<typename M::value_type, Sum>
+        explicit summed_area_table(const M &src) {
+            build(src, false);
+        }
+
+        // ================================
+        // 构建
+        // ================================
+
+        /**
+         * @brief 用新的矩阵重建求和表
+         *
+         * 尺寸不变时复用已有存储，适合逐帧更新的场景。
+         *
+         * @param src 源矩阵
+         *
+         * @throws std::overflow_error 当表的尺寸溢出索引类型时
+         * @throws std::bad_alloc 当内存分配失败时
+         */
+        template<Array2d_matrix_operand M>
+            requires std::convertible_to<typename M::value_type, Sum>
+        void assign(const M &src) {
+            build(src, false);
+        }
+
+        /**
+         * @brief 使用多线程重建求和表
+         *
+         * @param src 源矩阵
+         *
+         * @throws std::overflow_error 当表的尺寸溢出索引类型时
+         * @throws std::bad_alloc 当内存分配失败时
+         *
+         * @note 只对大矩阵（>10000元素）使用并行算法，小矩阵等同于assign()
+         */
+        template<Array2d_matrix_operand M>
+            requires std::convertible_to<typename M::value_type, Sum>
+        void assign_parallel(const M &src) {
+            const auto elements = static_cast<std::size_t>(src.rows()) * static_cast<std::size_t>(src.cols());
+            build(src, elements > 10000);
+        }
+
+        // ================================
+        // 查询
+        // ================================
+
+        /**
+         * @brief 获取源矩阵的行数
+         */
+        [[nodiscard]] index_type rows() const noexcept { return table_.rows() - 1; }
+
+        /**
+         * @brief 获取源矩阵的列数
+         */
+        [[nodiscard]] index_type cols() const noexcept { return table_.cols() - 1; }
+
+        /**
+         * @brief 源矩阵是否为空
+         */
+        [[nodiscard]] bool empty() const noexcept { return rows() == 0 || cols() == 0; }
+
+        /**
+         * @brief 计算矩形区域[r0, r1) x [c0, c1)内元素之和
+         *
+         * @param r0 起始行（包含）
+         * @param c0 起始列（包含）
+         * @param r1 结束行（不包含）
+         * @param c1 结束列（不包含）
+         * @return 区域内元素之和，空区域为0
+         *
+         * @throws std::out_of_range 当区域不满足0 <= r0 <= r1 <= rows()且0 <= c0 <= c1 <= cols()时
+         *
+         * @note 时间复杂度O(1)
+         */
+        [[nodiscard]] Sum rect_sum(index_type r0, index_type c0, index_type r1, index_type c1) const {
+            if (std::cmp_less(r0, 0) || r0 > r1 || r1 > rows() || std::cmp_less(c0, 0) || c0 > c1 || c1 > cols()) [[unlikely]] {
+                throw std::out_of_range("rect_sum: rectangle [" + std::to_string(r0) + ", " + std::to_string(r1) +
+                                        ") x [" + std::to_string(c0) + ", " + std::to_string(c1) +
+                                        ") out of range");
+            }
+            return table_(r1, c1) - table_(r0, c1) - table_(r1, c0) + table_(r0, c0);
+        }
+
+        /**
+         * @brief 所有元素之和
+         */
+        [[nodiscard]] Sum total() const noexcept { return table_(rows(), cols()); }
+
+        /**
+         * @brief 获取(rows + 1) x (cols + 1)的前缀和存储，table()(i, j)为[0, i) x [0, j)之和
+         */
+        [[nodiscard]] const table_type &table() const noexcept { return table_; }
+
+    private:
+        table_type table_;
+
+        /**
+         * @brief 行内前缀和：out[0] = 0，out[j + 1] = in[0] + ... + in[j]
+         *
+         * 每4个元素先在组内求前缀，再加上前一组的进位，进位链只有每组一次加法。
+         */
+        template<typename T>
+        static void prefix_row(const T *in, Sum *out, std::size_t count) noexcept {
+            out[0] = Sum{};
+            Sum         carry{};
+            std::size_t j = 0;
+            for (; j + 4 <= count; j += 4) {
+                const Sum p0 = static_cast<Sum>(in[j]);
+                const Sum p1 = p0 + static_cast<Sum>(in[j + 1]);
+                const Sum p2 = p1 + static_cast<Sum>(in[j + 2]);
+                const Sum p3 = p2 + static_cast<Sum>(in[j + 3]);
+                out[j + 1]   = carry + p0;
+                out[j + 2]   = carry + p1;
+                out[j + 3]   = carry + p2;
+                carry        = carry + p3;
+                out[j + 4]   = carry;
+            }
+            for (; j < count; ++j) {
+                carry      = carry + static_cast<Sum>(in[j]);
+                out[j + 1] = carry;
+            }
+        }
+
+        /**
+         * @brief 把上一行的前缀和逐元素累加到当前行
+         */
+        static void accumulate_row(const Sum *prev, Sum *out, std::size_t count) noexcept {
+            QM_IVDEP
+            for (std::size_t j = 0; j < count; ++j) {
+                out[j] += prev[j];
+            }
+        }
+
+        template<typename M>
+        void build(const M &src, bool parallel) {
+            const auto rows = static_cast<std::size_t>(src.rows());
+            const auto cols = static_cast<std::size_t>(src.cols());
+            if (static_cast<std::size_t>(table_.rows()) != rows + 1 || static_cast<std::size_t>(table_.cols()) != cols + 1) {
+                if (rows + 1 > static_cast<std::size_t>(std::numeric_limits<Idx>::max()) ||
+                    cols + 1 > static_cast<std::size_t>(std::numeric_limits<Idx>::max())) [[unlikely]] {
+                    throw std::overflow_error("summed_area_table: table dimensions overflow index type");
+                }
+                table_ = table_type(static_cast<Idx>(rows + 1), static_cast<Idx>(cols + 1), uninitialized);
+            }
+
+            const auto  in_stride  = static_cast<std::size_t>(src.pitch());
+            const auto  out_stride = static_cast<std::size_t>(table_.pitch());
+            const auto *in         = src.data();
+            Sum        *out        = table_.data();
+            std::fill(out, out + cols + 1, Sum{});
+
+            if (!parallel) {
+                // 逐行完成两个阶段，当前行在累加时仍位于L1缓存中
+                for (std::size_t i = 0; i < rows; ++i) {
+                    Sum *row = out + (i + 1) * out_stride;
+                    prefix_row(in + i * in_stride, row, cols);
+                    accumulate_row(row - out_stride, row, cols + 1);
+                }
+                return;
+            }
+
+            detail::parallel_chunks(rows, 1, [&](std::size_t first, std::size_t last) {
+                for (std::size_t i = first; i < last; ++i) {
+                    prefix_row(in + i * in_stride, out + (i + 1) * out_stride, cols);
+                }
+            });
+            detail::parallel_chunks(cols + 1, std::max<std::size_t>(1, 64 / sizeof(Sum)), [&](std::size_t first, std::size_t last) {
+                for (std::size_t i = 1; i <= rows; ++i) {
+                    Sum *row = out + i * out_stride;
+                    accumulate_row(row - out_stride + first, row + first, last - first);
+                }
+            });
+        }
+    };
+
+}  // namespace qm
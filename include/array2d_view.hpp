@@ -0,0 +1,720 @@
+#pragma once
+
+#include "array2d.hpp"
+#include "array2d_expr.hpp"
+#include "array2d_iterator.hpp"
+#include "array2d_simd.hpp"
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace qm {
+
+    // ================================
+    // 概念定义
+    // ================================
+
+    /**
+     * @brief 可被二维视图引用的矩阵类型概念
+     *
+     * 约束类型提供行优先存储的首地址、行数、列数和行距。
+     *
+     * @tparam M 待检验的矩阵类型
+     * @tparam Ty 视图的元素类型
+     */
+    template<typename M, typename Ty>
+    concept Array2d_viewable = requires(M &m) {
+        { m.data() } -> std::convertible_to<Ty *>;
+        { m.rows() } -> std::integral;
+        { m.cols() } -> std::integral;
+        { m.pitch() } -> std::integral;
+    };
+
+    // ================================
+    // array2d_view 类定义
+    // ================================
+
+    /**
+     * @brief 非拥有型二维数组视图
+     *
+     * 引用外部行优先存储（array2d、mmap区域、网络缓冲区等），不进行任何拷贝或分配。
+     * 支持行距（pitch）大于列数的存储，提供与array2d一致的元素访问、迭代器和行操作接口。
+     *
+     * @tparam Ty 元素类型；为const类型时视图只读
+     * @tparam Idx 索引类型，必须满足Array2d_index_type概念，默认为int
+     *
+     * @note 视图不管理被引用存储的生命周期，调用者需保证其在视图使用期间有效
+     * @note array2d可以隐式转换为对应的视图
+     *
+     * @par 示例:
+     * @code
+     * std::vector<float> buffer(rows * cols);
+     * array2d_view<float> view(buffer.data(), rows, cols);  // 零拷贝
+     * view(1, 2) = 3.0f;
+     * @endcode
+     */
+    template<typename Ty, Array2d_index_type Idx = int>
+        requires Array2d_compatible<std::remove_const_t<Ty>>
+    class array2d_view {
+    public:
+        // ================================
+        // 公共类型定义
+        // ================================
+
+        using element_type    = Ty;                        /**< 元素类型（可能带const） */
+        using value_type      = std::remove_cv_t<Ty>;      /**< 值类型 */
+        using index_type      = Idx;                       /**< 索引类型 */
+        using size_type       = std::make_unsigned_t<Idx>; /**< 大小类型 */
+        using difference_type = std::make_signed_t<Idx>;   /**< 差值类型 */
+        using pointer         = Ty *;                      /**< 指针类型 */
+        using const_pointer   = const Ty *;                /**< 常量指针类型 */
+        using reference       = Ty &;                      /**< 引用类型 */
+        using const_reference = const Ty &;                /**< 常量引用类型 */
+
+        using iterator               = Array2d_pitched_iterator<Ty>;          /**< 迭代器类型 */
+        using const_iterator         = Array2d_pitched_iterator<const Ty>;    /**< 常量迭代器类型 */
+        using reverse_iterator       = std::reverse_iterator<iterator>;       /**< 反向迭代器类型 */
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>; /**< 常量反向迭代器类型 */
+
+        /**
+         * @brief 视图是否只读
+         */
+        static constexpr bool is_read_only = std::is_const_v<Ty>;
+
+        // ================================
+        // 构造函数
+        // ================================
+
+        /**
+         * @brief 默认构造函数
+         *
+         * 创建一个空视图（0行0列）。
+         */
+        constexpr array2d_view() noexcept = default;
+
+        /**
+         * @brief 从紧密排列的行优先缓冲区构造视图
+         *
+         * @param data 缓冲区首地址
+         * @param rows 行数，必须非负
+         * @param cols 列数，必须非负
+         *
+         * @throws std::invalid_argument 当行数或列数为负时
+         */
+        constexpr array2d_view(pointer data, index_type rows, index_type cols)
+            : data_(data),
+              rows_(validate_dimension(rows, "rows")),
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(cols_) {}
+
+        /**
+         * @brief 从带行距的行优先缓冲区构造视图
+         *
+         * @param data 缓冲区首地址
+         * @param rows 行数，必须非负
+         * @param cols 列数，必须非负
+         * @param pitch 相邻行首之间的元素距离，必须不小于列数
+         *
+         * @throws std::invalid_argument 当行数或列数为负，或行距小于列数时
+         */
+        constexpr array2d_view(pointer data, index_type rows, index_type cols, row_pitch pitch)
+            : data_(data),
+              rows_(validate_dimension(rows, "rows")),
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(validate_pitch(pitch, cols_)) {}
+
+        /**
+         * @brief 从矩阵对象隐式构造视图
+         *
+         * @tparam Matrix 矩阵类型，例如array2d
+         * @param matrix 被引用的矩阵（必须是左值，避免引用临时对象）
+         *
+         * @note 视图沿用矩阵的行距，因此对pitched_layout同样适用
+         */
+        template<typename Matrix>
+            requires Array2d_viewable<Matrix, Ty> &&
+                     (!std::same_as<std::remove_cv_t<Matrix>, array2d_view>)
+        constexpr array2d_view(Matrix &matrix) noexcept
+            : data_(matrix.data()),
+              rows_(static_cast<index_type>(matrix.rows())),
+              cols_(static_cast<index_type>(matrix.cols())),
+              pitch_(static_cast<index_type>(matrix.pitch())) {}
+
+        /**
+         * @brief 从可写视图到只读视图的转换构造
+         *
+         * @tparam U 源视图的元素类型
+         * @param other 源视图
+         */
+        template<typename U>
+            requires(!std::same_as<U, Ty> && std::convertible_to<U *, Ty *>)
+        constexpr array2d_view(const array2d_view<U, Idx> &other) noexcept
+            : data_(other.data()), rows_(other.rows()), cols_(other.cols()), pitch_(other.pitch()) {}
+
+        // ================================
+        // 元素访问方法
+        // ================================
+
+        /**
+         * @brief 行访问操作符
+         *
+         * @param row 行索引
+         * @return 指向指定行首元素的指针
+         *
+         * @note 不进行边界检查（在调试模式下使用断言）
+         */
+        [[nodiscard]] QM_FORCEINLINE constexpr pointer operator[](index_type row) const noexcept {
+            assert_bounds(row, rows_);
+            return data_ + calculate_offset(row, 0);
+        }
+
+        /**
+         * @brief 二维索引访问操作符
+         *
+         * @param row 行索引
+         * @param col 列索引
+         * @return 指定位置元素的引用
+         *
+         * @note 不进行边界检查（在调试模式下使用断言）
+         */
+        [[nodiscard]] QM_FORCEINLINE constexpr reference operator()(index_type row, index_type col) const noexcept {
+            assert_bounds(row, rows_);
+            assert_bounds(col, cols_);
+            return data_[calculate_offset(row, col)];
+        }
+
+        /**
+         * @brief 带边界检查的元素访问
+         *
+         * @param row 行索引
+         * @param col 列索引
+         * @return 指定位置元素的引用
+         *
+         * @throws std::out_of_range 当索引超出边界时
+         */
+        [[nodiscard]] constexpr reference at(index_type row, index_type col) const {
+            if (row < 0 || row >= rows_ || col < 0 || col >= cols_) [[unlikely]] {
+                throw std::out_of_range("array2d_view: index (" + std::to_string(row) + ", " +
+                                        std::to_string(col) + ") out of range [0, " + std::to_string(rows_) +
+                                        ") x [0, " + std::to_string(cols_) + ")");
+            }
+            return data_[calculate_offset(row, col)];
+        }
+
+        // ================================
+        // 迭代器支持
+        // ================================
+
+        [[nodiscard]] constexpr iterator begin() const noexcept {
+            return iterator(data_, 0, cols_, pitch_);
+        }
+
+        [[nodiscard]] constexpr iterator end() const noexcept {
+            // 空视图的尾后迭代器与首迭代器相同，避免对空指针做偏移
+            return cols_ == 0 ? begin() : iterator(data_ + calculate_offset(rows_, 0), 0, cols_, pitch_);
+        }
+
+        [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return const_iterator(begin()); }
+
+        [[nodiscard]] constexpr const_iterator cend() const noexcept { return const_iterator(end()); }
+
+        [[nodiscard]] constexpr reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+
+        [[nodiscard]] constexpr reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+        [[nodiscard]] constexpr const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+
+        [[nodiscard]] constexpr const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
+
+        /**
+         * @brief 行迭代器包装器
+         *
+         * 提供对单行元素的迭代器访问。
+         */
+        struct row_iterator_wrapper {
+            pointer   ptr_;  /**< 指向行首的指针 */
+            size_type cols_; /**< 列数 */
+
+            [[nodiscard]] Array2d_iterator<Ty> begin() const noexcept { return Array2d_iterator<Ty>(ptr_); }
+
+            [[nodiscard]] Array2d_iterator<Ty> end() const noexcept { return Array2d_iterator<Ty>(ptr_ + cols_); }
+        };
+
+        /**
+         * @brief 获取指定行的迭代器范围
+         *
+         * @param row 行索引
+         * @return 行迭代器包装器，可用于范围for循环
+         */
+        [[nodiscard]] row_iterator_wrapper row_range(index_type row) const noexcept {
+            assert_bounds(row, rows_);
+            return {data_ + calculate_offset(row, 0), static_cast<size_type>(cols_)};
+        }
+
+        // ================================
+        // 尺寸查询
+        // ================================
+
+        [[nodiscard]] constexpr index_type rows() const noexcept { return rows_; }
+
+        [[nodiscard]] constexpr index_type cols() const noexcept { return cols_; }
+
+        /**
+         * @brief 获取行距
+         * @return 相邻行首之间的元素距离
+         */
+        [[nodiscard]] constexpr index_type pitch() const noexcept { return pitch_; }
+
+        [[nodiscard]] constexpr size_type size() const noexcept {
+            return static_cast<size_type>(rows_) * static_cast<size_type>(cols_);
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept { return rows_ == 0 || cols_ == 0; }
+
+        [[nodiscard]] constexpr bool is_square() const noexcept { return rows_ == cols_; }
+
+        /**
+         * @brief 检查视图覆盖的元素是否连续存储
+         * @return 行距等于列数（或只有一行）时返回true
+         */
+        [[nodiscard]] constexpr bool is_contiguous() const noexcept { return pitch_ == cols_ || rows_ <= 1; }
+
+        /**
+         * @brief 获取视图首元素指针
+         */
+        [[nodiscard]] constexpr pointer data() const noexcept { return data_; }
+
+        // ================================
+        // span 操作
+        // ================================
+
+        /**
+         * @brief 获取视图覆盖的所有元素的span
+         * @return 覆盖所有元素的span
+         *
+         * @throws std::invalid_argument 当视图不连续（行距大于列数且多于一行）时
+         */
+        [[nodiscard]] constexpr std::span<Ty> as_span() const {
+            if (!is_contiguous()) [[unlikely]] {
+                throw std::invalid_argument("as_span: view is not contiguous");
+            }
+            return {data_, size()};
+        }
+
+        /**
+         * @brief 获取指定行的span视图
+         *
+         * @param row 行索引
+         * @return 覆盖指定行所有元素的span
+         */
+        [[nodiscard]] constexpr std::span<Ty> row(index_type row) const noexcept {
+            assert_bounds(row, rows_);
+            return {data_ + calculate_offset(row, 0), static_cast<size_type>(cols_)};
+        }
+
+        /**
+         * @brief 获取指定列的所有元素
+         *
+         * @param col 列索引
+         * @return 包含指定列所有元素的vector
+         *
+         * @note 只需遍历时请使用不分配内存的col_view()
+         */
+        [[nodiscard]] std::vector<value_type> col(index_type col) const {
+            assert_bounds(col, cols_);
+            std::vector<value_type> result;
+            result.reserve(static_cast<size_type>(rows_));
+
+            for (index_type i = 0; i < rows_; ++i) {
+                result.push_back(data_[calculate_offset(i, col)]);
+            }
+            return result;
+        }
+
+        /**
+         * @brief 获取指定列的零拷贝视图
+         *
+         * @param col 列索引
+         * @return 按行距跨步访问该列的随机访问范围
+         *
+         * @note 不进行边界检查（在调试模式下使用断言）
+         */
+        [[nodiscard]] constexpr array2d_column<Ty> col_view(index_type col) const noexcept {
+            assert_bounds(col, cols_);
+            return {data_ + col, static_cast<size_type>(rows_), pitch_};
+        }
+
+        /**
+         * @brief 获取矩形子块的嵌套视图
+         *
+         * @param start_row 起始行索引（相对于本视图）
+         * @param start_col 起始列索引（相对于本视图）
+         * @param num_rows 行数
+         * @param num_cols 列数
+         * @return 引用子块的视图，行距与本视图相同
+         *
+         * @throws std::out_of_range 当子块超出视图边界时
+         *
+         * @note 不拷贝任何数据，可以任意层级地嵌套
+         */
+        [[nodiscard]] constexpr array2d_view submatrix(index_type start_row, index_type start_col,
+                                                       index_type num_rows, index_type num_cols) const {
+            if (start_row < 0 || start_col < 0 || num_rows < 0 || num_cols < 0 ||
+                start_row > rows_ - num_rows || start_col > cols_ - num_cols) [[unlikely]] {
+                throw std::out_of_range("array2d_view: block (" + std::to_string(start_row) + ", " +
+                                        std::to_string(start_col) + ") + " + std::to_string(num_rows) + "x" +
+                                        std::to_string(num_cols) + " out of range " + std::to_string(rows_) +
+                                        "x" + std::to_string(cols_));
+            }
+            return array2d_view(data_ + calculate_offset(start_row, start_col), num_rows, num_cols,
+                                row_pitch{static_cast<std::size_t>(pitch_)});
+        }
+
+        // ================================
+        // 数据操作
+        // ================================
+
+        /**
+         * @brief 重置视图覆盖的所有元素
+         *
+         * @param opt 重置选项，默认为All_bits0
+         *
+         * @note 对POD类型逐行使用向量化的字节填充内核，连续视图一次填充
+         * @note 只写入视图内的元素，行距中的其他元素保持不变
+         */
+        void reset(Array_reset_opt opt = Array_reset_opt::All_bits0) const
+                noexcept(std::is_nothrow_default_constructible_v<value_type> &&
+                         std::is_nothrow_move_assignable_v<value_type>)
+            requires(!is_read_only)
+        {
+            if (empty()) return;
+
+            if constexpr (std::is_trivially_destructible_v<value_type> &&
+                          std::is_trivially_default_constructible_v<value_type> &&
+                          std::is_standard_layout_v<value_type>) {
+                const auto byte = static_cast<unsigned char>(opt);
+                if (is_contiguous()) {
+                    simd::fill_bytes(data_, byte, size() * sizeof(value_type));
+                    return;
+                }
+                // 与fill()一致，按视图的总写入量决定是否使用非临时写入
+                const auto row_bytes = static_cast<std::size_t>(cols_) * sizeof(value_type);
+                const bool streaming = row_bytes * static_cast<std::size_t>(rows_) >= simd::streaming_threshold;
+                for (index_type i = 0; i < rows_; ++i) {
+                    simd::fill_pattern(data_ + calculate_offset(i, 0), row_bytes, &byte, 1, streaming);
+                }
+            } else {
+                for (index_type i = 0; i < rows_; ++i) {
+                    std::fill_n(data_ + calculate_offset(i, 0), cols_, value_type{});
+                }
+            }
+        }
+
+        /**
+         * @brief 用指定值填充视图覆盖的所有元素
+         *
+         * @param val 用于填充的值
+         *
+         * @note 只写入视图内的元素，行距中的其他元素保持不变
+         */
+        void fill(const value_type &val) const noexcept(std::is_nothrow_copy_assignable_v<value_type>)
+            requires(!is_read_only)
+        {
+            if constexpr (simd::Fill_pattern_type<value_type>) {
+                if (is_contiguous()) {
+                    simd::fill(data_, size(), val);
+                    return;
+                }
+                const auto row_bytes = static_cast<std::size_t>(cols_) * sizeof(value_type);
+                const bool streaming = row_bytes * static_cast<std::size_t>(rows_) >= simd::streaming_threshold;
+                for (index_type i = 0; i < rows_; ++i) {
+                    simd::fill_pattern(data_ + calculate_offset(i, 0), row_bytes, &val, sizeof(value_type), streaming);
+                }
+            } else {
+                if (is_contiguous()) {
+                    std::fill_n(data_, size(), val);
+                    return;
+                }
+                for (index_type i = 0; i < rows_; ++i) {
+                    std::fill_n(data_ + calculate_offset(i, 0), cols_, val);
+                }
+            }
+        }
+
+        /**
+         * @brief 将逐元素表达式的结果写入视图覆盖的元素
+         *
+         * @param expr 与视图同尺寸的表达式
+         *
+         * @throws std::invalid_argument 当表达式与本视图尺寸不同时
+         *
+         * @note 单次遍历求值，行距中视图外的元素保持不变
+         *
+         * @par 示例
+         * @code
+         * auto block = m.submatrix(1, 1, 4, 4);
+         * block.assign(qm::clamp(block * 2.0, 0.0, 1.0));
+         * @endcode
+         */
+        template<Array2d_expression_node E>
+            requires std::convertible_to<typename E::value_type, value_type>
+        void assign(const E &expr) const
+            requires(!is_read_only)
+        {
+            if (expr.rows() != static_cast<std::size_t>(rows_) || expr.cols() != static_cast<std::size_t>(cols_))
+                    [[unlikely]] {
+                throw std::invalid_argument("assign: expression dimensions don't match view dimensions");
+            }
+            evaluate_expression(data_, static_cast<std::size_t>(pitch_), expr);
+        }
+
+        /**
+         * @brief 从另一个同尺寸视图逐元素复制
+         *
+         * @param src 源视图（array2d及可写视图均可隐式转换）
+         *
+         * @throws std::invalid_argument 当源与本视图尺寸不同时
+         *
+         * @note 源与目标重叠时结果与先拷贝到临时缓冲区一致：行距相同时按安全方向逐行复制，
+         *       行距不同时确实经由临时缓冲区复制
+         */
+        void copy_from(array2d_view<const value_type, Idx> src) const
+            requires(!is_read_only)
+        {
+            if (src.rows() != rows_ || src.cols() != cols_) [[unlikely]] {
+                throw std::invalid_argument("copy_from: source dimensions don't match view dimensions");
+            }
+            if (empty() || (src.data() == data_ && src.pitch() == pitch_)) return;
+
+            if (src.pitch() != pitch_) {
+                // 行距不同时逐行的安全方向不存在，重叠的区间先复制到临时缓冲区
+                const auto span_end = [](const auto *first, index_type pitch, index_type rows, index_type cols) {
+                    return first + static_cast<size_type>(rows - 1) * static_cast<size_type>(pitch) +
+                           static_cast<size_type>(cols);
+                };
+                const value_type *dst_first = data_;
+                const auto        overlaps  = std::less<>{}(src.data(), span_end(dst_first, pitch_, rows_, cols_)) &&
+                                              std::less<>{}(dst_first, span_end(src.data(), src.pitch(), rows_, cols_));
+                if (overlaps) {
+                    std::vector<std::remove_cv_t<value_type>> buffer;
+                    buffer.reserve(static_cast<size_type>(rows_) * static_cast<size_type>(cols_));
+                    for (index_type i = 0; i < rows_; ++i) buffer.insert(buffer.end(), src[i], src[i] + cols_);
+                    for (index_type i = 0; i < rows_; ++i) {
+                        std::copy_n(buffer.data() + static_cast<size_type>(i) * static_cast<size_type>(cols_), cols_,
+                                    data_ + calculate_offset(i, 0));
+                    }
+                } else {
+                    for (index_type i = 0; i < rows_; ++i) std::copy_n(src[i], cols_, data_ + calculate_offset(i, 0));
+                }
+                return;
+            }
+
+            const auto copy_one = [&](index_type i) {
+                const auto from = src[i];
+                const auto to   = data_ + calculate_offset(i, 0);
+                if constexpr (std::is_trivially_copyable_v<value_type>) {
+                    std::memmove(to, from, static_cast<size_type>(cols_) * sizeof(value_type));
+                } else if (to < from) {
+                    std::copy_n(from, cols_, to);
+                } else {
+                    std::copy_backward(from, from + cols_, to + cols_);
+                }
+            };
+
+            // 目标位于源之后时自下而上复制，避免覆盖尚未读取的源行
+            if (std::less<>{}(src.data(), data_)) {
+                for (index_type i = rows_; i-- > 0;) copy_one(i);
+            } else {
+                for (index_type i = 0; i < rows_; ++i) copy_one(i);
+            }
+        }
+
+        /**
+         * @brief 用指定值填充一行
+         *
+         * @param row 行索引
+         * @param val 用于填充的值
+         */
+        void fill_row(index_type row, const value_type &val) const
+                noexcept(std::is_nothrow_copy_assignable_v<value_type>)
+            requires(!is_read_only)
+        {
+            assert_bounds(row, rows_);
+            std::fill_n(data_ + calculate_offset(row, 0), cols_, val);
+        }
+
+        /**
+         * @brief 复制一行到另一行
+         *
+         * @param src_row 源行索引
+         * @param dest_row 目标行索引
+         */
+        void copy_row(index_type src_row, index_type dest_row) const
+                noexcept(std::is_nothrow_copy_assignable_v<value_type>)
+            requires(!is_read_only)
+        {
+            assert_bounds(src_row, rows_);
+            assert_bounds(dest_row, rows_);
+
+            if (src_row == dest_row) return;
+
+            const auto src  = data_ + calculate_offset(src_row, 0);
+            const auto dest = data_ + calculate_offset(dest_row, 0);
+            if constexpr (std::is_trivially_copyable_v<value_type>) {
+                std::memcpy(dest, src, static_cast<size_type>(cols_) * sizeof(value_type));
+            } else {
+                std::copy_n(src, cols_, dest);
+            }
+        }
+
+        /**
+         * @brief 交换两行
+         *
+         * @param row1 第一行索引
+         * @param row2 第二行索引
+         */
+        void swap_rows(index_type row1, index_type row2) const noexcept(std::is_nothrow_swappable_v<value_type>)
+            requires(!is_read_only)
+        {
+            assert_bounds(row1, rows_);
+            assert_bounds(row2, rows_);
+
+            if (row1 == row2) return;
+            if constexpr (std::is_trivially_copyable_v<value_type>) {
+                simd::swap_bytes(data_ + calculate_offset(row1, 0), data_ + calculate_offset(row2, 0),
+                                 static_cast<std::size_t>(cols_) * sizeof(value_type));
+            } else {
+                std::swap_ranges(data_ + calculate_offset(row1, 0), data_ + calculate_offset(row1, cols_),
+                                 data_ + calculate_offset(row2, 0));
+            }
+        }
+
+        /**
+         * @brief 就地转置视图覆盖的方阵
+         *
+         * @throws std::invalid_argument 当视图不是方阵时
+         */
+        void transpose() const
+            requires(!is_read_only)
+        {
+            if (!is_square()) {
+                throw std::invalid_argument("transpose: view must be square for in-place transpose");
+            }
+            for (index_type i = 0; i < rows_; ++i) {
+                for (index_type j = i + 1; j < cols_; ++j) {
+                    using std::swap;
+                    swap((*this)(i, j), (*this)(j, i));
+                }
+            }
+        }
+
+        /**
+         * @brief 返回转置后的新矩阵
+         *
+         * @return 拥有存储的cols() x rows()矩阵
+         *
+         * @note 使用与array2d::transposed()相同的缓存无关分块算法，支持任意尺寸和行距
+         */
+        [[nodiscard]] array2d<value_type, Idx> transposed() const {
+            auto result = [&] {
+                if constexpr (std::is_trivially_default_constructible_v<value_type>) {
+                    return array2d<value_type, Idx>(cols_, rows_, uninitialized);
+                } else {
+                    return array2d<value_type, Idx>(cols_, rows_);
+                }
+            }();
+            simd::transpose<value_type>(data_, static_cast<std::size_t>(pitch_), result.data(),
+                                        static_cast<std::size_t>(result.pitch()), static_cast<std::size_t>(rows_),
+                                        static_cast<std::size_t>(cols_));
+            return result;
+        }
+
+        // ================================
+        // 比较操作符
+        // ================================
+
+        /**
+         * @brief 逐元素相等比较
+         *
+         * @param other 另一个视图
+         * @return 尺寸相同且对应元素相等时返回true
+         */
+        template<typename U>
+        [[nodiscard]] bool operator==(const array2d_view<U, Idx> &other) const
+            requires std::equality_comparable_with<const value_type &, const std::remove_cv_t<U> &>
+        {
+            return rows_ == other.rows() && cols_ == other.cols() && std::equal(begin(), end(), other.begin());
+        }
+
+    private:
+        // ================================
+        // 私有辅助方法
+        // ================================
+
+        static constexpr index_type validate_dimension(index_type dim, const char *name) {
+            if (dim < 0) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + " must be non-negative");
+            }
+            return dim;
+        }
+
+        static constexpr index_type validate_pitch(row_pitch pitch, index_type cols) {
+            if (pitch.value < static_cast<std::size_t>(cols) ||
+                pitch.value > static_cast<std::size_t>(std::numeric_limits<index_type>::max())) [[unlikely]] {
+                throw std::invalid_argument("pitch must not be smaller than cols");
+            }
+            return static_cast<index_type>(pitch.value);
+        }
+
+        constexpr size_type calculate_offset(index_type row, index_type col) const noexcept {
+            return static_cast<size_type>(row) * static_cast<size_type>(pitch_) + static_cast<size_type>(col);
+        }
+
+        static constexpr void assert_bounds([[maybe_unused]] index_type index,
+                                            [[maybe_unused]] index_type limit) noexcept {
+#ifdef _DEBUG
+            assert(index >= 0 && index < limit);
+#endif
+        }
+
+        pointer    data_ = nullptr; /**< 首元素指针 */
+        index_type rows_{};         /**< 行数 */
+        index_type cols_{};         /**< 列数 */
+        index_type pitch_{};        /**< 行距 */
+    };
+
+    // ================================
+    // 类模板参数推导指引
+    // ================================
+
+    /**
+     * @brief 从指针和尺寸推导视图类型
+     */
+    template<typename Ty, Array2d_index_type IndexType>
+    array2d_view(Ty *, IndexType, IndexType) -> array2d_view<Ty, IndexType>;
+
+    /**
+     * @brief 从指针、尺寸和行距推导视图类型
+     */
+    template<typename Ty, Array2d_index_type IndexType>
+    array2d_view(Ty *, IndexType, IndexType, row_pitch) -> array2d_view<Ty, IndexType>;
+
+    /**
+     * @brief 从矩阵对象推导视图类型
+     *
+     * 常量矩阵推导出只读视图。
+     */
+    template<typename Matrix>
+        requires requires { typename Matrix::index_type; }
+    array2d_view(Matrix &) -> array2d_view<std::remove_pointer_t<decltype(std::declval<Matrix &>().data())>,
+                                           typename Matrix::index_type>;
+
+}  // namespace qm
@@ -1,19 +1,111 @@
 #pragma once
 #include <algorithm>
+#include <atomic>
 #include <bit>
+#include <cassert>
+#include <cmath>
 #include <compare>
 #include <concepts>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
-#include <execution>
+#include <exception>
+#include <functional>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <numeric>
 #include <optional>
+#include <ranges>
 #include <span>
 #include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
+namespace qm {
+    template<typename T, std::size_t Align>
+    class aligned_allocator {
+        static_assert(Align > 0 && (Align & (Align - 1)) == 0, "aligned_allocator: Align must be a power of two");
+    public:
+        using value_type                             = T;
+        using size_type                              = std::size_t;
+        using difference_type                        = std::ptrdiff_t;
+        using propagate_on_container_move_assignment = std::true_type;
+        using is_always_equal                        = std::true_type;
+        static constexpr std::size_t alignment = Align > alignof(T) ? Align : alignof(T);
+        template<typename U>
+        struct rebind {
+            using other = aligned_allocator<U, Align>;
+        };
+        constexpr aligned_allocator() noexcept = default;
+        template<typename U>
+        constexpr aligned_allocator(const aligned_allocator<U, Align> &) noexcept {}
+        [[nodiscard]] T *allocate(size_type n) {
+            if (n > std::numeric_limits<size_type>::max() / sizeof(T)) [[unlikely]] {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{alignment}));
+        }
+        void deallocate(T *p, size_type n) noexcept {
+            ::operator delete(p, n * sizeof(T), std::align_val_t{alignment});
+        }
+        template<typename U>
+        [[nodiscard]] constexpr bool operator==(const aligned_allocator<U, Align> &) const noexcept {
+            return true;
+        }
+    };
+    template<std::size_t Align>
+    using aligned = aligned_allocator<std::byte, Align>;
+    template<typename A>
+    class default_init_allocator : public A {
+        using traits = std::allocator_traits<A>;
+    public:
+        template<typename U>
+        struct rebind {
+            using other = default_init_allocator<typename traits::template rebind_alloc<U>>;
+        };
+        using A::A;
+        constexpr default_init_allocator() noexcept(noexcept(A())) = default;
+        constexpr default_init_allocator(const A &alloc) noexcept : A(alloc) {}
+        template<typename B>
+        constexpr default_init_allocator(const default_init_allocator<B> &other) noexcept
+            : A(static_cast<const B &>(other)) {}
+        template<typename U>
+        void construct(U *p) noexcept(std::is_nothrow_default_constructible_v<U>) {
+            if constexpr (std::is_trivially_default_constructible_v<U>) {
+                ::new (static_cast<void *>(p)) U;
+            } else {
+                traits::construct(static_cast<A &>(*this), p);
+            }
+        }
+        template<typename U, typename... Args>
+        void construct(U *p, Args &&...args) {
+            traits::construct(static_cast<A &>(*this), p, std::forward<Args>(args)...);
+        }
+        [[nodiscard]] default_init_allocator select_on_container_copy_construction() const {
+            return default_init_allocator(traits::select_on_container_copy_construction(static_cast<const A &>(*this)));
+        }
+        [[nodiscard]] friend bool operator==(const default_init_allocator &lhs,
+                                             const default_init_allocator &rhs) noexcept {
+            return static_cast<const A &>(lhs) == static_cast<const A &>(rhs);
+        }
+    };
+    template<typename Alloc>
+    struct allocator_alignment
+        : std::integral_constant<std::size_t, alignof(typename std::allocator_traits<Alloc>::value_type)> {};
+    template<typename Alloc>
+        requires requires { { Alloc::alignment } -> std::convertible_to<std::size_t>; }
+    struct allocator_alignment<Alloc> : std::integral_constant<std::size_t, Alloc::alignment> {};
+    template<typename Alloc>
+    inline constexpr std::size_t allocator_alignment_v = allocator_alignment<Alloc>::value;
+}  // namespace qm
 #ifndef QM_FORCEINLINE_DEFINED
 #define QM_FORCEINLINE_DEFINED
 #if defined(_MSC_VER)
@@ -124,7 +216,223 @@ namespace qm {
             const Array2d_iterator<T>                    &iter) noexcept {
         return iter + offset;
     }
-    template<typename T>
+    template<Array2d_iterator_compatible T>
+    class Array2d_pitched_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept  = std::random_access_iterator_tag;
+        using value_type        = std::remove_cv_t<T>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = T *;
+        using reference         = T &;
+        constexpr Array2d_pitched_iterator() noexcept = default;
+        constexpr Array2d_pitched_iterator(pointer row, difference_type col,
+                                           difference_type cols, difference_type pitch) noexcept
+            : row_(row), col_(col), cols_(cols), pitch_(pitch) {}
+        template<Array2d_iterator_compatible U>
+        constexpr explicit Array2d_pitched_iterator(const Array2d_pitched_iterator<U> &other) noexcept
+            requires std::convertible_to<U *, T *>
+            : row_(other.row_data()), col_(other.column()), cols_(other.columns()), pitch_(other.pitch()) {}
+        [[nodiscard]] QM_FORCEINLINE constexpr reference operator*() const noexcept {
+            return row_[col_];
+        }
+        [[nodiscard]] QM_FORCEINLINE constexpr pointer operator->() const noexcept {
+            return row_ + col_;
+        }
+        QM_FORCEINLINE constexpr Array2d_pitched_iterator &operator++() noexcept {
+            if (++col_ == cols_) {
+                col_ = 0;
+                row_ += pitch_;
+            }
+            return *this;
+        }
+        QM_FORCEINLINE constexpr Array2d_pitched_iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        QM_FORCEINLINE constexpr Array2d_pitched_iterator &operator--() noexcept {
+            if (col_ == 0) {
+                col_ = cols_;
+                row_ -= pitch_;
+            }
+            --col_;
+            return *this;
+        }
+        QM_FORCEINLINE constexpr Array2d_pitched_iterator operator--(int) noexcept {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
+        constexpr auto operator+=(const difference_type offset) noexcept -> Array2d_pitched_iterator & {
+            if (cols_ == 0) return *this;
+            auto linear   = col_ + offset;
+            auto row_step = linear / cols_;
+            linear %= cols_;
+            if (linear < 0) {
+                linear += cols_;
+                --row_step;
+            }
+            row_ += row_step * pitch_;
+            col_ = linear;
+            return *this;
+        }
+        [[nodiscard]] constexpr auto operator+(const difference_type offset) const noexcept -> Array2d_pitched_iterator {
+            auto tmp = *this;
+            return tmp += offset;
+        }
+        constexpr auto operator-=(const difference_type offset) noexcept -> Array2d_pitched_iterator & {
+            return *this += -offset;
+        }
+        [[nodiscard]] constexpr auto operator-(const difference_type offset) const noexcept -> Array2d_pitched_iterator {
+            auto tmp = *this;
+            return tmp -= offset;
+        }
+        [[nodiscard]] constexpr auto operator-(const Array2d_pitched_iterator &other) const noexcept -> difference_type {
+            const auto row_diff = pitch_ == 0 ? 0 : (row_ - other.row_) / pitch_;
+            return row_diff * cols_ + (col_ - other.col_);
+        }
+        [[nodiscard]] constexpr auto operator[](const difference_type offset) const noexcept -> reference {
+            return *(*this + offset);
+        }
+        [[nodiscard]] constexpr std::strong_ordering operator<=>(const Array2d_pitched_iterator &other) const noexcept {
+            if (auto cmp = row_ <=> other.row_; cmp != 0) return cmp;
+            return col_ <=> other.col_;
+        }
+        [[nodiscard]] QM_FORCEINLINE constexpr bool operator==(const Array2d_pitched_iterator &other) const noexcept {
+            return row_ == other.row_ && col_ == other.col_;
+        }
+        [[nodiscard]] constexpr pointer row_data() const noexcept { return row_; }
+        [[nodiscard]] constexpr difference_type column() const noexcept { return col_; }
+        [[nodiscard]] constexpr difference_type columns() const noexcept { return cols_; }
+        [[nodiscard]] constexpr difference_type pitch() const noexcept { return pitch_; }
+
+    private:
+        pointer         row_   = nullptr;
+        difference_type col_   = 0;
+        difference_type cols_  = 0;
+        difference_type pitch_ = 0;
+    };
+    template<Array2d_iterator_compatible T>
+    [[nodiscard]] constexpr Array2d_pitched_iterator<T> operator+(
+            typename Array2d_pitched_iterator<T>::difference_type offset,
+            const Array2d_pitched_iterator<T>                    &iter) noexcept {
+        return iter + offset;
+    }
+    template<Array2d_iterator_compatible T>
+    class Array2d_strided_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept  = std::random_access_iterator_tag;
+        using value_type        = std::remove_cv_t<T>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = T *;
+        using reference         = T &;
+        constexpr Array2d_strided_iterator() noexcept = default;
+        constexpr Array2d_strided_iterator(pointer first, difference_type index, difference_type stride) noexcept
+            : first_(first), index_(index), stride_(stride) {}
+        constexpr Array2d_strided_iterator(pointer first, difference_type stride) noexcept
+            : Array2d_strided_iterator(first, 0, stride) {}
+        template<Array2d_iterator_compatible U>
+        constexpr Array2d_strided_iterator(const Array2d_strided_iterator<U> &other) noexcept
+            requires std::convertible_to<U *, T *>
+            : first_(other.first()), index_(other.index()), stride_(other.stride()) {}
+        [[nodiscard]] QM_FORCEINLINE constexpr reference operator*() const noexcept {
+            return first_[index_ * stride_];
+        }
+        [[nodiscard]] QM_FORCEINLINE constexpr pointer operator->() const noexcept {
+            return first_ + index_ * stride_;
+        }
+        QM_FORCEINLINE constexpr Array2d_strided_iterator &operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        QM_FORCEINLINE constexpr Array2d_strided_iterator operator++(int) noexcept {
+            auto tmp = *this;
+            ++index_;
+            return tmp;
+        }
+        QM_FORCEINLINE constexpr Array2d_strided_iterator &operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        QM_FORCEINLINE constexpr Array2d_strided_iterator operator--(int) noexcept {
+            auto tmp = *this;
+            --index_;
+            return tmp;
+        }
+        QM_FORCEINLINE constexpr auto operator+=(const difference_type offset) noexcept -> Array2d_strided_iterator & {
+            index_ += offset;
+            return *this;
+        }
+        [[nodiscard]] QM_FORCEINLINE constexpr auto operator+(const difference_type offset) const noexcept
+                -> Array2d_strided_iterator {
+            return {first_, index_ + offset, stride_};
+        }
+        QM_FORCEINLINE constexpr auto operator-=(const difference_type offset) noexcept -> Array2d_strided_iterator & {
+            index_ -= offset;
+            return *this;
+        }
+        [[nodiscard]] QM_FORCEINLINE constexpr auto operator-(const difference_type offset) const noexcept
+                -> Array2d_strided_iterator {
+            return {first_, index_ - offset, stride_};
+        }
+        [[nodiscard]] QM_FORCEINLINE constexpr auto operator-(const Array2d_strided_iterator &other) const noexcept
+                -> difference_type {
+            return index_ - other.index_;
+        }
+        [[nodiscard]] QM_FORCEINLINE constexpr auto operator[](const difference_type offset) const noexcept -> reference {
+            return first_[(index_ + offset) * stride_];
+        }
+        [[nodiscard]] constexpr std::strong_ordering operator<=>(const Array2d_strided_iterator &other) const noexcept {
+            return index_ <=> other.index_;
+        }
+        [[nodiscard]] QM_FORCEINLINE constexpr bool operator==(const Array2d_strided_iterator &other) const noexcept {
+            return index_ == other.index_;
+        }
+        [[nodiscard]] constexpr pointer base() const noexcept { return first_ + index_ * stride_; }
+        [[nodiscard]] constexpr pointer first() const noexcept { return first_; }
+        [[nodiscard]] constexpr difference_type index() const noexcept { return index_; }
+        [[nodiscard]] constexpr difference_type stride() const noexcept { return stride_; }
+
+    private:
+        pointer         first_  = nullptr;
+        difference_type index_  = 0;
+        difference_type stride_ = 0;
+    };    template<Array2d_iterator_compatible T>
+    [[nodiscard]] constexpr Array2d_strided_iterator<T> operator+(
+            typename Array2d_strided_iterator<T>::difference_type offset,
+            const Array2d_strided_iterator<T>                    &iter) noexcept {
+        return iter + offset;
+    }
+    template<Array2d_iterator_compatible T>
+    class array2d_column : public std::ranges::view_interface<array2d_column<T>> {
+    public:
+        using value_type      = std::remove_cv_t<T>;
+        using size_type       = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer         = T *;
+        using reference       = T &;
+        using iterator        = Array2d_strided_iterator<T>;
+        constexpr array2d_column() noexcept = default;
+        constexpr array2d_column(pointer first, size_type size, difference_type stride) noexcept
+            : first_(first), size_(size), stride_(stride) {}
+        template<Array2d_iterator_compatible U>
+        constexpr array2d_column(const array2d_column<U> &other) noexcept
+            requires std::convertible_to<U *, T *>
+            : first_(other.begin().first()), size_(other.size()), stride_(other.stride()) {}
+        [[nodiscard]] constexpr iterator begin() const noexcept { return {first_, 0, stride_}; }
+        [[nodiscard]] constexpr iterator end() const noexcept {
+            return {first_, static_cast<difference_type>(size_), stride_};
+        }
+        [[nodiscard]] constexpr size_type size() const noexcept { return size_; }
+        [[nodiscard]] constexpr difference_type stride() const noexcept { return stride_; }
+
+    private:
+        pointer         first_  = nullptr;
+        size_type       size_   = 0;
+        difference_type stride_ = 0;
+    };    template<typename T>
     struct is_array2d_iterator : std::false_type {};
     template<Array2d_iterator_compatible T>
     struct is_array2d_iterator<Array2d_iterator<T>> : std::true_type {};
@@ -165,455 +473,4496 @@ namespace std {
         }
     };
 }  // namespace std
-#ifndef QM_ARRAY_RESET_OPT_DEFINED
-#define QM_ARRAY_RESET_OPT_DEFINED
-namespace qm {
-    enum class Array_reset_opt : std::int8_t {
-        All_bits0 = 0,
-        All_bits1 = -1,
-        Safe_max  = 0x3F
+#if !defined(QM_ARRAY2D_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define QM_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define QM_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define QM_SIMD_TARGET(isa)
+#endif
+#if defined(__clang__)
+#define QM_IVDEP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define QM_IVDEP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+#define QM_IVDEP __pragma(loop(ivdep))
+#else
+#define QM_IVDEP
+#endif
+#ifndef QM_ARRAY2D_STREAMING_THRESHOLD
+#define QM_ARRAY2D_STREAMING_THRESHOLD (std::size_t{8} << 20)
+#endif
+namespace qm::simd {
+    enum class isa : std::uint8_t {
+        scalar,
+        sse2,
+        avx2,
+        avx512
     };
-    template<typename T>
-    concept Array2d_compatible =
-            std::is_object_v<T> &&
-            !std::is_abstract_v<T> &&
-            requires { sizeof(T); };
-    template<typename Idx>
-    concept Array2d_index_type =
-            std::is_integral_v<Idx> &&
-            !std::is_same_v<Idx, bool> &&
-            !std::is_same_v<Idx, char>;
-    template<Array2d_compatible Ty, Array2d_index_type Idx = int>
-    class array2d {
-    public:
-        using value_type             = Ty;
-        using index_type             = Idx;
-        using size_type              = std::make_unsigned_t<Idx>;
-        using difference_type        = std::make_signed_t<Idx>;
-        using pointer                = Ty *;
-        using const_pointer          = const Ty *;
-        using reference              = Ty &;
-        using const_reference        = const Ty &;
-        using iterator               = Array2d_iterator<Ty>;
-        using const_iterator         = Array2d_iterator<const Ty>;
-        using reverse_iterator       = std::reverse_iterator<iterator>;
-        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-        constexpr array2d() noexcept = default;
-        array2d(index_type rows, index_type cols)
-            : rows_(validate_dimension(rows, "rows")),
-              cols_(validate_dimension(cols, "cols")) {
-            if (rows_ > 0 && cols_ > 0) {
-                const auto size = calculate_size(rows_, cols_);
-                data_.resize(size);
-            }
+    inline constexpr std::size_t streaming_threshold = QM_ARRAY2D_STREAMING_THRESHOLD;
+    namespace detail {
+        inline isa detect_isa() noexcept {
+#if defined(QM_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return isa::avx512;
+            if (__builtin_cpu_supports("avx2")) return isa::avx2;
+            return isa::sse2;
+#elif defined(QM_SIMD_X86)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) return isa::sse2;
+            __cpuid(info, 1);
+            const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+            if (!os_saves_ymm) return isa::sse2;
+            __cpuidex(info, 7, 0);
+            if ((info[1] & (1 << 16)) != 0 && (_xgetbv(0) & 0xE6) == 0xE6) return isa::avx512;
+            if ((info[1] & (1 << 5)) != 0) return isa::avx2;
+            return isa::sse2;
+#else
+            return isa::scalar;
+#endif
         }
-        array2d(index_type rows, index_type cols, const Ty &val)
-            : rows_(validate_dimension(rows, "rows")),
-              cols_(validate_dimension(cols, "cols")) {
-            if (rows_ > 0 && cols_ > 0) {
-                const auto size = calculate_size(rows_, cols_);
-                data_.resize(size, val);
+    }  // namespace detail
+    [[nodiscard]] inline isa detected_isa() noexcept {
+        static const isa level = detail::detect_isa();
+        return level;
+    }
+    [[nodiscard]] inline bool has_fma() noexcept {
+        static const bool supported = [] {
+#if defined(QM_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+            __builtin_cpu_init();
+            return detected_isa() >= isa::avx2 && __builtin_cpu_supports("fma");
+#elif defined(QM_SIMD_X86)
+            int info[4];
+            __cpuid(info, 1);
+            return detected_isa() >= isa::avx2 && (info[2] & (1 << 12)) != 0;
+#else
+            return false;
+#endif
+        }();
+        return supported;
+    }
+    namespace detail {
+        inline constexpr std::size_t pattern_block_size = 128;
+        using fill_body_fn = void (*)(unsigned char *dst, std::size_t chunks, const unsigned char *src,
+                                      bool streaming) noexcept;
+        inline void fill_body_scalar(unsigned char *dst, std::size_t chunks, const unsigned char *src,
+                                     bool) noexcept {
+            for (std::size_t i = 0; i < chunks; ++i) {
+                std::memcpy(dst + i * 64, src, 64);
             }
         }
-        array2d(std::initializer_list<std::initializer_list<Ty>> init_list) {
-            if (init_list.size() == 0) {
-                rows_ = cols_ = 0;
-                return;
-            }
-            rows_ = static_cast<index_type>(init_list.size());
-            cols_ = static_cast<index_type>(init_list.begin()->size());
-            for (const auto &row: init_list) {
-                if (static_cast<index_type>(row.size()) != cols_) {
-                    throw std::invalid_argument("All rows must have the same number of columns");
-                }
+#ifdef QM_SIMD_X86
+        QM_SIMD_TARGET("sse2")
+        inline void fill_body_sse2(unsigned char *dst, std::size_t chunks, const unsigned char *src,
+                                   bool streaming) noexcept {
+            const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+            auto         *out   = reinterpret_cast<__m128i *>(dst);
+            if (streaming) {
+                for (std::size_t i = 0; i < chunks; ++i) _mm_stream_si128(out + i, value);
+                _mm_sfence();
+            } else {
+                for (std::size_t i = 0; i < chunks; ++i) _mm_store_si128(out + i, value);
             }
-            const auto size = calculate_size(rows_, cols_);
-            data_.reserve(size);
-            for (const auto &row: init_list) {
-                data_.insert(data_.end(), row.begin(), row.end());
+        }
+        QM_SIMD_TARGET("avx2")
+        inline void fill_body_avx2(unsigned char *dst, std::size_t chunks, const unsigned char *src,
+                                   bool streaming) noexcept {
+            const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+            auto         *out   = reinterpret_cast<__m256i *>(dst);
+            if (streaming) {
+                for (std::size_t i = 0; i < chunks; ++i) _mm256_stream_si256(out + i, value);
+                _mm_sfence();
+            } else {
+                for (std::size_t i = 0; i < chunks; ++i) _mm256_store_si256(out + i, value);
             }
         }
-        template<typename Container>
-        array2d(index_type rows, index_type cols, const Container &container)
-            requires std::ranges::range<Container> &&
-                             std::convertible_to<std::ranges::range_value_t<Container>, Ty>
-            : rows_(validate_dimension(rows, "rows")),
-              cols_(validate_dimension(cols, "cols")) {
-            const auto expected_size = calculate_size(rows_, cols_);
-            if (std::ranges::size(container) != expected_size) {
-                throw std::invalid_argument("Container size doesn't match matrix dimensions");
+        QM_SIMD_TARGET("avx512f")
+        inline void fill_body_avx512(unsigned char *dst, std::size_t chunks, const unsigned char *src,
+                                     bool streaming) noexcept {
+            const __m512i value = _mm512_loadu_si512(src);
+            auto         *out   = reinterpret_cast<__m512i *>(dst);
+            if (streaming) {
+                for (std::size_t i = 0; i < chunks; ++i) _mm512_stream_si512(out + i, value);
+                _mm_sfence();
+            } else {
+                for (std::size_t i = 0; i < chunks; ++i) _mm512_store_si512(out + i, value);
             }
-            data_.reserve(expected_size);
-            std::ranges::copy(container, std::back_inserter(data_));
         }
-        array2d(const array2d &)                = default;
-        array2d(array2d &&) noexcept            = default;
-        array2d &operator=(const array2d &)     = default;
-        array2d &operator=(array2d &&) noexcept = default;
-        ~array2d()                              = default;
-        [[nodiscard]] QM_FORCEINLINE pointer operator[](index_type row) noexcept {
-            assert_bounds(row, rows_);
-            return data_.data() + calculate_offset(row, 0);
+#endif
+        inline void select_fill_body(isa level, std::size_t &width, fill_body_fn &body) noexcept {
+            switch (level) {
+#ifdef QM_SIMD_X86
+                case isa::avx512:
+                    width = 64;
+                    body  = fill_body_avx512;
+                    return;
+                case isa::avx2:
+                    width = 32;
+                    body  = fill_body_avx2;
+                    return;
+                case isa::sse2:
+                    width = 16;
+                    body  = fill_body_sse2;
+                    return;
+#endif
+                default:
+                    width = 64;
+                    body  = fill_body_scalar;
+                    return;
+            }
         }
-        [[nodiscard]] QM_FORCEINLINE const_pointer operator[](index_type row) const noexcept {
-            assert_bounds(row, rows_);
-            return data_.data() + calculate_offset(row, 0);
+    }  // namespace detail
+    inline void fill_pattern(isa level, void *dst, std::size_t bytes, const void *pattern,
+                             std::size_t pattern_size, bool streaming) noexcept {
+        alignas(64) unsigned char block[detail::pattern_block_size];
+        for (std::size_t i = 0; i < detail::pattern_block_size; i += pattern_size) {
+            std::memcpy(block + i, pattern, pattern_size);
         }
-        [[nodiscard]] QM_FORCEINLINE reference operator()(index_type row, index_type col) noexcept {
-            assert_bounds(row, rows_);
-            assert_bounds(col, cols_);
-            return data_[calculate_offset(row, col)];
+        std::size_t          width;
+        detail::fill_body_fn body;
+        detail::select_fill_body(level, width, body);
+        auto *out  = static_cast<unsigned char *>(dst);
+        auto  head = (width - reinterpret_cast<std::uintptr_t>(out) % width) % width;
+        if (bytes <= head + width) {
+            for (std::size_t pos = 0; pos < bytes; pos += width) {
+                const auto n = bytes - pos < width ? bytes - pos : width;
+                std::memcpy(out + pos, block + pos % pattern_size, n);
+            }
+            return;
         }
-        [[nodiscard]] QM_FORCEINLINE const_reference operator()(index_type row, index_type col) const noexcept {
-            assert_bounds(row, rows_);
-            assert_bounds(col, cols_);
-            return data_[calculate_offset(row, col)];
+        std::memcpy(out, block, head);
+        const auto chunks = (bytes - head) / width;
+        body(out + head, chunks, block + head % pattern_size, streaming);
+        const auto pos = head + chunks * width;
+        std::memcpy(out + pos, block + pos % pattern_size, bytes - pos);
+    }
+    inline void fill_pattern(void *dst, std::size_t bytes, const void *pattern, std::size_t pattern_size,
+                             bool streaming) noexcept {
+        fill_pattern(detected_isa(), dst, bytes, pattern, pattern_size, streaming);
+    }
+    template<typename T>
+    concept Fill_pattern_type = std::is_trivially_copyable_v<T> &&
+                                (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8 ||
+                                 sizeof(T) == 16);
+    template<Fill_pattern_type T>
+    void fill(T *dst, std::size_t count, const T &val) noexcept {
+        const auto bytes = count * sizeof(T);
+        fill_pattern(dst, bytes, &val, sizeof(T), bytes >= streaming_threshold);
+    }
+    inline void fill_bytes(void *dst, unsigned char byte, std::size_t bytes) noexcept {
+        fill_pattern(dst, bytes, &byte, 1, bytes >= streaming_threshold);
+    }
+    namespace detail {
+        using swap_body_fn = std::size_t (*)(unsigned char *a, unsigned char *b, std::size_t bytes) noexcept;
+        inline std::size_t swap_body_scalar(unsigned char *a, unsigned char *b, std::size_t bytes) noexcept {
+            unsigned char tmp[64];
+            std::size_t   done = 0;
+            for (; done + sizeof(tmp) <= bytes; done += sizeof(tmp)) {
+                std::memcpy(tmp, a + done, sizeof(tmp));
+                std::memcpy(a + done, b + done, sizeof(tmp));
+                std::memcpy(b + done, tmp, sizeof(tmp));
+            }
+            return done;
         }
-        [[nodiscard]] reference at(index_type row, index_type col) {
-            return at_impl<false>(row, col);
+#ifdef QM_SIMD_X86
+        QM_SIMD_TARGET("sse2")
+        inline std::size_t swap_body_sse2(unsigned char *a, unsigned char *b, std::size_t bytes) noexcept {
+            std::size_t done = 0;
+            for (; done + 32 <= bytes; done += 32) {
+                auto *pa = reinterpret_cast<__m128i *>(a + done);
+                auto *pb = reinterpret_cast<__m128i *>(b + done);
+                const __m128i a0 = _mm_loadu_si128(pa), a1 = _mm_loadu_si128(pa + 1);
+                const __m128i b0 = _mm_loadu_si128(pb), b1 = _mm_loadu_si128(pb + 1);
+                _mm_storeu_si128(pa, b0);
+                _mm_storeu_si128(pa + 1, b1);
+                _mm_storeu_si128(pb, a0);
+                _mm_storeu_si128(pb + 1, a1);
+            }
+            return done;
         }
-        [[nodiscard]] const_reference at(index_type row, index_type col) const {
-            return at_impl<true>(row, col);
+        QM_SIMD_TARGET("avx2")
+        inline std::size_t swap_body_avx2(unsigned char *a, unsigned char *b, std::size_t bytes) noexcept {
+            std::size_t done = 0;
+            for (; done + 64 <= bytes; done += 64) {
+                auto *pa = reinterpret_cast<__m256i *>(a + done);
+                auto *pb = reinterpret_cast<__m256i *>(b + done);
+                const __m256i a0 = _mm256_loadu_si256(pa), a1 = _mm256_loadu_si256(pa + 1);
+                const __m256i b0 = _mm256_loadu_si256(pb), b1 = _mm256_loadu_si256(pb + 1);
+                _mm256_storeu_si256(pa, b0);
+                _mm256_storeu_si256(pa + 1, b1);
+                _mm256_storeu_si256(pb, a0);
+                _mm256_storeu_si256(pb + 1, a1);
+            }
+            return done;
         }
-        [[nodiscard]] constexpr iterator begin() noexcept {
-            return iterator(data_.data());
+#endif
+        inline swap_body_fn select_swap_body() noexcept {
+#ifdef QM_SIMD_X86
+            if (detected_isa() >= isa::avx2) return swap_body_avx2;
+            if (detected_isa() >= isa::sse2) return swap_body_sse2;
+#endif
+            return swap_body_scalar;
         }
-        [[nodiscard]] constexpr const_iterator begin() const noexcept {
-            return const_iterator(data_.data());
+    }  // namespace detail
+    inline void swap_bytes(void *a, void *b, std::size_t bytes) noexcept {
+        auto *pa = static_cast<unsigned char *>(a);
+        auto *pb = static_cast<unsigned char *>(b);
+        static const detail::swap_body_fn body = detail::select_swap_body();
+        for (std::size_t i = body(pa, pb, bytes); i < bytes; ++i) {
+            const unsigned char tmp = pa[i];
+            pa[i]                   = pb[i];
+            pb[i]                   = tmp;
         }
-        [[nodiscard]] constexpr iterator end() noexcept {
-            return iterator(data_.data() + data_.size());
+    }
+    template<typename T>
+    concept Reduce_simd_type = std::same_as<T, float> || std::same_as<T, double>;
+    namespace detail {
+        template<typename T>
+        T sum_generic(const T *p, std::size_t n) {
+            if constexpr (std::is_arithmetic_v<T>) {
+                T acc[4]{};
+                std::size_t i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    acc[0] += p[i];
+                    acc[1] += p[i + 1];
+                    acc[2] += p[i + 2];
+                    acc[3] += p[i + 3];
+                }
+                for (; i < n; ++i) acc[0] += p[i];
+                return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+            } else {
+                T acc{};
+                for (std::size_t i = 0; i < n; ++i) acc = acc + p[i];
+                return acc;
+            }
         }
-        [[nodiscard]] constexpr const_iterator end() const noexcept {
-            return const_iterator(data_.data() + data_.size());
+        template<typename T>
+        T sum_kahan_generic(const T *p, std::size_t n) {
+            T sum{};
+            T comp{};
+            for (std::size_t i = 0; i < n; ++i) {
+                const T t = sum + p[i];
+                if (std::abs(sum) >= std::abs(p[i])) {
+                    comp += (sum - t) + p[i];
+                } else {
+                    comp += (p[i] - t) + sum;
+                }
+                sum = t;
+            }
+            return sum + comp;
         }
-        [[nodiscard]] constexpr const_iterator   cbegin() const noexcept { return begin(); }
-        [[nodiscard]] constexpr const_iterator   cend() const noexcept { return end(); }
-        [[nodiscard]] constexpr reverse_iterator rbegin() noexcept {
-            return reverse_iterator(end());
+        template<bool Max, typename T>
+        T extremum_generic(const T *p, std::size_t n) {
+            T best = p[0];
+            for (std::size_t i = 1; i < n; ++i) {
+                if constexpr (Max) {
+                    best = best < p[i] ? p[i] : best;
+                } else {
+                    best = p[i] < best ? p[i] : best;
+                }
+            }
+            return best;
         }
-        [[nodiscard]] constexpr const_reverse_iterator rbegin() const noexcept {
-            return const_reverse_iterator(end());
+#ifdef QM_SIMD_X86
+        namespace avx2 {
+            QM_SIMD_TARGET("avx2") inline __m256d load(const double *p) noexcept { return _mm256_loadu_pd(p); }
+            QM_SIMD_TARGET("avx2") inline __m256 load(const float *p) noexcept { return _mm256_loadu_ps(p); }
+            QM_SIMD_TARGET("avx2") inline __m256d zero(double) noexcept { return _mm256_setzero_pd(); }
+            QM_SIMD_TARGET("avx2") inline __m256 zero(float) noexcept { return _mm256_setzero_ps(); }
+            QM_SIMD_TARGET("avx2") inline __m256d add(__m256d a, __m256d b) noexcept { return _mm256_add_pd(a, b); }
+            QM_SIMD_TARGET("avx2") inline __m256 add(__m256 a, __m256 b) noexcept { return _mm256_add_ps(a, b); }
+            QM_SIMD_TARGET("avx2") inline __m256d sub(__m256d a, __m256d b) noexcept { return _mm256_sub_pd(a, b); }
+            QM_SIMD_TARGET("avx2") inline __m256 sub(__m256 a, __m256 b) noexcept { return _mm256_sub_ps(a, b); }
+            QM_SIMD_TARGET("avx2") inline __m256d min(__m256d a, __m256d b) noexcept { return _mm256_min_pd(a, b); }
+            QM_SIMD_TARGET("avx2") inline __m256 min(__m256 a, __m256 b) noexcept { return _mm256_min_ps(a, b); }
+            QM_SIMD_TARGET("avx2") inline __m256d max(__m256d a, __m256d b) noexcept { return _mm256_max_pd(a, b); }
+            QM_SIMD_TARGET("avx2") inline __m256 max(__m256 a, __m256 b) noexcept { return _mm256_max_ps(a, b); }
+            QM_SIMD_TARGET("avx2") inline void store(double *p, __m256d v) noexcept { _mm256_storeu_pd(p, v); }
+            QM_SIMD_TARGET("avx2") inline void store(float *p, __m256 v) noexcept { _mm256_storeu_ps(p, v); }
+            template<typename V>
+            QM_SIMD_TARGET("avx2")
+            inline void kahan_step(V &sum, V &comp, V x) noexcept {
+                const V y = sub(x, comp);
+                const V t = add(sum, y);
+                comp      = sub(sub(t, sum), y);
+                sum       = t;
+            }
+            template<bool Max, typename V>
+            QM_SIMD_TARGET("avx2")
+            inline V pick(V a, V b) noexcept {
+                if constexpr (Max) {
+                    return max(a, b);
+                } else {
+                    return min(a, b);
+                }
+            }
+            template<Reduce_simd_type T>
+            QM_SIMD_TARGET("avx2")
+            T sum(const T *p, std::size_t n) noexcept {
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                auto acc0 = zero(T{}), acc1 = zero(T{}), acc2 = zero(T{}), acc3 = zero(T{});
+                std::size_t i = 0;
+                for (; i + 4 * lanes <= n; i += 4 * lanes) {
+                    acc0 = add(acc0, load(p + i));
+                    acc1 = add(acc1, load(p + i + lanes));
+                    acc2 = add(acc2, load(p + i + 2 * lanes));
+                    acc3 = add(acc3, load(p + i + 3 * lanes));
+                }
+                for (; i + lanes <= n; i += lanes) acc0 = add(acc0, load(p + i));
+                alignas(32) T partial[lanes];
+                store(partial, add(add(acc0, acc1), add(acc2, acc3)));
+                T result{};
+                for (std::size_t k = 0; k < lanes; ++k) result += partial[k];
+                for (; i < n; ++i) result += p[i];
+                return result;
+            }
+            template<Reduce_simd_type T>
+            QM_SIMD_TARGET("avx2")
+            T sum_kahan(const T *p, std::size_t n) noexcept {
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                auto sum0 = zero(T{}), sum1 = zero(T{}), comp0 = zero(T{}), comp1 = zero(T{});
+                std::size_t i = 0;
+                for (; i + 2 * lanes <= n; i += 2 * lanes) {
+                    kahan_step(sum0, comp0, load(p + i));
+                    kahan_step(sum1, comp1, load(p + i + lanes));
+                }
+                alignas(32) T partial[4 * lanes];
+                store(partial, sum0);
+                store(partial + lanes, sum1);
+                store(partial + 2 * lanes, comp0);
+                store(partial + 3 * lanes, comp1);
+                for (std::size_t k = 2 * lanes; k < 4 * lanes; ++k) partial[k] = -partial[k];
+                const auto tail = n - i;
+                return sum_kahan_generic(partial, 4 * lanes) + sum_kahan_generic(p + i, tail);
+            }
+            template<bool Max, Reduce_simd_type T>
+            QM_SIMD_TARGET("avx2")
+            T extremum(const T *p, std::size_t n) noexcept {
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                if (n < 4 * lanes) return extremum_generic<Max>(p, n);
+                auto acc0 = load(p), acc1 = load(p + lanes), acc2 = load(p + 2 * lanes), acc3 = load(p + 3 * lanes);
+                std::size_t i = 4 * lanes;
+                for (; i + 4 * lanes <= n; i += 4 * lanes) {
+                    acc0 = pick<Max>(acc0, load(p + i));
+                    acc1 = pick<Max>(acc1, load(p + i + lanes));
+                    acc2 = pick<Max>(acc2, load(p + i + 2 * lanes));
+                    acc3 = pick<Max>(acc3, load(p + i + 3 * lanes));
+                }
+                alignas(32) T partial[lanes];
+                store(partial, pick<Max>(pick<Max>(acc0, acc1), pick<Max>(acc2, acc3)));
+                const T best = extremum_generic<Max>(partial, lanes);
+                if (i == n) return best;
+                const T rest = extremum_generic<Max>(p + i, n - i);
+                if constexpr (Max) {
+                    return best < rest ? rest : best;
+                } else {
+                    return rest < best ? rest : best;
+                }
+            }
+        }  // namespace avx2
+#endif
+        template<bool Max, typename T>
+        T extremum(const T *p, std::size_t n) {
+#ifdef QM_SIMD_X86
+            if constexpr (Reduce_simd_type<T>) {
+                if (detected_isa() >= isa::avx2) return avx2::extremum<Max>(p, n);
+            }
+#endif
+            return extremum_generic<Max>(p, n);
         }
-        [[nodiscard]] constexpr reverse_iterator rend() noexcept {
-            return reverse_iterator(begin());
+        template<bool Max, typename T>
+        std::size_t arg_extremum(const T *p, std::size_t n) {
+            constexpr std::size_t block = 1024;
+            const auto better = [](const T &a, const T &b) {
+                if constexpr (Max) {
+                    return b < a;
+                } else {
+                    return a < b;
+                }
+            };
+            std::size_t index = 0;
+            T           best  = p[0];
+            for (std::size_t first = 0; first < n; first += block) {
+                const auto count = n - first < block ? n - first : block;
+                const T    value = extremum<Max>(p + first, count);
+                if (first == 0 || better(value, best)) {
+                    best = value;
+                    for (std::size_t i = first; i < first + count; ++i) {
+                        if (!better(p[i], value) && !better(value, p[i])) {
+                            index = i;
+                            break;
+                        }
+                    }
+                }
+            }
+            return index;
         }
-        [[nodiscard]] constexpr const_reverse_iterator rend() const noexcept {
-            return const_reverse_iterator(begin());
+    }  // namespace detail
+    template<typename T>
+    [[nodiscard]] T sum(const T *p, std::size_t n) {
+#ifdef QM_SIMD_X86
+        if constexpr (Reduce_simd_type<T>) {
+            if (detected_isa() >= isa::avx2) return detail::avx2::sum(p, n);
+        }
+#endif
+        return detail::sum_generic(p, n);
+    }
+    template<typename T>
+    [[nodiscard]] T sum_kahan(const T *p, std::size_t n) {
+        if constexpr (std::is_floating_point_v<T>) {
+#ifdef QM_SIMD_X86
+            if constexpr (Reduce_simd_type<T>) {
+                if (detected_isa() >= isa::avx2) return detail::avx2::sum_kahan(p, n);
+            }
+#endif
+            return detail::sum_kahan_generic(p, n);
+        } else {
+            return sum(p, n);
+        }
+    }
+    template<typename T>
+    [[nodiscard]] T sum_pairwise(const T *p, std::size_t n) {
+        if (n <= 256) return sum(p, n);
+        const auto half = n / 2;
+        return sum_pairwise(p, half) + sum_pairwise(p + half, n - half);
+    }
+    template<typename T>
+    [[nodiscard]] T min(const T *p, std::size_t n) {
+        return detail::extremum<false>(p, n);
+    }
+    template<typename T>
+    [[nodiscard]] T max(const T *p, std::size_t n) {
+        return detail::extremum<true>(p, n);
+    }
+    template<typename T>
+    [[nodiscard]] std::size_t argmin(const T *p, std::size_t n) {
+        return detail::arg_extremum<false>(p, n);
+    }
+    template<typename T>
+    [[nodiscard]] std::size_t argmax(const T *p, std::size_t n) {
+        return detail::arg_extremum<true>(p, n);
+    }
+    namespace detail {
+        template<typename T>
+        inline constexpr std::size_t transpose_tile_extent =
+                256 / sizeof(T) > 64 ? 64 : (256 / sizeof(T) < 4 ? 4 : 256 / sizeof(T));
+        template<typename T>
+        void transpose_tile_scalar(const T *src, std::size_t src_stride, T *dst, std::size_t dst_stride,
+                                   std::size_t rows, std::size_t cols) {
+            for (std::size_t i = 0; i < rows; ++i) {
+                for (std::size_t j = 0; j < cols; ++j) {
+                    dst[j * dst_stride + i] = src[i * src_stride + j];
+                }
+            }
+        }
+#ifdef QM_SIMD_X86
+        QM_SIMD_TARGET("sse2")
+        inline void transpose_4x4_32(const void *src, std::size_t src_stride, void *dst,
+                                     std::size_t dst_stride) noexcept {
+            const auto *in  = static_cast<const float *>(src);
+            auto       *out = static_cast<float *>(dst);
+            __m128      r0  = _mm_loadu_ps(in);
+            __m128      r1  = _mm_loadu_ps(in + src_stride);
+            __m128      r2  = _mm_loadu_ps(in + 2 * src_stride);
+            __m128      r3  = _mm_loadu_ps(in + 3 * src_stride);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(out, r0);
+            _mm_storeu_ps(out + dst_stride, r1);
+            _mm_storeu_ps(out + 2 * dst_stride, r2);
+            _mm_storeu_ps(out + 3 * dst_stride, r3);
+        }
+        QM_SIMD_TARGET("sse2")
+        inline void transpose_2x2_64(const void *src, std::size_t src_stride, void *dst,
+                                     std::size_t dst_stride) noexcept {
+            const auto  *in  = static_cast<const double *>(src);
+            auto        *out = static_cast<double *>(dst);
+            const __m128d r0 = _mm_loadu_pd(in);
+            const __m128d r1 = _mm_loadu_pd(in + src_stride);
+            _mm_storeu_pd(out, _mm_unpacklo_pd(r0, r1));
+            _mm_storeu_pd(out + dst_stride, _mm_unpackhi_pd(r0, r1));
+        }
+        QM_SIMD_TARGET("avx2")
+        inline void transpose_8x8_32(const void *src, std::size_t src_stride, void *dst,
+                                     std::size_t dst_stride) noexcept {
+            const auto *in  = static_cast<const float *>(src);
+            auto       *out = static_cast<float *>(dst);
+            __m256      r[8];
+            for (int k = 0; k < 8; ++k) r[k] = _mm256_loadu_ps(in + k * src_stride);
+            const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+            const __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+            const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+            const __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+            const __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+            const __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+            const __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+            const __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+            const __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+            _mm256_storeu_ps(out, _mm256_permute2f128_ps(u0, u4, 0x20));
+            _mm256_storeu_ps(out + dst_stride, _mm256_permute2f128_ps(u1, u5, 0x20));
+            _mm256_storeu_ps(out + 2 * dst_stride, _mm256_permute2f128_ps(u2, u6, 0x20));
+            _mm256_storeu_ps(out + 3 * dst_stride, _mm256_permute2f128_ps(u3, u7, 0x20));
+            _mm256_storeu_ps(out + 4 * dst_stride, _mm256_permute2f128_ps(u0, u4, 0x31));
+            _mm256_storeu_ps(out + 5 * dst_stride, _mm256_permute2f128_ps(u1, u5, 0x31));
+            _mm256_storeu_ps(out + 6 * dst_stride, _mm256_permute2f128_ps(u2, u6, 0x31));
+            _mm256_storeu_ps(out + 7 * dst_stride, _mm256_permute2f128_ps(u3, u7, 0x31));
+        }
+        QM_SIMD_TARGET("avx2")
+        inline void transpose_4x4_64(const void *src, std::size_t src_stride, void *dst,
+                                     std::size_t dst_stride) noexcept {
+            const auto  *in = static_cast<const double *>(src);
+            auto        *out = static_cast<double *>(dst);
+            const __m256d r0 = _mm256_loadu_pd(in);
+            const __m256d r1 = _mm256_loadu_pd(in + src_stride);
+            const __m256d r2 = _mm256_loadu_pd(in + 2 * src_stride);
+            const __m256d r3 = _mm256_loadu_pd(in + 3 * src_stride);
+            const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+            const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+            const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+            const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+            _mm256_storeu_pd(out, _mm256_permute2f128_pd(t0, t2, 0x20));
+            _mm256_storeu_pd(out + dst_stride, _mm256_permute2f128_pd(t1, t3, 0x20));
+            _mm256_storeu_pd(out + 2 * dst_stride, _mm256_permute2f128_pd(t0, t2, 0x31));
+            _mm256_storeu_pd(out + 3 * dst_stride, _mm256_permute2f128_pd(t1, t3, 0x31));
+        }
+        template<typename T>
+        QM_SIMD_TARGET("sse2")
+        void transpose_tile_sse2(const T *src, std::size_t src_stride, T *dst, std::size_t dst_stride,
+                                 std::size_t rows, std::size_t cols) noexcept {
+            constexpr std::size_t k         = 16 / sizeof(T);
+            const auto            full_rows = rows - rows % k;
+            const auto            full_cols = cols - cols % k;
+            for (std::size_t i = 0; i < full_rows; i += k) {
+                for (std::size_t j = 0; j < full_cols; j += k) {
+                    if constexpr (sizeof(T) == 4) {
+                        transpose_4x4_32(src + i * src_stride + j, src_stride, dst + j * dst_stride + i, dst_stride);
+                    } else {
+                        transpose_2x2_64(src + i * src_stride + j, src_stride, dst + j * dst_stride + i, dst_stride);
+                    }
+                }
+            }
+            transpose_tile_scalar(src + full_cols, src_stride, dst + full_cols * dst_stride, dst_stride, rows,
+                                  cols - full_cols);
+            transpose_tile_scalar(src + full_rows * src_stride, src_stride, dst + full_rows, dst_stride,
+                                  rows - full_rows, full_cols);
+        }
+        template<typename T>
+        QM_SIMD_TARGET("avx2")
+        void transpose_tile_avx2(const T *src, std::size_t src_stride, T *dst, std::size_t dst_stride,
+                                 std::size_t rows, std::size_t cols) noexcept {
+            constexpr std::size_t k         = 32 / sizeof(T);
+            const auto            full_rows = rows - rows % k;
+            const auto            full_cols = cols - cols % k;
+            for (std::size_t i = 0; i < full_rows; i += k) {
+                for (std::size_t j = 0; j < full_cols; j += k) {
+                    if constexpr (sizeof(T) == 4) {
+                        transpose_8x8_32(src + i * src_stride + j, src_stride, dst + j * dst_stride + i, dst_stride);
+                    } else {
+                        transpose_4x4_64(src + i * src_stride + j, src_stride, dst + j * dst_stride + i, dst_stride);
+                    }
+                }
+            }
+            transpose_tile_scalar(src + full_cols, src_stride, dst + full_cols * dst_stride, dst_stride, rows,
+                                  cols - full_cols);
+            transpose_tile_scalar(src + full_rows * src_stride, src_stride, dst + full_rows, dst_stride,
+                                  rows - full_rows, full_cols);
+        }
+#endif
+        template<typename T>
+        using transpose_tile_fn = void (*)(const T *, std::size_t, T *, std::size_t, std::size_t, std::size_t);
+        template<typename T>
+        void transpose_recursive(const T *src, std::size_t src_stride, T *dst, std::size_t dst_stride,
+                                 std::size_t rows, std::size_t cols, transpose_tile_fn<T> tile) {
+            constexpr std::size_t extent = transpose_tile_extent<T>;
+            const auto split = [](std::size_t n) {
+                const auto half = ((n / 2) + 7) & ~std::size_t{7};
+                return half < n ? half : n / 2;
+            };
+            while (rows > extent || cols > extent) {
+                if (rows >= cols) {
+                    const auto half = split(rows);
+                    transpose_recursive(src, src_stride, dst, dst_stride, half, cols, tile);
+                    src += half * src_stride;
+                    dst += half;
+                    rows -= half;
+                } else {
+                    const auto half = split(cols);
+                    transpose_recursive(src, src_stride, dst, dst_stride, rows, half, tile);
+                    src += half;
+                    dst += half * dst_stride;
+                    cols -= half;
+                }
+            }
+            tile(src, src_stride, dst, dst_stride, rows, cols);
+        }
+        template<typename T>
+        transpose_tile_fn<T> select_transpose_tile() noexcept {
+#ifdef QM_SIMD_X86
+            if constexpr (std::is_trivially_copyable_v<T> && (sizeof(T) == 4 || sizeof(T) == 8)) {
+                if (detected_isa() >= isa::avx2) return transpose_tile_avx2<T>;
+                if (detected_isa() >= isa::sse2) return transpose_tile_sse2<T>;
+            }
+#endif
+            return transpose_tile_scalar<T>;
+        }
+    }  // namespace detail
+    template<typename T>
+    void transpose(const T *src, std::size_t src_stride, T *dst, std::size_t dst_stride, std::size_t rows,
+                   std::size_t cols) {
+        if (rows == 0 || cols == 0) return;
+        detail::transpose_recursive(src, src_stride, dst, dst_stride, rows, cols, detail::select_transpose_tile<T>());
+    }
+    template<typename T>
+    struct gemm_kernel {
+        using fn = void (*)(std::size_t kc, const T *ap, const T *bp, T *c, std::size_t ldc, T alpha, T beta);
+        std::size_t mr;
+        std::size_t nr;
+        fn          kernel;
+    };
+    namespace detail {
+        template<typename T, std::size_t MR, std::size_t NR>
+        void gemm_kernel_generic(std::size_t kc, const T *ap, const T *bp, T *c, std::size_t ldc, T alpha, T beta) {
+            T acc[MR][NR]{};
+            for (std::size_t p = 0; p < kc; ++p) {
+                for (std::size_t i = 0; i < MR; ++i) {
+                    for (std::size_t j = 0; j < NR; ++j) {
+                        acc[i][j] += ap[i] * bp[j];
+                    }
+                }
+                ap += MR;
+                bp += NR;
+            }
+            for (std::size_t i = 0; i < MR; ++i) {
+                for (std::size_t j = 0; j < NR; ++j) {
+                    c[i * ldc + j] = beta == T{} ? alpha * acc[i][j] : alpha * acc[i][j] + beta * c[i * ldc + j];
+                }
+            }
+        }
+#ifdef QM_SIMD_X86
+        QM_SIMD_TARGET("avx2,fma")
+        inline void gemm_store_f64(double *row, __m256d acc, __m256d va, __m256d vb, bool accumulate) noexcept {
+            const __m256d scaled = _mm256_mul_pd(va, acc);
+            _mm256_storeu_pd(row, accumulate ? _mm256_fmadd_pd(vb, _mm256_loadu_pd(row), scaled) : scaled);
+        }
+        QM_SIMD_TARGET("avx2,fma")
+        inline void gemm_store_f32(float *row, __m256 acc, __m256 va, __m256 vb, bool accumulate) noexcept {
+            const __m256 scaled = _mm256_mul_ps(va, acc);
+            _mm256_storeu_ps(row, accumulate ? _mm256_fmadd_ps(vb, _mm256_loadu_ps(row), scaled) : scaled);
+        }
+        QM_SIMD_TARGET("avx2")
+        inline void gemm_store_i32(std::int32_t *row, __m256i acc, __m256i va, __m256i vb, bool accumulate) noexcept {
+            auto         *out    = reinterpret_cast<__m256i *>(row);
+            const __m256i scaled = _mm256_mullo_epi32(va, acc);
+            _mm256_storeu_si256(out, accumulate ? _mm256_add_epi32(scaled, _mm256_mullo_epi32(vb, _mm256_loadu_si256(out)))
+                                                : scaled);
+        }
+        QM_SIMD_TARGET("avx2,fma")
+        inline void gemm_kernel_avx2_f64(std::size_t kc, const double *ap, const double *bp, double *c,
+                                         std::size_t ldc, double alpha, double beta) {
+            __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+            __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+            __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+            __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+            __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+            __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+            for (std::size_t p = 0; p < kc; ++p) {
+                const __m256d b0 = _mm256_loadu_pd(bp);
+                const __m256d b1 = _mm256_loadu_pd(bp + 4);
+                __m256d       a  = _mm256_broadcast_sd(ap);
+                c00 = _mm256_fmadd_pd(a, b0, c00);
+                c01 = _mm256_fmadd_pd(a, b1, c01);
+                a   = _mm256_broadcast_sd(ap + 1);
+                c10 = _mm256_fmadd_pd(a, b0, c10);
+                c11 = _mm256_fmadd_pd(a, b1, c11);
+                a   = _mm256_broadcast_sd(ap + 2);
+                c20 = _mm256_fmadd_pd(a, b0, c20);
+                c21 = _mm256_fmadd_pd(a, b1, c21);
+                a   = _mm256_broadcast_sd(ap + 3);
+                c30 = _mm256_fmadd_pd(a, b0, c30);
+                c31 = _mm256_fmadd_pd(a, b1, c31);
+                a   = _mm256_broadcast_sd(ap + 4);
+                c40 = _mm256_fmadd_pd(a, b0, c40);
+                c41 = _mm256_fmadd_pd(a, b1, c41);
+                a   = _mm256_broadcast_sd(ap + 5);
+                c50 = _mm256_fmadd_pd(a, b0, c50);
+                c51 = _mm256_fmadd_pd(a, b1, c51);
+                ap += 6;
+                bp += 8;
+            }
+            const __m256d va         = _mm256_set1_pd(alpha);
+            const __m256d vb         = _mm256_set1_pd(beta);
+            const bool    accumulate = beta != 0.0;
+            gemm_store_f64(c, c00, va, vb, accumulate);
+            gemm_store_f64(c + 4, c01, va, vb, accumulate);
+            gemm_store_f64(c + ldc, c10, va, vb, accumulate);
+            gemm_store_f64(c + ldc + 4, c11, va, vb, accumulate);
+            gemm_store_f64(c + 2 * ldc, c20, va, vb, accumulate);
+            gemm_store_f64(c + 2 * ldc + 4, c21, va, vb, accumulate);
+            gemm_store_f64(c + 3 * ldc, c30, va, vb, accumulate);
+            gemm_store_f64(c + 3 * ldc + 4, c31, va, vb, accumulate);
+            gemm_store_f64(c + 4 * ldc, c40, va, vb, accumulate);
+            gemm_store_f64(c + 4 * ldc + 4, c41, va, vb, accumulate);
+            gemm_store_f64(c + 5 * ldc, c50, va, vb, accumulate);
+            gemm_store_f64(c + 5 * ldc + 4, c51, va, vb, accumulate);
+        }
+        QM_SIMD_TARGET("avx2,fma")
+        inline void gemm_kernel_avx2_f32(std::size_t kc, const float *ap, const float *bp, float *c,
+                                         std::size_t ldc, float alpha, float beta) {
+            __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+            __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+            __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+            __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+            __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+            __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+            for (std::size_t p = 0; p < kc; ++p) {
+                const __m256 b0 = _mm256_loadu_ps(bp);
+                const __m256 b1 = _mm256_loadu_ps(bp + 8);
+                __m256       a  = _mm256_broadcast_ss(ap);
+                c00 = _mm256_fmadd_ps(a, b0, c00);
+                c01 = _mm256_fmadd_ps(a, b1, c01);
+                a   = _mm256_broadcast_ss(ap + 1);
+                c10 = _mm256_fmadd_ps(a, b0, c10);
+                c11 = _mm256_fmadd_ps(a, b1, c11);
+                a   = _mm256_broadcast_ss(ap + 2);
+                c20 = _mm256_fmadd_ps(a, b0, c20);
+                c21 = _mm256_fmadd_ps(a, b1, c21);
+                a   = _mm256_broadcast_ss(ap + 3);
+                c30 = _mm256_fmadd_ps(a, b0, c30);
+                c31 = _mm256_fmadd_ps(a, b1, c31);
+                a   = _mm256_broadcast_ss(ap + 4);
+                c40 = _mm256_fmadd_ps(a, b0, c40);
+                c41 = _mm256_fmadd_ps(a, b1, c41);
+                a   = _mm256_broadcast_ss(ap + 5);
+                c50 = _mm256_fmadd_ps(a, b0, c50);
+                c51 = _mm256_fmadd_ps(a, b1, c51);
+                ap += 6;
+                bp += 16;
+            }
+            const __m256 va         = _mm256_set1_ps(alpha);
+            const __m256 vb         = _mm256_set1_ps(beta);
+            const bool   accumulate = beta != 0.0f;
+            gemm_store_f32(c, c00, va, vb, accumulate);
+            gemm_store_f32(c + 8, c01, va, vb, accumulate);
+            gemm_store_f32(c + ldc, c10, va, vb, accumulate);
+            gemm_store_f32(c + ldc + 8, c11, va, vb, accumulate);
+            gemm_store_f32(c + 2 * ldc, c20, va, vb, accumulate);
+            gemm_store_f32(c + 2 * ldc + 8, c21, va, vb, accumulate);
+            gemm_store_f32(c + 3 * ldc, c30, va, vb, accumulate);
+            gemm_store_f32(c + 3 * ldc + 8, c31, va, vb, accumulate);
+            gemm_store_f32(c + 4 * ldc, c40, va, vb, accumulate);
+            gemm_store_f32(c + 4 * ldc + 8, c41, va, vb, accumulate);
+            gemm_store_f32(c + 5 * ldc, c50, va, vb, accumulate);
+            gemm_store_f32(c + 5 * ldc + 8, c51, va, vb, accumulate);
+        }
+        QM_SIMD_TARGET("avx2")
+        inline void gemm_kernel_avx2_i32(std::size_t kc, const std::int32_t *ap, const std::int32_t *bp,
+                                         std::int32_t *c, std::size_t ldc, std::int32_t alpha, std::int32_t beta) {
+            __m256i c00 = _mm256_setzero_si256(), c01 = _mm256_setzero_si256();
+            __m256i c10 = _mm256_setzero_si256(), c11 = _mm256_setzero_si256();
+            __m256i c20 = _mm256_setzero_si256(), c21 = _mm256_setzero_si256();
+            __m256i c30 = _mm256_setzero_si256(), c31 = _mm256_setzero_si256();
+            for (std::size_t p = 0; p < kc; ++p) {
+                const __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bp));
+                const __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bp + 8));
+                __m256i       a  = _mm256_set1_epi32(ap[0]);
+                c00 = _mm256_add_epi32(c00, _mm256_mullo_epi32(a, b0));
+                c01 = _mm256_add_epi32(c01, _mm256_mullo_epi32(a, b1));
+                a   = _mm256_set1_epi32(ap[1]);
+                c10 = _mm256_add_epi32(c10, _mm256_mullo_epi32(a, b0));
+                c11 = _mm256_add_epi32(c11, _mm256_mullo_epi32(a, b1));
+                a   = _mm256_set1_epi32(ap[2]);
+                c20 = _mm256_add_epi32(c20, _mm256_mullo_epi32(a, b0));
+                c21 = _mm256_add_epi32(c21, _mm256_mullo_epi32(a, b1));
+                a   = _mm256_set1_epi32(ap[3]);
+                c30 = _mm256_add_epi32(c30, _mm256_mullo_epi32(a, b0));
+                c31 = _mm256_add_epi32(c31, _mm256_mullo_epi32(a, b1));
+                ap += 4;
+                bp += 16;
+            }
+            const __m256i va         = _mm256_set1_epi32(alpha);
+            const __m256i vb         = _mm256_set1_epi32(beta);
+            const bool    accumulate = beta != 0;
+            gemm_store_i32(c, c00, va, vb, accumulate);
+            gemm_store_i32(c + 8, c01, va, vb, accumulate);
+            gemm_store_i32(c + ldc, c10, va, vb, accumulate);
+            gemm_store_i32(c + ldc + 8, c11, va, vb, accumulate);
+            gemm_store_i32(c + 2 * ldc, c20, va, vb, accumulate);
+            gemm_store_i32(c + 2 * ldc + 8, c21, va, vb, accumulate);
+            gemm_store_i32(c + 3 * ldc, c30, va, vb, accumulate);
+            gemm_store_i32(c + 3 * ldc + 8, c31, va, vb, accumulate);
+        }
+#endif
+    }  // namespace detail
+    template<typename T>
+    [[nodiscard]] gemm_kernel<T> select_gemm_kernel() noexcept {
+#ifdef QM_SIMD_X86
+        if constexpr (std::same_as<T, double>) {
+            if (has_fma()) return {6, 8, detail::gemm_kernel_avx2_f64};
+        } else if constexpr (std::same_as<T, float>) {
+            if (has_fma()) return {6, 16, detail::gemm_kernel_avx2_f32};
+        } else if constexpr (std::same_as<T, std::int32_t>) {
+            if (detected_isa() >= isa::avx2) return {4, 16, detail::gemm_kernel_avx2_i32};
+        }
+#endif
+        return {4, 8, detail::gemm_kernel_generic<T, 4, 8>};
+    }
+    namespace detail {
+        template<typename T>
+        T dot_generic(const T *a, const T *b, std::size_t n) {
+            T           acc[4]{};
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                acc[0] += a[i] * b[i];
+                acc[1] += a[i + 1] * b[i + 1];
+                acc[2] += a[i + 2] * b[i + 2];
+                acc[3] += a[i + 3] * b[i + 3];
+            }
+            for (; i < n; ++i) acc[0] += a[i] * b[i];
+            return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+        }
+        template<typename T>
+        void axpy_generic(T alpha, const T *x, T *y, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) y[i] += alpha * x[i];
+        }
+#ifdef QM_SIMD_X86
+        namespace fma {
+            QM_SIMD_TARGET("avx2,fma") inline __m256d load(const double *p) noexcept { return _mm256_loadu_pd(p); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256 load(const float *p) noexcept { return _mm256_loadu_ps(p); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256d zero(double) noexcept { return _mm256_setzero_pd(); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256 zero(float) noexcept { return _mm256_setzero_ps(); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256d broadcast(double x) noexcept { return _mm256_set1_pd(x); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256 broadcast(float x) noexcept { return _mm256_set1_ps(x); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256d add(__m256d a, __m256d b) noexcept { return _mm256_add_pd(a, b); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256 add(__m256 a, __m256 b) noexcept { return _mm256_add_ps(a, b); }
+            QM_SIMD_TARGET("avx2,fma") inline __m256d fmadd(__m256d a, __m256d b, __m256d c) noexcept {
+                return _mm256_fmadd_pd(a, b, c);
+            }
+            QM_SIMD_TARGET("avx2,fma") inline __m256 fmadd(__m256 a, __m256 b, __m256 c) noexcept {
+                return _mm256_fmadd_ps(a, b, c);
+            }
+            QM_SIMD_TARGET("avx2,fma") inline void store(double *p, __m256d v) noexcept { _mm256_storeu_pd(p, v); }
+            QM_SIMD_TARGET("avx2,fma") inline void store(float *p, __m256 v) noexcept { _mm256_storeu_ps(p, v); }
+            template<Reduce_simd_type T>
+            QM_SIMD_TARGET("avx2,fma")
+            T dot(const T *a, const T *b, std::size_t n) noexcept {
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                auto acc0 = zero(T{}), acc1 = zero(T{}), acc2 = zero(T{}), acc3 = zero(T{});
+                std::size_t i = 0;
+                for (; i + 4 * lanes <= n; i += 4 * lanes) {
+                    acc0 = fmadd(load(a + i), load(b + i), acc0);
+                    acc1 = fmadd(load(a + i + lanes), load(b + i + lanes), acc1);
+                    acc2 = fmadd(load(a + i + 2 * lanes), load(b + i + 2 * lanes), acc2);
+                    acc3 = fmadd(load(a + i + 3 * lanes), load(b + i + 3 * lanes), acc3);
+                }
+                for (; i + lanes <= n; i += lanes) acc0 = fmadd(load(a + i), load(b + i), acc0);
+                alignas(32) T partial[lanes];
+                store(partial, add(add(acc0, acc1), add(acc2, acc3)));
+                T result{};
+                for (std::size_t k = 0; k < lanes; ++k) result += partial[k];
+                for (; i < n; ++i) result += a[i] * b[i];
+                return result;
+            }
+            template<Reduce_simd_type T>
+            QM_SIMD_TARGET("avx2,fma")
+            void axpy(T alpha, const T *x, T *y, std::size_t n) noexcept {
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                const auto            va    = broadcast(alpha);
+                std::size_t           i     = 0;
+                for (; i + 2 * lanes <= n; i += 2 * lanes) {
+                    store(y + i, fmadd(va, load(x + i), load(y + i)));
+                    store(y + i + lanes, fmadd(va, load(x + i + lanes), load(y + i + lanes)));
+                }
+                for (; i + lanes <= n; i += lanes) store(y + i, fmadd(va, load(x + i), load(y + i)));
+                for (; i < n; ++i) y[i] += alpha * x[i];
+            }
+        }  // namespace fma
+#endif
+    }  // namespace detail
+    template<typename T>
+    [[nodiscard]] T dot(const T *a, const T *b, std::size_t n) {
+#ifdef QM_SIMD_X86
+        if constexpr (Reduce_simd_type<T>) {
+            if (has_fma()) return detail::fma::dot(a, b, n);
+        }
+#endif
+        return detail::dot_generic(a, b, n);
+    }
+    template<typename T>
+    void axpy(T alpha, const T *x, T *y, std::size_t n) {
+#ifdef QM_SIMD_X86
+        if constexpr (Reduce_simd_type<T>) {
+            if (has_fma()) {
+                detail::fma::axpy(alpha, x, y, n);
+                return;
+            }
+        }
+#endif
+        detail::axpy_generic(alpha, x, y, n);
+    }
+    namespace detail {
+        template<typename T>
+        void correlate_rows_generic(const T *const *rows, std::size_t row_count, const T *weights, std::size_t taps,
+                                    T *out, std::size_t n, bool accumulate) {
+            if (!accumulate) {
+                for (std::size_t j = 0; j < n; ++j) out[j] = T{};
+            }
+            for (std::size_t u = 0; u < row_count; ++u) {
+                for (std::size_t v = 0; v < taps; ++v) {
+                    const T  w = weights[u * taps + v];
+                    const T *p = rows[u] + v;
+                    QM_IVDEP
+                    for (std::size_t j = 0; j < n; ++j) out[j] += w * p[j];
+                }
+            }
+        }
+#ifdef QM_SIMD_X86
+        namespace fma {
+            template<Reduce_simd_type T>
+            QM_SIMD_TARGET("avx2,fma")
+            void correlate_rows(const T *const *rows, std::size_t row_count, const T *weights, std::size_t taps,
+                                T *out, std::size_t n, bool accumulate) noexcept {
+                constexpr std::size_t lanes = 32 / sizeof(T);
+                std::size_t           j     = 0;
+                for (; j + 2 * lanes <= n; j += 2 * lanes) {
+                    auto s0 = accumulate ? load(out + j) : zero(T{});
+                    auto s1 = accumulate ? load(out + j + lanes) : zero(T{});
+                    for (std::size_t u = 0; u < row_count; ++u) {
+                        const T *p = rows[u] + j;
+                        const T *w = weights + u * taps;
+                        for (std::size_t v = 0; v < taps; ++v) {
+                            const auto wv = broadcast(w[v]);
+                            s0            = fmadd(wv, load(p + v), s0);
+                            s1            = fmadd(wv, load(p + v + lanes), s1);
+                        }
+                    }
+                    store(out + j, s0);
+                    store(out + j + lanes, s1);
+                }
+                for (; j + lanes <= n; j += lanes) {
+                    auto s0 = accumulate ? load(out + j) : zero(T{});
+                    for (std::size_t u = 0; u < row_count; ++u) {
+                        const T *p = rows[u] + j;
+                        const T *w = weights + u * taps;
+                        for (std::size_t v = 0; v < taps; ++v) s0 = fmadd(broadcast(w[v]), load(p + v), s0);
+                    }
+                    store(out + j, s0);
+                }
+                for (; j < n; ++j) {
+                    T acc = accumulate ? out[j] : T{};
+                    for (std::size_t u = 0; u < row_count; ++u) {
+                        for (std::size_t v = 0; v < taps; ++v) acc += weights[u * taps + v] * rows[u][j + v];
+                    }
+                    out[j] = acc;
+                }
+            }
+        }  // namespace fma
+#endif
+    }  // namespace detail
+    template<typename T>
+    void correlate_rows(const T *const *rows, std::size_t row_count, const T *weights, std::size_t taps, T *out,
+                        std::size_t n, bool accumulate = false) {
+#ifdef QM_SIMD_X86
+        if constexpr (Reduce_simd_type<T>) {
+            if (has_fma()) {
+                detail::fma::correlate_rows(rows, row_count, weights, taps, out, n, accumulate);
+                return;
+            }
+        }
+#endif
+        detail::correlate_rows_generic(rows, row_count, weights, taps, out, n, accumulate);
+    }
+}  // namespace qm::simd
+namespace qm {
+    struct array2d_expr_base {};
+    template<typename E>
+    concept Array2d_expression_node = std::derived_from<std::remove_cvref_t<E>, array2d_expr_base>;
+    template<typename M>
+    concept Array2d_matrix_operand = !Array2d_expression_node<M> && requires(const M &m) {
+        typename M::value_type;
+        { m.data() } -> std::convertible_to<const typename M::value_type *>;
+        { m.rows() } -> std::integral;
+        { m.cols() } -> std::integral;
+        { m.pitch() } -> std::integral;
+    };
+    template<typename E>
+    concept Array2d_expression = Array2d_expression_node<E> || Array2d_matrix_operand<std::remove_cvref_t<E>>;
+    template<typename S>
+    concept Array2d_scalar = std::is_arithmetic_v<std::remove_cvref_t<S>>;
+    template<typename T>
+    class array2d_expr_leaf {
+    public:
+        using value_type = T;
+        static constexpr bool is_scalar = false;
+        template<Array2d_matrix_operand M>
+        explicit array2d_expr_leaf(const M &matrix) noexcept
+            : data_(matrix.data()),
+              rows_(static_cast<std::size_t>(matrix.rows())),
+              cols_(static_cast<std::size_t>(matrix.cols())),
+              pitch_(static_cast<std::size_t>(matrix.pitch())) {}
+        [[nodiscard]] std::size_t rows() const noexcept { return rows_; }
+        [[nodiscard]] std::size_t cols() const noexcept { return cols_; }
+        [[nodiscard]] bool contiguous() const noexcept { return pitch_ == cols_ || rows_ <= 1; }
+        [[nodiscard]] QM_FORCEINLINE const T *row(std::size_t i) const noexcept { return data_ + i * pitch_; }
+
+    private:
+        const T    *data_;
+        std::size_t rows_;
+        std::size_t cols_;
+        std::size_t pitch_;
+    };
+    template<typename S>
+    class array2d_expr_scalar {
+    public:
+        using value_type = S;
+        static constexpr bool is_scalar = true;
+        struct row_evaluator {
+            S value;
+            QM_FORCEINLINE S operator[](std::size_t) const noexcept { return value; }
+        };
+        explicit array2d_expr_scalar(S value) noexcept : value_(value) {}
+        [[nodiscard]] static constexpr bool contiguous() noexcept { return true; }
+        [[nodiscard]] QM_FORCEINLINE row_evaluator row(std::size_t) const noexcept { return {value_}; }
+
+    private:
+        S value_;
+    };
+    namespace detail {
+        template<typename E>
+        auto make_operand(const E &e) {
+            if constexpr (Array2d_expression_node<E>) {
+                return e;
+            } else if constexpr (Array2d_scalar<E>) {
+                return array2d_expr_scalar<E>(e);
+            } else {
+                return array2d_expr_leaf<typename E::value_type>(e);
+            }
+        }
+        template<typename E>
+        using operand_t = decltype(make_operand(std::declval<const E &>()));
+    }  // namespace detail
+    template<typename Op, typename... Operands>
+    class array2d_expr : public array2d_expr_base {
+    public:
+        using value_type = std::remove_cvref_t<std::invoke_result_t<const Op &, typename Operands::value_type...>>;
+        static constexpr bool is_scalar = false;
+        template<typename... Rows>
+        struct row_evaluator {
+            Op                  op;
+            std::tuple<Rows...> rows;
+            QM_FORCEINLINE value_type operator[](std::size_t j) const {
+                return std::apply([&](const auto &...r) { return static_cast<value_type>(op(r[j]...)); }, rows);
+            }
+        };
+        explicit array2d_expr(Op op, Operands... operands)
+            : op_(std::move(op)), operands_(std::move(operands)...) {
+            bool has_shape = false;
+            const auto check = [&](const auto &operand) {
+                if constexpr (!std::remove_cvref_t<decltype(operand)>::is_scalar) {
+                    if (!has_shape) {
+                        rows_     = operand.rows();
+                        cols_     = operand.cols();
+                        has_shape = true;
+                    } else if (operand.rows() != rows_ || operand.cols() != cols_) [[unlikely]] {
+                        throw std::invalid_argument("array2d expression: operand shapes do not match");
+                    }
+                }
+            };
+            std::apply([&](const auto &...o) { (check(o), ...); }, operands_);
+        }
+        [[nodiscard]] std::size_t rows() const noexcept { return rows_; }
+        [[nodiscard]] std::size_t cols() const noexcept { return cols_; }
+        [[nodiscard]] bool contiguous() const noexcept {
+            return std::apply([](const auto &...o) { return (o.contiguous() && ...); }, operands_);
+        }
+        [[nodiscard]] QM_FORCEINLINE auto row(std::size_t i) const {
+            return std::apply(
+                    [&](const auto &...o) { return row_evaluator<decltype(o.row(i))...>{op_, {o.row(i)...}}; },
+                    operands_);
+        }
+
+    private:
+        Op                      op_;
+        std::tuple<Operands...> operands_;
+        std::size_t             rows_ = 0;
+        std::size_t             cols_ = 0;
+    };
+    namespace detail {
+        struct expr_min {
+            template<typename A, typename B>
+            QM_FORCEINLINE auto operator()(const A &a, const B &b) const {
+                using R = std::common_type_t<A, B>;
+                return static_cast<R>(b) < static_cast<R>(a) ? static_cast<R>(b) : static_cast<R>(a);
+            }
+        };
+        struct expr_max {
+            template<typename A, typename B>
+            QM_FORCEINLINE auto operator()(const A &a, const B &b) const {
+                using R = std::common_type_t<A, B>;
+                return static_cast<R>(a) < static_cast<R>(b) ? static_cast<R>(b) : static_cast<R>(a);
+            }
+        };
+        struct expr_abs {
+            template<typename A>
+            QM_FORCEINLINE A operator()(const A &a) const {
+                if constexpr (std::is_unsigned_v<A>) {
+                    return a;
+                } else {
+                    return a < A{} ? static_cast<A>(-a) : a;
+                }
+            }
+        };
+        struct expr_clamp {
+            template<typename V, typename L, typename H>
+            QM_FORCEINLINE auto operator()(const V &v, const L &lo, const H &hi) const {
+                using R = std::common_type_t<V, L, H>;
+                const R x = static_cast<R>(v);
+                return x < static_cast<R>(lo) ? static_cast<R>(lo) : (static_cast<R>(hi) < x ? static_cast<R>(hi) : x);
+            }
+        };
+        struct expr_where {
+            template<typename C, typename A, typename B>
+            QM_FORCEINLINE auto operator()(const C &c, const A &a, const B &b) const {
+                using R = std::common_type_t<A, B>;
+                return c ? static_cast<R>(a) : static_cast<R>(b);
+            }
+        };
+        template<typename Op, typename... Args>
+        auto make_expr(Op op, const Args &...args) {
+            return array2d_expr<Op, operand_t<Args>...>(std::move(op), make_operand(args)...);
+        }
+    }  // namespace detail
+    template<typename A, typename B>
+    concept Array2d_expression_args = (Array2d_expression<A> && (Array2d_expression<B> || Array2d_scalar<B>)) ||
+                                      (Array2d_scalar<A> && Array2d_expression<B>);
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto operator+(const A &a, const B &b) {
+        return detail::make_expr(std::plus<>{}, a, b);
+    }
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto operator-(const A &a, const B &b) {
+        return detail::make_expr(std::minus<>{}, a, b);
+    }
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto operator*(const A &a, const B &b) {
+        return detail::make_expr(std::multiplies<>{}, a, b);
+    }
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto operator/(const A &a, const B &b) {
+        return detail::make_expr(std::divides<>{}, a, b);
+    }
+    template<Array2d_expression A>
+    [[nodiscard]] auto operator-(const A &a) {
+        return detail::make_expr(std::negate<>{}, a);
+    }
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto min(const A &a, const B &b) {
+        return detail::make_expr(detail::expr_min{}, a, b);
+    }
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto max(const A &a, const B &b) {
+        return detail::make_expr(detail::expr_max{}, a, b);
+    }
+    template<Array2d_expression A>
+    [[nodiscard]] auto min(const A &a, const A &b) {
+        return detail::make_expr(detail::expr_min{}, a, b);
+    }
+    template<Array2d_expression A>
+    [[nodiscard]] auto max(const A &a, const A &b) {
+        return detail::make_expr(detail::expr_max{}, a, b);
+    }
+    template<Array2d_expression A>
+    [[nodiscard]] auto abs(const A &a) {
+        return detail::make_expr(detail::expr_abs{}, a);
+    }
+    template<Array2d_expression V, typename L, typename H>
+        requires(Array2d_expression<L> || Array2d_scalar<L>) && (Array2d_expression<H> || Array2d_scalar<H>)
+    [[nodiscard]] auto clamp(const V &v, const L &lo, const H &hi) {
+        return detail::make_expr(detail::expr_clamp{}, v, lo, hi);
+    }
+    template<Array2d_expression V>
+    [[nodiscard]] auto clamp(const V &v, const V &lo, const V &hi) {
+        return detail::make_expr(detail::expr_clamp{}, v, lo, hi);
+    }
+    template<Array2d_expression C, typename A, typename B>
+        requires(Array2d_expression<A> || Array2d_scalar<A>) && (Array2d_expression<B> || Array2d_scalar<B>)
+    [[nodiscard]] auto where(const C &cond, const A &a, const B &b) {
+        return detail::make_expr(detail::expr_where{}, cond, a, b);
+    }
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto less(const A &a, const B &b) {
+        return detail::make_expr(std::less<>{}, a, b);
+    }
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto less_equal(const A &a, const B &b) {
+        return detail::make_expr(std::less_equal<>{}, a, b);
+    }
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto greater(const A &a, const B &b) {
+        return detail::make_expr(std::greater<>{}, a, b);
+    }
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto greater_equal(const A &a, const B &b) {
+        return detail::make_expr(std::greater_equal<>{}, a, b);
+    }
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto equal_to(const A &a, const B &b) {
+        return detail::make_expr(std::equal_to<>{}, a, b);
+    }
+    template<typename A, typename B>
+        requires Array2d_expression_args<A, B>
+    [[nodiscard]] auto not_equal_to(const A &a, const B &b) {
+        return detail::make_expr(std::not_equal_to<>{}, a, b);
+    }
+    template<typename T, Array2d_expression_node E>
+    void evaluate_expression(T *dst, std::size_t pitch, const E &expr) {
+        const auto rows = expr.rows();
+        const auto cols = expr.cols();
+        if (rows == 0 || cols == 0) return;
+        const auto run = [](T *out, const auto &row, std::size_t count) {
+            QM_IVDEP
+            for (std::size_t j = 0; j < count; ++j) {
+                out[j] = static_cast<T>(row[j]);
+            }
+        };
+        if ((pitch == cols || rows == 1) && expr.contiguous()) {
+            run(dst, expr.row(0), rows * cols);
+        } else {
+            for (std::size_t i = 0; i < rows; ++i) {
+                run(dst + i * pitch, expr.row(i), cols);
+            }
+        }
+    }
+}  // namespace qm
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#ifndef QM_ARRAY2D_THREADS
+#define QM_ARRAY2D_THREADS 0
+#endif
+namespace qm {
+    class thread_pool {
+    public:
+        explicit thread_pool(std::size_t threads = 0, bool pin_threads = false) : pinned_(pin_threads) {
+            if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+            workers_.reserve(threads - 1);
+            try {
+                for (std::size_t id = 1; id < threads; ++id) {
+                    workers_.emplace_back([this, id] { worker_loop(id); });
+                }
+            } catch (...) {
+                shutdown();
+                throw;
+            }
+        }
+        thread_pool(const thread_pool &)            = delete;
+        thread_pool &operator=(const thread_pool &) = delete;
+        ~thread_pool() { shutdown(); }
+        [[nodiscard]] std::size_t size() const noexcept { return workers_.size() + 1; }
+        [[nodiscard]] bool pinned() const noexcept { return pinned_; }
+        template<typename Fn>
+        void run(std::size_t tasks, Fn &&fn) {
+            if (tasks == 0) return;
+            std::unique_lock submit(submit_, std::try_to_lock);
+            if (tasks == 1 || workers_.empty() || inside_ || !submit.owns_lock()) {
+                for (std::size_t task = 0; task < tasks; ++task) fn(task);
+                return;
+            }
+            using F = std::remove_reference_t<Fn>;
+            job work(&fn, [](void *ctx, std::size_t task) { (*static_cast<F *>(ctx))(task); }, tasks);
+            {
+                std::lock_guard lock(mutex_);
+                job_  = &work;
+                busy_ = workers_.size();
+                ++generation_;
+            }
+            wake_.notify_all();
+            execute(work);
+            {
+                std::unique_lock lock(mutex_);
+                done_.wait(lock, [this] { return busy_ == 0; });
+                job_ = nullptr;
+            }
+            if (work.error) std::rethrow_exception(work.error);
+        }
+
+    private:
+        struct job {
+            void *ctx;
+            void (*invoke)(void *, std::size_t);
+            std::size_t              tasks;
+            std::atomic<std::size_t> next{0};
+            std::exception_ptr       error;
+            std::mutex               error_mutex;
+            job(void *c, void (*f)(void *, std::size_t), std::size_t n) : ctx(c), invoke(f), tasks(n) {}
+        };
+        std::vector<std::thread> workers_;
+        std::mutex               mutex_;
+        std::condition_variable  wake_;
+        std::condition_variable  done_;
+        job                     *job_        = nullptr;
+        std::uint64_t            generation_ = 0;
+        std::size_t              busy_       = 0;
+        bool                     stop_       = false;
+        bool                     pinned_;
+        std::mutex               submit_;
+        static inline thread_local bool inside_ = false;
+        static void execute(job &work) noexcept {
+            inside_ = true;
+            for (;;) {
+                const auto task = work.next.fetch_add(1, std::memory_order_relaxed);
+                if (task >= work.tasks) break;
+                try {
+                    work.invoke(work.ctx, task);
+                } catch (...) {
+                    std::lock_guard lock(work.error_mutex);
+                    if (!work.error) work.error = std::current_exception();
+                    work.next.store(work.tasks, std::memory_order_relaxed);
+                }
+            }
+            inside_ = false;
+        }
+        void worker_loop(std::size_t id) {
+            if (pinned_) pin_current_thread(id);
+            std::uint64_t seen = 0;
+            for (;;) {
+                job *work;
+                {
+                    std::unique_lock lock(mutex_);
+                    wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                    if (stop_) return;
+                    seen = generation_;
+                    work = job_;
+                }
+                execute(*work);
+                {
+                    std::lock_guard lock(mutex_);
+                    if (--busy_ == 0) done_.notify_one();
+                }
+            }
+        }
+        void shutdown() noexcept {
+            {
+                std::lock_guard lock(mutex_);
+                stop_ = true;
+            }
+            wake_.notify_all();
+            for (auto &worker: workers_) {
+                if (worker.joinable()) worker.join();
+            }
+            workers_.clear();
+        }
+        static void pin_current_thread([[maybe_unused]] std::size_t id) noexcept {
+#if defined(__linux__)
+            const auto cpus = std::max(1u, std::thread::hardware_concurrency());
+            cpu_set_t  set;
+            CPU_ZERO(&set);
+            CPU_SET(id % cpus, &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+        }
+    };
+    namespace detail {
+        inline std::mutex &default_thread_pool_mutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
+        inline std::unique_ptr<thread_pool> &default_thread_pool_storage() {
+            static std::unique_ptr<thread_pool> pool;
+            return pool;
+        }
+        inline std::atomic<thread_pool *> &default_thread_pool_pointer() {
+            static std::atomic<thread_pool *> pointer{nullptr};
+            return pointer;
+        }
+    }  // namespace detail
+    inline thread_pool &default_thread_pool() {
+        if (auto *pool = detail::default_thread_pool_pointer().load(std::memory_order_acquire)) [[likely]] {
+            return *pool;
+        }
+        std::lock_guard lock(detail::default_thread_pool_mutex());
+        auto           &storage = detail::default_thread_pool_storage();
+        if (!storage) {
+            storage = std::make_unique<thread_pool>(QM_ARRAY2D_THREADS);
+            detail::default_thread_pool_pointer().store(storage.get(), std::memory_order_release);
+        }
+        return *storage;
+    }
+    inline void configure_thread_pool(std::size_t threads, bool pin_threads = false) {
+        std::lock_guard lock(detail::default_thread_pool_mutex());
+        auto           &storage = detail::default_thread_pool_storage();
+        detail::default_thread_pool_pointer().store(nullptr, std::memory_order_release);
+        storage.reset();
+        storage = std::make_unique<thread_pool>(threads, pin_threads);
+        detail::default_thread_pool_pointer().store(storage.get(), std::memory_order_release);
+    }
+    namespace detail {
+        inline std::pair<std::size_t, std::size_t> chunk_bounds(std::size_t units, std::size_t chunk,
+                                                                std::size_t chunks) noexcept {
+            return {units * chunk / chunks, units * (chunk + 1) / chunks};
+        }
+        template<typename Fn>
+        void parallel_chunks(std::size_t total, std::size_t align, Fn &&fn) {
+            if (total == 0) return;
+            auto      &pool   = default_thread_pool();
+            const auto units  = (total + align - 1) / align;
+            const auto chunks = std::min<std::size_t>(units, pool.size() * 4);
+            pool.run(chunks, [&](std::size_t chunk) {
+                const auto [lo, hi] = chunk_bounds(units, chunk, chunks);
+                const auto first    = lo * align;
+                const auto last     = std::min(hi * align, total);
+                if (first < last) fn(first, last);
+            });
+        }
+        struct alignas(64) steal_range {
+            std::mutex               mutex;
+            std::atomic<std::size_t> first{0};
+            std::atomic<std::size_t> last{0};
+            [[nodiscard]] std::size_t remaining() const noexcept {
+                const auto f = first.load(std::memory_order_relaxed);
+                const auto l = last.load(std::memory_order_relaxed);
+                return l > f ? l - f : 0;
+            }
+        };
+        inline std::size_t default_grain(std::size_t total, std::size_t threads) noexcept {
+            return std::max<std::size_t>(1, total / (threads * 16));
+        }
+        template<typename Fn>
+        void parallel_steal(std::size_t total, std::size_t grain, Fn &&fn) {
+            if (total == 0) return;
+            auto      &pool    = default_thread_pool();
+            const auto threads = std::min(pool.size(), total);
+            if (grain == 0) grain = default_grain(total, threads);
+            if (threads == 1 || grain >= total) {
+                for (std::size_t first = 0; first < total; first += grain) fn(first, std::min(first + grain, total));
+                return;
+            }
+            std::vector<steal_range> ranges(threads);
+            for (std::size_t t = 0; t < threads; ++t) {
+                ranges[t].first.store(total * t / threads, std::memory_order_relaxed);
+                ranges[t].last.store(total * (t + 1) / threads, std::memory_order_relaxed);
+            }
+            std::atomic<bool> failed{false};
+            const auto take = [&](std::size_t victim, bool own, std::size_t &first, std::size_t &last) {
+                auto           &range = ranges[victim];
+                std::lock_guard lock(range.mutex);
+                const auto      f = range.first.load(std::memory_order_relaxed);
+                const auto      l = range.last.load(std::memory_order_relaxed);
+                if (f >= l) return false;
+                if (own) {
+                    first = f;
+                    last  = std::min(l, f + grain);
+                    range.first.store(last, std::memory_order_relaxed);
+                } else {
+                    first = l - f > grain ? f + (l - f) / 2 : f;
+                    last  = l;
+                    range.last.store(first, std::memory_order_relaxed);
+                }
+                return true;
+            };
+            pool.run(threads, [&](std::size_t self) {
+                std::size_t first, last;
+                while (!failed.load(std::memory_order_relaxed)) {
+                    if (!take(self, true, first, last)) {
+                        std::size_t victim = self, most = 0;
+                        for (std::size_t t = 0; t < threads; ++t) {
+                            if (const auto rest = ranges[t].remaining(); t != self && rest > most) {
+                                victim = t;
+                                most   = rest;
+                            }
+                        }
+                        if (most == 0) break;
+                        if (!take(victim, false, first, last)) continue;
+                        std::lock_guard lock(ranges[self].mutex);
+                        ranges[self].first.store(std::min(last, first + grain), std::memory_order_relaxed);
+                        ranges[self].last.store(last, std::memory_order_relaxed);
+                        last = std::min(last, first + grain);
+                    }
+                    try {
+                        fn(first, last);
+                    } catch (...) {
+                        failed.store(true, std::memory_order_relaxed);
+                        throw;
+                    }
+                }
+            });
+        }
+    }  // namespace detail
+    template<std::integral Idx, typename Fn>
+    void parallel_for_rows(Idx rows, Fn &&fn, std::size_t grain = 0) {
+        if (std::cmp_less_equal(rows, 0)) return;
+        detail::parallel_steal(static_cast<std::size_t>(rows), grain, [&](std::size_t first, std::size_t last) {
+            fn(static_cast<Idx>(first), static_cast<Idx>(last));
+        });
+    }
+    template<typename M, typename Fn>
+        requires requires(const M &m) {
+            { m.rows() } -> std::integral;
+        }
+    void parallel_for_rows(const M &matrix, Fn &&fn, std::size_t grain = 0) {
+        parallel_for_rows(matrix.rows(), std::forward<Fn>(fn), grain);
+    }
+    template<std::integral Idx, typename Fn>
+    void parallel_for_tiles(Idx rows, Idx cols, Idx tile_rows, Idx tile_cols, Fn &&fn) {
+        if (std::cmp_less_equal(tile_rows, 0) || std::cmp_less_equal(tile_cols, 0)) [[unlikely]] {
+            throw std::invalid_argument("parallel_for_tiles: tile size must be positive");
+        }
+        if (std::cmp_less_equal(rows, 0) || std::cmp_less_equal(cols, 0)) return;
+        const auto height       = static_cast<std::size_t>(tile_rows);
+        const auto width        = static_cast<std::size_t>(tile_cols);
+        const auto tiles_down   = (static_cast<std::size_t>(rows) + height - 1) / height;
+        const auto tiles_across = (static_cast<std::size_t>(cols) + width - 1) / width;
+        detail::parallel_steal(tiles_down * tiles_across, 1, [&](std::size_t first, std::size_t last) {
+            for (auto tile = first; tile < last; ++tile) {
+                const auto r0 = tile / tiles_across * height;
+                const auto c0 = tile % tiles_across * width;
+                fn(static_cast<Idx>(r0), static_cast<Idx>(std::min(r0 + height, static_cast<std::size_t>(rows))),
+                   static_cast<Idx>(c0), static_cast<Idx>(std::min(c0 + width, static_cast<std::size_t>(cols))));
+            }
+        });
+    }
+}  // namespace qm
+#ifndef QM_ARRAY_RESET_OPT_DEFINED
+#define QM_ARRAY_RESET_OPT_DEFINED
+namespace qm {
+    enum class Array_reset_opt : std::int8_t {
+        All_bits0 = 0,
+        All_bits1 = -1,
+        Safe_max  = 0x3F
+    };
+    enum class Array_sum_opt : std::int8_t {
+        Fast     = 0,
+        Pairwise = 1,
+        Kahan    = 2
+    };
+    template<typename T>
+    concept Array2d_compatible =
+            std::is_object_v<T> &&
+            !std::is_abstract_v<T> &&
+            requires { sizeof(T); };
+    template<typename Idx>
+    concept Array2d_index_type =
+            std::is_integral_v<Idx> &&
+            !std::is_same_v<Idx, bool> &&
+            !std::is_same_v<Idx, char>;
+    struct dense_layout {};
+    struct pitched_layout {
+        static constexpr std::size_t line_size       = 64;
+        static constexpr std::size_t conflict_stride = 1024;
+    };
+    template<typename L>
+    concept Array2d_layout = std::same_as<L, dense_layout> || std::same_as<L, pitched_layout>;
+    struct row_pitch {
+        std::size_t value;
+    };
+    struct uninitialized_t {
+        explicit uninitialized_t() = default;
+    };
+    inline constexpr uninitialized_t uninitialized{};
+    template<typename Ty, Array2d_index_type Idx>
+        requires Array2d_compatible<std::remove_const_t<Ty>>
+    class array2d_view;
+    template<typename Ty, Array2d_index_type Idx>
+        requires std::is_trivially_copyable_v<Ty> && (!std::is_const_v<Ty>)
+    class array2d_atomic_view;
+    template<Array2d_compatible Ty, Array2d_index_type Idx = int, typename Alloc = std::allocator<Ty>,
+             Array2d_layout Layout = dense_layout>
+    class array2d {
+    public:
+        using value_type             = Ty;
+        using index_type             = Idx;
+        using size_type              = std::make_unsigned_t<Idx>;
+        using difference_type        = std::make_signed_t<Idx>;
+        using pointer                = Ty *;
+        using const_pointer          = const Ty *;
+        using reference              = Ty &;
+        using const_reference        = const Ty &;
+        using allocator_type  = typename std::allocator_traits<Alloc>::template rebind_alloc<Ty>;
+        using layout_type     = Layout;
+        static constexpr bool is_pitched = std::same_as<Layout, pitched_layout>;
+        using iterator = std::conditional_t<is_pitched, Array2d_pitched_iterator<Ty>, Array2d_iterator<Ty>>;
+        using const_iterator = std::conditional_t<is_pitched, Array2d_pitched_iterator<const Ty>, Array2d_iterator<const Ty>>;
+        using reverse_iterator       = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        static constexpr std::size_t storage_alignment = allocator_alignment_v<allocator_type>;
+        using storage_type = std::vector<Ty, default_init_allocator<allocator_type>>;
+        constexpr array2d() noexcept(noexcept(allocator_type())) = default;
+        constexpr explicit array2d(const allocator_type &alloc) noexcept
+            : data_(alloc) {}
+        array2d(index_type rows, index_type cols, const allocator_type &alloc = allocator_type())
+            : rows_(validate_dimension(rows, "rows")),
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(default_pitch(cols_)),
+              data_(alloc) {
+            if (rows_ > 0 && cols_ > 0) {
+                const auto size = calculate_size(rows_, pitch_);
+                resize_value_initialized(data_, size);
+            }
+        }
+        array2d(index_type rows, index_type cols, uninitialized_t, const allocator_type &alloc = allocator_type())
+            requires std::is_trivially_default_constructible_v<Ty>
+            : rows_(validate_dimension(rows, "rows")),
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(default_pitch(cols_)),
+              data_(alloc) {
+            if (rows_ > 0 && cols_ > 0) {
+                data_.resize(calculate_size(rows_, pitch_));
+            }
+        }
+        array2d(index_type rows, index_type cols, const Ty &val, const allocator_type &alloc = allocator_type())
+            : rows_(validate_dimension(rows, "rows")),
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(default_pitch(cols_)),
+              data_(alloc) {
+            if (rows_ > 0 && cols_ > 0) {
+                const auto size = calculate_size(rows_, pitch_);
+                data_.resize(size, val);
+            }
+        }
+        array2d(index_type rows, index_type cols, row_pitch pitch, const allocator_type &alloc = allocator_type())
+            requires is_pitched
+            : rows_(validate_dimension(rows, "rows")),
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(validate_pitch(pitch, cols_)),
+              data_(alloc) {
+            if (rows_ > 0 && cols_ > 0) {
+                const auto size = calculate_size(rows_, pitch_);
+                resize_value_initialized(data_, size);
+            }
+        }
+        array2d(index_type rows, index_type cols, row_pitch pitch, uninitialized_t,
+                const allocator_type &alloc = allocator_type())
+            requires is_pitched && std::is_trivially_default_constructible_v<Ty>
+            : rows_(validate_dimension(rows, "rows")),
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(validate_pitch(pitch, cols_)),
+              data_(alloc) {
+            if (rows_ > 0 && cols_ > 0) {
+                data_.resize(calculate_size(rows_, pitch_));
+            }
+        }
+        array2d(index_type rows, index_type cols, row_pitch pitch, const Ty &val,
+                const allocator_type &alloc = allocator_type())
+            requires is_pitched
+            : rows_(validate_dimension(rows, "rows")),
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(validate_pitch(pitch, cols_)),
+              data_(alloc) {
+            if (rows_ > 0 && cols_ > 0) {
+                const auto size = calculate_size(rows_, pitch_);
+                data_.resize(size, val);
+            }
+        }
+        array2d(std::initializer_list<std::initializer_list<Ty>> init_list,
+                const allocator_type                             &alloc = allocator_type())
+            : data_(alloc) {
+            if (init_list.size() == 0) {
+                rows_ = cols_ = 0;
+                return;
+            }
+            rows_ = static_cast<index_type>(init_list.size());
+            cols_ = static_cast<index_type>(init_list.begin()->size());
+            pitch_ = default_pitch(cols_);
+            for (const auto &row: init_list) {
+                if (static_cast<index_type>(row.size()) != cols_) {
+                    throw std::invalid_argument("All rows must have the same number of columns");
+                }
+            }
+            if constexpr (is_pitched) {
+                resize_value_initialized(data_, calculate_size(rows_, pitch_));
+                index_type i = 0;
+                for (const auto &row: init_list) {
+                    std::ranges::copy(row, data_.data() + calculate_offset(i++, 0));
+                }
+            } else {
+            const auto size = calculate_size(rows_, cols_);
+            data_.reserve(size);
+            for (const auto &row: init_list) {
+                data_.insert(data_.end(), row.begin(), row.end());
+                }
+            }
+        }
+        template<typename Container>
+        array2d(index_type rows, index_type cols, const Container &container,
+                const allocator_type &alloc = allocator_type())
+            requires std::ranges::range<Container> &&
+                             std::convertible_to<std::ranges::range_value_t<Container>, Ty>
+            : rows_(validate_dimension(rows, "rows")),
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(default_pitch(cols_)),
+              data_(alloc) {
+            const auto expected_size = calculate_size(rows_, cols_);
+            if (std::ranges::size(container) != expected_size) {
+                throw std::invalid_argument("Container size doesn't match matrix dimensions");
+            }
+            if constexpr (is_pitched) {
+                if (expected_size == 0) return;
+                resize_value_initialized(data_, calculate_size(rows_, pitch_));
+                auto src = std::ranges::begin(container);
+                for (index_type i = 0; i < rows_; ++i) {
+                    src = std::ranges::copy_n(src, cols_, data_.data() + calculate_offset(i, 0)).in;
+                }
+            } else {
+            data_.reserve(expected_size);
+            std::ranges::copy(container, std::back_inserter(data_));
+            }
+        }
+        array2d(const array2d &)                = default;
+        array2d(array2d &&) noexcept            = default;
+        array2d(const array2d &other, const allocator_type &alloc)
+            : rows_(other.rows_),
+              cols_(other.cols_),
+              pitch_(other.pitch_),
+              data_(other.data_, alloc) {}
+        array2d(array2d &&other, const allocator_type &alloc)
+            : rows_(other.rows_),
+              cols_(other.cols_),
+              pitch_(other.pitch_),
+              data_(std::move(other.data_), alloc) {
+            other.rows_ = other.cols_ = other.pitch_ = 0;
+            other.data_.clear();
+        }
+        template<Array2d_expression_node E>
+            requires std::convertible_to<typename E::value_type, Ty>
+        array2d(const E &expr, const allocator_type &alloc = allocator_type())
+            : rows_(static_cast<index_type>(expr.rows())),
+              cols_(static_cast<index_type>(expr.cols())),
+              pitch_(default_pitch(cols_)),
+              data_(alloc) {
+            data_.resize(static_cast<size_type>(calculate_size(rows_, pitch_)));
+            evaluate_expression(data_.data(), static_cast<std::size_t>(pitch()), expr);
+        }
+        array2d &operator=(const array2d &)     = default;
+        array2d &operator=(array2d &&) noexcept = default;
+        template<Array2d_expression_node E>
+            requires std::convertible_to<typename E::value_type, Ty>
+        array2d &operator=(const E &expr) {
+            if (expr.rows() == static_cast<std::size_t>(rows_) && expr.cols() == static_cast<std::size_t>(cols_)) {
+                evaluate_expression(data_.data(), static_cast<std::size_t>(pitch()), expr);
+            } else {
+                *this = array2d(expr, get_allocator());
+            }
+            return *this;
+        }
+        template<typename Rhs>
+            requires Array2d_expression_args<array2d, Rhs>
+        array2d &operator+=(const Rhs &rhs) {
+            return *this = *this + rhs;
+        }
+        template<typename Rhs>
+            requires Array2d_expression_args<array2d, Rhs>
+        array2d &operator-=(const Rhs &rhs) {
+            return *this = *this - rhs;
+        }
+        template<typename Rhs>
+            requires Array2d_expression_args<array2d, Rhs>
+        array2d &operator*=(const Rhs &rhs) {
+            return *this = *this * rhs;
+        }
+        template<typename Rhs>
+            requires Array2d_expression_args<array2d, Rhs>
+        array2d &operator/=(const Rhs &rhs) {
+            return *this = *this / rhs;
+        }
+        ~array2d()                              = default;
+        [[nodiscard]] QM_FORCEINLINE pointer operator[](index_type row) noexcept {
+            assert_bounds(row, rows_);
+            return data_.data() + calculate_offset(row, 0);
+        }
+        [[nodiscard]] QM_FORCEINLINE const_pointer operator[](index_type row) const noexcept {
+            assert_bounds(row, rows_);
+            return data_.data() + calculate_offset(row, 0);
+        }
+        [[nodiscard]] QM_FORCEINLINE reference operator()(index_type row, index_type col) noexcept {
+            assert_bounds(row, rows_);
+            assert_bounds(col, cols_);
+            return data_[calculate_offset(row, col)];
+        }
+        [[nodiscard]] QM_FORCEINLINE const_reference operator()(index_type row, index_type col) const noexcept {
+            assert_bounds(row, rows_);
+            assert_bounds(col, cols_);
+            return data_[calculate_offset(row, col)];
+        }
+        [[nodiscard]] reference at(index_type row, index_type col) {
+            return at_impl<false>(row, col);
+        }
+        [[nodiscard]] const_reference at(index_type row, index_type col) const {
+            return at_impl<true>(row, col);
+        }
+        [[nodiscard]] constexpr iterator begin() noexcept {
+            return make_iterator<iterator>(data_.data());
+        }
+        [[nodiscard]] constexpr const_iterator begin() const noexcept {
+            return make_iterator<const_iterator>(data_.data());
+        }
+        [[nodiscard]] constexpr iterator end() noexcept {
+            return make_iterator<iterator>(data_.data() + data_.size());
+        }
+        [[nodiscard]] constexpr const_iterator end() const noexcept {
+            return make_iterator<const_iterator>(data_.data() + data_.size());
+        }
+        [[nodiscard]] constexpr const_iterator   cbegin() const noexcept { return begin(); }
+        [[nodiscard]] constexpr const_iterator   cend() const noexcept { return end(); }
+        [[nodiscard]] constexpr reverse_iterator rbegin() noexcept {
+            return reverse_iterator(end());
+        }
+        [[nodiscard]] constexpr const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator(end());
+        }
+        [[nodiscard]] constexpr reverse_iterator rend() noexcept {
+            return reverse_iterator(begin());
+        }
+        [[nodiscard]] constexpr const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator(begin());
         }
         [[nodiscard]] constexpr const_reverse_iterator crbegin() const noexcept { return rbegin(); }
         [[nodiscard]] constexpr const_reverse_iterator crend() const noexcept { return rend(); }
+        struct row_iterator_wrapper {
+            using iterator = Array2d_iterator<Ty>;
+            pointer   ptr_;
+            size_type cols_;
+            row_iterator_wrapper(pointer ptr, size_type cols) : ptr_(ptr), cols_(cols) {}
+            [[nodiscard]] iterator begin() const noexcept { return iterator(ptr_); }
+            [[nodiscard]] iterator end() const noexcept { return iterator(ptr_ + cols_); }
+        };
+        struct const_row_iterator_wrapper {
+            using const_iterator = Array2d_iterator<const Ty>;
+            const_pointer ptr_;
+            size_type     cols_;
+            const_row_iterator_wrapper(const_pointer ptr, size_type cols) : ptr_(ptr), cols_(cols) {}
+            [[nodiscard]] const_iterator begin() const noexcept { return const_iterator(ptr_); }
+            [[nodiscard]] const_iterator end() const noexcept { return const_iterator(ptr_ + cols_); }
+        };
+        [[nodiscard]] row_iterator_wrapper row_range(index_type row) noexcept {
+            assert_bounds(row, rows_);
+            return {data_.data() + calculate_offset(row, 0), static_cast<size_type>(cols_)};
+        }
+        [[nodiscard]] const_row_iterator_wrapper row_range(index_type row) const noexcept {
+            assert_bounds(row, rows_);
+            return {data_.data() + calculate_offset(row, 0), static_cast<size_type>(cols_)};
+        }
+        [[nodiscard]] constexpr index_type rows() const noexcept { return rows_; }
+        [[nodiscard]] constexpr index_type cols() const noexcept { return cols_; }
+        [[nodiscard]] constexpr index_type pitch() const noexcept {
+            if constexpr (is_pitched) {
+                return pitch_;
+            } else {
+                return cols_;
+            }
+        }
+        [[nodiscard]] constexpr size_type size() const noexcept {
+            if constexpr (is_pitched) {
+                return static_cast<size_type>(rows_) * static_cast<size_type>(cols_);
+            } else {
+                return data_.size();
+            }
+        }
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            if constexpr (is_pitched) {
+                return rows_ == 0 || cols_ == 0;
+            } else {
+                return data_.empty();
+            }
+        }
+        [[nodiscard]] constexpr size_type  capacity() const noexcept { return data_.capacity(); }
+        [[nodiscard]] constexpr bool       is_square() const noexcept { return rows_ == cols_; }
+        [[nodiscard]] constexpr allocator_type get_allocator() const noexcept {
+            return static_cast<const allocator_type &>(data_.get_allocator());
+        }
+        [[nodiscard]] constexpr bool rows_aligned() const noexcept {
+            return (static_cast<std::size_t>(pitch()) * sizeof(Ty)) % storage_alignment == 0;
+        }
+        void                               reserve(index_type rows, index_type cols) {
+            const auto new_capacity = calculate_size(
+                    validate_dimension(rows, "rows"),
+                    default_pitch(validate_dimension(cols, "cols")));
+            data_.reserve(new_capacity);
+        }
+        void shrink_to_fit() {
+            data_.shrink_to_fit();
+        }
+        [[nodiscard]] constexpr std::span<Ty> as_span() noexcept
+            requires(!is_pitched)
+        {
+            return {std::assume_aligned<storage_alignment>(data_.data()), data_.size()};
+        }
+        [[nodiscard]] constexpr std::span<const Ty> as_span() const noexcept
+            requires(!is_pitched)
+        {
+            return {std::assume_aligned<storage_alignment>(data_.data()), data_.size()};
+        }
+        [[nodiscard]] constexpr std::span<Ty> row(index_type row) noexcept {
+            assert_bounds(row, rows_);
+            return {data_.data() + calculate_offset(row, 0), static_cast<size_type>(cols_)};
+        }
+        [[nodiscard]] constexpr std::span<const Ty> row(index_type row) const noexcept {
+            assert_bounds(row, rows_);
+            return {data_.data() + calculate_offset(row, 0), static_cast<size_type>(cols_)};
+        }
+        [[nodiscard]] std::vector<Ty> col(index_type col) const {
+            assert_bounds(col, cols_);
+            std::vector<Ty> result;
+            result.reserve(static_cast<size_type>(rows_));
+            for (index_type i = 0; i < rows_; ++i) {
+                result.push_back(data_[calculate_offset(i, col)]);
+            }
+            return result;
+        }
+        [[nodiscard]] constexpr array2d_column<Ty> col_view(index_type col) noexcept {
+            assert_bounds(col, cols_);
+            return {data_.data() + col, static_cast<size_type>(rows_), pitch()};
+        }
+        [[nodiscard]] constexpr array2d_column<const Ty> col_view(index_type col) const noexcept {
+            assert_bounds(col, cols_);
+            return {data_.data() + col, static_cast<size_type>(rows_), pitch()};
+        }
+        [[nodiscard]] std::span<Ty> submatrix_row_major(
+                index_type start_row, index_type start_col,
+                index_type num_rows, index_type num_cols) noexcept {
+            assert_bounds(start_row, rows_);
+            assert_bounds(start_col, cols_);
+            assert_bounds(start_row + num_rows - 1, rows_);
+            assert_bounds(start_col + num_cols - 1, cols_);
+            if (start_col == 0 && num_cols == cols_ && pitch() == cols_) {
+                return {data_.data() + calculate_offset(start_row, 0),
+                        static_cast<size_type>(num_rows * cols_)};
+            }
+            return {data_.data() + calculate_offset(start_row, start_col),
+                    static_cast<size_type>(num_cols)};
+        }
+        [[nodiscard]] array2d_view<Ty, Idx> submatrix(index_type start_row, index_type start_col,
+                                                      index_type num_rows, index_type num_cols) {
+            check_block(start_row, start_col, num_rows, num_cols);
+            return {data_.data() + calculate_offset(start_row, start_col), num_rows, num_cols,
+                    row_pitch{static_cast<std::size_t>(pitch())}};
+        }
+        [[nodiscard]] array2d_view<const Ty, Idx> submatrix(index_type start_row, index_type start_col,
+                                                            index_type num_rows, index_type num_cols) const {
+            check_block(start_row, start_col, num_rows, num_cols);
+            return {data_.data() + calculate_offset(start_row, start_col), num_rows, num_cols,
+                    row_pitch{static_cast<std::size_t>(pitch())}};
+        }
+        [[nodiscard]] auto atomic_view()
+            requires std::is_trivially_copyable_v<Ty>
+        {
+            return array2d_atomic_view<Ty, Idx>(*this);
+        }
+        void reset(Array_reset_opt opt = Array_reset_opt::All_bits0) noexcept {
+            if (data_.empty()) return;
+            if constexpr (std::is_trivially_destructible_v<Ty> &&
+                          std::is_trivially_default_constructible_v<Ty> &&
+                          std::is_standard_layout_v<Ty>) {
+                simd::fill_bytes(data_.data(), static_cast<unsigned char>(opt), data_.size() * sizeof(Ty));
+            } else {
+                if constexpr (std::is_nothrow_default_constructible_v<Ty>) {
+                    std::fill(data_.begin(), data_.end(), Ty{});
+                } else {
+                    for (auto &element: data_) {
+                        element = Ty{};
+                    }
+                }
+            }
+        }
+        void fill(const Ty &val) noexcept(std::is_nothrow_copy_assignable_v<Ty>) {
+            if constexpr (simd::Fill_pattern_type<Ty>) {
+                simd::fill(data_.data(), data_.size(), val);
+            } else {
+                std::fill(data_.begin(), data_.end(), val);
+            }
+        }
+        void fill_parallel(const Ty &val) {
+            if (data_.size() > 10000) {
+                detail::parallel_chunks(data_.size(), std::max<std::size_t>(1, 64 / sizeof(Ty)),
+                                        [&](std::size_t first, std::size_t last) {
+                                            if constexpr (simd::Fill_pattern_type<Ty>) {
+                                                simd::fill(data_.data() + first, last - first, val);
+                                            } else {
+                                                std::fill(data_.begin() + first, data_.begin() + last, val);
+                                            }
+                                        });
+            } else {
+                fill(val);
+            }
+        }
+        [[nodiscard]] Ty sum(Array_sum_opt opt = Array_sum_opt::Fast) const {
+            if constexpr (is_pitched) {
+                return sum_rows(0, rows_, opt);
+            } else {
+                return sum_segment(data_.data(), data_.size(), opt);
+            }
+        }
+        [[nodiscard]] Ty sum_parallel(Array_sum_opt opt = Array_sum_opt::Fast) const {
+            const auto total = static_cast<std::size_t>(rows_) * static_cast<std::size_t>(cols_);
+            if (total <= 10000) return sum(opt);
+            const auto units  = is_pitched ? static_cast<std::size_t>(rows_) : total;
+            auto      &pool   = default_thread_pool();
+            const auto chunks = std::min<std::size_t>(units, pool.size() * 4);
+            std::vector<Ty> partial(chunks);
+            pool.run(chunks, [&](std::size_t chunk) {
+                Ty        &result        = partial[chunk];
+                const auto [first, last] = detail::chunk_bounds(units, chunk, chunks);
+                if constexpr (is_pitched) {
+                    result = sum_rows(static_cast<index_type>(first), static_cast<index_type>(last), opt);
+                } else {
+                    result = sum_segment(data_.data() + first, static_cast<size_type>(last - first), opt);
+                }
+            });
+            return sum_segment(partial.data(), static_cast<size_type>(partial.size()), opt);
+        }
+        [[nodiscard]] Ty min() const {
+            return extremum<false>("min");
+        }
+        [[nodiscard]] Ty max() const {
+            return extremum<true>("max");
+        }
+        [[nodiscard]] std::pair<index_type, index_type> argmin() const {
+            return arg_extremum<false>("argmin");
+        }
+        [[nodiscard]] std::pair<index_type, index_type> argmax() const {
+            return arg_extremum<true>("argmax");
+        }
+        template<typename T, typename BinaryOp = std::plus<>>
+        [[nodiscard]] std::vector<T> row_reduce(T init, BinaryOp op = {}) const {
+            constexpr bool vectorized_sum = std::same_as<T, Ty> &&
+                                            (std::same_as<BinaryOp, std::plus<>> || std::same_as<BinaryOp, std::plus<Ty>>);
+            std::vector<T> result;
+            result.reserve(static_cast<size_type>(rows_));
+            for (index_type i = 0; i < rows_; ++i) {
+                const Ty *row = data_.data() + calculate_offset(i, 0);
+                if constexpr (vectorized_sum) {
+                    result.push_back(init + simd::sum(row, static_cast<size_type>(cols_)));
+                } else {
+                    T acc = init;
+                    for (index_type j = 0; j < cols_; ++j) {
+                        acc = op(std::move(acc), row[j]);
+                    }
+                    result.push_back(std::move(acc));
+                }
+            }
+            return result;
+        }
+        template<typename T, typename BinaryOp = std::plus<>>
+        [[nodiscard]] std::vector<T> col_reduce(T init, BinaryOp op = {}) const {
+            std::vector<T> result(static_cast<size_type>(cols_), init);
+            for (index_type i = 0; i < rows_; ++i) {
+                const Ty *row = data_.data() + calculate_offset(i, 0);
+                for (index_type j = 0; j < cols_; ++j) {
+                    result[j] = op(std::move(result[j]), row[j]);
+                }
+            }
+            return result;
+        }
+        void copy_row(index_type src_row, index_type dest_row) noexcept(std::is_nothrow_copy_assignable_v<Ty>) {
+            assert_bounds(src_row, rows_);
+            assert_bounds(dest_row, rows_);
+            if (src_row == dest_row) return;
+            const auto src_offset  = calculate_offset(src_row, 0);
+            const auto dest_offset = calculate_offset(dest_row, 0);
+            const auto copy_size   = static_cast<size_type>(cols_);
+            if constexpr (std::is_trivially_copyable_v<Ty>) {
+                std::memcpy(data_.data() + dest_offset,
+                            data_.data() + src_offset,
+                            copy_size * sizeof(Ty));
+            } else {
+                std::copy_n(data_.data() + src_offset, copy_size, data_.data() + dest_offset);
+            }
+        }
+        void swap_rows(index_type row1, index_type row2) noexcept(std::is_nothrow_swappable_v<Ty>) {
+            assert_bounds(row1, rows_);
+            assert_bounds(row2, rows_);
+            if (row1 == row2) return;
+            const auto offset1   = calculate_offset(row1, 0);
+            const auto offset2   = calculate_offset(row2, 0);
+            const auto swap_size = static_cast<size_type>(cols_);
+            if constexpr (std::is_trivially_copyable_v<Ty>) {
+                simd::swap_bytes(data_.data() + offset1, data_.data() + offset2, swap_size * sizeof(Ty));
+            } else {
+            for (size_type i = 0; i < swap_size; ++i) {
+                using std::swap;
+                swap(data_[offset1 + i], data_[offset2 + i]);
+                }
+            }
+        }
+        void fill_row(index_type row, const Ty &val) noexcept(std::is_nothrow_copy_assignable_v<Ty>) {
+            assert_bounds(row, rows_);
+            const auto offset = calculate_offset(row, 0);
+            std::fill_n(data_.data() + offset, cols_, val);
+        }
+        void permute_rows(std::span<const index_type> perm) {
+            validate_permutation(perm, rows_, "permute_rows");
+            std::vector<Ty> buffer;
+            buffer.reserve(static_cast<size_type>(cols_));
+            std::vector<bool> done(static_cast<size_type>(rows_));
+            for (index_type start = 0; start < rows_; ++start) {
+                if (done[start] || perm[start] == start) continue;
+                if (perm[perm[start]] == start) {
+                    done[start] = done[perm[start]] = true;
+                    swap_rows(start, perm[start]);
+                    continue;
+                }
+                Ty *const first = data_.data() + calculate_offset(start, 0);
+                buffer.assign(std::make_move_iterator(first), std::make_move_iterator(first + cols_));
+                index_type cur = start;
+                while (perm[cur] != start) {
+                    done[cur] = true;
+                    relocate_row(perm[cur], cur);
+                    cur = perm[cur];
+                }
+                done[cur] = true;
+                std::move(buffer.begin(), buffer.end(), data_.data() + calculate_offset(cur, 0));
+            }
+        }
+        void permute_cols(std::span<const index_type> perm) {
+            validate_permutation(perm, cols_, "permute_cols");
+            std::vector<Ty> buffer;
+            buffer.reserve(static_cast<size_type>(cols_));
+            for (index_type i = 0; i < rows_; ++i) {
+                Ty *const row = data_.data() + calculate_offset(i, 0);
+                buffer.clear();
+                for (index_type j = 0; j < cols_; ++j) {
+                    buffer.push_back(std::move(row[perm[j]]));
+                }
+                std::move(buffer.begin(), buffer.end(), row);
+            }
+        }
+        void transpose() {
+            transpose_impl(false);
+            }
+        void transpose_parallel() {
+            transpose_impl(size() > 10000);
+        }
+        [[nodiscard]] array2d transposed() const {
+            array2d result = make_transposed_result();
+            simd::transpose(data_.data(), static_cast<size_type>(pitch()), result.data_.data(),
+                            static_cast<size_type>(result.pitch()), static_cast<size_type>(rows_),
+                            static_cast<size_type>(cols_));
+            return result;
+        }
+        [[nodiscard]] array2d transposed_parallel() const {
+            if (size() <= 10000) return transposed();
+            array2d    result     = make_transposed_result();
+            const auto src_stride = static_cast<size_type>(pitch());
+            const auto dst_stride = static_cast<size_type>(result.pitch());
+            const auto rows       = static_cast<size_type>(rows_);
+            const auto cols       = static_cast<size_type>(cols_);
+            constexpr size_type extent   = simd::detail::transpose_tile_extent<Ty>;
+            const bool          by_rows  = rows >= cols;
+            const auto          length   = by_rows ? rows : cols;
+            const auto          tiles    = (length + extent - 1) / extent;
+            auto               &pool     = default_thread_pool();
+            const auto          bands    = std::min<size_type>(tiles, pool.size() * 4);
+            pool.run(bands, [&](size_type band) {
+                const auto first = tiles * band / bands * extent;
+                const auto last  = std::min(tiles * (band + 1) / bands * extent, length);
+                if (by_rows) {
+                    simd::transpose(data_.data() + first * src_stride, src_stride, result.data_.data() + first,
+                                    dst_stride, last - first, cols);
+                } else {
+                    simd::transpose(data_.data() + first, src_stride, result.data_.data() + first * dst_stride,
+                                    dst_stride, rows, last - first);
+                }
+            });
+            return result;
+        }
+        void resize(index_type new_rows, index_type new_cols) {
+            resize_impl(new_rows, new_cols, std::nullopt);
+        }
+        void resize(index_type new_rows, index_type new_cols, const Ty &val) {
+            resize_impl(new_rows, new_cols, val);
+        }
+        void resize_uninitialized(index_type new_rows, index_type new_cols)
+            requires std::is_trivially_default_constructible_v<Ty>
+        {
+            resize_impl(new_rows, new_cols, std::nullopt, false);
+        }
+        void push_back_row(std::span<const Ty> row) {
+            auto new_cols  = cols_;
+            auto new_pitch = pitch_;
+            if (rows_ == 0) {
+                if (row.size() > static_cast<std::size_t>(std::numeric_limits<index_type>::max())) [[unlikely]] {
+                    throw std::overflow_error("push_back_row: row is too long");
+                }
+                new_cols  = static_cast<index_type>(row.size());
+                new_pitch = default_pitch(new_cols);
+            } else if (row.size() != static_cast<std::size_t>(cols_)) [[unlikely]] {
+                throw std::invalid_argument("push_back_row: row size doesn't match matrix columns");
+            }
+            const auto first   = data_.data();
+            const bool aliased = !row.empty() && std::less_equal<>{}(first, row.data()) &&
+                                 std::less<>{}(row.data(), first + data_.size());
+            const auto offset  = aliased ? static_cast<std::size_t>(row.data() - first) : 0;
+            append_row(new_cols, new_pitch, [&] {
+                if (aliased) {
+                    for (std::size_t i = 0; i < row.size(); ++i) data_.push_back(data_[offset + i]);
+                } else {
+                    data_.insert(data_.end(), row.begin(), row.end());
+                }
+                if constexpr (is_pitched) {
+                    resize_value_initialized(data_, data_.size() + static_cast<std::size_t>(new_pitch - new_cols));
+                }
+            });
+        }
+        template<typename... Args>
+            requires std::constructible_from<Ty, Args...>
+        std::span<Ty> emplace_back_row(Args &&...args) {
+            if constexpr (sizeof...(Args) == 0) {
+                append_row(cols_, pitch_, [&] {
+                    resize_value_initialized(data_, data_.size() + static_cast<std::size_t>(pitch_));
+                });
+            } else {
+                const Ty value(std::forward<Args>(args)...);
+                append_row(cols_, pitch_, [&] { data_.resize(data_.size() + static_cast<std::size_t>(pitch_), value); });
+            }
+            return row(rows_ - 1);
+        }
+        void insert_rows(index_type pos, index_type count) {
+            insert_rows(pos, count, Ty{});
+        }
+        void insert_rows(index_type pos, index_type count, const Ty &val) {
+            if (pos < 0 || pos > rows_) [[unlikely]] {
+                throw std::out_of_range("insert_rows: position " + std::to_string(pos) + " out of range [0, " +
+                                        std::to_string(rows_) + "]");
+            }
+            const auto new_rows = grown_rows(count);
+            if (count == 0) return;
+            if (cols_ > 0) {
+                insert_storage(calculate_offset(pos, 0), calculate_size(count, pitch_), val);
+            }
+            rows_ = new_rows;
+        }
+        void erase_rows(index_type pos, index_type count) {
+            if (pos < 0 || count < 0 || pos > rows_ - count) [[unlikely]] {
+                throw std::out_of_range("erase_rows: rows [" + std::to_string(pos) + ", " +
+                                        std::to_string(pos) + " + " + std::to_string(count) + ") out of range [0, " +
+                                        std::to_string(rows_) + ")");
+            }
+            if (count == 0) return;
+            if (cols_ > 0) {
+                erase_storage(calculate_offset(pos, 0), calculate_size(count, pitch_));
+            }
+            rows_ -= count;
+        }
+        void insert_cols(index_type pos, index_type count) {
+            insert_cols(pos, count, Ty{});
+        }
+        void insert_cols(index_type pos, index_type count, const Ty &val) {
+            if (pos < 0 || pos > cols_) [[unlikely]] {
+                throw std::out_of_range("insert_cols: position " + std::to_string(pos) + " out of range [0, " +
+                                        std::to_string(cols_) + "]");
+            }
+            validate_dimension(count, "count");
+            if (count > std::numeric_limits<index_type>::max() - cols_) [[unlikely]] {
+                throw std::overflow_error("Matrix column count overflow");
+            }
+            if (count == 0) return;
+            const auto new_cols  = static_cast<index_type>(cols_ + count);
+            const auto new_pitch = default_pitch(new_cols);
+            const auto new_size  = static_cast<std::size_t>(calculate_size(rows_, new_pitch));
+            if (rows_ > 0) {
+                bool in_place = false;
+                if constexpr (nothrow_element_ops) {
+                    in_place = new_size <= data_.capacity();
+                }
+                const Ty fill = val;
+                if (in_place) {
+                    shift_cols_in_place(new_pitch, new_size, pos, 0, count, &fill);
+                } else {
+                    rebuild_cols(new_cols, new_pitch, std::max(new_size, data_.capacity() * 2), pos, 0, count, &fill);
+                }
+            }
+            cols_  = new_cols;
+            pitch_ = new_pitch;
+        }
+        void erase_cols(index_type pos, index_type count) {
+            if (pos < 0 || count < 0 || pos > cols_ - count) [[unlikely]] {
+                throw std::out_of_range("erase_cols: columns [" + std::to_string(pos) + ", " +
+                                        std::to_string(pos) + " + " + std::to_string(count) + ") out of range [0, " +
+                                        std::to_string(cols_) + ")");
+            }
+            if (count == 0) return;
+            const auto new_cols  = static_cast<index_type>(cols_ - count);
+            const auto new_pitch = default_pitch(new_cols);
+            const auto new_size  = static_cast<std::size_t>(calculate_size(rows_, new_pitch));
+            if (rows_ > 0) {
+                bool in_place = false;
+                if constexpr (nothrow_element_ops) {
+                    in_place = new_size <= data_.capacity();
+                }
+                if (in_place) {
+                    shift_cols_in_place(new_pitch, new_size, pos, count, 0, nullptr);
+                } else {
+                    rebuild_cols(new_cols, new_pitch, new_size, pos, count, 0, nullptr);
+                }
+            }
+            cols_  = new_cols;
+            pitch_ = new_pitch;
+        }
+        [[nodiscard]] constexpr pointer data() noexcept {
+            return std::assume_aligned<storage_alignment>(data_.data());
+        }
+        [[nodiscard]] constexpr const_pointer data() const noexcept {
+            return std::assume_aligned<storage_alignment>(data_.data());
+        }
+        void                                  swap(array2d &other) noexcept {
+            using std::swap;
+            swap(rows_, other.rows_);
+            swap(cols_, other.cols_);
+            swap(pitch_, other.pitch_);
+            swap(data_, other.data_);
+        }
+        [[nodiscard]] const auto &get_data() const noexcept { return data_; }
+        [[nodiscard]] auto       &get_vector() noexcept { return data_; }
+        [[nodiscard]] bool        operator==(const array2d &other) const
+                noexcept(noexcept(std::declval<Ty>() == std::declval<Ty>())) {
+            if constexpr (is_pitched) {
+                return rows_ == other.rows_ &&
+                       cols_ == other.cols_ &&
+                       std::equal(begin(), end(), other.begin());
+            } else {
+            return rows_ == other.rows_ &&
+                   cols_ == other.cols_ &&
+                   data_ == other.data_;
+            }
+        }
+        [[nodiscard]] auto operator<=>(const array2d &other) const
+            requires std::three_way_comparable<Ty>
+        {
+            if (auto cmp = rows_ <=> other.rows_; cmp != 0) return cmp;
+            if (auto cmp = cols_ <=> other.cols_; cmp != 0) return cmp;
+            if constexpr (is_pitched) {
+                return std::lexicographical_compare_three_way(begin(), end(), other.begin(), other.end());
+            } else {
+            return data_ <=> other.data_;
+            }
+        }
+
+    private:
+        static constexpr index_type validate_dimension(index_type dim, const char *name) {
+            if (dim < 0) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + " must be non-negative");
+            }
+            return dim;
+        }
+        static constexpr size_type calculate_size(index_type rows, index_type cols) {
+            const auto size = static_cast<size_type>(rows) * static_cast<size_type>(cols);
+            if (rows > 0 && cols > 0 && size / static_cast<size_type>(rows) != static_cast<size_type>(cols)) {
+                throw std::overflow_error("Matrix size calculation overflow");
+            }
+            return size;
+        }
+        static constexpr index_type default_pitch(index_type cols) {
+            if constexpr (is_pitched) {
+                constexpr std::size_t line = std::max(pitched_layout::line_size, storage_alignment);
+                if constexpr (line % sizeof(Ty) != 0) {
+                    return cols;
+                } else {
+                    if (cols == 0) return cols;
+                    constexpr std::size_t per_line = line / sizeof(Ty);
+                    auto pitch = (static_cast<std::size_t>(cols) + per_line - 1) / per_line * per_line;
+                    if ((pitch * sizeof(Ty)) % pitched_layout::conflict_stride == 0) {
+                        pitch += per_line;
+                    }
+                    if (pitch > static_cast<std::size_t>(std::numeric_limits<index_type>::max())) [[unlikely]] {
+                        throw std::overflow_error("Matrix pitch calculation overflow");
+                    }
+                    return static_cast<index_type>(pitch);
+                }
+            } else {
+                return cols;
+            }
+        }
+        static constexpr index_type validate_pitch(row_pitch pitch, index_type cols) {
+            if (pitch.value < static_cast<std::size_t>(cols) ||
+                pitch.value > static_cast<std::size_t>(std::numeric_limits<index_type>::max())) [[unlikely]] {
+                throw std::invalid_argument("pitch must not be smaller than cols");
+            }
+            return static_cast<index_type>(pitch.value);
+        }
+        constexpr size_type calculate_offset(index_type row, index_type col) const noexcept {
+            return static_cast<size_type>(row) * static_cast<size_type>(pitch()) + static_cast<size_type>(col);
+        }
+        template<typename It, typename Ptr>
+        constexpr It make_iterator(Ptr ptr) const noexcept {
+            if constexpr (is_pitched) {
+                return It(ptr, 0, static_cast<std::ptrdiff_t>(cols_), static_cast<std::ptrdiff_t>(pitch_));
+            } else {
+                return It(ptr);
+            }
+        }
+        void transpose_impl(bool parallel) {
+            if (is_square()) {
+                transpose_square(parallel);
+                return;
+            }
+            if constexpr (is_pitched && !nothrow_element_ops) {
+                *this = transposed();
+                return;
+            }
+
+            const auto count = static_cast<std::size_t>(rows_) * static_cast<std::size_t>(cols_);
+            std::vector<std::uint64_t> visited((count + 63) / 64);
+            if constexpr (is_pitched) {
+                const auto new_pitch = default_pitch(rows_);
+                data_.reserve(static_cast<std::size_t>(calculate_size(cols_, new_pitch)));
+                resize_in_place(rows_, cols_, cols_, count, std::nullopt, false);
+            }
+            transpose_cycles(visited, parallel);
+            std::swap(rows_, cols_);
+            pitch_ = cols_;
+            if constexpr (is_pitched) {
+                const auto new_pitch = default_pitch(cols_);
+                resize_in_place(rows_, cols_, new_pitch, static_cast<std::size_t>(calculate_size(rows_, new_pitch)),
+                                std::nullopt, true);
+            }
+        }
+        void transpose_square(bool parallel) {
+            constexpr index_type block_size = std::max<index_type>(1, 64 / sizeof(Ty));
+            const auto swap_block_row = [this](index_type i) {
+                const auto i_end = std::min(static_cast<index_type>(i + block_size), rows_);
+                for (index_type j = i; j < cols_; j += block_size) {
+                    const auto j_end = std::min(static_cast<index_type>(j + block_size), cols_);
+                    for (index_type bi = i; bi < i_end; ++bi) {
+                        const auto start_j = (i == j) ? bi + 1 : j;
+                        for (index_type bj = start_j; bj < j_end; ++bj) {
+                            using std::swap;
+                            swap((*this)[bi][bj], (*this)[bj][bi]);
+                        }
+                    }
+                }
+            };
+            if (parallel) {
+                default_thread_pool().run(static_cast<size_type>((rows_ + block_size - 1) / block_size),
+                                          [&](size_type k) { swap_block_row(static_cast<index_type>(k * block_size)); });
+            } else {
+                for (index_type i = 0; i < rows_; i += block_size) swap_block_row(i);
+            }
+        }
+        void transpose_cycles(std::vector<std::uint64_t> &visited, bool parallel) {
+            const auto rows  = static_cast<std::size_t>(rows_);
+            const auto cols  = static_cast<std::size_t>(cols_);
+            const auto count = rows * cols;
+            if (count < 3) return;
+            Ty        *p      = data_.data();
+            const auto source = [rows, cols](std::size_t d) { return (d % rows) * cols + d / rows; };
+            const auto rotate = [&](std::size_t leader, auto mark) {
+                Ty          tmp = std::move(p[leader]);
+                std::size_t cur = leader;
+                for (;;) {
+                    mark(cur);
+                    const auto src = source(cur);
+                    if (src == leader) break;
+                    p[cur] = std::move(p[src]);
+                    cur    = src;
+                }
+                p[cur] = std::move(tmp);
+            };
+            if (!parallel) {
+                const auto mark = [&](std::size_t k) { visited[k / 64] |= std::uint64_t{1} << (k % 64); };
+                for (std::size_t k = 1; k + 1 < count; ++k) {
+                    if ((visited[k / 64] >> (k % 64)) & 1) continue;
+                    rotate(k, mark);
+                }
+                return;
+            }
+            const auto is_visited = [&](std::size_t k) {
+                return (std::atomic_ref<std::uint64_t>(visited[k / 64]).load(std::memory_order_relaxed) >> (k % 64)) & 1;
+            };
+            const auto mark = [&](std::size_t k) {
+                std::atomic_ref<std::uint64_t>(visited[k / 64]).fetch_or(std::uint64_t{1} << (k % 64),
+                                                                         std::memory_order_relaxed);
+            };
+            auto      &pool   = default_thread_pool();
+            const auto chunks = std::min<std::size_t>(count, pool.size() * 16);
+            pool.run(chunks, [&](std::size_t chunk) {
+                const auto [lo, hi] = detail::chunk_bounds(count, chunk, chunks);
+                const auto first    = std::max<std::size_t>(1, lo);
+                const auto last     = std::min(hi, count - 1);
+                for (std::size_t k = first; k < last; ++k) {
+                    if (is_visited(k)) continue;
+                    bool leader = true;
+                    for (auto s = source(k); s != k; s = source(s)) {
+                        if (s < k) {
+                            leader = false;
+                            break;
+                        }
+                    }
+                    if (leader) rotate(k, mark);
+                }
+            });
+        }
+        static void validate_permutation(std::span<const index_type> perm, index_type count, const char *name) {
+            if (perm.size() != static_cast<size_type>(count)) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": permutation size mismatch");
+            }
+            std::vector<bool> seen(perm.size());
+            for (const auto index: perm) {
+                if (index < 0 || index >= count || seen[index]) [[unlikely]] {
+                    throw std::invalid_argument(std::string(name) + ": not a permutation");
+                }
+                seen[index] = true;
+            }
+        }
+        void relocate_row(index_type src, index_type dst) noexcept(std::is_nothrow_move_assignable_v<Ty>) {
+            Ty *const from = data_.data() + calculate_offset(src, 0);
+            Ty *const to   = data_.data() + calculate_offset(dst, 0);
+            if constexpr (std::is_trivially_copyable_v<Ty>) {
+                std::memcpy(to, from, static_cast<size_type>(cols_) * sizeof(Ty));
+            } else {
+                std::move(from, from + cols_, to);
+            }
+        }
+        array2d make_transposed_result() const {
+            if constexpr (std::is_trivially_default_constructible_v<Ty>) {
+                return array2d(cols_, rows_, uninitialized, get_allocator());
+            } else {
+                return array2d(cols_, rows_, get_allocator());
+            }
+        }
+        static Ty sum_segment(const Ty *first, size_type count, Array_sum_opt opt) {
+            switch (opt) {
+                case Array_sum_opt::Pairwise:
+                    return simd::sum_pairwise(first, count);
+                case Array_sum_opt::Kahan:
+                    return simd::sum_kahan(first, count);
+                default:
+                    return simd::sum(first, count);
+            }
+        }
+        Ty sum_rows(index_type first, index_type last, Array_sum_opt opt) const {
+            std::vector<Ty> row_sums;
+            row_sums.reserve(static_cast<size_type>(last - first));
+            for (index_type i = first; i < last; ++i) {
+                row_sums.push_back(sum_segment(data_.data() + calculate_offset(i, 0), static_cast<size_type>(cols_), opt));
+            }
+            return sum_segment(row_sums.data(), row_sums.size(), opt);
+        }
+        template<bool Max>
+        Ty extremum(const char *name) const {
+            if (empty()) [[unlikely]] {
+                throw std::out_of_range(std::string(name) + ": matrix is empty");
+            }
+            if constexpr (is_pitched) {
+                const auto cols = static_cast<size_type>(cols_);
+                Ty         best = Max ? simd::max(data_.data(), cols) : simd::min(data_.data(), cols);
+                for (index_type i = 1; i < rows_; ++i) {
+                    const Ty *row   = data_.data() + calculate_offset(i, 0);
+                    const Ty  value = Max ? simd::max(row, cols) : simd::min(row, cols);
+                    if (Max ? best < value : value < best) best = value;
+                }
+                return best;
+            } else {
+                return Max ? simd::max(data_.data(), data_.size()) : simd::min(data_.data(), data_.size());
+            }
+        }
+        template<bool Max>
+        std::pair<index_type, index_type> arg_extremum(const char *name) const {
+            if (empty()) [[unlikely]] {
+                throw std::out_of_range(std::string(name) + ": matrix is empty");
+            }
+            const auto locate = [](const Ty *first, size_type count) {
+                return Max ? simd::argmax(first, count) : simd::argmin(first, count);
+            };
+            if constexpr (is_pitched) {
+                const auto cols = static_cast<size_type>(cols_);
+                index_type best_row = 0;
+                auto       best_col = locate(data_.data(), cols);
+                for (index_type i = 1; i < rows_; ++i) {
+                    const Ty  *row = data_.data() + calculate_offset(i, 0);
+                    const auto j   = locate(row, cols);
+                    const Ty  &best = data_[calculate_offset(best_row, static_cast<index_type>(best_col))];
+                    if (Max ? best < row[j] : row[j] < best) {
+                        best_row = i;
+                        best_col = j;
+                    }
+                }
+                return {best_row, static_cast<index_type>(best_col)};
+            } else {
+                const auto index = locate(data_.data(), data_.size());
+                const auto cols  = static_cast<size_type>(cols_);
+                return {static_cast<index_type>(index / cols), static_cast<index_type>(index % cols)};
+            }
+        }
+        static constexpr void assert_bounds([[maybe_unused]] index_type index,
+                                            [[maybe_unused]] index_type limit) noexcept {
+#ifdef _DEBUG
+            assert(index >= 0 && index < limit);
+#endif
+        }
+        std::string format_bounds_error(index_type row, index_type col) const {
+            return "array2d: index (" + std::to_string(row) + ", " + std::to_string(col) +
+                   ") out of range [0, " + std::to_string(rows_) + ") x [0, " + std::to_string(cols_) + ")";
+        }
+        static constexpr bool nothrow_element_ops =
+                std::is_nothrow_default_constructible_v<Ty> && std::is_nothrow_copy_constructible_v<Ty> &&
+                std::is_nothrow_copy_assignable_v<Ty> && std::is_nothrow_move_assignable_v<Ty>;
+        void resize_in_place(index_type new_rows, index_type new_cols, index_type new_pitch, std::size_t new_size,
+                             const std::optional<Ty> &fill_value, bool value_init) noexcept {
+            const auto old_size  = data_.size();
+            const auto copy_rows = std::min(rows_, new_rows);
+            const auto copy_cols = std::min(cols_, new_cols);
+            if (new_size > old_size) {
+                grow_storage(data_, new_size, fill_value, value_init);
+            }
+            const auto move_row = [&](index_type i) {
+                move_elements(data_.data() + calculate_offset(i, 0),
+                              data_.data() + static_cast<size_type>(i) * static_cast<size_type>(new_pitch), copy_cols);
+            };
+            if (copy_cols > 0 && new_pitch > pitch_) {
+                for (index_type i = copy_rows; i-- > 1;) move_row(i);
+            } else if (copy_cols > 0 && new_pitch < pitch_) {
+                for (index_type i = 1; i < copy_rows; ++i) move_row(i);
+            }
+            if (fill_value || value_init) {
+                const Ty   val   = fill_value ? *fill_value : Ty{};
+                const auto limit = std::min(old_size, new_size);
+                const auto reset = [&](std::size_t first, std::size_t last) {
+                    last = std::min(last, limit);
+                    if (first < last) std::fill(data_.begin() + first, data_.begin() + last, val);
+                };
+                const auto stride = static_cast<std::size_t>(new_pitch);
+                if (copy_cols < new_pitch) {
+                    for (index_type i = 0; i < copy_rows; ++i) {
+                        reset(i * stride + static_cast<std::size_t>(copy_cols), (i + 1) * stride);
+                    }
+                }
+                reset(static_cast<std::size_t>(copy_rows) * stride, new_size);
+            }
+            if (new_size < old_size) {
+                data_.erase(data_.begin() + new_size, data_.end());
+            }
+            rows_  = new_rows;
+            cols_  = new_cols;
+            pitch_ = new_pitch;
+        }
+        index_type grown_rows(index_type count) const {
+            validate_dimension(count, "count");
+            if (count > std::numeric_limits<index_type>::max() - rows_) [[unlikely]] {
+                throw std::overflow_error("Matrix row count overflow");
+            }
+            return static_cast<index_type>(rows_ + count);
+        }
+        void reserve_rows(index_type rows, index_type pitch) {
+            const auto needed = static_cast<std::size_t>(calculate_size(rows, pitch));
+            if (needed > data_.capacity()) {
+                data_.reserve(std::max(needed, data_.capacity() * 2));
+            }
+        }
+        template<typename Fn>
+        void append_row(index_type new_cols, index_type new_pitch, Fn &&append) {
+            const auto new_rows = grown_rows(1);
+            if (new_cols > 0) {
+                reserve_rows(new_rows, new_pitch);
+                const auto old_size = data_.size();
+                try {
+                    append();
+                } catch (...) {
+                    data_.erase(data_.begin() + old_size, data_.end());
+                    throw;
+                }
+            }
+            rows_  = new_rows;
+            cols_  = new_cols;
+            pitch_ = new_pitch;
+        }
+        static void move_elements(pointer src, pointer dst, index_type n) noexcept {
+            if (n <= 0 || src == dst) return;
+            if constexpr (std::is_trivially_copyable_v<Ty>) {
+                std::memmove(dst, src, static_cast<size_type>(n) * sizeof(Ty));
+            } else if (dst > src) {
+                std::move_backward(src, src + n, dst + n);
+            } else {
+                std::move(src, src + n, dst);
+            }
+        }
+        void shift_cols_in_place(index_type new_pitch, std::size_t new_size, index_type pos, index_type erased,
+                                 index_type inserted, const Ty *val) noexcept {
+            if (new_size > data_.size()) {
+                resize_value_initialized(data_, new_size);
+            }
+            const auto tail     = static_cast<index_type>(cols_ - pos - erased);
+            const auto move_row = [&](index_type i) {
+                const auto src = data_.data() + calculate_offset(i, 0);
+                const auto dst = data_.data() + static_cast<size_type>(i) * static_cast<size_type>(new_pitch);
+                if (dst > src) {
+                    move_elements(src + pos + erased, dst + pos + inserted, tail);
+                    move_elements(src, dst, pos);
+                } else {
+                    move_elements(src, dst, pos);
+                    move_elements(src + pos + erased, dst + pos + inserted, tail);
+                }
+                if (inserted > 0) std::fill_n(dst + pos, inserted, *val);
+            };
+            if (new_pitch > pitch_) {
+                for (index_type i = rows_; i-- > 0;) move_row(i);
+            } else {
+                for (index_type i = 0; i < rows_; ++i) move_row(i);
+            }
+            if (new_size < data_.size()) {
+                data_.erase(data_.begin() + static_cast<std::ptrdiff_t>(new_size), data_.end());
+            }
+        }
+        void rebuild_cols(index_type new_cols, index_type new_pitch, std::size_t capacity, index_type pos,
+                          index_type erased, index_type inserted, const Ty *val) {
+            storage_type result(data_.get_allocator());
+            result.reserve(capacity);
+            const auto take = [](pointer p) {
+                if constexpr (nothrow_element_ops) {
+                    return std::make_move_iterator(p);
+                } else {
+                    return static_cast<const_pointer>(p);
+                }
+            };
+            for (index_type i = 0; i < rows_; ++i) {
+                const auto src = data_.data() + calculate_offset(i, 0);
+                result.insert(result.end(), take(src), take(src + pos));
+                if (inserted > 0) {
+                    result.insert(result.end(), static_cast<std::size_t>(inserted), *val);
+                }
+                result.insert(result.end(), take(src + pos + erased), take(src + cols_));
+                if constexpr (is_pitched) {
+                    resize_value_initialized(result, result.size() + static_cast<std::size_t>(new_pitch - new_cols));
+                }
+            }
+            data_.swap(result);
+        }
+        void insert_storage(std::size_t offset, std::size_t count, const Ty &val) {
+            const auto pos = data_.begin() + static_cast<std::ptrdiff_t>(offset);
+            if constexpr (nothrow_element_ops) {
+                data_.insert(pos, count, val);
+            } else {
+                storage_type result(data_.get_allocator());
+                result.reserve(data_.size() + count);
+                result.insert(result.end(), data_.begin(), pos);
+                result.insert(result.end(), count, val);
+                result.insert(result.end(), pos, data_.end());
+                data_.swap(result);
+            }
+        }
+        void erase_storage(std::size_t offset, std::size_t count) {
+            const auto first = data_.begin() + static_cast<std::ptrdiff_t>(offset);
+            const auto last  = first + static_cast<std::ptrdiff_t>(count);
+            if constexpr (nothrow_element_ops) {
+                data_.erase(first, last);
+            } else {
+                storage_type result(data_.get_allocator());
+                result.reserve(data_.size() - count);
+                result.insert(result.end(), data_.begin(), first);
+                result.insert(result.end(), last, data_.end());
+                data_.swap(result);
+            }
+        }
+        static void grow_storage(storage_type &storage, std::size_t size, const std::optional<Ty> &fill_value,
+                                 bool value_init) {
+            if (fill_value) {
+                storage.resize(size, *fill_value);
+            } else if (value_init) {
+                resize_value_initialized(storage, size);
+            } else {
+                storage.resize(size);
+            }
+        }
+        static void resize_value_initialized(storage_type &storage, std::size_t size) {
+            if constexpr (std::is_trivially_default_constructible_v<Ty> && std::is_copy_constructible_v<Ty>) {
+                storage.resize(size, Ty{});
+            } else {
+                storage.resize(size);
+            }
+        }
+        void check_block(index_type start_row, index_type start_col,
+                         index_type num_rows, index_type num_cols) const {
+            if (start_row < 0 || start_col < 0 || num_rows < 0 || num_cols < 0 ||
+                start_row > rows_ - num_rows || start_col > cols_ - num_cols) [[unlikely]] {
+                throw std::out_of_range("array2d: block (" + std::to_string(start_row) + ", " +
+                                        std::to_string(start_col) + ") + " + std::to_string(num_rows) + "x" +
+                                        std::to_string(num_cols) + " out of range " + std::to_string(rows_) +
+                                        "x" + std::to_string(cols_));
+            }
+        }
+        template<bool IsConst>
+        [[nodiscard]] auto at_impl(index_type row, index_type col) const
+                -> std::conditional_t<IsConst, const_reference, reference> {
+            if (row < 0 || row >= rows_ || col < 0 || col >= cols_) [[unlikely]] {
+                throw std::out_of_range(format_bounds_error(row, col));
+            }
+            if constexpr (IsConst) {
+                return data_[calculate_offset(row, col)];
+            } else {
+                return const_cast<reference>(data_[calculate_offset(row, col)]);
+            }
+        }
+        void resize_impl(index_type new_rows, index_type new_cols, std::optional<Ty> fill_value,
+                         bool value_init = true) {
+            new_rows = validate_dimension(new_rows, "new_rows");
+            new_cols = validate_dimension(new_cols, "new_cols");
+            if (new_rows == rows_ && new_cols == cols_) return;
+            const auto new_pitch = default_pitch(new_cols);
+            const auto new_size  = calculate_size(new_rows, new_pitch);
+            if (new_size == 0) {
+                data_.clear();
+                rows_ = new_rows;
+                cols_ = new_cols;
+                pitch_ = new_pitch;
+                return;
+            }
+            if constexpr (nothrow_element_ops) {
+                if (new_size <= data_.capacity()) {
+                    resize_in_place(new_rows, new_cols, new_pitch, new_size, fill_value, value_init);
+                    return;
+                }
+            }
+            storage_type new_data(data_.get_allocator());
+            grow_storage(new_data, new_size, fill_value, value_init);
+            if (rows_ > 0 && cols_ > 0) {
+                const auto copy_rows = std::min(rows_, new_rows);
+                const auto copy_cols = std::min(cols_, new_cols);
+                for (index_type i = 0; i < copy_rows; ++i) {
+                    const auto old_offset = calculate_offset(i, 0);
+                    const auto new_offset = static_cast<size_type>(i) * static_cast<size_type>(new_pitch);
+                    if constexpr (std::is_trivially_copyable_v<Ty>) {
+                        std::memcpy(new_data.data() + new_offset,
+                                    data_.data() + old_offset,
+                                    static_cast<size_type>(copy_cols) * sizeof(Ty));
+                    } else {
+                        std::copy_n(data_.data() + old_offset, copy_cols, new_data.data() + new_offset);
+                    }
+                }
+            }
+            data_ = std::move(new_data);
+            rows_ = new_rows;
+            cols_ = new_cols;
+            pitch_ = new_pitch;
+        }
+
+    protected:
+        index_type      rows_{};
+        index_type      cols_{};
+        index_type                      pitch_{};
+        storage_type data_;
+    };
+    template<Array2d_compatible Ty, Array2d_index_type Idx, typename Alloc, Array2d_layout Layout>
+    void swap(array2d<Ty, Idx, Alloc, Layout> &lhs, array2d<Ty, Idx, Alloc, Layout> &rhs) noexcept {
+        lhs.swap(rhs);
+    }
+    template<Array2d_index_type IndexType>
+    array2d(IndexType, IndexType) -> array2d<double, IndexType>;
+    template<Array2d_index_type IndexType, Array2d_compatible ValueType>
+        requires(!std::ranges::range<ValueType> || std::is_arithmetic_v<ValueType>)
+    array2d(IndexType, IndexType, const ValueType &) -> array2d<ValueType, IndexType>;
+    template<Array2d_compatible ValueType>
+    array2d(std::initializer_list<std::initializer_list<ValueType>>) -> array2d<ValueType>;
+    template<Array2d_index_type IndexType, typename Container>
+        requires std::ranges::range<Container> &&
+                 (!std::is_arithmetic_v<Container>) &&
+                 Array2d_compatible<std::ranges::range_value_t<Container>>
+    array2d(IndexType, IndexType, const Container &) -> array2d<std::ranges::range_value_t<Container>, IndexType>;
+    template<Array2d_compatible ValueType, Array2d_index_type IndexType, typename Alloc, Array2d_layout Layout>
+    array2d(const array2d<ValueType, IndexType, Alloc, Layout> &) -> array2d<ValueType, IndexType, Alloc, Layout>;
+    template<Array2d_compatible ValueType, Array2d_index_type IndexType, typename Alloc, Array2d_layout Layout>
+    array2d(array2d<ValueType, IndexType, Alloc, Layout> &&) -> array2d<ValueType, IndexType, Alloc, Layout>;
+    template<Array2d_compatible Ty, Array2d_index_type Idx = int, typename Alloc = std::allocator<Ty>>
+    using pitched_array2d = array2d<Ty, Idx, Alloc, pitched_layout>;
+    namespace pmr {
+        template<Array2d_compatible Ty, Array2d_index_type Idx = int>
+        using array2d = qm::array2d<Ty, Idx, std::pmr::polymorphic_allocator<Ty>>;
+    }  // namespace pmr
+}  // namespace qm
+#endif
+namespace qm {
+    template<typename M, typename Ty>
+    concept Array2d_viewable = requires(M &m) {
+        { m.data() } -> std::convertible_to<Ty *>;
+        { m.rows() } -> std::integral;
+        { m.cols() } -> std::integral;
+        { m.pitch() } -> std::integral;
+    };
+    template<typename Ty, Array2d_index_type Idx = int>
+        requires Array2d_compatible<std::remove_const_t<Ty>>
+    class array2d_view {
+    public:
+        using element_type    = Ty;
+        using value_type      = std::remove_cv_t<Ty>;
+        using index_type      = Idx;
+        using size_type       = std::make_unsigned_t<Idx>;
+        using difference_type = std::make_signed_t<Idx>;
+        using pointer         = Ty *;
+        using const_pointer   = const Ty *;
+        using reference       = Ty &;
+        using const_reference = const Ty &;
+        using iterator               = Array2d_pitched_iterator<Ty>;
+        using const_iterator         = Array2d_pitched_iterator<const Ty>;
+        using reverse_iterator       = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+        static constexpr bool is_read_only = std::is_const_v<Ty>;
+        constexpr array2d_view() noexcept = default;
+        constexpr array2d_view(pointer data, index_type rows, index_type cols)
+            : data_(data),
+              rows_(validate_dimension(rows, "rows")),
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(cols_) {}
+        constexpr array2d_view(pointer data, index_type rows, index_type cols, row_pitch pitch)
+            : data_(data),
+              rows_(validate_dimension(rows, "rows")),
+              cols_(validate_dimension(cols, "cols")),
+              pitch_(validate_pitch(pitch, cols_)) {}
+        template<typename Matrix>
+            requires Array2d_viewable<Matrix, Ty> &&
+                     (!std::same_as<std::remove_cv_t<Matrix>, array2d_view>)
+        constexpr array2d_view(Matrix &matrix) noexcept
+            : data_(matrix.data()),
+              rows_(static_cast<index_type>(matrix.rows())),
+              cols_(static_cast<index_type>(matrix.cols())),
+              pitch_(static_cast<index_type>(matrix.pitch())) {}
+        template<typename U>
+            requires(!std::same_as<U, Ty> && std::convertible_to<U *, Ty *>)
+        constexpr array2d_view(const array2d_view<U, Idx> &other) noexcept
+            : data_(other.data()), rows_(other.rows()), cols_(other.cols()), pitch_(other.pitch()) {}
+        [[nodiscard]] QM_FORCEINLINE constexpr pointer operator[](index_type row) const noexcept {
+            assert_bounds(row, rows_);
+            return data_ + calculate_offset(row, 0);
+        }
+        [[nodiscard]] QM_FORCEINLINE constexpr reference operator()(index_type row, index_type col) const noexcept {
+            assert_bounds(row, rows_);
+            assert_bounds(col, cols_);
+            return data_[calculate_offset(row, col)];
+        }
+        [[nodiscard]] constexpr reference at(index_type row, index_type col) const {
+            if (row < 0 || row >= rows_ || col < 0 || col >= cols_) [[unlikely]] {
+                throw std::out_of_range("array2d_view: index (" + std::to_string(row) + ", " +
+                                        std::to_string(col) + ") out of range [0, " + std::to_string(rows_) +
+                                        ") x [0, " + std::to_string(cols_) + ")");
+            }
+            return data_[calculate_offset(row, col)];
+        }
+        [[nodiscard]] constexpr iterator begin() const noexcept {
+            return iterator(data_, 0, cols_, pitch_);
+        }
+        [[nodiscard]] constexpr iterator end() const noexcept {
+            return cols_ == 0 ? begin() : iterator(data_ + calculate_offset(rows_, 0), 0, cols_, pitch_);
+        }
+        [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return const_iterator(begin()); }
+        [[nodiscard]] constexpr const_iterator cend() const noexcept { return const_iterator(end()); }
+        [[nodiscard]] constexpr reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+        [[nodiscard]] constexpr reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+        [[nodiscard]] constexpr const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend()); }
+        [[nodiscard]] constexpr const_reverse_iterator crend() const noexcept { return const_reverse_iterator(cbegin()); }
         struct row_iterator_wrapper {
             pointer   ptr_;
             size_type cols_;
-            row_iterator_wrapper(pointer ptr, size_type cols) : ptr_(ptr), cols_(cols) {}
-            [[nodiscard]] iterator begin() const noexcept { return iterator(ptr_); }
-            [[nodiscard]] iterator end() const noexcept { return iterator(ptr_ + cols_); }
+            [[nodiscard]] Array2d_iterator<Ty> begin() const noexcept { return Array2d_iterator<Ty>(ptr_); }
+            [[nodiscard]] Array2d_iterator<Ty> end() const noexcept { return Array2d_iterator<Ty>(ptr_ + cols_); }
+        };
+        [[nodiscard]] row_iterator_wrapper row_range(index_type row) const noexcept {
+            assert_bounds(row, rows_);
+            return {data_ + calculate_offset(row, 0), static_cast<size_type>(cols_)};
+        }
+        [[nodiscard]] constexpr index_type rows() const noexcept { return rows_; }
+        [[nodiscard]] constexpr index_type cols() const noexcept { return cols_; }
+        [[nodiscard]] constexpr index_type pitch() const noexcept { return pitch_; }
+        [[nodiscard]] constexpr size_type size() const noexcept {
+            return static_cast<size_type>(rows_) * static_cast<size_type>(cols_);
+        }
+        [[nodiscard]] constexpr bool empty() const noexcept { return rows_ == 0 || cols_ == 0; }
+        [[nodiscard]] constexpr bool is_square() const noexcept { return rows_ == cols_; }
+        [[nodiscard]] constexpr bool is_contiguous() const noexcept { return pitch_ == cols_ || rows_ <= 1; }
+        [[nodiscard]] constexpr pointer data() const noexcept { return data_; }
+        [[nodiscard]] constexpr std::span<Ty> as_span() const {
+            if (!is_contiguous()) [[unlikely]] {
+                throw std::invalid_argument("as_span: view is not contiguous");
+            }
+            return {data_, size()};
+        }
+        [[nodiscard]] constexpr std::span<Ty> row(index_type row) const noexcept {
+            assert_bounds(row, rows_);
+            return {data_ + calculate_offset(row, 0), static_cast<size_type>(cols_)};
+        }
+        [[nodiscard]] std::vector<value_type> col(index_type col) const {
+            assert_bounds(col, cols_);
+            std::vector<value_type> result;
+            result.reserve(static_cast<size_type>(rows_));
+            for (index_type i = 0; i < rows_; ++i) {
+                result.push_back(data_[calculate_offset(i, col)]);
+            }
+            return result;
+        }
+        [[nodiscard]] constexpr array2d_column<Ty> col_view(index_type col) const noexcept {
+            assert_bounds(col, cols_);
+            return {data_ + col, static_cast<size_type>(rows_), pitch_};
+        }
+        [[nodiscard]] constexpr array2d_view submatrix(index_type start_row, index_type start_col,
+                                                       index_type num_rows, index_type num_cols) const {
+            if (start_row < 0 || start_col < 0 || num_rows < 0 || num_cols < 0 ||
+                start_row > rows_ - num_rows || start_col > cols_ - num_cols) [[unlikely]] {
+                throw std::out_of_range("array2d_view: block (" + std::to_string(start_row) + ", " +
+                                        std::to_string(start_col) + ") + " + std::to_string(num_rows) + "x" +
+                                        std::to_string(num_cols) + " out of range " + std::to_string(rows_) +
+                                        "x" + std::to_string(cols_));
+            }
+            return array2d_view(data_ + calculate_offset(start_row, start_col), num_rows, num_cols,
+                                row_pitch{static_cast<std::size_t>(pitch_)});
+        }
+        void reset(Array_reset_opt opt = Array_reset_opt::All_bits0) const
+                noexcept(std::is_nothrow_default_constructible_v<value_type> &&
+                         std::is_nothrow_move_assignable_v<value_type>)
+            requires(!is_read_only)
+        {
+            if (empty()) return;
+            if constexpr (std::is_trivially_destructible_v<value_type> &&
+                          std::is_trivially_default_constructible_v<value_type> &&
+                          std::is_standard_layout_v<value_type>) {
+                const auto byte = static_cast<unsigned char>(opt);
+                if (is_contiguous()) {
+                    simd::fill_bytes(data_, byte, size() * sizeof(value_type));
+                    return;
+                }
+                const auto row_bytes = static_cast<std::size_t>(cols_) * sizeof(value_type);
+                const bool streaming = row_bytes * static_cast<std::size_t>(rows_) >= simd::streaming_threshold;
+                for (index_type i = 0; i < rows_; ++i) {
+                    simd::fill_pattern(data_ + calculate_offset(i, 0), row_bytes, &byte, 1, streaming);
+                }
+            } else {
+                for (index_type i = 0; i < rows_; ++i) {
+                    std::fill_n(data_ + calculate_offset(i, 0), cols_, value_type{});
+                }
+            }
+        }
+        void fill(const value_type &val) const noexcept(std::is_nothrow_copy_assignable_v<value_type>)
+            requires(!is_read_only)
+        {
+            if constexpr (simd::Fill_pattern_type<value_type>) {
+                if (is_contiguous()) {
+                    simd::fill(data_, size(), val);
+                    return;
+                }
+                const auto row_bytes = static_cast<std::size_t>(cols_) * sizeof(value_type);
+                const bool streaming = row_bytes * static_cast<std::size_t>(rows_) >= simd::streaming_threshold;
+                for (index_type i = 0; i < rows_; ++i) {
+                    simd::fill_pattern(data_ + calculate_offset(i, 0), row_bytes, &val, sizeof(value_type), streaming);
+                }
+            } else {
+            if (is_contiguous()) {
+                std::fill_n(data_, size(), val);
+                return;
+            }
+            for (index_type i = 0; i < rows_; ++i) {
+                std::fill_n(data_ + calculate_offset(i, 0), cols_, val);
+                }
+            }
+        }
+        template<Array2d_expression_node E>
+            requires std::convertible_to<typename E::value_type, value_type>
+        void assign(const E &expr) const
+            requires(!is_read_only)
+        {
+            if (expr.rows() != static_cast<std::size_t>(rows_) || expr.cols() != static_cast<std::size_t>(cols_))
+                    [[unlikely]] {
+                throw std::invalid_argument("assign: expression dimensions don't match view dimensions");
+            }
+            evaluate_expression(data_, static_cast<std::size_t>(pitch_), expr);
+        }
+        void copy_from(array2d_view<const value_type, Idx> src) const
+            requires(!is_read_only)
+        {
+            if (src.rows() != rows_ || src.cols() != cols_) [[unlikely]] {
+                throw std::invalid_argument("copy_from: source dimensions don't match view dimensions");
+            }
+            if (empty() || (src.data() == data_ && src.pitch() == pitch_)) return;
+            if (src.pitch() != pitch_) {
+                const auto span_end = [](const auto *first, index_type pitch, index_type rows, index_type cols) {
+                    return first + static_cast<size_type>(rows - 1) * static_cast<size_type>(pitch) +
+                           static_cast<size_type>(cols);
+                };
+                const value_type *dst_first = data_;
+                const auto        overlaps  = std::less<>{}(src.data(), span_end(dst_first, pitch_, rows_, cols_)) &&
+                                              std::less<>{}(dst_first, span_end(src.data(), src.pitch(), rows_, cols_));
+                if (overlaps) {
+                    std::vector<std::remove_cv_t<value_type>> buffer;
+                    buffer.reserve(static_cast<size_type>(rows_) * static_cast<size_type>(cols_));
+                    for (index_type i = 0; i < rows_; ++i) buffer.insert(buffer.end(), src[i], src[i] + cols_);
+                    for (index_type i = 0; i < rows_; ++i) {
+                        std::copy_n(buffer.data() + static_cast<size_type>(i) * static_cast<size_type>(cols_), cols_,
+                                    data_ + calculate_offset(i, 0));
+                    }
+                } else {
+                    for (index_type i = 0; i < rows_; ++i) std::copy_n(src[i], cols_, data_ + calculate_offset(i, 0));
+                }
+                return;
+            }
+            const auto copy_one = [&](index_type i) {
+                const auto from = src[i];
+                const auto to   = data_ + calculate_offset(i, 0);
+                if constexpr (std::is_trivially_copyable_v<value_type>) {
+                    std::memmove(to, from, static_cast<size_type>(cols_) * sizeof(value_type));
+                } else if (to < from) {
+                    std::copy_n(from, cols_, to);
+                } else {
+                    std::copy_backward(from, from + cols_, to + cols_);
+                }
+            };
+            if (std::less<>{}(src.data(), data_)) {
+                for (index_type i = rows_; i-- > 0;) copy_one(i);
+            } else {
+                for (index_type i = 0; i < rows_; ++i) copy_one(i);
+            }
+        }
+        void fill_row(index_type row, const value_type &val) const
+                noexcept(std::is_nothrow_copy_assignable_v<value_type>)
+            requires(!is_read_only)
+        {
+            assert_bounds(row, rows_);
+            std::fill_n(data_ + calculate_offset(row, 0), cols_, val);
+        }
+        void copy_row(index_type src_row, index_type dest_row) const
+                noexcept(std::is_nothrow_copy_assignable_v<value_type>)
+            requires(!is_read_only)
+        {
+            assert_bounds(src_row, rows_);
+            assert_bounds(dest_row, rows_);
+            if (src_row == dest_row) return;
+            const auto src  = data_ + calculate_offset(src_row, 0);
+            const auto dest = data_ + calculate_offset(dest_row, 0);
+            if constexpr (std::is_trivially_copyable_v<value_type>) {
+                std::memcpy(dest, src, static_cast<size_type>(cols_) * sizeof(value_type));
+            } else {
+                std::copy_n(src, cols_, dest);
+            }
+        }
+        void swap_rows(index_type row1, index_type row2) const noexcept(std::is_nothrow_swappable_v<value_type>)
+            requires(!is_read_only)
+        {
+            assert_bounds(row1, rows_);
+            assert_bounds(row2, rows_);
+            if (row1 == row2) return;
+            if constexpr (std::is_trivially_copyable_v<value_type>) {
+                simd::swap_bytes(data_ + calculate_offset(row1, 0), data_ + calculate_offset(row2, 0),
+                                 static_cast<std::size_t>(cols_) * sizeof(value_type));
+            } else {
+            std::swap_ranges(data_ + calculate_offset(row1, 0), data_ + calculate_offset(row1, cols_),
+                             data_ + calculate_offset(row2, 0));
+            }
+        }
+        void transpose() const
+            requires(!is_read_only)
+        {
+            if (!is_square()) {
+                throw std::invalid_argument("transpose: view must be square for in-place transpose");
+            }
+            for (index_type i = 0; i < rows_; ++i) {
+                for (index_type j = i + 1; j < cols_; ++j) {
+                    using std::swap;
+                    swap((*this)(i, j), (*this)(j, i));
+                }
+            }
+        }
+        [[nodiscard]] array2d<value_type, Idx> transposed() const {
+            auto result = [&] {
+                if constexpr (std::is_trivially_default_constructible_v<value_type>) {
+                    return array2d<value_type, Idx>(cols_, rows_, uninitialized);
+                } else {
+                    return array2d<value_type, Idx>(cols_, rows_);
+                }
+            }();
+            simd::transpose<value_type>(data_, static_cast<std::size_t>(pitch_), result.data(),
+                                        static_cast<std::size_t>(result.pitch()), static_cast<std::size_t>(rows_),
+                                        static_cast<std::size_t>(cols_));
+            return result;
+        }
+        template<typename U>
+        [[nodiscard]] bool operator==(const array2d_view<U, Idx> &other) const
+            requires std::equality_comparable_with<const value_type &, const std::remove_cv_t<U> &>
+        {
+            return rows_ == other.rows() && cols_ == other.cols() && std::equal(begin(), end(), other.begin());
+        }
+
+    private:
+        static constexpr index_type validate_dimension(index_type dim, const char *name) {
+            if (dim < 0) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + " must be non-negative");
+            }
+            return dim;
+        }
+        static constexpr index_type validate_pitch(row_pitch pitch, index_type cols) {
+            if (pitch.value < static_cast<std::size_t>(cols) ||
+                pitch.value > static_cast<std::size_t>(std::numeric_limits<index_type>::max())) [[unlikely]] {
+                throw std::invalid_argument("pitch must not be smaller than cols");
+            }
+            return static_cast<index_type>(pitch.value);
+        }
+        constexpr size_type calculate_offset(index_type row, index_type col) const noexcept {
+            return static_cast<size_type>(row) * static_cast<size_type>(pitch_) + static_cast<size_type>(col);
+        }
+        static constexpr void assert_bounds([[maybe_unused]] index_type index,
+                                            [[maybe_unused]] index_type limit) noexcept {
+#ifdef _DEBUG
+            assert(index >= 0 && index < limit);
+#endif
+        }
+        pointer    data_ = nullptr;
+        index_type rows_{};
+        index_type cols_{};
+        index_type pitch_{};
+    };
+    template<typename Ty, Array2d_index_type IndexType>
+    array2d_view(Ty *, IndexType, IndexType) -> array2d_view<Ty, IndexType>;
+    template<typename Ty, Array2d_index_type IndexType>
+    array2d_view(Ty *, IndexType, IndexType, row_pitch) -> array2d_view<Ty, IndexType>;
+    template<typename Matrix>
+        requires requires { typename Matrix::index_type; }
+    array2d_view(Matrix &) -> array2d_view<std::remove_pointer_t<decltype(std::declval<Matrix &>().data())>,
+                                           typename Matrix::index_type>;
+}  // namespace qm
+namespace qm {
+    template<typename T>
+    concept Array2d_linalg_value = std::is_arithmetic_v<T> && !std::same_as<T, bool>;
+    template<typename M, typename T>
+    concept Array2d_writable_operand = Array2d_matrix_operand<M> && requires(M &m) {
+        { m.data() } -> std::same_as<T *>;
+    };
+    template<Array2d_matrix_operand M>
+    using operand_index_t = std::remove_cvref_t<decltype(std::declval<const M &>().rows())>;
+    namespace detail {
+        template<typename T, typename Idx, std::integral R, std::integral C>
+        array2d<T, Idx> make_result(R rows, C cols, const char *name) {
+            if (std::cmp_greater(rows, std::numeric_limits<Idx>::max()) ||
+                std::cmp_greater(cols, std::numeric_limits<Idx>::max())) [[unlikely]] {
+                throw std::overflow_error(std::string(name) + ": result dimensions overflow index type");
+            }
+            return array2d<T, Idx>(static_cast<Idx>(rows), static_cast<Idx>(cols), uninitialized);
+        }
+        inline constexpr std::size_t gemm_kc = 256;
+        inline constexpr std::size_t gemm_mc = 96;
+        inline constexpr std::size_t gemm_nc = 2048;
+        inline constexpr std::size_t gemm_small = 16 * 16 * 16;
+        template<typename T>
+        struct gemm_operand {
+            T          *data;
+            std::size_t rows;
+            std::size_t cols;
+            std::size_t stride;
         };
-        struct const_row_iterator_wrapper {
-            const_pointer ptr_;
-            size_type     cols_;
-            const_row_iterator_wrapper(const_pointer ptr, size_type cols) : ptr_(ptr), cols_(cols) {}
-            [[nodiscard]] const_iterator begin() const noexcept { return const_iterator(ptr_); }
-            [[nodiscard]] const_iterator end() const noexcept { return const_iterator(ptr_ + cols_); }
+        template<typename M>
+        auto make_gemm_operand(M &m) noexcept {
+            using pointer = std::remove_pointer_t<decltype(m.data())>;
+            return gemm_operand<pointer>{m.data(), static_cast<std::size_t>(m.rows()), static_cast<std::size_t>(m.cols()),
+                                         static_cast<std::size_t>(m.pitch())};
+        }
+        template<typename T, typename U>
+        bool gemm_overlaps(const gemm_operand<T> &x, const gemm_operand<U> &y) noexcept {
+            if (x.rows == 0 || x.cols == 0 || y.rows == 0 || y.cols == 0) return false;
+            const auto x_first = reinterpret_cast<std::uintptr_t>(x.data);
+            const auto y_first = reinterpret_cast<std::uintptr_t>(y.data);
+            const auto x_last  = reinterpret_cast<std::uintptr_t>(x.data + (x.rows - 1) * x.stride + x.cols);
+            const auto y_last  = reinterpret_cast<std::uintptr_t>(y.data + (y.rows - 1) * y.stride + y.cols);
+            return x_first < y_last && y_first < x_last;
+        }
+        template<typename T>
+        void gemm_pack_a(const T *a, std::size_t lda, std::size_t mc, std::size_t kc, std::size_t mr, T *out) {
+            for (std::size_t i0 = 0; i0 < mc; i0 += mr) {
+                const auto height = std::min(mr, mc - i0);
+                for (std::size_t p = 0; p < kc; ++p) {
+                    for (std::size_t i = 0; i < height; ++i) {
+                        out[i] = a[(i0 + i) * lda + p];
+                    }
+                    std::fill(out + height, out + mr, T{});
+                    out += mr;
+                }
+            }
+        }
+        template<typename T>
+        void gemm_pack_b(const T *b, std::size_t ldb, std::size_t kc, std::size_t nc, std::size_t nr, T *out) {
+            for (std::size_t j0 = 0; j0 < nc; j0 += nr) {
+                const auto width = std::min(nr, nc - j0);
+                for (std::size_t p = 0; p < kc; ++p) {
+                    const T *src = b + p * ldb + j0;
+                    std::copy(src, src + width, out);
+                    std::fill(out + width, out + nr, T{});
+                    out += nr;
+                }
+            }
+        }
+        template<typename T>
+        void gemm_macro_kernel(const simd::gemm_kernel<T> &micro, std::size_t mc, std::size_t nc, std::size_t kc,
+                               const T *packed_a, const T *packed_b, T *c, std::size_t ldc, T alpha, T beta) {
+            const auto mr = micro.mr;
+            const auto nr = micro.nr;
+            T          edge[16 * 16];
+            for (std::size_t jr = 0; jr < nc; jr += nr) {
+                const auto width = std::min(nr, nc - jr);
+                for (std::size_t ir = 0; ir < mc; ir += mr) {
+                    const auto height = std::min(mr, mc - ir);
+                    const T   *ap     = packed_a + ir * kc;
+                    const T   *bp     = packed_b + jr * kc;
+                    T         *dst    = c + ir * ldc + jr;
+                    if (height == mr && width == nr) [[likely]] {
+                        micro.kernel(kc, ap, bp, dst, ldc, alpha, beta);
+                        continue;
+                    }
+                    micro.kernel(kc, ap, bp, edge, nr, alpha, T{});
+                    for (std::size_t i = 0; i < height; ++i) {
+                        for (std::size_t j = 0; j < width; ++j) {
+                            T &out = dst[i * ldc + j];
+                            out    = beta == T{} ? edge[i * nr + j] : edge[i * nr + j] + beta * out;
+                        }
+                    }
+                }
+            }
+        }
+        template<typename T>
+        void gemm_scale(const gemm_operand<T> &c, T beta) {
+            for (std::size_t i = 0; i < c.rows; ++i) {
+                T *row = c.data + i * c.stride;
+                if (beta == T{}) {
+                    std::fill(row, row + c.cols, T{});
+                } else {
+                    std::transform(row, row + c.cols, row, [beta](T x) { return beta * x; });
+                }
+            }
+        }
+        template<typename T>
+        void gemm_small_kernel(const gemm_operand<const T> &a, const gemm_operand<const T> &b, const gemm_operand<T> &c,
+                               T alpha, T beta) {
+            for (std::size_t i = 0; i < a.rows; ++i) {
+                const T *a_row = a.data + i * a.stride;
+                T       *c_row = c.data + i * c.stride;
+                for (std::size_t j = 0; j < b.cols; ++j) {
+                    T acc{};
+                    for (std::size_t p = 0; p < a.cols; ++p) acc += a_row[p] * b.data[p * b.stride + j];
+                    c_row[j] = beta == T{} ? alpha * acc : alpha * acc + beta * c_row[j];
+                }
+            }
+        }
+        template<typename T>
+        void gemm(const gemm_operand<const T> &a, const gemm_operand<const T> &b, const gemm_operand<T> &c, T alpha,
+                  T beta, bool parallel) {
+            const auto m = a.rows;
+            const auto n = b.cols;
+            const auto k = a.cols;
+            if (m == 0 || n == 0) return;
+            if (k == 0 || alpha == T{}) {
+                gemm_scale(c, beta);
+                return;
+            }
+            if (m * n <= gemm_small && m * n * k <= gemm_small) {
+                gemm_small_kernel(a, b, c, alpha, beta);
+                return;
+            }
+            const auto micro      = simd::select_gemm_kernel<T>();
+            const auto row_blocks = (m + gemm_mc - 1) / gemm_mc;
+            const auto round_up   = [](std::size_t x, std::size_t r) { return (x + r - 1) / r * r; };
+            const auto size_b   = std::min(k, gemm_kc) * round_up(std::min(n, gemm_nc), micro.nr);
+            const auto size_a   = round_up(std::min(m, gemm_mc), micro.mr) * std::min(k, gemm_kc);
+            const auto packed_b = std::make_unique_for_overwrite<T[]>(size_b);
+            const auto packed_a = std::make_unique_for_overwrite<T[]>(parallel ? 0 : size_a);
+            for (std::size_t jc = 0; jc < n; jc += gemm_nc) {
+                const auto nc = std::min(gemm_nc, n - jc);
+                for (std::size_t pc = 0; pc < k; pc += gemm_kc) {
+                    const auto kc = std::min(gemm_kc, k - pc);
+                    const T    beta_block = pc == 0 ? beta : T{1};
+                    gemm_pack_b(b.data + pc * b.stride + jc, b.stride, kc, nc, micro.nr, packed_b.get());
+                    const auto update_rows = [&](std::size_t block, T *buffer) {
+                        const auto ic = block * gemm_mc;
+                        const auto mc = std::min(gemm_mc, m - ic);
+                        gemm_pack_a(a.data + ic * a.stride + pc, a.stride, mc, kc, micro.mr, buffer);
+                        gemm_macro_kernel(micro, mc, nc, kc, buffer, packed_b.get(), c.data + ic * c.stride + jc,
+                                          c.stride, alpha, beta_block);
+                    };
+                    if (parallel) {
+                        default_thread_pool().run(row_blocks, [&](std::size_t block) {
+                            thread_local std::vector<T> buffer;
+                            if (buffer.size() < size_a) buffer.resize(size_a);
+                            update_rows(block, buffer.data());
+                        });
+                    } else {
+                        for (std::size_t block = 0; block < row_blocks; ++block) {
+                            update_rows(block, packed_a.get());
+                        }
+                    }
+                }
+            }
+        }
+        template<typename T>
+        void gemm_validate(const gemm_operand<const T> &a, const gemm_operand<const T> &b, const gemm_operand<T> &c,
+                           const char *name) {
+            if (a.cols != b.rows) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": inner dimensions do not match");
+            }
+            if (c.rows != a.rows || c.cols != b.cols) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": output shape does not match");
+            }
+            if (gemm_overlaps(c, a) || gemm_overlaps(c, b)) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": output must not alias an input");
+            }
+        }
+        template<typename A, typename B, typename C, typename T>
+        void matmul_impl(const A &a, const B &b, C &c, T alpha, T beta, bool parallel, const char *name) {
+            const auto lhs = make_gemm_operand(a);
+            const auto rhs = make_gemm_operand(b);
+            const auto out = make_gemm_operand(c);
+            const gemm_operand<const T> lhs_view{lhs.data, lhs.rows, lhs.cols, lhs.stride};
+            const gemm_operand<const T> rhs_view{rhs.data, rhs.rows, rhs.cols, rhs.stride};
+            gemm_validate(lhs_view, rhs_view, out, name);
+            gemm(lhs_view, rhs_view, out, alpha, beta, parallel);
+        }
+    }  // namespace detail
+    template<Array2d_matrix_operand A, Array2d_matrix_operand B, typename C>
+        requires Array2d_linalg_value<typename A::value_type> &&
+                 std::same_as<typename A::value_type, typename B::value_type> &&
+                 Array2d_writable_operand<std::remove_reference_t<C>, typename A::value_type>
+    void matmul(const A &a, const B &b, C &&c, typename A::value_type alpha = 1, typename A::value_type beta = 0) {
+        detail::matmul_impl(a, b, c, alpha, beta, false, "matmul");
+    }
+    template<Array2d_matrix_operand A, Array2d_matrix_operand B, typename C>
+        requires Array2d_linalg_value<typename A::value_type> &&
+                 std::same_as<typename A::value_type, typename B::value_type> &&
+                 Array2d_writable_operand<std::remove_reference_t<C>, typename A::value_type>
+    void matmul_parallel(const A &a, const B &b, C &&c, typename A::value_type alpha = 1,
+                         typename A::value_type beta = 0) {
+        const auto elements = static_cast<std::size_t>(c.rows()) * static_cast<std::size_t>(c.cols());
+        detail::matmul_impl(a, b, c, alpha, beta, elements > 10000, "matmul_parallel");
+    }
+    template<Array2d_matrix_operand A, Array2d_matrix_operand B>
+        requires Array2d_linalg_value<typename A::value_type> &&
+                 std::same_as<typename A::value_type, typename B::value_type>
+    [[nodiscard]] array2d<typename A::value_type, operand_index_t<A>> matmul(const A &a, const B &b) {
+        if (std::cmp_not_equal(a.cols(), b.rows())) [[unlikely]] {
+            throw std::invalid_argument("matmul: inner dimensions do not match");
+        }
+        auto c = detail::make_result<typename A::value_type, operand_index_t<A>>(a.rows(), b.cols(), "matmul");
+        matmul(a, b, c);
+        return c;
+    }
+    template<Array2d_matrix_operand A, Array2d_matrix_operand B>
+        requires Array2d_linalg_value<typename A::value_type> &&
+                 std::same_as<typename A::value_type, typename B::value_type>
+    [[nodiscard]] array2d<typename A::value_type, operand_index_t<A>> matmul_parallel(const A &a, const B &b) {
+        if (std::cmp_not_equal(a.cols(), b.rows())) [[unlikely]] {
+            throw std::invalid_argument("matmul_parallel: inner dimensions do not match");
+        }
+        auto c = detail::make_result<typename A::value_type, operand_index_t<A>>(a.rows(), b.cols(), "matmul_parallel");
+        matmul_parallel(a, b, c);
+        return c;
+    }
+    namespace detail {
+        inline constexpr std::size_t gevm_block = 1024;
+        template<typename T>
+        void gemv_rows(const gemm_operand<const T> &a, const T *x, T *y, T alpha, T beta, std::size_t first,
+                       std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                const T d = simd::dot(a.data + i * a.stride, x, a.cols);
+                y[i]      = beta == T{} ? alpha * d : alpha * d + beta * y[i];
+            }
+        }
+        template<typename T>
+        void gevm_cols(const gemm_operand<const T> &a, const T *x, T *y, T alpha, T beta, std::size_t first,
+                       std::size_t last) {
+            if (beta == T{}) {
+                std::fill(y + first, y + last, T{});
+            } else if (beta != T{1}) {
+                std::transform(y + first, y + last, y + first, [beta](T v) { return beta * v; });
+            }
+            for (std::size_t j0 = first; j0 < last; j0 += gevm_block) {
+                const auto width = std::min(gevm_block, last - j0);
+                for (std::size_t i = 0; i < a.rows; ++i) {
+                    simd::axpy(static_cast<T>(alpha * x[i]), a.data + i * a.stride + j0, y + j0, width);
+                }
+            }
+        }
+        template<typename T>
+        void gemv_validate(const gemm_operand<const T> &a, std::span<const T> x, std::span<T> y, std::size_t x_size,
+                           std::size_t y_size, const char *name) {
+            if (x.size() != x_size) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": input vector length does not match");
+            }
+            if (y.size() != y_size) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": output vector length does not match");
+            }
+            const gemm_operand<T>       out{y.data(), 1, y.size(), y.size()};
+            const gemm_operand<const T> in{x.data(), 1, x.size(), x.size()};
+            if (gemm_overlaps(out, a) || gemm_overlaps(out, in)) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": output must not alias an input");
+            }
+        }
+        template<typename A, typename T>
+        void gemv_impl(const A &a, std::span<const T> x, std::span<T> y, T alpha, T beta, bool parallel,
+                       const char *name) {
+            const auto m = make_gemm_operand(a);
+            const gemm_operand<const T> lhs{m.data, m.rows, m.cols, m.stride};
+            gemv_validate(lhs, x, y, lhs.cols, lhs.rows, name);
+            if (parallel) {
+                parallel_chunks(lhs.rows, 64 / sizeof(T), [&](std::size_t first, std::size_t last) {
+                    gemv_rows(lhs, x.data(), y.data(), alpha, beta, first, last);
+                });
+            } else {
+                gemv_rows(lhs, x.data(), y.data(), alpha, beta, 0, lhs.rows);
+            }
+        }
+        template<typename A, typename T>
+        void gevm_impl(std::span<const T> x, const A &a, std::span<T> y, T alpha, T beta, bool parallel,
+                       const char *name) {
+            const auto m = make_gemm_operand(a);
+            const gemm_operand<const T> rhs{m.data, m.rows, m.cols, m.stride};
+            gemv_validate(rhs, x, y, rhs.rows, rhs.cols, name);
+            if (parallel) {
+                parallel_chunks(rhs.cols, 64 / sizeof(T), [&](std::size_t first, std::size_t last) {
+                    gevm_cols(rhs, x.data(), y.data(), alpha, beta, first, last);
+                });
+            } else {
+                gevm_cols(rhs, x.data(), y.data(), alpha, beta, 0, rhs.cols);
+            }
+        }
+    }  // namespace detail
+    template<Array2d_matrix_operand A>
+        requires Array2d_linalg_value<typename A::value_type>
+    void gemv(const A &a, std::span<const typename A::value_type> x, std::span<typename A::value_type> y,
+              typename A::value_type alpha = 1, typename A::value_type beta = 0) {
+        detail::gemv_impl(a, x, y, alpha, beta, false, "gemv");
+    }
+    template<Array2d_matrix_operand A>
+        requires Array2d_linalg_value<typename A::value_type>
+    void gemv_parallel(const A &a, std::span<const typename A::value_type> x, std::span<typename A::value_type> y,
+                       typename A::value_type alpha = 1, typename A::value_type beta = 0) {
+        const auto elements = static_cast<std::size_t>(a.rows()) * static_cast<std::size_t>(a.cols());
+        detail::gemv_impl(a, x, y, alpha, beta, elements > 10000, "gemv_parallel");
+    }
+    template<Array2d_matrix_operand A>
+        requires Array2d_linalg_value<typename A::value_type>
+    [[nodiscard]] std::vector<typename A::value_type> gemv(const A &a, std::span<const typename A::value_type> x) {
+        std::vector<typename A::value_type> y(static_cast<std::size_t>(a.rows()));
+        gemv(a, x, std::span(y));
+        return y;
+    }
+    template<Array2d_matrix_operand A>
+        requires Array2d_linalg_value<typename A::value_type>
+    void gevm(std::span<const typename A::value_type> x, const A &a, std::span<typename A::value_type> y,
+              typename A::value_type alpha = 1, typename A::value_type beta = 0) {
+        detail::gevm_impl(x, a, y, alpha, beta, false, "gevm");
+    }
+    template<Array2d_matrix_operand A>
+        requires Array2d_linalg_value<typename A::value_type>
+    void gevm_parallel(std::span<const typename A::value_type> x, const A &a, std::span<typename A::value_type> y,
+                       typename A::value_type alpha = 1, typename A::value_type beta = 0) {
+        const auto elements = static_cast<std::size_t>(a.rows()) * static_cast<std::size_t>(a.cols());
+        detail::gevm_impl(x, a, y, alpha, beta, elements > 10000, "gevm_parallel");
+    }
+    template<Array2d_matrix_operand A>
+        requires Array2d_linalg_value<typename A::value_type>
+    [[nodiscard]] std::vector<typename A::value_type> gevm(std::span<const typename A::value_type> x, const A &a) {
+        std::vector<typename A::value_type> y(static_cast<std::size_t>(a.cols()));
+        gevm(x, a, std::span(y));
+        return y;
+    }
+}  // namespace qm
+namespace qm {
+    template<typename Ty>
+    using summed_area_sum_t = std::conditional_t<std::is_floating_point_v<Ty>, std::common_type_t<Ty, double>,
+                                                 std::conditional_t<std::is_signed_v<Ty>, std::int64_t, std::uint64_t>>;
+    template<typename Ty, typename Sum = summed_area_sum_t<Ty>, Array2d_index_type Idx = int>
+    class summed_area_table {
+    public:
+        using source_type = Ty;
+        using value_type  = Sum;
+        using index_type  = Idx;
+        using size_type   = std::make_unsigned_t<Idx>;
+        using table_type  = array2d<Sum, Idx>;
+        summed_area_table() : table_(1, 1, Sum{}) {}
+        template<Array2d_matrix_operand M>
+            requires std::convertible_to<typename M::value_type, Sum>
+        explicit summed_area_table(const M &src) {
+            build(src, false);
+        }
+        template<Array2d_matrix_operand M>
+            requires std::convertible_to<typename M::value_type, Sum>
+        void assign(const M &src) {
+            build(src, false);
+        }
+        template<Array2d_matrix_operand M>
+            requires std::convertible_to<typename M::value_type, Sum>
+        void assign_parallel(const M &src) {
+            const auto elements = static_cast<std::size_t>(src.rows()) * static_cast<std::size_t>(src.cols());
+            build(src, elements > 10000);
+        }
+        [[nodiscard]] index_type rows() const noexcept { return table_.rows() - 1; }
+        [[nodiscard]] index_type cols() const noexcept { return table_.cols() - 1; }
+        [[nodiscard]] bool empty() const noexcept { return rows() == 0 || cols() == 0; }
+        [[nodiscard]] Sum rect_sum(index_type r0, index_type c0, index_type r1, index_type c1) const {
+            if (std::cmp_less(r0, 0) || r0 > r1 || r1 > rows() || std::cmp_less(c0, 0) || c0 > c1 || c1 > cols()) [[unlikely]] {
+                throw std::out_of_range("rect_sum: rectangle [" + std::to_string(r0) + ", " + std::to_string(r1) +
+                                        ") x [" + std::to_string(c0) + ", " + std::to_string(c1) +
+                                        ") out of range");
+            }
+            return table_(r1, c1) - table_(r0, c1) - table_(r1, c0) + table_(r0, c0);
+        }
+        [[nodiscard]] Sum total() const noexcept { return table_(rows(), cols()); }
+        [[nodiscard]] const table_type &table() const noexcept { return table_; }
+
+    private:
+        table_type table_;
+        template<typename T>
+        static void prefix_row(const T *in, Sum *out, std::size_t count) noexcept {
+            out[0] = Sum{};
+            Sum         carry{};
+            std::size_t j = 0;
+            for (; j + 4 <= count; j += 4) {
+                const Sum p0 = static_cast<Sum>(in[j]);
+                const Sum p1 = p0 + static_cast<Sum>(in[j + 1]);
+                const Sum p2 = p1 + static_cast<Sum>(in[j + 2]);
+                const Sum p3 = p2 + static_cast<Sum>(in[j + 3]);
+                out[j + 1]   = carry + p0;
+                out[j + 2]   = carry + p1;
+                out[j + 3]   = carry + p2;
+                carry        = carry + p3;
+                out[j + 4]   = carry;
+            }
+            for (; j < count; ++j) {
+                carry      = carry + static_cast<Sum>(in[j]);
+                out[j + 1] = carry;
+            }
+        }
+        static void accumulate_row(const Sum *prev, Sum *out, std::size_t count) noexcept {
+            QM_IVDEP
+            for (std::size_t j = 0; j < count; ++j) {
+                out[j] += prev[j];
+            }
+        }
+        template<typename M>
+        void build(const M &src, bool parallel) {
+            const auto rows = static_cast<std::size_t>(src.rows());
+            const auto cols = static_cast<std::size_t>(src.cols());
+            if (static_cast<std::size_t>(table_.rows()) != rows + 1 || static_cast<std::size_t>(table_.cols()) != cols + 1) {
+                if (rows + 1 > static_cast<std::size_t>(std::numeric_limits<Idx>::max()) ||
+                    cols + 1 > static_cast<std::size_t>(std::numeric_limits<Idx>::max())) [[unlikely]] {
+                    throw std::overflow_error("summed_area_table: table dimensions overflow index type");
+                }
+                table_ = table_type(static_cast<Idx>(rows + 1), static_cast<Idx>(cols + 1), uninitialized);
+            }
+            const auto  in_stride  = static_cast<std::size_t>(src.pitch());
+            const auto  out_stride = static_cast<std::size_t>(table_.pitch());
+            const auto *in         = src.data();
+            Sum        *out        = table_.data();
+            std::fill(out, out + cols + 1, Sum{});
+            if (!parallel) {
+                for (std::size_t i = 0; i < rows; ++i) {
+                    Sum *row = out + (i + 1) * out_stride;
+                    prefix_row(in + i * in_stride, row, cols);
+                    accumulate_row(row - out_stride, row, cols + 1);
+                }
+                return;
+            }
+            detail::parallel_chunks(rows, 1, [&](std::size_t first, std::size_t last) {
+                for (std::size_t i = first; i < last; ++i) {
+                    prefix_row(in + i * in_stride, out + (i + 1) * out_stride, cols);
+                }
+            });
+            detail::parallel_chunks(cols + 1, std::max<std::size_t>(1, 64 / sizeof(Sum)), [&](std::size_t first, std::size_t last) {
+                for (std::size_t i = 1; i <= rows; ++i) {
+                    Sum *row = out + i * out_stride;
+                    accumulate_row(row - out_stride + first, row + first, last - first);
+                }
+            });
+        }
+    };
+}  // namespace qm
+namespace qm {
+    enum class Array_border_opt : std::int8_t {
+        Clamp    = 0,
+        Wrap     = 1,
+        Reflect  = 2,
+        Constant = 3
+    };
+    namespace detail {
+        template<typename T>
+        using stencil_widen_t =
+                std::conditional_t<!std::is_integral_v<T> || sizeof(T) >= sizeof(std::int64_t), T,
+                                   std::conditional_t<sizeof(T) == 1, std::int32_t, std::int64_t>>;
+    }  // namespace detail
+    template<typename T, typename W>
+    using stencil_acc_t = detail::stencil_widen_t<std::common_type_t<T, W>>;
+    namespace detail {
+        inline std::ptrdiff_t border_index(std::ptrdiff_t i, std::ptrdiff_t n, Array_border_opt mode) noexcept {
+            if (i >= 0 && i < n) [[likely]] return i;
+            switch (mode) {
+                case Array_border_opt::Clamp:
+                    return i < 0 ? 0 : n - 1;
+                case Array_border_opt::Wrap: {
+                    const auto r = i % n;
+                    return r < 0 ? r + n : r;
+                }
+                case Array_border_opt::Reflect: {
+                    if (n == 1) return 0;
+                    const auto period = 2 * (n - 1);
+                    auto       r      = i % period;
+                    if (r < 0) r += period;
+                    return r < n ? r : period - r;
+                }
+                default:
+                    return -1;
+            }
+        }
+        template<typename D, typename Acc>
+        D stencil_cast(Acc v) noexcept {
+            if constexpr (std::is_integral_v<D> && std::is_floating_point_v<Acc>) {
+                v = std::nearbyint(v);
+                if (!(v > static_cast<Acc>(std::numeric_limits<D>::lowest()))) return std::numeric_limits<D>::lowest();
+                if (v >= static_cast<Acc>(std::numeric_limits<D>::max())) return std::numeric_limits<D>::max();
+                return static_cast<D>(v);
+            } else if constexpr (std::is_integral_v<D> && std::is_integral_v<Acc>) {
+                if (std::cmp_less(v, std::numeric_limits<D>::lowest())) return std::numeric_limits<D>::lowest();
+                if (std::cmp_greater(v, std::numeric_limits<D>::max())) return std::numeric_limits<D>::max();
+                return static_cast<D>(v);
+            } else {
+                return static_cast<D>(v);
+            }
+        }
+        template<typename T, typename Acc>
+        struct stencil_source {
+            const T         *data;
+            std::ptrdiff_t   rows;
+            std::ptrdiff_t   cols;
+            std::size_t      stride;
+            Array_border_opt mode;
+            Acc              border;
+            const Acc *row(std::ptrdiff_t r, std::ptrdiff_t first, std::size_t count, Acc *buffer) const {
+                const auto last   = first + static_cast<std::ptrdiff_t>(count);
+                const auto mapped = border_index(r, rows, mode);
+                if (mapped < 0) {
+                    std::fill(buffer, buffer + count, border);
+                    return buffer;
+                }
+                const T *p = data + static_cast<std::size_t>(mapped) * stride;
+                if constexpr (std::same_as<T, Acc>) {
+                    if (first >= 0 && last <= cols) return p + first;
+                }
+                const auto lo = std::clamp<std::ptrdiff_t>(first, 0, cols);
+                const auto hi = std::clamp<std::ptrdiff_t>(last, lo, cols);
+                for (auto c = first; c < lo; ++c) {
+                    const auto m       = border_index(c, cols, mode);
+                    buffer[c - first] = m < 0 ? border : static_cast<Acc>(p[m]);
+                }
+                Acc *middle = buffer + (lo - first);
+                QM_IVDEP
+                for (std::ptrdiff_t c = 0; c < hi - lo; ++c) {
+                    middle[c] = static_cast<Acc>(p[lo + c]);
+                }
+                for (auto c = hi; c < last; ++c) {
+                    const auto m       = border_index(c, cols, mode);
+                    buffer[c - first] = m < 0 ? border : static_cast<Acc>(p[m]);
+                }
+                return buffer;
+            }
+        };
+        template<typename Acc>
+        std::size_t stencil_tile_width(std::size_t ring_rows, std::size_t kw, std::size_t cols) noexcept {
+            constexpr std::size_t budget = (std::size_t{256} << 10) / sizeof(Acc);
+            const auto            per_row = budget / (ring_rows + 2);
+            const auto            tile    = per_row > kw + 256 ? per_row - kw : 256;
+            return std::max<std::size_t>(1, std::min(tile, cols));
+        }
+        inline std::size_t stencil_slot(std::ptrdiff_t r, std::size_t n) noexcept {
+            const auto m = r % static_cast<std::ptrdiff_t>(n);
+            return static_cast<std::size_t>(m < 0 ? m + static_cast<std::ptrdiff_t>(n) : m);
+        }
+        template<typename D, typename Acc, typename Fn>
+        void stencil_emit(D *out, Acc *buffer, std::size_t n, Fn compute) {
+            if constexpr (std::same_as<D, Acc>) {
+                compute(out);
+            } else {
+                compute(buffer);
+                for (std::size_t j = 0; j < n; ++j) out[j] = stencil_cast<D>(buffer[j]);
+            }
+        }
+        template<typename T, typename Acc, typename D>
+        void stencil_rows(const stencil_source<T, Acc> &src, const Acc *weights, std::size_t kh, std::size_t kw,
+                          D *dst, std::size_t dst_stride, std::size_t row_first, std::size_t row_last) {
+            const auto ah    = static_cast<std::ptrdiff_t>(kh / 2);
+            const auto aw    = static_cast<std::ptrdiff_t>(kw / 2);
+            const auto cols  = static_cast<std::size_t>(src.cols);
+            const auto tile  = stencil_tile_width<Acc>(kh, kw, cols);
+            const auto width = tile + kw - 1;
+            std::vector<Acc>            ring(kh * width);
+            std::vector<const Acc *>    slot_data(kh);
+            std::vector<std::ptrdiff_t> slot_row(kh);
+            std::vector<const Acc *>    taps(kh);
+            std::vector<Acc>            acc(tile);
+            for (std::size_t j0 = 0; j0 < cols; j0 += tile) {
+                const auto tw    = std::min(tile, cols - j0);
+                const auto first = static_cast<std::ptrdiff_t>(j0) - aw;
+                std::fill(slot_row.begin(), slot_row.end(), std::numeric_limits<std::ptrdiff_t>::min());
+                for (auto i = row_first; i < row_last; ++i) {
+                    for (std::size_t u = 0; u < kh; ++u) {
+                        const auto r    = static_cast<std::ptrdiff_t>(i + u) - ah;
+                        const auto slot = stencil_slot(r, kh);
+                        if (slot_row[slot] != r) {
+                            slot_data[slot] = src.row(r, first, tw + kw - 1, ring.data() + slot * width);
+                            slot_row[slot]  = r;
+                        }
+                        taps[u] = slot_data[slot];
+                    }
+                    stencil_emit(dst + i * dst_stride + j0, acc.data(), tw, [&](Acc *target) {
+                        simd::correlate_rows(taps.data(), kh, weights, kw, target, tw);
+                    });
+                }
+            }
+        }
+        template<typename T, typename Acc, typename D>
+        void stencil_separable_rows(const stencil_source<T, Acc> &src, const Acc *row_kernel, std::size_t kw,
+                                    const Acc *col_kernel, std::size_t kh, D *dst, std::size_t dst_stride,
+                                    std::size_t row_first, std::size_t row_last) {
+            const auto ah   = static_cast<std::ptrdiff_t>(kh / 2);
+            const auto aw   = static_cast<std::ptrdiff_t>(kw / 2);
+            const auto cols = static_cast<std::size_t>(src.cols);
+            const auto tile = stencil_tile_width<Acc>(kh + 1, kw, cols);
+            std::vector<Acc>            ring(kh * tile);
+            std::vector<std::ptrdiff_t> slot_row(kh);
+            std::vector<Acc>            padded(tile + kw - 1);
+            std::vector<const Acc *>    lines(kh);
+            std::vector<Acc>            acc(tile);
+            for (std::size_t j0 = 0; j0 < cols; j0 += tile) {
+                const auto tw    = std::min(tile, cols - j0);
+                const auto first = static_cast<std::ptrdiff_t>(j0) - aw;
+                std::fill(slot_row.begin(), slot_row.end(), std::numeric_limits<std::ptrdiff_t>::min());
+                for (auto i = row_first; i < row_last; ++i) {
+                    for (std::size_t u = 0; u < kh; ++u) {
+                        const auto r    = static_cast<std::ptrdiff_t>(i + u) - ah;
+                        const auto slot = stencil_slot(r, kh);
+                        Acc       *line = ring.data() + slot * tile;
+                        if (slot_row[slot] != r) {
+                            const Acc *source = src.row(r, first, tw + kw - 1, padded.data());
+                            simd::correlate_rows(&source, 1, row_kernel, kw, line, tw);
+                            slot_row[slot] = r;
+                        }
+                        lines[u] = line;
+                    }
+                    stencil_emit(dst + i * dst_stride + j0, acc.data(), tw, [&](Acc *target) {
+                        simd::correlate_rows(lines.data(), kh, col_kernel, 1, target, tw);
+                    });
+                }
+            }
+        }
+        template<typename Fn>
+        void stencil_dispatch(std::size_t rows, bool parallel, Fn fn) {
+            if (parallel) {
+                parallel_chunks(rows, 1, fn);
+            } else {
+                fn(std::size_t{0}, rows);
+            }
+        }
+        template<typename T, typename D>
+        void stencil_validate(const gemm_operand<const T> &src, const gemm_operand<D> &dst, const char *name) {
+            if (dst.rows != src.rows || dst.cols != src.cols) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": output shape does not match");
+            }
+            if (gemm_overlaps(dst, src)) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": output must not alias the source");
+            }
+        }
+        template<typename Acc, typename S, typename D, typename K>
+        void stencil_impl(const S &src, D &dst, const K &kernel, Array_border_opt border,
+                          typename S::value_type border_value, bool parallel, const char *name) {
+            using T        = typename S::value_type;
+            const auto in  = make_gemm_operand(src);
+            const auto out = make_gemm_operand(dst);
+            if (kernel.rows() <= 0 || kernel.cols() <= 0) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": kernel is empty");
+            }
+            stencil_validate(gemm_operand<const T>{in.data, in.rows, in.cols, in.stride}, out, name);
+            if (in.rows == 0 || in.cols == 0) return;
+            const auto       kh = static_cast<std::size_t>(kernel.rows());
+            const auto       kw = static_cast<std::size_t>(kernel.cols());
+            std::vector<Acc> weights(kh * kw);
+            for (std::size_t u = 0; u < kh; ++u) {
+                const auto *row = kernel.data() + u * static_cast<std::size_t>(kernel.pitch());
+                std::transform(row, row + kw, weights.begin() + static_cast<std::ptrdiff_t>(u * kw),
+                               [](const auto &w) { return static_cast<Acc>(w); });
+            }
+            const stencil_source<T, Acc> source{in.data,
+                                                static_cast<std::ptrdiff_t>(in.rows),
+                                                static_cast<std::ptrdiff_t>(in.cols),
+                                                in.stride,
+                                                border,
+                                                static_cast<Acc>(border_value)};
+            stencil_dispatch(in.rows, parallel, [&](std::size_t first, std::size_t last) {
+                stencil_rows(source, weights.data(), kh, kw, out.data, out.stride, first, last);
+            });
+        }
+        template<typename Acc, typename S, typename D, typename R, typename C>
+        void stencil_separable_impl(const S &src, D &dst, const R &row_kernel, const C &col_kernel,
+                                    Array_border_opt border, typename S::value_type border_value, bool parallel,
+                                    const char *name) {
+            using T        = typename S::value_type;
+            const auto in  = make_gemm_operand(src);
+            const auto out = make_gemm_operand(dst);
+            if (std::ranges::empty(row_kernel) || std::ranges::empty(col_kernel)) [[unlikely]] {
+                throw std::invalid_argument(std::string(name) + ": kernel is empty");
+            }
+            stencil_validate(gemm_operand<const T>{in.data, in.rows, in.cols, in.stride}, out, name);
+            if (in.rows == 0 || in.cols == 0) return;
+            std::vector<Acc> horizontal(std::ranges::size(row_kernel));
+            std::vector<Acc> vertical(std::ranges::size(col_kernel));
+            std::ranges::transform(row_kernel, horizontal.begin(), [](const auto &w) { return static_cast<Acc>(w); });
+            std::ranges::transform(col_kernel, vertical.begin(), [](const auto &w) { return static_cast<Acc>(w); });
+            const stencil_source<T, Acc> source{in.data,
+                                                static_cast<std::ptrdiff_t>(in.rows),
+                                                static_cast<std::ptrdiff_t>(in.cols),
+                                                in.stride,
+                                                border,
+                                                static_cast<Acc>(border_value)};
+            stencil_dispatch(in.rows, parallel, [&](std::size_t first, std::size_t last) {
+                stencil_separable_rows(source, horizontal.data(), horizontal.size(), vertical.data(), vertical.size(),
+                                       out.data, out.stride, first, last);
+            });
+        }
+    }  // namespace detail
+    template<Array2d_matrix_operand S, typename D, Array2d_matrix_operand K>
+        requires Array2d_linalg_value<typename S::value_type> && Array2d_linalg_value<typename K::value_type> &&
+                 Array2d_writable_operand<std::remove_reference_t<D>, typename std::remove_reference_t<D>::value_type>
+    void stencil(const S &src, D &&dst, const K &kernel, Array_border_opt border = Array_border_opt::Clamp,
+                 typename S::value_type border_value = {}) {
+        using Acc = stencil_acc_t<typename S::value_type, typename K::value_type>;
+        detail::stencil_impl<Acc>(src, dst, kernel, border, border_value, false, "stencil");
+    }
+    template<Array2d_matrix_operand S, typename D, Array2d_matrix_operand K>
+        requires Array2d_linalg_value<typename S::value_type> && Array2d_linalg_value<typename K::value_type> &&
+                 Array2d_writable_operand<std::remove_reference_t<D>, typename std::remove_reference_t<D>::value_type>
+    void stencil_parallel(const S &src, D &&dst, const K &kernel, Array_border_opt border = Array_border_opt::Clamp,
+                          typename S::value_type border_value = {}) {
+        using Acc           = stencil_acc_t<typename S::value_type, typename K::value_type>;
+        const auto elements = static_cast<std::size_t>(src.rows()) * static_cast<std::size_t>(src.cols());
+        detail::stencil_impl<Acc>(src, dst, kernel, border, border_value, elements > 10000, "stencil_parallel");
+    }
+    template<Array2d_matrix_operand S, Array2d_matrix_operand K>
+        requires Array2d_linalg_value<typename S::value_type> && Array2d_linalg_value<typename K::value_type>
+    [[nodiscard]] array2d<typename S::value_type, operand_index_t<S>> stencil(
+            const S &src, const K &kernel, Array_border_opt border = Array_border_opt::Clamp,
+            typename S::value_type border_value = {}) {
+        auto dst = detail::make_result<typename S::value_type, operand_index_t<S>>(src.rows(), src.cols(), "stencil");
+        stencil(src, dst, kernel, border, border_value);
+        return dst;
+    }
+    template<Array2d_matrix_operand S, typename D, std::ranges::contiguous_range R, std::ranges::contiguous_range C>
+        requires Array2d_linalg_value<typename S::value_type> &&
+                 Array2d_linalg_value<std::ranges::range_value_t<R>> &&
+                 std::same_as<std::ranges::range_value_t<R>, std::ranges::range_value_t<C>> &&
+                 Array2d_writable_operand<std::remove_reference_t<D>, typename std::remove_reference_t<D>::value_type>
+    void stencil_separable(const S &src, D &&dst, const R &row_kernel, const C &col_kernel,
+                           Array_border_opt border = Array_border_opt::Clamp, typename S::value_type border_value = {}) {
+        using Acc = stencil_acc_t<typename S::value_type, std::ranges::range_value_t<R>>;
+        detail::stencil_separable_impl<Acc>(src, dst, row_kernel, col_kernel, border, border_value, false,
+                                            "stencil_separable");
+    }
+    template<Array2d_matrix_operand S, typename D, std::ranges::contiguous_range R, std::ranges::contiguous_range C>
+        requires Array2d_linalg_value<typename S::value_type> &&
+                 Array2d_linalg_value<std::ranges::range_value_t<R>> &&
+                 std::same_as<std::ranges::range_value_t<R>, std::ranges::range_value_t<C>> &&
+                 Array2d_writable_operand<std::remove_reference_t<D>, typename std::remove_reference_t<D>::value_type>
+    void stencil_separable_parallel(const S &src, D &&dst, const R &row_kernel, const C &col_kernel,
+                                    Array_border_opt border       = Array_border_opt::Clamp,
+                                    typename S::value_type border_value = {}) {
+        using Acc           = stencil_acc_t<typename S::value_type, std::ranges::range_value_t<R>>;
+        const auto elements = static_cast<std::size_t>(src.rows()) * static_cast<std::size_t>(src.cols());
+        detail::stencil_separable_impl<Acc>(src, dst, row_kernel, col_kernel, border, border_value, elements > 10000,
+                                            "stencil_separable_parallel");
+    }
+}  // namespace qm
+namespace qm {
+    template<Array2d_compatible Ty, Array2d_index_type Idx = int, typename Alloc = std::allocator<Ty>,
+             Array2d_layout Layout = dense_layout>
+    class double_buffered_array2d {
+        struct alignas(64) reader_slot {
+            std::atomic<std::size_t> count{0};
+        };
+    public:
+        using array_type      = array2d<Ty, Idx, Alloc, Layout>;
+        using value_type      = Ty;
+        using index_type      = Idx;
+        using view_type       = array2d_view<Ty, Idx>;
+        using const_view_type = array2d_view<const Ty, Idx>;
+        class read_guard {
+        public:
+            read_guard(const read_guard &)            = delete;
+            read_guard &operator=(const read_guard &) = delete;
+            read_guard(read_guard &&other) noexcept
+                : slot_(std::exchange(other.slot_, nullptr)), view_(other.view_), generation_(other.generation_) {}
+            read_guard &operator=(read_guard &&other) noexcept {
+                if (this != &other) {
+                    release();
+                    slot_       = std::exchange(other.slot_, nullptr);
+                    view_       = other.view_;
+                    generation_ = other.generation_;
+                }
+                return *this;
+            }
+            ~read_guard() { release(); }
+            [[nodiscard]] const const_view_type &view() const noexcept { return view_; }
+            [[nodiscard]] std::uint64_t generation() const noexcept { return generation_; }
+            const const_view_type *operator->() const noexcept { return &view_; }
+
+        private:
+            friend class double_buffered_array2d;
+            reader_slot    *slot_;
+            const_view_type view_;
+            std::uint64_t   generation_;
+            read_guard(reader_slot &slot, const_view_type view, std::uint64_t generation) noexcept
+                : slot_(&slot), view_(view), generation_(generation) {}
+            void release() noexcept {
+                if (slot_) slot_->count.fetch_sub(1, std::memory_order_release);
+                slot_ = nullptr;
+            }
         };
-        [[nodiscard]] row_iterator_wrapper row_range(index_type row) noexcept {
-            assert_bounds(row, rows_);
-            return {data_.data() + calculate_offset(row, 0), static_cast<size_type>(cols_)};
-        }
-        [[nodiscard]] const_row_iterator_wrapper row_range(index_type row) const noexcept {
-            assert_bounds(row, rows_);
-            return {data_.data() + calculate_offset(row, 0), static_cast<size_type>(cols_)};
+        double_buffered_array2d(index_type rows, index_type cols, const Ty &value = Ty{})
+            : buffers_{array_type(rows, cols, value), array_type(rows, cols, value)} {}
+        explicit double_buffered_array2d(array_type initial) : buffers_{std::move(initial), array_type{}} {
+            buffers_[1] = buffers_[0];
         }
-        [[nodiscard]] constexpr index_type rows() const noexcept { return rows_; }
-        [[nodiscard]] constexpr index_type cols() const noexcept { return cols_; }
-        [[nodiscard]] constexpr size_type  size() const noexcept { return data_.size(); }
-        [[nodiscard]] constexpr bool       empty() const noexcept { return data_.empty(); }
-        [[nodiscard]] constexpr size_type  capacity() const noexcept { return data_.capacity(); }
-        [[nodiscard]] constexpr bool       is_square() const noexcept { return rows_ == cols_; }
-        void                               reserve(index_type rows, index_type cols) {
-            const auto new_capacity = calculate_size(
-                    validate_dimension(rows, "rows"),
-                    validate_dimension(cols, "cols"));
-            data_.reserve(new_capacity);
+        double_buffered_array2d(const double_buffered_array2d &)            = delete;
+        double_buffered_array2d &operator=(const double_buffered_array2d &) = delete;
+        [[nodiscard]] index_type rows() const noexcept { return buffers_[0].rows(); }
+        [[nodiscard]] index_type cols() const noexcept { return buffers_[0].cols(); }
+        [[nodiscard]] std::uint64_t generation() const noexcept { return generation_.load(std::memory_order_acquire); }
+        [[nodiscard]] read_guard read() const noexcept {
+            for (;;) {
+                const auto g    = generation_.load();
+                auto      &slot = readers_[g & 1];
+                slot.count.fetch_add(1);
+                if (generation_.load() == g) return read_guard(slot, const_view_type(buffers_[g & 1]), g);
+                slot.count.fetch_sub(1, std::memory_order_relaxed);
+            }
         }
-        void shrink_to_fit() {
-            data_.shrink_to_fit();
+        [[nodiscard]] const_view_type front() const noexcept {
+            return const_view_type(buffers_[generation_.load(std::memory_order_relaxed) & 1]);
         }
-        [[nodiscard]] constexpr std::span<Ty> as_span() noexcept {
-            return {data_.data(), data_.size()};
+        [[nodiscard]] view_type back() noexcept {
+            const auto next = (generation_.load(std::memory_order_relaxed) + 1) & 1;
+            while (readers_[next].count.load() != 0) std::this_thread::yield();
+            return view_type(buffers_[next]);
         }
-        [[nodiscard]] constexpr std::span<const Ty> as_span() const noexcept {
-            return {data_.data(), data_.size()};
+        void publish() noexcept { generation_.fetch_add(1); }
+        template<typename Fn>
+            requires std::invocable<Fn &, const_view_type, view_type>
+        void update(Fn &&fn) {
+            auto next = back();
+            fn(front(), next);
+            publish();
         }
-        [[nodiscard]] constexpr std::span<Ty> row(index_type row) noexcept {
-            assert_bounds(row, rows_);
-            return {data_.data() + calculate_offset(row, 0), static_cast<size_type>(cols_)};
+        template<typename Fn>
+            requires std::invocable<Fn &, const_view_type, view_type, index_type, index_type>
+        void update_parallel(Fn &&fn, std::size_t grain = 0) {
+            const auto cur  = front();
+            const auto next = back();
+            parallel_for_rows(rows(), [&](index_type first, index_type last) { fn(cur, next, first, last); }, grain);
+            publish();
         }
-        [[nodiscard]] constexpr std::span<const Ty> row(index_type row) const noexcept {
-            assert_bounds(row, rows_);
-            return {data_.data() + calculate_offset(row, 0), static_cast<size_type>(cols_)};
+
+    private:
+        array_type                 buffers_[2];
+        mutable reader_slot        readers_[2];
+        std::atomic<std::uint64_t> generation_{0};
+    };
+}  // namespace qm
+namespace qm {
+    template<Array2d_compatible Ty, Array2d_index_type Idx = int>
+        requires std::default_initializable<Ty> && std::copyable<Ty>
+    class cow_array2d {
+    public:
+        using value_type      = Ty;
+        using index_type      = Idx;
+        using size_type       = std::size_t;
+        using reference       = Ty &;
+        using const_reference = const Ty &;
+        using view_type       = array2d_view<Ty, Idx>;
+        using const_view_type = array2d_view<const Ty, Idx>;
+        static constexpr index_type default_tile_extent = 64;
+        cow_array2d() = default;
+        cow_array2d(index_type rows, index_type cols, const Ty &value = Ty{},
+                    index_type tile_rows = default_tile_extent, index_type tile_cols = default_tile_extent) {
+            reshape(rows, cols, tile_rows, tile_cols);
+            fill(value);
         }
-        [[nodiscard]] std::vector<Ty> col(index_type col) const {
-            assert_bounds(col, cols_);
-            std::vector<Ty> result;
-            result.reserve(static_cast<size_type>(rows_));
-            for (index_type i = 0; i < rows_; ++i) {
-                result.push_back(data_[calculate_offset(i, col)]);
+        template<Array2d_matrix_operand M>
+            requires std::convertible_to<typename M::value_type, Ty>
+        explicit cow_array2d(const M &src, index_type tile_rows = default_tile_extent,
+                             index_type tile_cols = default_tile_extent) {
+            reshape(static_cast<index_type>(src.rows()), static_cast<index_type>(src.cols()), tile_rows, tile_cols);
+            const auto pitch = static_cast<size_type>(src.pitch());
+            for (size_type t = 0; t < tiles_.size(); ++t) {
+                auto       tile = make_tile();
+                const auto [r0, c0, height, width] = tile_extent(t);
+                for (size_type i = 0; i < height; ++i) {
+                    std::copy_n(src.data() + (r0 + i) * pitch + c0, width, tile.get() + i * tile_stride());
+                }
+                tiles_[t] = std::move(tile);
             }
-            return result;
         }
-        [[nodiscard]] std::span<Ty> submatrix_row_major(
-                index_type start_row, index_type start_col,
-                index_type num_rows, index_type num_cols) noexcept {
-            assert_bounds(start_row, rows_);
-            assert_bounds(start_col, cols_);
-            assert_bounds(start_row + num_rows - 1, rows_);
-            assert_bounds(start_col + num_cols - 1, cols_);
-            if (start_col == 0 && num_cols == cols_) {
-                return {data_.data() + calculate_offset(start_row, 0),
-                        static_cast<size_type>(num_rows * cols_)};
-            }
-            return {data_.data() + calculate_offset(start_row, start_col),
-                    static_cast<size_type>(num_cols)};
+        cow_array2d(const cow_array2d &)            = default;
+        cow_array2d(cow_array2d &&) noexcept        = default;
+        cow_array2d &operator=(const cow_array2d &) = default;
+        cow_array2d &operator=(cow_array2d &&) noexcept = default;
+        [[nodiscard]] cow_array2d snapshot() const { return *this; }
+        [[nodiscard]] index_type rows() const noexcept { return rows_; }
+        [[nodiscard]] index_type cols() const noexcept { return cols_; }
+        [[nodiscard]] bool       empty() const noexcept { return rows_ == 0 || cols_ == 0; }
+        [[nodiscard]] index_type tile_rows() const noexcept { return tile_rows_; }
+        [[nodiscard]] index_type tile_cols() const noexcept { return tile_cols_; }
+        [[nodiscard]] index_type tiles_down() const noexcept {
+            return tiles_across_ == 0 ? 0 : static_cast<index_type>(tiles_.size() / tiles_across_);
         }
-        void reset(Array_reset_opt opt = Array_reset_opt::All_bits0) noexcept {
-            if (data_.empty()) return;
-            if constexpr (std::is_trivially_destructible_v<Ty> &&
-                          std::is_trivially_default_constructible_v<Ty> &&
-                          std::is_standard_layout_v<Ty>) {
-                if (opt == Array_reset_opt::All_bits0) {
-                    if constexpr (sizeof(Ty) % sizeof(std::uint64_t) == 0) {
-                        const auto count = data_.size() * sizeof(Ty) / sizeof(std::uint64_t);
-                        auto      *ptr   = reinterpret_cast<std::uint64_t *>(data_.data());
-                        std::fill_n(ptr, count, 0ULL);
-                    } else {
-                        std::memset(data_.data(), 0, data_.size() * sizeof(Ty));
-                    }
+        [[nodiscard]] index_type tiles_across() const noexcept { return static_cast<index_type>(tiles_across_); }
+        [[nodiscard]] const_reference operator()(index_type row, index_type col) const noexcept {
+            const auto [tile, offset] = locate(row, col);
+            return tiles_[tile][offset];
+        }
+        [[nodiscard]] const_reference at(index_type row, index_type col) const {
+            check_bounds(row, col);
+            return (*this)(row, col);
+        }
+        [[nodiscard]] reference modify(index_type row, index_type col) {
+            check_bounds(row, col);
+            const auto [tile, offset] = locate(row, col);
+            return writable_tile(tile)[offset];
+        }
+        void set(index_type row, index_type col, const Ty &value) { modify(row, col) = value; }
+        [[nodiscard]] const_view_type tile(index_type tile_row, index_type tile_col) const {
+            const auto t                  = tile_index(tile_row, tile_col);
+            const auto [r0, c0, h, w]     = tile_extent(t);
+            return const_view_type(tiles_[t].get(), static_cast<index_type>(h), static_cast<index_type>(w),
+                                   row_pitch{tile_stride()});
+        }
+        [[nodiscard]] view_type tile(index_type tile_row, index_type tile_col) {
+            const auto t              = tile_index(tile_row, tile_col);
+            const auto [r0, c0, h, w] = tile_extent(t);
+            return view_type(writable_tile(t), static_cast<index_type>(h), static_cast<index_type>(w),
+                             row_pitch{tile_stride()});
+        }
+        [[nodiscard]] bool tile_shared(index_type tile_row, index_type tile_col) const {
+            return tiles_[tile_index(tile_row, tile_col)].shared();
+        }
+        [[nodiscard]] size_type shared_tiles() const noexcept {
+            return static_cast<size_type>(
+                    std::count_if(tiles_.begin(), tiles_.end(), [](const auto &tile) { return tile.shared(); }));
+        }
+        void fill(const Ty &value) {
+            if (tiles_.empty()) return;
+            auto tile = make_tile();
+            std::fill_n(tile.get(), tile_size(), value);
+            std::fill(tiles_.begin(), tiles_.end(), tile);
+        }
+        [[nodiscard]] array2d<Ty, Idx> to_array2d() const {
+            array2d<Ty, Idx> result = [this] {
+                if constexpr (std::is_trivially_default_constructible_v<Ty>) {
+                    return array2d<Ty, Idx>(rows_, cols_, uninitialized);
                 } else {
-                    std::memset(data_.data(), static_cast<int>(opt), data_.size() * sizeof(Ty));
+                    return array2d<Ty, Idx>(rows_, cols_);
                 }
-            } else {
-                if constexpr (std::is_nothrow_default_constructible_v<Ty>) {
-                    std::fill(data_.begin(), data_.end(), Ty{});
-                } else {
-                    for (auto &element: data_) {
-                        element = Ty{};
-                    }
+            }();
+            const auto pitch = static_cast<size_type>(result.pitch());
+            for (size_type t = 0; t < tiles_.size(); ++t) {
+                const auto [r0, c0, height, width] = tile_extent(t);
+                for (size_type i = 0; i < height; ++i) {
+                    std::copy_n(tiles_[t].get() + i * tile_stride(), width, result.data() + (r0 + i) * pitch + c0);
                 }
             }
+            return result;
         }
-        void fill(const Ty &val) noexcept(std::is_nothrow_copy_assignable_v<Ty>) {
-            if constexpr (std::is_trivially_copyable_v<Ty> && sizeof(Ty) == 1) {
-                std::memset(data_.data(), *reinterpret_cast<const unsigned char *>(&val), data_.size());
-            } else {
-                std::fill(data_.begin(), data_.end(), val);
+
+    private:
+        struct tile_rect {
+            size_type row, col, height, width;
+        };
+        class tile_ref {
+        public:
+            tile_ref() noexcept = default;
+            explicit tile_ref(size_type size) : block_(new block{{1}, std::make_unique<Ty[]>(size)}) {}
+            tile_ref(const tile_ref &other) noexcept : block_(other.block_) {
+                if (block_) block_->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+            tile_ref(tile_ref &&other) noexcept : block_(std::exchange(other.block_, nullptr)) {}
+            tile_ref &operator=(const tile_ref &other) noexcept {
+                tile_ref(other).swap(*this);
+                return *this;
+            }
+            tile_ref &operator=(tile_ref &&other) noexcept {
+                tile_ref(std::move(other)).swap(*this);
+                return *this;
             }
+            ~tile_ref() {
+                if (block_ && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete block_;
+            }
+            void swap(tile_ref &other) noexcept { std::swap(block_, other.block_); }
+            [[nodiscard]] Ty *get() const noexcept { return block_ ? block_->elements.get() : nullptr; }
+            [[nodiscard]] Ty &operator[](size_type i) const noexcept { return block_->elements[i]; }
+            [[nodiscard]] bool unique() const noexcept { return block_->refs.load(std::memory_order_acquire) == 1; }
+            [[nodiscard]] bool shared() const noexcept {
+                return block_ && block_->refs.load(std::memory_order_relaxed) > 1;
+            }
+        private:
+            struct block {
+                std::atomic<size_type> refs;
+                std::unique_ptr<Ty[]>  elements;
+            };
+            block *block_ = nullptr;
+        };
+        index_type                       rows_         = 0;
+        index_type                       cols_         = 0;
+        index_type                       tile_rows_    = default_tile_extent;
+        index_type                       tile_cols_    = default_tile_extent;
+        size_type                        tiles_across_ = 0;
+        std::vector<tile_ref>            tiles_;
+        [[nodiscard]] size_type tile_stride() const noexcept { return static_cast<size_type>(tile_cols_); }
+        [[nodiscard]] size_type tile_size() const noexcept {
+            return static_cast<size_type>(tile_rows_) * static_cast<size_type>(tile_cols_);
         }
-        void fill_parallel(const Ty &val) noexcept(std::is_nothrow_copy_assignable_v<Ty>) {
-            if (data_.size() > 10000) {
-                std::fill(std::execution::par_unseq, data_.begin(), data_.end(), val);
-            } else {
-                fill(val);
+        [[nodiscard]] tile_ref make_tile() const { return tile_ref(tile_size()); }
+        void reshape(index_type rows, index_type cols, index_type tile_rows, index_type tile_cols) {
+            if (std::cmp_less(rows, 0) || std::cmp_less(cols, 0)) [[unlikely]] {
+                throw std::invalid_argument("cow_array2d: dimensions must be non-negative");
+            }
+            if (std::cmp_less_equal(tile_rows, 0) || std::cmp_less_equal(tile_cols, 0)) [[unlikely]] {
+                throw std::invalid_argument("cow_array2d: tile size must be positive");
+            }
+            rows_      = rows;
+            cols_      = cols;
+            tile_rows_ = tile_rows;
+            tile_cols_ = tile_cols;
+            if (empty()) {
+                tiles_across_ = 0;
+                tiles_.clear();
+                return;
             }
+            const auto down = (static_cast<size_type>(rows) + tile_rows - 1) / static_cast<size_type>(tile_rows);
+            tiles_across_   = (static_cast<size_type>(cols) + tile_cols - 1) / static_cast<size_type>(tile_cols);
+            tiles_.assign(down * tiles_across_, tile_ref());
         }
-        void copy_row(index_type src_row, index_type dest_row) noexcept(std::is_nothrow_copy_assignable_v<Ty>) {
-            assert_bounds(src_row, rows_);
-            assert_bounds(dest_row, rows_);
-            if (src_row == dest_row) return;
-            const auto src_offset  = calculate_offset(src_row, 0);
-            const auto dest_offset = calculate_offset(dest_row, 0);
-            const auto copy_size   = static_cast<size_type>(cols_);
-            if constexpr (std::is_trivially_copyable_v<Ty>) {
-                std::memcpy(data_.data() + dest_offset,
-                            data_.data() + src_offset,
-                            copy_size * sizeof(Ty));
-            } else {
-                std::copy_n(data_.data() + src_offset, copy_size, data_.data() + dest_offset);
+        [[nodiscard]] std::pair<size_type, size_type> locate(index_type row, index_type col) const noexcept {
+            const auto r = static_cast<size_type>(row), c = static_cast<size_type>(col);
+            const auto h = static_cast<size_type>(tile_rows_), w = static_cast<size_type>(tile_cols_);
+            return {r / h * tiles_across_ + c / w, r % h * w + c % w};
+        }
+        [[nodiscard]] tile_rect tile_extent(size_type t) const noexcept {
+            const auto row = t / tiles_across_ * static_cast<size_type>(tile_rows_);
+            const auto col = t % tiles_across_ * static_cast<size_type>(tile_cols_);
+            return {row, col, std::min(static_cast<size_type>(tile_rows_), static_cast<size_type>(rows_) - row),
+                    std::min(static_cast<size_type>(tile_cols_), static_cast<size_type>(cols_) - col)};
+        }
+        [[nodiscard]] size_type tile_index(index_type tile_row, index_type tile_col) const {
+            if (std::cmp_less(tile_row, 0) || std::cmp_greater_equal(tile_row, tiles_down()) ||
+                std::cmp_less(tile_col, 0) || std::cmp_greater_equal(tile_col, tiles_across_)) [[unlikely]] {
+                throw std::out_of_range("cow_array2d: tile (" + std::to_string(tile_row) + ", " +
+                                        std::to_string(tile_col) + ") out of range");
             }
+            return static_cast<size_type>(tile_row) * tiles_across_ + static_cast<size_type>(tile_col);
         }
-        void swap_rows(index_type row1, index_type row2) noexcept(std::is_nothrow_swappable_v<Ty>) {
-            assert_bounds(row1, rows_);
-            assert_bounds(row2, rows_);
-            if (row1 == row2) return;
-            const auto offset1   = calculate_offset(row1, 0);
-            const auto offset2   = calculate_offset(row2, 0);
-            const auto swap_size = static_cast<size_type>(cols_);
-            for (size_type i = 0; i < swap_size; ++i) {
-                using std::swap;
-                swap(data_[offset1 + i], data_[offset2 + i]);
+        void check_bounds(index_type row, index_type col) const {
+            if (std::cmp_less(row, 0) || row >= rows_ || std::cmp_less(col, 0) || col >= cols_) [[unlikely]] {
+                throw std::out_of_range("cow_array2d: index (" + std::to_string(row) + ", " + std::to_string(col) +
+                                        ") out of range");
             }
         }
-        void fill_row(index_type row, const Ty &val) noexcept(std::is_nothrow_copy_assignable_v<Ty>) {
-            assert_bounds(row, rows_);
-            const auto offset = calculate_offset(row, 0);
-            std::fill_n(data_.data() + offset, cols_, val);
+        Ty *writable_tile(size_type t) {
+            auto &tile = tiles_[t];
+            if (!tile.unique()) {
+                auto copy = make_tile();
+                std::copy_n(tile.get(), tile_size(), copy.get());
+                tile = std::move(copy);
+            }
+            return tile.get();
         }
-        void transpose() {
-            if (!is_square()) {
-                throw std::invalid_argument("transpose: matrix must be square for in-place transpose");
+    };
+}  // namespace qm
+namespace qm {
+    template<typename Ty, Array2d_index_type Idx = int>
+        requires std::is_trivially_copyable_v<Ty> && (!std::is_const_v<Ty>)
+    class array2d_atomic_view {
+    public:
+        using value_type = Ty;
+        using index_type = Idx;
+        using size_type  = std::size_t;
+        using reference  = std::atomic_ref<Ty>;
+        static constexpr size_type required_alignment = std::atomic_ref<Ty>::required_alignment;
+        constexpr array2d_atomic_view() noexcept = default;
+        array2d_atomic_view(Ty *data, index_type rows, index_type cols, row_pitch pitch)
+            : data_(data), rows_(rows), cols_(cols), pitch_(static_cast<index_type>(pitch.value)) {
+            if (std::cmp_less(rows, 0) || std::cmp_less(cols, 0)) [[unlikely]] {
+                throw std::invalid_argument("array2d_atomic_view: dimensions must be non-negative");
             }
-            constexpr size_type block_size = 64 / sizeof(Ty);
-            for (index_type i = 0; i < rows_; i += block_size) {
-                const auto i_end = std::min(i + static_cast<index_type>(block_size), rows_);
-                for (index_type j = i; j < cols_; j += block_size) {
-                    const auto j_end = std::min(j + static_cast<index_type>(block_size), cols_);
-                    for (index_type bi = i; bi < i_end; ++bi) {
-                        const auto start_j = (i == j) ? bi + 1 : j;
-                        for (index_type bj = start_j; bj < j_end; ++bj) {
-                            using std::swap;
-                            swap((*this)[bi][bj], (*this)[bj][bi]);
-                        }
-                    }
-                }
+            if (std::cmp_less(pitch.value, cols)) [[unlikely]] {
+                throw std::invalid_argument("array2d_atomic_view: pitch must not be smaller than cols");
+            }
+            if (reinterpret_cast<std::uintptr_t>(data) % required_alignment != 0 ||
+                (rows > 1 && pitch.value * sizeof(Ty) % required_alignment != 0)) [[unlikely]] {
+                throw std::invalid_argument("array2d_atomic_view: elements are not aligned to " +
+                                            std::to_string(required_alignment) + " bytes");
             }
         }
-        [[nodiscard]] array2d transposed() const {
-            array2d             result(cols_, rows_);
-            constexpr size_type block_size = 64 / sizeof(Ty);
-            for (index_type i = 0; i < rows_; i += block_size) {
-                const auto i_end = std::min(i + static_cast<index_type>(block_size), rows_);
-                for (index_type j = 0; j < cols_; j += block_size) {
-                    const auto j_end = std::min(j + static_cast<index_type>(block_size), cols_);
-                    for (index_type bi = i; bi < i_end; ++bi) {
-                        for (index_type bj = j; bj < j_end; ++bj) {
-                            result[bj][bi] = (*this)[bi][bj];
-                        }
-                    }
-                }
+        template<typename Matrix>
+            requires Array2d_matrix_operand<Matrix> && std::convertible_to<decltype(std::declval<Matrix &>().data()), Ty *>
+        explicit array2d_atomic_view(Matrix &matrix)
+            : array2d_atomic_view(matrix.data(), static_cast<index_type>(matrix.rows()),
+                                  static_cast<index_type>(matrix.cols()),
+                                  row_pitch{static_cast<std::size_t>(matrix.pitch())}) {}
+        [[nodiscard]] constexpr index_type rows() const noexcept { return rows_; }
+        [[nodiscard]] constexpr index_type cols() const noexcept { return cols_; }
+        [[nodiscard]] constexpr index_type pitch() const noexcept { return pitch_; }
+        [[nodiscard]] constexpr Ty        *data() const noexcept { return data_; }
+        [[nodiscard]] reference operator()(index_type row, index_type col) const noexcept {
+            return reference(data_[static_cast<size_type>(row) * static_cast<size_type>(pitch_) +
+                                   static_cast<size_type>(col)]);
+        }
+        [[nodiscard]] reference at(index_type row, index_type col) const {
+            if (std::cmp_less(row, 0) || row >= rows_ || std::cmp_less(col, 0) || col >= cols_) [[unlikely]] {
+                throw std::out_of_range("array2d_atomic_view: index (" + std::to_string(row) + ", " +
+                                        std::to_string(col) + ") out of range");
             }
-            return result;
+            return (*this)(row, col);
         }
-        void resize(index_type new_rows, index_type new_cols) {
-            resize_impl(new_rows, new_cols, std::nullopt);
+        [[nodiscard]] Ty load(index_type row, index_type col,
+                              std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            return (*this)(row, col).load(order);
         }
-        void resize(index_type new_rows, index_type new_cols, const Ty &val) {
-            resize_impl(new_rows, new_cols, val);
+        void store(index_type row, index_type col, Ty value,
+                   std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            (*this)(row, col).store(value, order);
         }
-        [[nodiscard]] constexpr pointer       data() noexcept { return data_.data(); }
-        [[nodiscard]] constexpr const_pointer data() const noexcept { return data_.data(); }
-        void                                  swap(array2d &other) noexcept {
-            using std::swap;
-            swap(rows_, other.rows_);
-            swap(cols_, other.cols_);
-            swap(data_, other.data_);
+        Ty exchange(index_type row, index_type col, Ty value,
+                    std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            return (*this)(row, col).exchange(value, order);
         }
-        [[nodiscard]] const auto &get_data() const noexcept { return data_; }
-        [[nodiscard]] auto       &get_vector() noexcept { return data_; }
-        [[nodiscard]] bool        operator==(const array2d &other) const
-                noexcept(noexcept(std::declval<Ty>() == std::declval<Ty>())) {
-            return rows_ == other.rows_ &&
-                   cols_ == other.cols_ &&
-                   data_ == other.data_;
+        bool compare_exchange(index_type row, index_type col, Ty &expected, Ty desired,
+                              std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            return (*this)(row, col).compare_exchange_strong(expected, desired, order);
         }
-        [[nodiscard]] auto operator<=>(const array2d &other) const
-            requires std::three_way_comparable<Ty>
+        Ty fetch_add(index_type row, index_type col, Ty value,
+                     std::memory_order order = std::memory_order_seq_cst) const noexcept
+            requires(std::integral<Ty> || std::floating_point<Ty>) && (!std::same_as<Ty, bool>)
         {
-            if (auto cmp = rows_ <=> other.rows_; cmp != 0) return cmp;
-            if (auto cmp = cols_ <=> other.cols_; cmp != 0) return cmp;
-            return data_ <=> other.data_;
+            return (*this)(row, col).fetch_add(value, order);
+        }
+        Ty fetch_sub(index_type row, index_type col, Ty value,
+                     std::memory_order order = std::memory_order_seq_cst) const noexcept
+            requires(std::integral<Ty> || std::floating_point<Ty>) && (!std::same_as<Ty, bool>)
+        {
+            return (*this)(row, col).fetch_sub(value, order);
+        }
+        Ty fetch_min(index_type row, index_type col, Ty value,
+                     std::memory_order order = std::memory_order_seq_cst) const noexcept
+            requires std::totally_ordered<Ty>
+        {
+            return fetch_update(row, col, value, order, std::less<>{});
+        }
+        Ty fetch_max(index_type row, index_type col, Ty value,
+                     std::memory_order order = std::memory_order_seq_cst) const noexcept
+            requires std::totally_ordered<Ty>
+        {
+            return fetch_update(row, col, value, order, std::greater<>{});
         }
 
     private:
-        static constexpr index_type validate_dimension(index_type dim, const char *name) {
-            if (dim < 0) [[unlikely]] {
-                throw std::invalid_argument(std::string(name) + " must be non-negative");
+        Ty        *data_  = nullptr;
+        index_type rows_  = 0;
+        index_type cols_  = 0;
+        index_type pitch_ = 0;
+        template<typename Better>
+        Ty fetch_update(index_type row, index_type col, Ty value, std::memory_order order, Better better) const noexcept {
+            auto ref     = (*this)(row, col);
+            Ty   current = ref.load(std::memory_order_relaxed);
+            while (better(value, current) && !ref.compare_exchange_weak(current, value, order, std::memory_order_relaxed)) {
             }
-            return dim;
+            return current;
         }
-        static constexpr size_type calculate_size(index_type rows, index_type cols) {
-            const auto size = static_cast<size_type>(rows) * static_cast<size_type>(cols);
-            if (rows > 0 && cols > 0 && size / static_cast<size_type>(rows) != static_cast<size_type>(cols)) {
-                throw std::overflow_error("Matrix size calculation overflow");
+    };
+    template<typename Matrix>
+        requires requires { typename Matrix::index_type; }
+    array2d_atomic_view(Matrix &)
+            -> array2d_atomic_view<std::remove_pointer_t<decltype(std::declval<Matrix &>().data())>,
+                                   typename Matrix::index_type>;
+    template<typename Ty, Array2d_index_type Idx = int>
+        requires std::default_initializable<Ty> && std::copyable<Ty>
+    class privatized_accumulator {
+    public:
+        using value_type = Ty;
+        using index_type = Idx;
+        using array_type = array2d<Ty, Idx>;
+        privatized_accumulator(index_type rows, index_type cols, const Ty &identity = Ty{})
+            : rows_(rows), cols_(cols), identity_(identity) {
+            if (std::cmp_less(rows, 0) || std::cmp_less(cols, 0)) [[unlikely]] {
+                throw std::invalid_argument("privatized_accumulator: dimensions must be non-negative");
             }
-            return size;
-        }
-        constexpr size_type calculate_offset(index_type row, index_type col) const noexcept {
-            return static_cast<size_type>(row) * static_cast<size_type>(cols_) + static_cast<size_type>(col);
-        }
-        static constexpr void assert_bounds([[maybe_unused]] index_type index,
-                                            [[maybe_unused]] index_type limit) noexcept {
-#ifdef _DEBUG
-            assert(index >= 0 && index < limit);
-#endif
-        }
-        std::string format_bounds_error(index_type row, index_type col) const {
-            return "array2d: index (" + std::to_string(row) + ", " + std::to_string(col) +
-                   ") out of range [0, " + std::to_string(rows_) + ") x [0, " + std::to_string(cols_) + ")";
         }
-        template<bool IsConst>
-        [[nodiscard]] auto at_impl(index_type row, index_type col) const
-                -> std::conditional_t<IsConst, const_reference, reference> {
-            if (row < 0 || row >= rows_ || col < 0 || col >= cols_) [[unlikely]] {
-                throw std::out_of_range(format_bounds_error(row, col));
-            }
-            if constexpr (IsConst) {
-                return data_[calculate_offset(row, col)];
-            } else {
-                return const_cast<reference>(data_[calculate_offset(row, col)]);
+        privatized_accumulator(const privatized_accumulator &)            = delete;
+        privatized_accumulator &operator=(const privatized_accumulator &) = delete;
+        [[nodiscard]] index_type rows() const noexcept { return rows_; }
+        [[nodiscard]] index_type cols() const noexcept { return cols_; }
+        [[nodiscard]] array_type &local() {
+            const auto      id = std::this_thread::get_id();
+            std::lock_guard lock(mutex_);
+            for (auto &[owner, copy]: copies_) {
+                if (owner == id) return *copy;
             }
+            copies_.emplace_back(id, std::make_unique<array_type>(rows_, cols_, identity_));
+            return *copies_.back().second;
         }
-        void resize_impl(index_type new_rows, index_type new_cols, std::optional<Ty> fill_value) {
-            new_rows = validate_dimension(new_rows, "new_rows");
-            new_cols = validate_dimension(new_cols, "new_cols");
-            if (new_rows == rows_ && new_cols == cols_) return;
-            const auto new_size = calculate_size(new_rows, new_cols);
-            if (new_size == 0) {
-                data_.clear();
-                rows_ = new_rows;
-                cols_ = new_cols;
-                return;
-            }
-            std::vector<Ty> new_data;
-            if (fill_value) {
-                new_data.assign(new_size, *fill_value);
-            } else {
-                new_data.resize(new_size);
+        [[nodiscard]] std::size_t copies() const {
+            std::lock_guard lock(mutex_);
+            return copies_.size();
+        }
+        template<typename Matrix, typename Op = std::plus<>>
+            requires Array2d_matrix_operand<Matrix> && std::convertible_to<decltype(std::declval<Matrix &>().data()), Ty *>
+        void merge_into(Matrix &target, Op op = {}) const {
+            if (static_cast<index_type>(target.rows()) != rows_ || static_cast<index_type>(target.cols()) != cols_)
+                    [[unlikely]] {
+                throw std::invalid_argument("privatized_accumulator: target shape does not match");
             }
-            if (rows_ > 0 && cols_ > 0) {
-                const auto copy_rows = std::min(rows_, new_rows);
-                const auto copy_cols = std::min(cols_, new_cols);
-                for (index_type i = 0; i < copy_rows; ++i) {
-                    const auto old_offset = static_cast<size_type>(i) * static_cast<size_type>(cols_);
-                    const auto new_offset = static_cast<size_type>(i) * static_cast<size_type>(new_cols);
-                    if constexpr (std::is_trivially_copyable_v<Ty>) {
-                        std::memcpy(new_data.data() + new_offset,
-                                    data_.data() + old_offset,
-                                    static_cast<size_type>(copy_cols) * sizeof(Ty));
-                    } else {
-                        std::copy_n(data_.data() + old_offset, copy_cols, new_data.data() + new_offset);
+            std::lock_guard lock(mutex_);
+            if (copies_.empty()) return;
+            const auto pitch = static_cast<std::size_t>(target.pitch());
+            const auto cols  = static_cast<std::size_t>(cols_);
+            Ty        *out   = target.data();
+            parallel_for_rows(rows_, [&](index_type first, index_type last) {
+                for (const auto &[owner, copy]: copies_) {
+                    for (auto i = first; i < last; ++i) {
+                        Ty       *dst = out + static_cast<std::size_t>(i) * pitch;
+                        const Ty *src = copy->data() + static_cast<std::size_t>(i) * static_cast<std::size_t>(copy->pitch());
+                        for (std::size_t j = 0; j < cols; ++j) dst[j] = op(dst[j], src[j]);
                     }
                 }
-            }
-            data_ = std::move(new_data);
-            rows_ = new_rows;
-            cols_ = new_cols;
+            });
+        }
+        template<typename Op = std::plus<>>
+        [[nodiscard]] array_type merged(Op op = {}) const {
+            array_type result(rows_, cols_, identity_);
+            merge_into(result, op);
+            return result;
+        }
+        void clear() {
+            std::lock_guard lock(mutex_);
+            copies_.clear();
         }
 
-    protected:
-        index_type      rows_{};
-        index_type      cols_{};
-        std::vector<Ty> data_;
+    private:
+        index_type         rows_;
+        index_type         cols_;
+        Ty                 identity_;
+        mutable std::mutex mutex_;
+        std::vector<std::pair<std::thread::id, std::unique_ptr<array_type>>> copies_;
     };
-    template<Array2d_compatible Ty, Array2d_index_type Idx>
-    void swap(array2d<Ty, Idx> &lhs, array2d<Ty, Idx> &rhs) noexcept {
-        lhs.swap(rhs);
-    }
-    template<Array2d_index_type IndexType>
-    array2d(IndexType, IndexType) -> array2d<double, IndexType>;
-    template<Array2d_index_type IndexType, Array2d_compatible ValueType>
-        requires(!std::ranges::range<ValueType> || std::is_arithmetic_v<ValueType>)
-    array2d(IndexType, IndexType, const ValueType &) -> array2d<ValueType, IndexType>;
-    template<Array2d_compatible ValueType>
-    array2d(std::initializer_list<std::initializer_list<ValueType>>) -> array2d<ValueType>;
-    template<Array2d_index_type IndexType, typename Container>
-        requires std::ranges::range<Container> &&
-                 (!std::is_arithmetic_v<Container>) &&
-                 Array2d_compatible<std::ranges::range_value_t<Container>>
-    array2d(IndexType, IndexType, const Container &) -> array2d<std::ranges::range_value_t<Container>, IndexType>;
-    template<Array2d_compatible ValueType, Array2d_index_type IndexType>
-    array2d(const array2d<ValueType, IndexType> &) -> array2d<ValueType, IndexType>;
-    template<Array2d_compatible ValueType, Array2d_index_type IndexType>
-    array2d(array2d<ValueType, IndexType> &&) -> array2d<ValueType, IndexType>;
-}  // namespace qm
-#endif
\ No newline at end of file
+}  // namespace qm
\ No newline at end of file
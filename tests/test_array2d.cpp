@@ -4,11 +4,16 @@
 // test_array2d.cpp
 #include "array2d.hpp"  // 假设头文件名为 array2d.hpp
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <list>
 #include <memory>
+#include <memory_resource>
+#include <numeric>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -367,6 +372,27 @@ TEST_F(Array2dTest, ColExtraction) {
     EXPECT_THAT(col2, ElementsAre(3, 6));
 }
 
+TEST_F(Array2dTest, ColView) {
+    auto col1 = small_matrix_.col_view(1);
+    EXPECT_EQ(col1.size(), 2u);
+    EXPECT_THAT(col1, ElementsAre(2, 5));
+
+    col1[1] = 50;
+    EXPECT_EQ(small_matrix_(1, 1), 50);
+    std::ranges::fill(small_matrix_.col_view(2), 0);
+    EXPECT_THAT(small_matrix_.row(0), ElementsAre(1, 2, 0));
+    EXPECT_THAT(small_matrix_.row(1), ElementsAre(4, 50, 0));
+
+    const auto &cmatrix = small_matrix_;
+    auto        ccol    = cmatrix.col_view(0);
+    static_assert(std::is_same_v<decltype(ccol), array2d_column<const int>>);
+    EXPECT_EQ(std::accumulate(ccol.begin(), ccol.end(), 0), 5);
+
+    pitched_array2d<int> pitched(3, 2, row_pitch{5}, 1);
+    pitched(2, 1) = 7;
+    EXPECT_THAT(pitched.col_view(1), ElementsAre(1, 1, 7));
+}
+
 TEST_F(Array2dTest, SubmatrixRowMajor) {
     array2d<int> matrix(4, 4);
     for (int i = 0; i < 4; ++i) {
@@ -388,6 +414,31 @@ TEST_F(Array2dTest, SubmatrixRowMajor) {
     EXPECT_THAT(partial_data, ElementsAre(6, 7));
 }
 
+TEST_F(Array2dTest, SubmatrixView) {
+    array2d<int> matrix(4, 5);
+    std::iota(matrix.begin(), matrix.end(), 0);
+
+    auto block = matrix.submatrix(1, 1, 2, 3);
+    EXPECT_EQ(block.rows(), 2);
+    EXPECT_EQ(block.cols(), 3);
+    EXPECT_EQ(block.pitch(), 5);
+    EXPECT_THAT(block.row(0), ElementsAre(6, 7, 8));
+    EXPECT_THAT(block.row(1), ElementsAre(11, 12, 13));
+
+    block.fill(0);
+    EXPECT_THAT(matrix.row(1), ElementsAre(5, 0, 0, 0, 9));
+    EXPECT_THAT(matrix.row(3), ElementsAre(15, 16, 17, 18, 19));
+
+    const auto &cmatrix = matrix;
+    auto        cblock  = cmatrix.submatrix(0, 0, 4, 5);
+    static_assert(decltype(cblock)::is_read_only);
+    EXPECT_EQ(std::ranges::count(cblock, 0), 7);
+
+    EXPECT_NO_THROW((void) matrix.submatrix(4, 5, 0, 0));
+    EXPECT_THROW((void) matrix.submatrix(3, 0, 2, 1), std::out_of_range);
+    EXPECT_THROW((void) matrix.submatrix(0, -1, 1, 1), std::out_of_range);
+}
+
 // ================================
 // 尺寸和容量测试
 // ================================
@@ -549,6 +600,54 @@ TEST_F(Array2dTest, FillRow) {
     EXPECT_EQ(small_matrix_[1][2], 6);
 }
 
+TEST_F(Array2dTest, SwapRowsVectorized) {
+    // 覆盖向量块和不足一块的尾部
+    for (int cols: {1, 7, 8, 16, 37, 100}) {
+        array2d<std::int16_t> matrix(3, cols);
+        std::iota(matrix.begin(), matrix.end(), std::int16_t{0});
+        matrix.swap_rows(0, 2);
+        for (int j = 0; j < cols; ++j) {
+            ASSERT_EQ(matrix(0, j), 2 * cols + j);
+            ASSERT_EQ(matrix(1, j), cols + j);
+            ASSERT_EQ(matrix(2, j), j);
+        }
+    }
+
+    pitched_array2d<double> pitched(2, 5, 1.0);
+    pitched.fill_row(1, 2.0);
+    pitched.swap_rows(0, 1);
+    EXPECT_THAT(pitched, ElementsAre(2.0, 2.0, 2.0, 2.0, 2.0, 1.0, 1.0, 1.0, 1.0, 1.0));
+}
+
+TEST_F(Array2dTest, PermuteRows) {
+    array2d<int> matrix{{0, 0}, {1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}};
+    // 一个3循环、一个2循环和一个不动点
+    const std::vector<int> perm{2, 0, 1, 4, 3, 5};
+    matrix.permute_rows(perm);
+    EXPECT_THAT(matrix, ElementsAre(2, 2, 0, 0, 1, 1, 4, 4, 3, 3, 5, 5));
+
+    array2d<std::string> names{{"a"}, {"b"}, {"c"}};
+    names.permute_rows(std::vector<int>{1, 2, 0});
+    EXPECT_THAT(names, ElementsAre("b", "c", "a"));
+
+    EXPECT_THROW(matrix.permute_rows(std::vector<int>{0, 1, 2}), std::invalid_argument);
+    EXPECT_THROW(matrix.permute_rows(std::vector<int>{0, 1, 2, 3, 4, 4}), std::invalid_argument);
+    EXPECT_THROW(matrix.permute_rows(std::vector<int>{0, 1, 2, 3, 4, 6}), std::invalid_argument);
+    // 失败时矩阵保持不变
+    EXPECT_THAT(matrix, ElementsAre(2, 2, 0, 0, 1, 1, 4, 4, 3, 3, 5, 5));
+}
+
+TEST_F(Array2dTest, PermuteCols) {
+    small_matrix_.permute_cols(std::vector<int>{2, 0, 1});
+    EXPECT_THAT(small_matrix_, ElementsAre(3, 1, 2, 6, 4, 5));
+
+    pitched_array2d<std::string> pitched{{"a", "b"}, {"c", "d"}};
+    pitched.permute_cols(std::vector<int>{1, 0});
+    EXPECT_THAT(pitched, ElementsAre("b", "a", "d", "c"));
+
+    EXPECT_THROW(small_matrix_.permute_cols(std::vector<int>{0, 0, 1}), std::invalid_argument);
+}
+
 // ================================
 // 转置测试
 // ================================
@@ -569,7 +668,27 @@ TEST_F(Array2dTest, TransposeSquare) {
 }
 
 TEST_F(Array2dTest, TransposeNonSquare) {
-    EXPECT_THROW(small_matrix_.transpose(), std::invalid_argument);
+    const auto *storage = small_matrix_.data();
+    small_matrix_.transpose();
+
+    EXPECT_EQ(small_matrix_.rows(), 3);
+    EXPECT_EQ(small_matrix_.cols(), 2);
+    EXPECT_EQ(small_matrix_.data(), storage);
+    EXPECT_THAT(small_matrix_, ElementsAre(1, 4, 2, 5, 3, 6));
+
+    // 转置后按新形状继续增删行
+    small_matrix_.emplace_back_row(7);
+    EXPECT_EQ(small_matrix_.rows(), 4);
+    EXPECT_EQ(small_matrix_.size(), 8);
+    small_matrix_.insert_rows(1, 1, 9);
+    EXPECT_THAT(small_matrix_, ElementsAre(1, 4, 9, 9, 2, 5, 3, 6, 7, 7));
+
+    array2d<int> m(2, 3);
+    std::iota(m.begin(), m.end(), 1);
+    m.reserve(10, 10);
+    m.transpose();
+    m.resize(3, 3, 0);
+    EXPECT_THAT(m, ElementsAre(1, 4, 0, 2, 5, 0, 3, 6, 0));
 }
 
 TEST_F(Array2dTest, Transposed) {
@@ -612,6 +731,115 @@ TEST_F(Array2dTest, TransposedSquare) {
     EXPECT_EQ(transposed[2][2], 9);
 }
 
+namespace {
+
+    /**
+     * @brief 按 src(i, j) = i * 1000 + j 填充并验证 dst 为其转置
+     */
+    template<typename Matrix, typename Make>
+    void check_transposed(typename Matrix::index_type rows, typename Matrix::index_type cols, Make make,
+                          bool parallel = false) {
+        Matrix src(rows, cols);
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) src(i, j) = make(i * 1000 + j);
+        }
+        const auto dst = parallel ? src.transposed_parallel() : src.transposed();
+        ASSERT_EQ(dst.rows(), cols);
+        ASSERT_EQ(dst.cols(), rows);
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
+                ASSERT_EQ(dst(j, i), src(i, j)) << rows << "x" << cols << " at (" << i << ", " << j << ")";
+            }
+        }
+    }
+
+    /**
+     * @brief 大于缓存行的元素类型
+     */
+    struct Wide {
+        std::array<double, 12> values{};
+
+        bool operator==(const Wide &) const = default;
+    };
+
+}  // namespace
+
+TEST_F(Array2dTest, TransposedAllSizesAndTypes) {
+    for (int rows: {1, 3, 8, 17, 64, 65, 130}) {
+        for (int cols: {1, 5, 8, 31, 64, 72, 129}) {
+            check_transposed<array2d<float>>(rows, cols, [](int v) { return static_cast<float>(v); });
+            check_transposed<array2d<double>>(rows, cols, [](int v) { return static_cast<double>(v); });
+            check_transposed<array2d<std::int64_t>>(rows, cols, [](int v) { return std::int64_t{v}; });
+            check_transposed<array2d<std::uint16_t>>(rows, cols, [](int v) { return static_cast<std::uint16_t>(v); });
+            check_transposed<pitched_array2d<int>>(rows, cols, [](int v) { return v; });
+        }
+    }
+    check_transposed<array2d<std::string>>(9, 70, [](int v) { return std::to_string(v); });
+}
+
+TEST_F(Array2dTest, TransposedLargeElements) {
+    // 元素大于64字节时分块大小不能为0
+    check_transposed<array2d<Wide>>(7, 11, [](int v) {
+        Wide w;
+        w.values.fill(v);
+        return w;
+    });
+
+    array2d<Wide> square(3, 3);
+    square(0, 2).values[0] = 5.0;
+    square.transpose();
+    EXPECT_EQ(square(2, 0).values[0], 5.0);
+}
+
+TEST_F(Array2dTest, TransposedParallel) {
+    check_transposed<array2d<float>>(300, 170, [](int v) { return static_cast<float>(v); }, true);
+    check_transposed<array2d<double>>(9, 3000, [](int v) { return static_cast<double>(v); }, true);
+    check_transposed<pitched_array2d<std::int16_t>>(250, 61, [](int v) { return static_cast<std::int16_t>(v); }, true);
+    check_transposed<array2d<int>>(4, 5, [](int v) { return v; }, true);
+}
+
+namespace {
+
+    /**
+     * @brief 验证就地转置与transposed()的结果一致
+     */
+    template<typename Matrix, typename Make>
+    void check_transpose_in_place(typename Matrix::index_type rows, typename Matrix::index_type cols, Make make,
+                                  bool parallel = false) {
+        Matrix matrix(rows, cols);
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) matrix(i, j) = make(i * 1000 + j);
+        }
+        const auto expected = matrix.transposed();
+        parallel ? matrix.transpose_parallel() : matrix.transpose();
+        ASSERT_EQ(matrix, expected) << rows << "x" << cols;
+        if constexpr (Matrix::is_pitched) {
+            EXPECT_EQ(matrix.pitch(), expected.pitch());
+        }
+    }
+
+}  // namespace
+
+TEST_F(Array2dTest, TransposeInPlaceRectangular) {
+    for (int rows: {1, 2, 3, 7, 16, 33}) {
+        for (int cols: {1, 2, 5, 16, 40}) {
+            check_transpose_in_place<array2d<int>>(rows, cols, [](int v) { return v; });
+            check_transpose_in_place<array2d<double>>(rows, cols, [](int v) { return v * 0.5; });
+            check_transpose_in_place<pitched_array2d<float>>(rows, cols, [](int v) { return static_cast<float>(v); });
+        }
+    }
+    check_transpose_in_place<array2d<std::string>>(5, 13, [](int v) { return std::to_string(v); });
+    check_transpose_in_place<pitched_array2d<std::string>>(4, 9, [](int v) { return std::to_string(v); });
+}
+
+TEST_F(Array2dTest, TransposeInPlaceParallel) {
+    check_transpose_in_place<array2d<float>>(123, 457, [](int v) { return static_cast<float>(v); }, true);
+    check_transpose_in_place<array2d<std::int64_t>>(1000, 11, [](int v) { return std::int64_t{v}; }, true);
+    check_transpose_in_place<pitched_array2d<int>>(150, 90, [](int v) { return v; }, true);
+    check_transpose_in_place<array2d<int>>(200, 200, [](int v) { return v; }, true);
+    check_transpose_in_place<array2d<int>>(3, 4, [](int v) { return v; }, true);
+}
+
 // ================================
 // resize 测试
 // ================================
@@ -691,6 +919,61 @@ TEST_F(Array2dTest, ResizeSame) {
     }
 }
 
+TEST_F(Array2dTest, ResizeInPlaceWithinCapacity) {
+    array2d<int> matrix{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    matrix.reserve(4, 5);
+    const auto *storage = matrix.data();
+
+    // 增加列数：自后向前移动各行，新列使用指定值
+    matrix.resize(3, 5, -1);
+    EXPECT_EQ(matrix.data(), storage);
+    EXPECT_THAT(matrix.row(0), ElementsAre(1, 2, 3, -1, -1));
+    EXPECT_THAT(matrix.row(1), ElementsAre(4, 5, 6, -1, -1));
+    EXPECT_THAT(matrix.row(2), ElementsAre(7, 8, 9, -1, -1));
+
+    // 减少列数、增加行数：自前向后移动，新行位于旧数据区域内也必须重新初始化
+    matrix.resize(6, 2);
+    EXPECT_EQ(matrix.data(), storage);
+    EXPECT_THAT(matrix.row(2), ElementsAre(7, 8));
+    EXPECT_THAT(matrix.row(3), ElementsAre(0, 0));
+    EXPECT_THAT(matrix.row(5), ElementsAre(0, 0));
+
+    // 缩小总尺寸不重新分配，容量保持不变
+    const auto capacity = matrix.capacity();
+    matrix.resize(2, 1);
+    EXPECT_EQ(matrix.data(), storage);
+    EXPECT_EQ(matrix.capacity(), capacity);
+    EXPECT_THAT(matrix, ElementsAre(1, 4));
+
+    // 超出容量时仍然重新分配
+    matrix.resize(10, 10, 5);
+    EXPECT_EQ(matrix(1, 0), 4);
+    EXPECT_EQ(matrix(9, 9), 5);
+}
+
+TEST_F(Array2dTest, ResizeInPlaceNonTrivialType) {
+    array2d<std::shared_ptr<int>> matrix(2, 3);
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            matrix(i, j) = std::make_shared<int>(i * 3 + j);
+        }
+    }
+    matrix.reserve(2, 6);
+    const auto *storage = matrix.data();
+
+    matrix.resize(2, 5);
+    EXPECT_EQ(matrix.data(), storage);
+    EXPECT_EQ(*matrix(1, 0), 3);
+    EXPECT_EQ(*matrix(1, 2), 5);
+    EXPECT_EQ(matrix(0, 3), nullptr);
+    EXPECT_EQ(matrix(1, 4), nullptr);
+    EXPECT_EQ(matrix(0, 2).use_count(), 1);
+
+    matrix.resize(3, 1);
+    EXPECT_EQ(*matrix(1, 0), 3);
+    EXPECT_EQ(matrix(2, 0), nullptr);
+}
+
 // ================================
 // 数据访问和工具方法测试
 // ================================
@@ -1003,6 +1286,45 @@ TEST_F(Array2dExceptionSafetyTest, ResizeExceptionSafety) {
     EXPECT_EQ(matrix.size(), 4);
 }
 
+TEST_F(Array2dExceptionSafetyTest, RowEditExceptionSafety) {
+    array2d<ThrowingType> matrix(2, 2);
+
+    ThrowingType::should_throw_ = true;
+
+    EXPECT_THROW(matrix.insert_rows(1, 2), std::runtime_error);
+    EXPECT_THROW(matrix.emplace_back_row(), std::runtime_error);
+
+    // 原矩阵应该保持不变
+    EXPECT_EQ(matrix.rows(), 2);
+    EXPECT_EQ(matrix.size(), 4);
+    EXPECT_EQ(matrix.get_data().size(), 4u);
+
+    // 空矩阵追加失败时不改变形状
+    ThrowingType::should_throw_ = false;
+    array2d<ThrowingType>     empty(0, 2);
+    std::vector<ThrowingType> record(3);
+    ThrowingType::should_throw_ = true;
+    EXPECT_THROW(empty.push_back_row(record), std::runtime_error);
+    EXPECT_EQ(empty.rows(), 0);
+    EXPECT_EQ(empty.cols(), 2);
+    EXPECT_TRUE(empty.get_data().empty());
+}
+
+TEST_F(Array2dExceptionSafetyTest, PitchedTransposeExceptionSafety) {
+    pitched_array2d<ThrowingType> matrix(3, 5);
+    matrix.transpose();
+    EXPECT_EQ(matrix.rows(), 5);
+    EXPECT_EQ(matrix.cols(), 3);
+
+    // 元素操作可能抛出时不在原存储上重排，异常传播给调用者且矩阵不变
+    const auto pitch            = matrix.pitch();
+    ThrowingType::should_throw_ = true;
+    EXPECT_THROW(matrix.transpose(), std::runtime_error);
+    EXPECT_EQ(matrix.rows(), 5);
+    EXPECT_EQ(matrix.cols(), 3);
+    EXPECT_EQ(matrix.pitch(), pitch);
+}
+
 // ================================
 // 边界情况测试
 // ================================
@@ -1177,4 +1499,702 @@ TEST_F(Array2dConceptTest, Array2dIndexTypeConcept) {
     static_assert(!Array2d_index_type<char>);
     static_assert(!Array2d_index_type<float>);
     static_assert(!Array2d_index_type<std::string>);
-}
\ No newline at end of file
+}
+
+// ================================
+// 分配器支持测试
+// ================================
+
+/**
+ * @brief 统计分配次数的内存资源，用于验证存储确实来自指定资源
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource *upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream) {}
+
+    std::size_t allocations   = 0;
+    std::size_t deallocations = 0;
+
+private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+        ++deallocations;
+        upstream_->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource *upstream_;
+};
+
+class Array2dAllocatorTest : public ::testing::Test {
+protected:
+    CountingResource resource_;
+};
+
+TEST_F(Array2dAllocatorTest, PmrConstructorsUseResource) {
+    qm::pmr::array2d<int> sized(3, 4, &resource_);
+    EXPECT_EQ(sized.get_allocator().resource(), &resource_);
+    EXPECT_EQ(resource_.allocations, 1);
+
+    qm::pmr::array2d<int> valued(2, 2, 7, &resource_);
+    EXPECT_THAT(valued, ElementsAre(7, 7, 7, 7));
+
+    qm::pmr::array2d<int> listed({{1, 2}, {3, 4}}, &resource_);
+    EXPECT_EQ(listed(1, 0), 3);
+
+    std::vector<int>      source{1, 2, 3, 4, 5, 6};
+    qm::pmr::array2d<int> from_container(2, 3, source, &resource_);
+    EXPECT_EQ(from_container(1, 2), 6);
+
+    qm::pmr::array2d<int> empty(&resource_);
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.get_allocator().resource(), &resource_);
+
+    EXPECT_EQ(resource_.allocations, 4);
+}
+
+TEST_F(Array2dAllocatorTest, ResizeAndTransposedKeepResource) {
+    qm::pmr::array2d<int> arr({{1, 2, 3}, {4, 5, 6}}, &resource_);
+    const auto            before = resource_.allocations;
+
+    arr.resize(3, 4, -1);
+    EXPECT_EQ(arr.get_allocator().resource(), &resource_);
+    EXPECT_GT(resource_.allocations, before);
+    EXPECT_EQ(arr(0, 2), 3);
+    EXPECT_EQ(arr(2, 3), -1);
+
+    const auto t = arr.transposed();
+    EXPECT_EQ(t.get_allocator().resource(), &resource_);
+    EXPECT_EQ(t(2, 0), 3);
+}
+
+TEST_F(Array2dAllocatorTest, AllocatorExtendedCopyAndMove) {
+    CountingResource      other_resource;
+    qm::pmr::array2d<int> arr({{1, 2}, {3, 4}}, &resource_);
+
+    qm::pmr::array2d<int> copy(arr, &other_resource);
+    EXPECT_EQ(copy, arr);
+    EXPECT_EQ(copy.get_allocator().resource(), &other_resource);
+
+    qm::pmr::array2d<int> moved(std::move(copy), &resource_);
+    EXPECT_EQ(moved, arr);
+    EXPECT_EQ(moved.get_allocator().resource(), &resource_);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(copy.rows(), 0);
+
+    // pmr 分配器在拷贝赋值时不传播，目标保留自己的内存资源
+    qm::pmr::array2d<int> target(&other_resource);
+    target = arr;
+    EXPECT_EQ(target, arr);
+    EXPECT_EQ(target.get_allocator().resource(), &other_resource);
+}
+
+TEST_F(Array2dAllocatorTest, MonotonicArenaReuse) {
+    std::array<std::byte, 4096>         buffer{};
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    for (int iteration = 0; iteration < 3; ++iteration) {
+        {
+            qm::pmr::array2d<double> delta(8, 8, 1.5, &arena);
+            delta(3, 3) = 2.5;
+            EXPECT_DOUBLE_EQ(delta(3, 3), 2.5);
+        }
+        arena.release();
+    }
+}
+
+TEST_F(Array2dAllocatorTest, AllocatorTypeAliases) {
+    static_assert(std::is_same_v<array2d<int>::allocator_type, std::allocator<int>>);
+    static_assert(std::is_same_v<qm::pmr::array2d<int>::allocator_type, std::pmr::polymorphic_allocator<int>>);
+    static_assert(std::is_same_v<qm::pmr::array2d<int, long>::index_type, long>);
+}
+
+// ================================
+// 对齐存储测试
+// ================================
+
+namespace {
+    template<typename Ptr>
+    bool is_aligned_to(Ptr *ptr, std::size_t alignment) {
+        return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+    }
+}  // namespace
+
+class Array2dAlignedTest : public ::testing::Test {};
+
+TEST_F(Array2dAlignedTest, StorageAlignment) {
+    static_assert(array2d<int>::storage_alignment == alignof(int));
+    static_assert(array2d<float, int, aligned<64>>::storage_alignment == 64);
+    static_assert(std::is_same_v<array2d<float, int, aligned<64>>::allocator_type, aligned_allocator<float, 64>>);
+    static_assert(aligned_allocator<char, 1>::alignment == 1);
+    static_assert(aligned_allocator<double, 2>::alignment == alignof(double));
+}
+
+TEST_F(Array2dAlignedTest, BasePointerAligned) {
+    array2d<float, int, aligned<64>> arr(7, 5, 1.0f);
+    EXPECT_TRUE(is_aligned_to(arr.data(), 64));
+    EXPECT_TRUE(is_aligned_to(arr.as_span().data(), 64));
+    EXPECT_TRUE(is_aligned_to(arr[0], 64));
+
+    arr.resize(13, 9, 2.0f);
+    EXPECT_TRUE(is_aligned_to(arr.data(), 64));
+    EXPECT_FLOAT_EQ(arr(6, 4), 1.0f);
+    EXPECT_FLOAT_EQ(arr(12, 8), 2.0f);
+
+    const auto t = arr.transposed();
+    EXPECT_TRUE(is_aligned_to(t.data(), 64));
+
+    const auto copy = arr;
+    EXPECT_TRUE(is_aligned_to(copy.data(), 64));
+    EXPECT_EQ(copy, arr);
+}
+
+TEST_F(Array2dAlignedTest, RowsAligned) {
+    array2d<float, int, aligned<64>> full_lines(4, 32);
+    EXPECT_TRUE(full_lines.rows_aligned());
+    for (int i = 0; i < full_lines.rows(); ++i) {
+        EXPECT_TRUE(is_aligned_to(full_lines.row(i).data(), 64));
+    }
+
+    array2d<float, int, aligned<64>> odd(4, 5);
+    EXPECT_FALSE(odd.rows_aligned());
+}
+
+// ================================
+// 带行距布局测试
+// ================================
+
+class Array2dPitchedTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        matrix_ = pitched_array2d<int>{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10, 11, 12}};
+    }
+
+    pitched_array2d<int> matrix_;
+};
+
+TEST_F(Array2dPitchedTest, DefaultPitch) {
+    // 3个int补齐到一个缓存行
+    EXPECT_EQ(matrix_.pitch(), 16);
+    EXPECT_EQ(matrix_.size(), 12);
+    EXPECT_EQ(matrix_.get_data().size(), 4 * 16);
+    EXPECT_TRUE(matrix_.rows_aligned());
+
+    // 行字节数为冲突步长的整数倍时额外错开一个缓存行
+    pitched_array2d<float> pow2(4, 1024);
+    EXPECT_EQ(pow2.pitch(), 1024 + 16);
+
+    pitched_array2d<double> odd(2, 9);
+    EXPECT_EQ(odd.pitch(), 16);
+
+    // dense布局的行距就是列数
+    array2d<float> dense(4, 1024);
+    EXPECT_EQ(dense.pitch(), 1024);
+}
+
+TEST_F(Array2dPitchedTest, ExplicitPitch) {
+    pitched_array2d<int> arr(3, 4, row_pitch{10}, 7);
+    EXPECT_EQ(arr.pitch(), 10);
+    EXPECT_EQ(arr.get_data().size(), 30);
+    EXPECT_EQ(arr[1] - arr[0], 10);
+    EXPECT_THAT(arr, ::testing::Each(7));
+
+    EXPECT_THROW((pitched_array2d<int>(3, 4, row_pitch{3})), std::invalid_argument);
+}
+
+TEST_F(Array2dPitchedTest, ElementAccess) {
+    EXPECT_EQ(matrix_(2, 1), 8);
+    EXPECT_EQ(matrix_[3][2], 12);
+    EXPECT_EQ(matrix_.at(1, 0), 4);
+    EXPECT_EQ(&matrix_(1, 0) - &matrix_(0, 0), matrix_.pitch());
+    EXPECT_THAT(matrix_.row(2), ElementsAre(7, 8, 9));
+    EXPECT_THAT(matrix_.col(1), ElementsAre(2, 5, 8, 11));
+    EXPECT_THROW((void) matrix_.at(0, 3), std::out_of_range);
+}
+
+TEST_F(Array2dPitchedTest, IterationSkipsPadding) {
+    matrix_.get_vector()[3] = -1;  // 写入第0行的填充元素
+
+    std::vector<int> values(matrix_.begin(), matrix_.end());
+    EXPECT_THAT(values, ElementsAre(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12));
+    EXPECT_EQ(std::distance(matrix_.begin(), matrix_.end()), 12);
+    EXPECT_EQ(std::ranges::find(matrix_, -1), matrix_.end());
+
+    std::vector<int> reversed(matrix_.rbegin(), matrix_.rend());
+    EXPECT_EQ(reversed.front(), 12);
+    EXPECT_EQ(reversed.back(), 1);
+
+    auto it = matrix_.begin();
+    EXPECT_EQ(it[4], 5);
+    EXPECT_EQ(*(it + 11), 12);
+    EXPECT_EQ(*(matrix_.end() - 4), 9);
+    EXPECT_EQ(*((it + 7) - 5), 3);
+    EXPECT_LT(it + 2, it + 3);
+    EXPECT_EQ((it + 9) - (it + 2), 7);
+
+    std::ranges::sort(matrix_, std::greater<>());
+    EXPECT_EQ(matrix_(0, 0), 12);
+    EXPECT_EQ(matrix_(3, 2), 1);
+
+    static_assert(std::random_access_iterator<pitched_array2d<int>::iterator>);
+    static_assert(std::random_access_iterator<pitched_array2d<int>::const_iterator>);
+    static_assert(std::ranges::random_access_range<const pitched_array2d<int>>);
+}
+
+TEST_F(Array2dPitchedTest, RowOperations) {
+    for (auto &elem: matrix_.row_range(1)) elem *= 10;
+    EXPECT_THAT(matrix_.row(1), ElementsAre(40, 50, 60));
+
+    matrix_.copy_row(0, 3);
+    EXPECT_THAT(matrix_.row(3), ElementsAre(1, 2, 3));
+
+    matrix_.swap_rows(0, 2);
+    EXPECT_THAT(matrix_.row(0), ElementsAre(7, 8, 9));
+    EXPECT_THAT(matrix_.row(2), ElementsAre(1, 2, 3));
+
+    matrix_.fill_row(1, 0);
+    EXPECT_THAT(matrix_.row(1), ElementsAre(0, 0, 0));
+    EXPECT_EQ(matrix_(2, 0), 1);
+}
+
+TEST_F(Array2dPitchedTest, TransposeAndResize) {
+    const auto t = matrix_.transposed();
+    EXPECT_EQ(t.rows(), 3);
+    EXPECT_EQ(t.cols(), 4);
+    EXPECT_THAT(t.row(0), ElementsAre(1, 4, 7, 10));
+
+    pitched_array2d<int> square{{1, 2}, {3, 4}};
+    square.transpose();
+    EXPECT_THAT(square, ElementsAre(1, 3, 2, 4));
+
+    matrix_.resize(2, 20, -1);
+    EXPECT_EQ(matrix_.pitch(), 32);
+    EXPECT_THAT(matrix_.row(0).first(4), ElementsAre(1, 2, 3, -1));
+    EXPECT_EQ(matrix_(1, 2), 6);
+    EXPECT_EQ(matrix_(1, 19), -1);
+}
+
+TEST_F(Array2dPitchedTest, ComparisonAndContainerConstruction) {
+    std::vector<int>     source{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    pitched_array2d<int> from_container(4, 3, source);
+    EXPECT_EQ(from_container, matrix_);
+
+    from_container.get_vector()[5] = 42;  // 只修改填充元素不影响比较
+    EXPECT_EQ(from_container, matrix_);
+
+    from_container(3, 2) = 13;
+    EXPECT_NE(from_container, matrix_);
+    EXPECT_TRUE(matrix_ < from_container);
+
+    pitched_array2d<int> copy = matrix_;
+    pitched_array2d<int> other(1, 1);
+    swap(copy, other);
+    EXPECT_EQ(other, matrix_);
+    EXPECT_EQ(other.pitch(), 16);
+}
+
+TEST_F(Array2dPitchedTest, AlignedRows) {
+    pitched_array2d<float, int, aligned<64>> arr(5, 7);
+    EXPECT_TRUE(arr.rows_aligned());
+    for (int i = 0; i < arr.rows(); ++i) {
+        EXPECT_TRUE(is_aligned_to(arr[i], 64));
+    }
+}
+
+TEST_F(Array2dPitchedTest, ResizeInPlaceChangesPitch) {
+    pitched_array2d<int> arr(4, 20);
+    std::iota(arr.begin(), arr.end(), 0);
+    const auto *storage = arr.data();
+
+    arr.resize(4, 3);
+    EXPECT_EQ(arr.data(), storage);
+    EXPECT_EQ(arr.pitch(), 16);
+    EXPECT_THAT(arr.row(3), ElementsAre(60, 61, 62));
+
+    arr.resize(4, 20);
+    EXPECT_EQ(arr.data(), storage);
+    EXPECT_EQ(arr.pitch(), 32);
+    EXPECT_THAT(arr.row(3).first(4), ElementsAre(60, 61, 62, 0));
+    EXPECT_EQ(std::ranges::count(arr, 0), 1 + 4 * 17);
+}
+
+// ================================
+// 未初始化构造测试
+// ================================
+
+/**
+ * @brief 未初始化构造测试夹具
+ *
+ * 存储来自预先写满0xAB的缓冲区，用于区分“未写入”与“被清零”。
+ */
+class Array2dUninitializedTest : public ::testing::Test {
+protected:
+    void SetUp() override { buffer_.fill(std::byte{0xAB}); }
+
+    std::array<std::byte, 4096>         buffer_{};
+    std::pmr::monotonic_buffer_resource resource_{buffer_.data(), buffer_.size(),
+                                                  std::pmr::null_memory_resource()};
+};
+
+TEST_F(Array2dUninitializedTest, ConstructorSkipsInitialization) {
+    qm::pmr::array2d<std::uint8_t> scratch(4, 8, uninitialized, &resource_);
+    EXPECT_EQ(scratch.rows(), 4);
+    EXPECT_EQ(scratch.cols(), 8);
+    EXPECT_EQ(std::ranges::count(scratch, 0xAB), 32);
+
+    qm::pmr::array2d<std::uint8_t> zeroed(4, 8, &resource_);
+    EXPECT_EQ(std::ranges::count(zeroed, 0), 32);
+}
+
+TEST_F(Array2dUninitializedTest, ResizeUninitializedKeepsOverlap) {
+    qm::pmr::array2d<std::uint8_t> arr({{1, 2}, {3, 4}}, &resource_);
+    arr.resize_uninitialized(3, 3);
+
+    EXPECT_THAT(arr.row(0).first(2), ElementsAre(1, 2));
+    EXPECT_THAT(arr.row(1).first(2), ElementsAre(3, 4));
+    EXPECT_EQ(arr(2, 2), 0xAB);
+
+    arr.resize(4, 4);
+    EXPECT_EQ(arr(3, 3), 0);
+    EXPECT_EQ(arr.get_allocator().resource(), &resource_);
+}
+
+TEST_F(Array2dUninitializedTest, PitchedAndConstraints) {
+    pitched_array2d<double> arr(3, 5, row_pitch{8}, uninitialized);
+    arr.fill(1.5);
+    EXPECT_EQ(std::ranges::count(arr, 1.5), 15);
+
+    static_assert(std::is_constructible_v<array2d<double>, int, int, uninitialized_t>);
+    static_assert(!std::is_constructible_v<array2d<std::string>, int, int, uninitialized_t>);
+    static_assert(std::is_same_v<array2d<int>::allocator_type, std::allocator<int>>);
+
+    // 非平凡类型仍然值初始化
+    struct Mixed {
+        int         id;
+        std::string name;
+    };
+    array2d<Mixed> mixed(2, 2);
+    EXPECT_EQ(mixed(1, 1).id, 0);
+    EXPECT_TRUE(mixed(1, 1).name.empty());
+}
+
+// ================================
+// 行追加、插入和删除测试
+// ================================
+
+class Array2dRowEditTest : public ::testing::Test {
+protected:
+    array2d<int> matrix_{{1, 2, 3}, {4, 5, 6}};
+};
+
+TEST_F(Array2dRowEditTest, PushBackRow) {
+    array2d<int>     table;
+    std::vector<int> record{1, 2, 3};
+
+    table.push_back_row(record);
+    EXPECT_EQ(table.rows(), 1);
+    EXPECT_EQ(table.cols(), 3);
+
+    for (int i = 0; i < 100; ++i) {
+        record[0] = i;
+        table.push_back_row(record);
+    }
+    EXPECT_EQ(table.rows(), 101);
+    EXPECT_THAT(table.row(100), ElementsAre(99, 2, 3));
+    EXPECT_GE(table.capacity(), table.size());
+
+    std::array<int, 2> wrong{0, 0};
+    EXPECT_THROW(table.push_back_row(wrong), std::invalid_argument);
+    EXPECT_EQ(table.rows(), 101);
+}
+
+TEST_F(Array2dRowEditTest, PushBackRowGrowsGeometrically) {
+    array2d<double>     table;
+    std::vector<double> record(16, 1.0);
+    std::size_t         reallocations = 0;
+    const double       *storage       = nullptr;
+
+    for (int i = 0; i < 1000; ++i) {
+        table.push_back_row(record);
+        if (table.data() != storage) {
+            storage = table.data();
+            ++reallocations;
+        }
+    }
+    EXPECT_EQ(table.rows(), 1000);
+    EXPECT_LE(reallocations, 12u);
+}
+
+TEST_F(Array2dRowEditTest, EmplaceBackRow) {
+    auto row = matrix_.emplace_back_row();
+    EXPECT_EQ(matrix_.rows(), 3);
+    EXPECT_THAT(row, ElementsAre(0, 0, 0));
+
+    row[1] = 8;
+    EXPECT_EQ(matrix_(2, 1), 8);
+
+    matrix_.emplace_back_row(7);
+    EXPECT_THAT(matrix_.row(3), ElementsAre(7, 7, 7));
+    EXPECT_THAT(matrix_.row(0), ElementsAre(1, 2, 3));
+}
+
+TEST_F(Array2dRowEditTest, AppendRowOfItself) {
+    // 每次追加都可能扩容，参数引用的是扩容前的存储
+    for (int i = 0; i < 10; ++i) {
+        matrix_.push_back_row(matrix_.row(i % 2));
+        matrix_.emplace_back_row(matrix_(1, 2));
+    }
+    EXPECT_EQ(matrix_.rows(), 22);
+    EXPECT_THAT(matrix_.row(18), ElementsAre(1, 2, 3));
+    EXPECT_THAT(matrix_.row(20), ElementsAre(4, 5, 6));
+    EXPECT_THAT(matrix_.row(19), ElementsAre(6, 6, 6));
+    EXPECT_THAT(matrix_.row(21), ElementsAre(6, 6, 6));
+
+    pitched_array2d<std::string> names{{"a", "b"}};
+    for (int i = 0; i < 5; ++i) names.push_back_row(names.row(i));
+    EXPECT_THAT(names.row(5), ElementsAre("a", "b"));
+}
+
+TEST_F(Array2dRowEditTest, InsertRows) {
+    matrix_.insert_rows(1, 2, 9);
+    EXPECT_EQ(matrix_.rows(), 4);
+    EXPECT_THAT(matrix_, ElementsAre(1, 2, 3, 9, 9, 9, 9, 9, 9, 4, 5, 6));
+
+    matrix_.insert_rows(4, 1);
+    EXPECT_THAT(matrix_.row(4), ElementsAre(0, 0, 0));
+
+    matrix_.insert_rows(0, 0);
+    EXPECT_EQ(matrix_.rows(), 5);
+
+    EXPECT_THROW(matrix_.insert_rows(6, 1), std::out_of_range);
+    EXPECT_THROW(matrix_.insert_rows(0, -1), std::invalid_argument);
+}
+
+TEST_F(Array2dRowEditTest, EraseRows) {
+    matrix_.push_back_row(std::vector<int>{7, 8, 9});
+    const auto capacity = matrix_.capacity();
+
+    matrix_.erase_rows(0, 2);
+    EXPECT_EQ(matrix_.rows(), 1);
+    EXPECT_THAT(matrix_, ElementsAre(7, 8, 9));
+    EXPECT_EQ(matrix_.capacity(), capacity);
+
+    EXPECT_THROW(matrix_.erase_rows(0, 2), std::out_of_range);
+    EXPECT_THROW(matrix_.erase_rows(-1, 1), std::out_of_range);
+
+    matrix_.erase_rows(0, 1);
+    EXPECT_TRUE(matrix_.empty());
+}
+
+TEST_F(Array2dRowEditTest, PitchedAndNonTrivialTypes) {
+    pitched_array2d<int> pitched(2, 3, 1);
+    pitched.push_back_row(std::vector<int>{4, 5, 6});
+    pitched.insert_rows(0, 1, 0);
+    EXPECT_EQ(pitched.rows(), 4);
+    EXPECT_THAT(pitched, ElementsAre(0, 0, 0, 1, 1, 1, 1, 1, 1, 4, 5, 6));
+    pitched.erase_rows(1, 2);
+    EXPECT_THAT(pitched.row(1), ElementsAre(4, 5, 6));
+
+    array2d<std::string> names;
+    names.push_back_row(std::vector<std::string>{"a", "b"});
+    names.insert_rows(0, 1, "x");
+    names.emplace_back_row(3, 'z');
+    EXPECT_THAT(names, ElementsAre("x", "x", "a", "b", "zzz", "zzz"));
+    names.erase_rows(1, 1);
+    EXPECT_THAT(names.row(1), ElementsAre("zzz", "zzz"));
+}
+
+// ================================
+// 列插入和删除测试
+// ================================
+
+class Array2dColEditTest : public ::testing::Test {
+protected:
+    array2d<int> matrix_{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+};
+
+TEST_F(Array2dColEditTest, InsertColsReallocating) {
+    matrix_.insert_cols(1, 2, 0);
+    EXPECT_EQ(matrix_.cols(), 5);
+    EXPECT_THAT(matrix_.row(0), ElementsAre(1, 0, 0, 2, 3));
+    EXPECT_THAT(matrix_.row(2), ElementsAre(7, 0, 0, 8, 9));
+    EXPECT_GE(matrix_.capacity(), 18u);
+
+    matrix_.insert_cols(5, 1);
+    EXPECT_THAT(matrix_.row(1), ElementsAre(4, 0, 0, 5, 6, 0));
+
+    EXPECT_THROW(matrix_.insert_cols(7, 1), std::out_of_range);
+    EXPECT_THROW(matrix_.insert_cols(0, -1), std::invalid_argument);
+}
+
+TEST_F(Array2dColEditTest, InsertColsInPlace) {
+    matrix_.reserve(3, 6);
+    const auto *storage = matrix_.data();
+
+    matrix_.insert_cols(0, 1, -1);
+    matrix_.insert_cols(4, 2, -2);
+    EXPECT_EQ(matrix_.data(), storage);
+    EXPECT_THAT(matrix_, ElementsAre(-1, 1, 2, 3, -2, -2,
+                                     -1, 4, 5, 6, -2, -2,
+                                     -1, 7, 8, 9, -2, -2));
+}
+
+TEST_F(Array2dColEditTest, InsertColsShrinkingPitchAndAliasedValue) {
+    // 显式的大行距大于新列数的默认行距，各行需要自前向后移动
+    pitched_array2d<int> wide(200, 10, row_pitch{1000});
+    for (int i = 0; i < 200; ++i) std::iota(wide.row(i).begin(), wide.row(i).end(), i * 10);
+    wide.insert_cols(5, 1, -1);
+    EXPECT_EQ(wide.cols(), 11);
+    EXPECT_EQ(static_cast<std::size_t>(wide.end() - wide.begin()), wide.size());
+    EXPECT_EQ(wide.get_vector().size(), static_cast<std::size_t>(200 * wide.pitch()));
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_THAT(wide.row(i), ElementsAre(i * 10, i * 10 + 1, i * 10 + 2, i * 10 + 3, i * 10 + 4, -1,
+                                             i * 10 + 5, i * 10 + 6, i * 10 + 7, i * 10 + 8, i * 10 + 9));
+    }
+
+    // 删除列后默认行距大于原行距
+    pitched_array2d<int> tight(3, 10, row_pitch{10});
+    std::iota(tight.begin(), tight.end(), 0);
+    tight.erase_cols(0, 1);
+    EXPECT_THAT(tight.row(2), ElementsAre(21, 22, 23, 24, 25, 26, 27, 28, 29));
+    EXPECT_THAT(tight.row(0), ElementsAre(1, 2, 3, 4, 5, 6, 7, 8, 9));
+
+    matrix_.reserve(3, 4);
+    matrix_.insert_cols(0, 1, matrix_(0, 0));
+    EXPECT_THAT(matrix_, ElementsAre(1, 1, 2, 3, 1, 4, 5, 6, 1, 7, 8, 9));
+    matrix_.insert_cols(0, 1, matrix_(2, 3));
+    EXPECT_THAT(matrix_.col_view(0), ElementsAre(9, 9, 9));
+}
+
+TEST_F(Array2dColEditTest, EraseCols) {
+    const auto *storage = matrix_.data();
+
+    matrix_.erase_cols(1, 1);
+    EXPECT_EQ(matrix_.data(), storage);
+    EXPECT_EQ(matrix_.cols(), 2);
+    EXPECT_THAT(matrix_, ElementsAre(1, 3, 4, 6, 7, 9));
+
+    matrix_.erase_cols(0, 1);
+    EXPECT_THAT(matrix_, ElementsAre(3, 6, 9));
+
+    EXPECT_THROW(matrix_.erase_cols(0, 2), std::out_of_range);
+    matrix_.erase_cols(0, 1);
+    EXPECT_EQ(matrix_.rows(), 3);
+    EXPECT_EQ(matrix_.cols(), 0);
+    EXPECT_TRUE(matrix_.empty());
+}
+
+TEST_F(Array2dColEditTest, PitchedAndNonTrivialTypes) {
+    pitched_array2d<int> pitched{{1, 2, 3}, {4, 5, 6}};
+    pitched.insert_cols(3, 20, 0);
+    EXPECT_EQ(pitched.pitch(), 32);
+    EXPECT_THAT(pitched.row(1).first(4), ElementsAre(4, 5, 6, 0));
+    pitched.erase_cols(1, 21);
+    EXPECT_EQ(pitched.pitch(), 16);
+    EXPECT_THAT(pitched, ElementsAre(1, 0, 4, 0));
+
+    array2d<std::string> names{{"a", "b"}, {"c", "d"}};
+    names.insert_cols(1, 1, "x");
+    EXPECT_THAT(names, ElementsAre("a", "x", "b", "c", "x", "d"));
+    names.erase_cols(0, 2);
+    EXPECT_THAT(names, ElementsAre("b", "d"));
+}
+
+// ================================
+// 归约操作测试
+// ================================
+
+class Array2dReduceTest : public ::testing::Test {
+protected:
+    array2d<int> matrix_{{3, 1, 4}, {1, 5, 9}, {2, 6, 5}};
+};
+
+TEST_F(Array2dReduceTest, SumMinMax) {
+    EXPECT_EQ(matrix_.sum(), 36);
+    EXPECT_EQ(matrix_.sum(Array_sum_opt::Pairwise), 36);
+    EXPECT_EQ(matrix_.sum(Array_sum_opt::Kahan), 36);
+    EXPECT_EQ(matrix_.min(), 1);
+    EXPECT_EQ(matrix_.max(), 9);
+
+    array2d<double> empty;
+    EXPECT_EQ(empty.sum(), 0.0);
+    EXPECT_THROW((void) empty.min(), std::out_of_range);
+    EXPECT_THROW((void) empty.argmax(), std::out_of_range);
+}
+
+TEST_F(Array2dReduceTest, ArgminArgmaxReturnFirstOccurrence) {
+    EXPECT_EQ(matrix_.argmin(), std::make_pair(0, 1));
+    EXPECT_EQ(matrix_.argmax(), std::make_pair(1, 2));
+
+    // 跨越多个内核块
+    array2d<double> large(300, 70, 1.0);
+    large(250, 3)  = -2.0;
+    large(251, 69) = -2.0;
+    large(4, 5)    = 7.0;
+    EXPECT_EQ(large.argmin(), std::make_pair(250, 3));
+    EXPECT_EQ(large.argmax(), std::make_pair(4, 5));
+    EXPECT_EQ(large.min(), -2.0);
+    EXPECT_EQ(large.max(), 7.0);
+}
+
+TEST_F(Array2dReduceTest, RowAndColReduce) {
+    EXPECT_THAT(matrix_.row_reduce(0), ElementsAre(8, 15, 13));
+    EXPECT_THAT(matrix_.col_reduce(0), ElementsAre(6, 12, 18));
+    EXPECT_THAT(matrix_.row_reduce(0, [](int a, int b) { return std::max(a, b); }), ElementsAre(4, 9, 6));
+    EXPECT_THAT(matrix_.col_reduce(100, [](int a, int b) { return std::min(a, b); }), ElementsAre(1, 1, 4));
+    EXPECT_THAT(matrix_.row_reduce(std::string{}, [](std::string s, int v) { return s + std::to_string(v); }),
+                ElementsAre("314", "159", "265"));
+
+    array2d<float> floats(2, 37, 0.5f);
+    EXPECT_THAT(floats.row_reduce(1.0f), ElementsAre(19.5f, 19.5f));
+    EXPECT_THAT(floats.col_reduce(0.0f), ::testing::Each(1.0f));
+}
+
+TEST_F(Array2dReduceTest, CompensatedSummation) {
+    // 1 + n * 1e-16：顺序累加会丢失全部小量
+    array2d<double> values(100, 1000, 1e-16);
+    values(0, 0) = 1.0;
+    const double expected = 1.0 + (values.size() - 1) * 1e-16;
+
+    EXPECT_NEAR(values.sum(Array_sum_opt::Kahan), expected, 1e-15);
+    EXPECT_NEAR(values.sum(Array_sum_opt::Pairwise), expected, 1e-13);
+    EXPECT_NEAR(values.sum_parallel(Array_sum_opt::Kahan), expected, 1e-15);
+}
+
+TEST_F(Array2dReduceTest, PitchedSkipsPadding) {
+    pitched_array2d<float> pitched(5, 3, 2.0f);
+    EXPECT_GT(pitched.pitch(), pitched.cols());
+    // 填充元素由fill一并写入，归约不应读取它们
+    pitched.fill(100.0f);
+    for (auto &value: pitched) value = 2.0f;
+    pitched(3, 1) = -1.0f;
+    pitched(1, 2) = 9.0f;
+
+    EXPECT_EQ(pitched.sum(), 2.0f * 13 - 1.0f + 9.0f);
+    EXPECT_EQ(pitched.sum(Array_sum_opt::Kahan), 2.0f * 13 - 1.0f + 9.0f);
+    EXPECT_EQ(pitched.min(), -1.0f);
+    EXPECT_EQ(pitched.max(), 9.0f);
+    EXPECT_EQ(pitched.argmin(), std::make_pair(3, 1));
+    EXPECT_EQ(pitched.argmax(), std::make_pair(1, 2));
+    EXPECT_THAT(pitched.row_reduce(0.0f), ElementsAre(6.0f, 13.0f, 6.0f, 3.0f, 6.0f));
+}
+
+TEST_F(Array2dReduceTest, SumParallel) {
+    array2d<long long> large(400, 300);
+    std::iota(large.begin(), large.end(), 0LL);
+    const long long n = static_cast<long long>(large.size());
+    EXPECT_EQ(large.sum_parallel(), n * (n - 1) / 2);
+    EXPECT_EQ(large.sum_parallel(Array_sum_opt::Pairwise), n * (n - 1) / 2);
+
+    pitched_array2d<int> pitched(200, 77, 1);
+    EXPECT_EQ(pitched.sum_parallel(), 200 * 77);
+    EXPECT_EQ(matrix_.sum_parallel(), 36);
+}
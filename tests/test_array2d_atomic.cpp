@@ -0,0 +1,165 @@
+//
+// test_array2d_atomic.cpp
+//
+#include "array2d.hpp"
+#include "array2d_atomic.hpp"
+#include <atomic>
+#include <cstdint>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace qm;
+using ::testing::Each;
+
+// ================================
+// 测试夹具类
+// ================================
+
+/**
+ * @brief 原子视图与私有化累加器测试夹具
+ */
+class Array2dAtomicTest : public ::testing::Test {
+protected:
+    array2d<int> samples_{400, 300};
+
+    void SetUp() override {
+        configure_thread_pool(4);
+        for (int i = 0; i < samples_.rows(); ++i) {
+            for (int j = 0; j < samples_.cols(); ++j) samples_(i, j) = (i * 31 + j * 17) % 64;
+        }
+    }
+
+    void TearDown() override { configure_thread_pool(0); }
+
+    /**
+     * @brief 串行计算的8x8直方图（按样本值的高低3位分桶）
+     */
+    array2d<std::int64_t> serial_histogram() const {
+        array2d<std::int64_t> hist(8, 8, 0);
+        for (auto value: samples_) ++hist(value / 8, value % 8);
+        return hist;
+    }
+};
+
+// ================================
+// array2d_atomic_view
+// ================================
+
+TEST_F(Array2dAtomicTest, ParallelHistogram) {
+    array2d<std::int64_t> hist(8, 8, 0);
+    auto                  counts = hist.atomic_view();
+    parallel_for_rows(samples_.rows(), [&](int first, int last) {
+        for (int i = first; i < last; ++i) {
+            for (int j = 0; j < samples_.cols(); ++j) {
+                counts.fetch_add(samples_(i, j) / 8, samples_(i, j) % 8, 1, std::memory_order_relaxed);
+            }
+        }
+    }, 8);
+    EXPECT_EQ(hist, serial_histogram());
+}
+
+TEST_F(Array2dAtomicTest, FloatingScatterAdd) {
+    array2d<double> grid(4, 4, 0.0);
+    auto            acc = grid.atomic_view();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (int k = 0; k < 1600; ++k) acc.fetch_add(k % 4, (k / 4) % 4, 0.5);
+        });
+    }
+    for (auto &thread: threads) thread.join();
+    EXPECT_THAT(grid, Each(0.5 * 4 * 100));
+
+    EXPECT_DOUBLE_EQ(acc.fetch_sub(0, 0, 200.0), 200.0);
+    EXPECT_DOUBLE_EQ(acc.load(0, 0), 0.0);
+}
+
+TEST_F(Array2dAtomicTest, MinMaxAndCompareExchange) {
+    array2d<int> extremes(1, 2);
+    extremes(0, 0) = std::numeric_limits<int>::max();
+    extremes(0, 1) = std::numeric_limits<int>::min();
+    auto view      = extremes.atomic_view();
+
+    parallel_for_rows(samples_.rows(), [&](int first, int last) {
+        for (int i = first; i < last; ++i) {
+            for (int j = 0; j < samples_.cols(); ++j) {
+                view.fetch_min(0, 0, samples_(i, j) + i);
+                view.fetch_max(0, 1, samples_(i, j) + i);
+            }
+        }
+    });
+    EXPECT_EQ(extremes(0, 0), 0);
+    EXPECT_EQ(extremes(0, 1), 63 + 399);
+
+    EXPECT_EQ(view.fetch_max(0, 1, 0), 462);   // 不写入时返回当前值
+    int expected = 1;
+    EXPECT_FALSE(view.compare_exchange(0, 0, expected, 5));
+    EXPECT_EQ(expected, 0);
+    EXPECT_TRUE(view.compare_exchange(0, 0, expected, 5));
+    EXPECT_EQ(view.exchange(0, 0, 7), 5);
+    EXPECT_EQ(view.at(0, 0).load(), 7);
+    EXPECT_THROW((void) view.at(1, 0), std::out_of_range);
+}
+
+TEST_F(Array2dAtomicTest, ViewOverSubmatrix) {
+    array2d<std::int64_t> m(10, 10, 0);
+    auto                  block = m.submatrix(2, 3, 4, 5);
+    array2d_atomic_view   view(block);
+    EXPECT_EQ(view.rows(), 4);
+    EXPECT_EQ(view.pitch(), 10);
+
+    view.fetch_add(3, 4, 9);
+    EXPECT_EQ(m(5, 7), 9);
+    EXPECT_EQ(m.sum(), 9);
+}
+
+// ================================
+// privatized_accumulator
+// ================================
+
+TEST_F(Array2dAtomicTest, PrivatizedHistogram) {
+    privatized_accumulator<std::int64_t> acc(8, 8);
+    parallel_for_rows(samples_.rows(), [&](int first, int last) {
+        auto &local = acc.local();
+        for (int i = first; i < last; ++i) {
+            for (int j = 0; j < samples_.cols(); ++j) ++local(samples_(i, j) / 8, samples_(i, j) % 8);
+        }
+    });
+    EXPECT_GE(acc.copies(), 1u);
+    EXPECT_LE(acc.copies(), default_thread_pool().size());
+    EXPECT_EQ(acc.merged(), serial_histogram());
+
+    // 合并到已有内容上
+    array2d<std::int64_t> hist(8, 8, 1);
+    acc.merge_into(hist);
+    EXPECT_EQ(hist, serial_histogram() + 1);
+
+    acc.clear();
+    EXPECT_EQ(acc.copies(), 0u);
+    EXPECT_THAT(acc.merged(), Each(0));
+}
+
+TEST_F(Array2dAtomicTest, PrivatizedCustomOperation) {
+    privatized_accumulator<int> acc(2, 2, std::numeric_limits<int>::min());
+    std::vector<std::thread>    threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([&, t] {
+            auto &local = acc.local();
+            for (int k = 0; k < 4; ++k) local(k / 2, k % 2) = std::max(local(k / 2, k % 2), t * 10 + k);
+        });
+    }
+    for (auto &thread: threads) thread.join();
+    EXPECT_EQ(acc.copies(), 3u);
+
+    const auto best = acc.merged([](int a, int b) { return std::max(a, b); });
+    EXPECT_EQ(best, (array2d<int>{{20, 21}, {22, 23}}));
+
+    array2d<int> wrong(3, 2);
+    EXPECT_THROW(acc.merge_into(wrong), std::invalid_argument);
+    EXPECT_THROW(privatized_accumulator<int>(-1, 2), std::invalid_argument);
+}
@@ -0,0 +1,153 @@
+//
+// test_array2d_cow.cpp
+//
+#include "array2d.hpp"
+#include "array2d_cow.hpp"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace qm;
+using ::testing::Each;
+
+// ================================
+// 测试夹具类
+// ================================
+
+/**
+ * @brief 写时复制矩阵测试夹具
+ */
+class CowArray2dTest : public ::testing::Test {
+protected:
+    array2d<int> source_{10, 13};
+
+    void SetUp() override {
+        for (int i = 0; i < source_.rows(); ++i) {
+            for (int j = 0; j < source_.cols(); ++j) source_(i, j) = i * 100 + j;
+        }
+    }
+
+    /**
+     * @brief 逐元素比较
+     */
+    template<typename A, typename B>
+    static void expect_same(const A &a, const B &b) {
+        ASSERT_EQ(a.rows(), b.rows());
+        ASSERT_EQ(a.cols(), b.cols());
+        for (int i = 0; i < a.rows(); ++i) {
+            for (int j = 0; j < a.cols(); ++j) ASSERT_EQ(a(i, j), b(i, j)) << i << ", " << j;
+        }
+    }
+};
+
+// ================================
+// 构造与访问
+// ================================
+
+TEST_F(CowArray2dTest, ConstructFromMatrix) {
+    cow_array2d<int> m(source_, 4, 5);
+    EXPECT_EQ(m.tiles_down(), 3);
+    EXPECT_EQ(m.tiles_across(), 3);
+    EXPECT_EQ(m.shared_tiles(), 0u);
+    expect_same(m, source_);
+    expect_same(m.to_array2d(), source_);
+    EXPECT_EQ(m.at(9, 12), 912);
+    EXPECT_THROW((void) m.at(10, 0), std::out_of_range);
+    EXPECT_THROW((void) m.at(0, -1), std::out_of_range);
+}
+
+TEST_F(CowArray2dTest, ConstructFromPitchedView) {
+    auto             view = source_.submatrix(2, 3, 5, 7);
+    cow_array2d<int> m(view, 2, 3);
+    expect_same(m, view);
+}
+
+TEST_F(CowArray2dTest, FilledConstructionSharesOneTile) {
+    cow_array2d<double> m(100, 100, 1.5, 16, 16);
+    EXPECT_EQ(m.shared_tiles(), 49u);
+    EXPECT_THAT(m.to_array2d(), Each(1.5));
+
+    m.set(0, 0, 2.0);
+    EXPECT_FALSE(m.tile_shared(0, 0));
+    EXPECT_TRUE(m.tile_shared(6, 6));
+    EXPECT_DOUBLE_EQ(m(0, 0), 2.0);
+    EXPECT_DOUBLE_EQ(m(99, 99), 1.5);
+}
+
+TEST_F(CowArray2dTest, InvalidArguments) {
+    EXPECT_THROW(cow_array2d<int>(-1, 2), std::invalid_argument);
+    EXPECT_THROW(cow_array2d<int>(2, 2, 0, 0, 4), std::invalid_argument);
+    EXPECT_THROW(cow_array2d<int>(source_, 4, -2), std::invalid_argument);
+
+    cow_array2d<int> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.to_array2d().size(), 0u);
+}
+
+// ================================
+// 快照与写时复制
+// ================================
+
+TEST_F(CowArray2dTest, SnapshotSharesUntilWrite) {
+    cow_array2d<int> base(source_, 4, 4);
+    auto             fork = base.snapshot();
+    EXPECT_EQ(base.shared_tiles(), 12u);
+
+    fork.set(5, 6, -1);
+    EXPECT_EQ(fork(5, 6), -1);
+    EXPECT_EQ(base(5, 6), 506);
+    EXPECT_FALSE(fork.tile_shared(1, 1));
+    EXPECT_FALSE(base.tile_shared(1, 1));
+    EXPECT_EQ(fork.shared_tiles(), 11u);
+
+    // 独占的块再次写入不再复制
+    fork.modify(4, 4) = -2;
+    EXPECT_EQ(fork.shared_tiles(), 11u);
+    EXPECT_EQ(base(4, 4), 404);
+
+    source_(5, 6) = -1;
+    source_(4, 4) = -2;
+    expect_same(fork, source_);
+}
+
+TEST_F(CowArray2dTest, TileViewWrites) {
+    cow_array2d<int> base(source_, 4, 4);
+    auto             fork = base;
+
+    auto edge = fork.tile(2, 3);   // 右下角的边缘块：2 x 1
+    EXPECT_EQ(edge.rows(), 2);
+    EXPECT_EQ(edge.cols(), 1);
+    edge.fill(7);
+    EXPECT_EQ(fork(9, 12), 7);
+    EXPECT_EQ(base(9, 12), 912);
+
+    const auto &cbase = base;
+    EXPECT_EQ(cbase.tile(0, 1)(1, 2), 106);
+    EXPECT_THROW((void) cbase.tile(3, 0), std::out_of_range);
+}
+
+TEST_F(CowArray2dTest, NonTrivialElements) {
+    cow_array2d<std::string> base(5, 5, "x", 2, 2);
+    auto                     fork = base.snapshot();
+    fork.set(4, 4, "y");
+    EXPECT_EQ(base(4, 4), "x");
+    EXPECT_EQ(fork.to_array2d()(4, 4), "y");
+}
+
+TEST_F(CowArray2dTest, SnapshotsReleasedOnOtherThreads) {
+    // 另一线程读取后释放快照，本线程随后的原地写入不能与该读取竞争（TSan下检查）
+    cow_array2d<int> base(source_, 4, 4);
+    for (int iter = 0; iter < 200; ++iter) {
+        auto        fork = base.snapshot();
+        std::thread reader([fork = std::move(fork), iter]() mutable {
+            EXPECT_EQ(fork(0, 0), iter);
+            fork = cow_array2d<int>();
+        });
+        base.set(0, 0, iter + 1);
+        reader.join();
+        EXPECT_EQ(base(0, 0), iter + 1);
+    }
+    EXPECT_FALSE(base.tile_shared(0, 0));
+}
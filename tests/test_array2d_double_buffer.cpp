@@ -0,0 +1,135 @@
+//
+// test_array2d_double_buffer.cpp
+//
+#include "array2d.hpp"
+#include "array2d_double_buffer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace qm;
+using ::testing::Each;
+
+// ================================
+// 测试夹具类
+// ================================
+
+/**
+ * @brief 双缓冲矩阵测试夹具
+ */
+class DoubleBufferedArray2dTest : public ::testing::Test {
+protected:
+    void TearDown() override { configure_thread_pool(0); }
+
+    /**
+     * @brief 生命游戏的一步，周期边界
+     */
+    static void life_rows(array2d_view<const std::uint8_t> cur, array2d_view<std::uint8_t> next, int first, int last) {
+        const int rows = cur.rows(), cols = cur.cols();
+        for (int i = first; i < last; ++i) {
+            for (int j = 0; j < cols; ++j) {
+                int alive = 0;
+                for (int di = -1; di <= 1; ++di) {
+                    for (int dj = -1; dj <= 1; ++dj) {
+                        if (di || dj) alive += cur((i + di + rows) % rows, (j + dj + cols) % cols);
+                    }
+                }
+                next(i, j) = alive == 3 || (alive == 2 && cur(i, j));
+            }
+        }
+    }
+};
+
+// ================================
+// 基本操作
+// ================================
+
+TEST_F(DoubleBufferedArray2dTest, ConstructAndFlip) {
+    double_buffered_array2d<int> grid(3, 4, 7);
+    EXPECT_EQ(grid.rows(), 3);
+    EXPECT_EQ(grid.cols(), 4);
+    EXPECT_EQ(grid.generation(), 0u);
+    EXPECT_THAT(grid.front(), Each(7));
+
+    auto next = grid.back();
+    next.fill(1);
+    EXPECT_THAT(grid.front(), Each(7));   // 发布前读者仍看到旧的一代
+
+    grid.publish();
+    EXPECT_EQ(grid.generation(), 1u);
+    EXPECT_THAT(grid.front(), Each(1));
+    EXPECT_THAT(grid.back(), Each(7));
+}
+
+TEST_F(DoubleBufferedArray2dTest, ConstructFromArray) {
+    double_buffered_array2d<int> grid(array2d<int>{{1, 2}, {3, 4}});
+    EXPECT_EQ(grid.front()(1, 0), 3);
+    EXPECT_EQ(grid.back()(1, 1), 4);
+}
+
+TEST_F(DoubleBufferedArray2dTest, UpdateMatchesSerialLife) {
+    array2d<std::uint8_t> seed(64, 48, 0);
+    seed(1, 2) = seed(2, 3) = seed(3, 1) = seed(3, 2) = seed(3, 3) = 1;   // 滑翔机
+    seed(30, 20) = seed(30, 21) = seed(30, 22) = 1;                        // 闪烁器
+
+    double_buffered_array2d<std::uint8_t> serial(seed), parallel(seed);
+    configure_thread_pool(4);
+    for (int step = 0; step < 40; ++step) {
+        serial.update([](auto cur, auto next) { life_rows(cur, next, 0, cur.rows()); });
+        parallel.update_parallel(life_rows, 3);
+    }
+    EXPECT_EQ(parallel.generation(), 40u);
+
+    const auto a = serial.front(), b = parallel.front();
+    for (int i = 0; i < a.rows(); ++i) {
+        for (int j = 0; j < a.cols(); ++j) ASSERT_EQ(a(i, j), b(i, j)) << i << ", " << j;
+    }
+    EXPECT_EQ(std::count(b.begin(), b.end(), 1), 8);
+}
+
+TEST_F(DoubleBufferedArray2dTest, FailedUpdateDoesNotPublish) {
+    double_buffered_array2d<int> grid(100, 10, 0);
+    EXPECT_THROW(grid.update_parallel([](auto, auto, int first, int) {
+        if (first >= 50) throw std::runtime_error("update failed");
+    }), std::runtime_error);
+    EXPECT_EQ(grid.generation(), 0u);
+}
+
+// ================================
+// 并发读取
+// ================================
+
+TEST_F(DoubleBufferedArray2dTest, ReadersSeeConsistentGenerations) {
+    double_buffered_array2d<std::uint64_t> grid(32, 32, 0);
+    std::atomic<bool>                      done{false};
+    std::atomic<int>                       torn{0};
+
+    // 每一代的所有元素都等于代数，读者若看到混合的值说明读到了正在写入的缓冲区
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                {
+                    auto guard = grid.read();
+                    for (auto value: guard.view()) {
+                        if (value != guard.generation()) ++torn;
+                    }
+                }
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (std::uint64_t g = 1; g <= 500; ++g) {
+        grid.update([g](auto, auto next) { next.fill(g); });
+    }
+    done = true;
+    for (auto &reader: readers) reader.join();
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_THAT(grid.read().view(), Each(500u));
+}
@@ -0,0 +1,165 @@
+//
+// test_array2d_expr.cpp
+//
+#include "array2d.hpp"
+#include <cstdint>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using namespace qm;
+using ::testing::Each;
+using ::testing::ElementsAre;
+
+// ================================
+// 测试夹具类
+// ================================
+
+/**
+ * @brief 表达式模板测试夹具
+ */
+class Array2dExprTest : public ::testing::Test {
+protected:
+    array2d<double> a_{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+    array2d<double> b_{{6.0, 5.0, 4.0}, {3.0, 2.0, 1.0}};
+};
+
+// ================================
+// 惰性求值测试
+// ================================
+
+TEST_F(Array2dExprTest, ExpressionIsLazy) {
+    auto expr = a_ * 2.0 + b_;
+    static_assert(Array2d_expression_node<decltype(expr)>);
+    EXPECT_EQ(expr.rows(), 2u);
+    EXPECT_EQ(expr.cols(), 3u);
+
+    // 表达式只引用存储，求值时读取当前的值
+    a_(0, 0) = 10.0;
+    array2d<double> result = expr;
+    EXPECT_THAT(result, ElementsAre(26.0, 9.0, 10.0, 11.0, 12.0, 13.0));
+}
+
+TEST_F(Array2dExprTest, ArithmeticAndScalarBroadcast) {
+    array2d<double> result = (a_ + b_) * 0.5 - a_ / 2.0 + 1.0;
+    EXPECT_THAT(result, ElementsAre(4.0, 3.5, 3.0, 2.5, 2.0, 1.5));
+
+    result = 10.0 - a_;
+    EXPECT_THAT(result, ElementsAre(9.0, 8.0, 7.0, 6.0, 5.0, 4.0));
+
+    result = -a_ * b_;
+    EXPECT_THAT(result, ElementsAre(-6.0, -10.0, -12.0, -12.0, -10.0, -6.0));
+}
+
+TEST_F(Array2dExprTest, ElementwiseFunctions) {
+    array2d<double> result = max(a_, b_);
+    EXPECT_THAT(result, ElementsAre(6.0, 5.0, 4.0, 4.0, 5.0, 6.0));
+
+    result = min(a_, 3.0);
+    EXPECT_THAT(result, ElementsAre(1.0, 2.0, 3.0, 3.0, 3.0, 3.0));
+
+    result = abs(a_ - b_);
+    EXPECT_THAT(result, ElementsAre(5.0, 3.0, 1.0, 1.0, 3.0, 5.0));
+
+    result = clamp(a_, 2.0, 5.0);
+    EXPECT_THAT(result, ElementsAre(2.0, 2.0, 3.0, 4.0, 5.0, 5.0));
+
+    result = where(greater(a_, b_), a_, -1.0);
+    EXPECT_THAT(result, ElementsAre(-1.0, -1.0, -1.0, 4.0, 5.0, 6.0));
+
+    array2d<std::uint8_t> mask = less_equal(a_, 3.0);
+    EXPECT_THAT(mask, ElementsAre(1, 1, 1, 0, 0, 0));
+}
+
+// ================================
+// 赋值测试
+// ================================
+
+TEST_F(Array2dExprTest, AssignInPlaceWithoutReallocation) {
+    const auto *storage = a_.data();
+
+    // 表达式引用目标本身
+    a_ = a_ * 2.0 + b_;
+    EXPECT_EQ(a_.data(), storage);
+    EXPECT_THAT(a_, ElementsAre(8.0, 9.0, 10.0, 11.0, 12.0, 13.0));
+
+    // 尺寸不同时重新分配
+    array2d<double> other(1, 1);
+    other = b_ + 1.0;
+    EXPECT_EQ(other.rows(), 2);
+    EXPECT_THAT(other, ElementsAre(7.0, 6.0, 5.0, 4.0, 3.0, 2.0));
+}
+
+TEST_F(Array2dExprTest, CompoundAssignment) {
+    a_ += b_;
+    EXPECT_THAT(a_, Each(7.0));
+    a_ -= 1.0;
+    a_ *= b_ - 5.0;
+    EXPECT_THAT(a_, ElementsAre(6.0, 0.0, -6.0, -12.0, -18.0, -24.0));
+    a_ /= 2.0;
+    EXPECT_THAT(a_, ElementsAre(3.0, 0.0, -3.0, -6.0, -9.0, -12.0));
+}
+
+TEST_F(Array2dExprTest, ShapeMismatchThrows) {
+    array2d<double> other(3, 2);
+    EXPECT_THROW((void) (a_ + other), std::invalid_argument);
+    EXPECT_THROW(a_ += other, std::invalid_argument);
+    EXPECT_THAT(a_, ElementsAre(1.0, 2.0, 3.0, 4.0, 5.0, 6.0));
+}
+
+TEST_F(Array2dExprTest, MixedTypesConvertOnAssignment) {
+    array2d<int> ints{{1, 2, 3}, {4, 5, 6}};
+    array2d<float> result = ints * 0.5 + a_;
+    EXPECT_THAT(result, ElementsAre(1.5f, 3.0f, 4.5f, 6.0f, 7.5f, 9.0f));
+
+    array2d<std::int64_t> rounded = ints * 3 / 2;
+    EXPECT_THAT(rounded, ElementsAre(1, 3, 4, 6, 7, 9));
+
+    array2d<unsigned> u{{1u, 2u}};
+    array2d<unsigned> same = abs(u);
+    EXPECT_THAT(same, ElementsAre(1u, 2u));
+}
+
+// ================================
+// 布局和视图测试
+// ================================
+
+TEST_F(Array2dExprTest, PitchedAndViewOperands) {
+    pitched_array2d<float> pitched(3, 5, 1.0f);
+    array2d<float>         dense(3, 5, 2.0f);
+
+    // 非连续操作数逐行求值，不写入行尾填充
+    pitched = pitched + dense * 3.0f;
+    EXPECT_THAT(pitched, Each(7.0f));
+
+    array2d<float> block = dense.submatrix(1, 1, 2, 3) + pitched.submatrix(0, 2, 2, 3);
+    EXPECT_EQ(block.rows(), 2);
+    EXPECT_THAT(block, Each(9.0f));
+
+    // 写入视图时行距中视图外的元素保持不变
+    dense.submatrix(0, 1, 3, 2).assign(clamp(dense.submatrix(0, 1, 3, 2) * 10.0f, 0.0f, 5.0f));
+    EXPECT_THAT(dense.row(0), ElementsAre(2.0f, 5.0f, 5.0f, 2.0f, 2.0f));
+    EXPECT_THROW(dense.submatrix(0, 0, 1, 1).assign(dense + 1.0f), std::invalid_argument);
+}
+
+TEST_F(Array2dExprTest, AllocatorIsKept) {
+    std::pmr::monotonic_buffer_resource resource;
+    pmr::array2d<double> pooled(2, 3, 1.0, &resource);
+    pooled = pooled + a_;
+    EXPECT_EQ(pooled.get_allocator().resource(), &resource);
+    EXPECT_THAT(pooled, ElementsAre(2.0, 3.0, 4.0, 5.0, 6.0, 7.0));
+}
+
+TEST_F(Array2dExprTest, SameTypeOverloadsBeatStdAlgorithms) {
+    // std::min/std::max/std::clamp可经ADL找到，同类型操作数必须选择逐元素版本
+    array2d<double> result = min(a_, b_);
+    EXPECT_THAT(result, ElementsAre(1.0, 2.0, 3.0, 3.0, 2.0, 1.0));
+
+    array2d<double> lo(2, 3, 2.0);
+    array2d<double> hi(2, 3, 4.0);
+    result = clamp(a_, lo, hi);
+    EXPECT_THAT(result, ElementsAre(2.0, 2.0, 3.0, 4.0, 4.0, 4.0));
+}
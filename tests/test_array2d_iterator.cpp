@@ -585,4 +585,127 @@ TEST_F(Array2dIteratorTest, ConstCorrectnessTests) {
     Array2d_iterator<const int> another_const_iter(const_ptr);
     EXPECT_TRUE(const_iter > another_const_iter);
     EXPECT_EQ(const_iter - another_const_iter, 1);
-}
\ No newline at end of file
+}
+// ================================
+// 带行距迭代器测试
+// ================================
+
+class Array2dPitchedIteratorTest : public ::testing::Test {
+protected:
+    // 3行2列，行距为4，每行末尾两个填充元素为-1
+    std::vector<int> storage_{1, 2, -1, -1, 3, 4, -1, -1, 5, 6, -1, -1};
+
+    Array2d_pitched_iterator<int> begin() { return {storage_.data(), 0, 2, 4}; }
+    Array2d_pitched_iterator<int> end() { return {storage_.data() + storage_.size(), 0, 2, 4}; }
+};
+
+TEST_F(Array2dPitchedIteratorTest, ForwardAndBackwardTraversal) {
+    std::vector<int> forward(begin(), end());
+    EXPECT_THAT(forward, ElementsAre(1, 2, 3, 4, 5, 6));
+
+    std::vector<int> backward;
+    for (auto it = end(); it != begin();) {
+        backward.push_back(*--it);
+    }
+    EXPECT_THAT(backward, ElementsAre(6, 5, 4, 3, 2, 1));
+}
+
+TEST_F(Array2dPitchedIteratorTest, RandomAccess) {
+    auto it = begin();
+    EXPECT_EQ(*(it + 3), 4);
+    EXPECT_EQ(it[5], 6);
+    EXPECT_EQ(*(end() - 1), 6);
+    EXPECT_EQ(*((it + 5) - 4), 2);
+    EXPECT_EQ(end() - begin(), 6);
+    EXPECT_EQ((it + 1) - (it + 4), -3);
+    EXPECT_EQ(it + 6, end());
+    EXPECT_TRUE(it + 1 < it + 2);
+    EXPECT_TRUE(it + 2 > it + 1);
+    EXPECT_EQ(2 + it, it + 2);
+
+    it += 4;
+    EXPECT_EQ(it.column(), 0);
+    EXPECT_EQ(it.row_data(), storage_.data() + 8);
+    it -= 3;
+    EXPECT_EQ(*it, 2);
+}
+
+TEST_F(Array2dPitchedIteratorTest, ConceptsAndConversion) {
+    static_assert(std::random_access_iterator<Array2d_pitched_iterator<int>>);
+    static_assert(std::random_access_iterator<Array2d_pitched_iterator<const int>>);
+    static_assert(!std::contiguous_iterator<Array2d_pitched_iterator<int>>);
+
+    Array2d_pitched_iterator<const int> const_it(begin() + 3);
+    EXPECT_EQ(*const_it, 4);
+    EXPECT_EQ(const_it.pitch(), 4);
+    EXPECT_EQ(const_it.columns(), 2);
+
+    EXPECT_EQ(std::accumulate(begin(), end(), 0), 21);
+    EXPECT_EQ(std::count(begin(), end(), -1), 0);
+}
+
+// ================================
+// 跨步迭代器测试
+// ================================
+
+class Array2dStridedIteratorTest : public ::testing::Test {
+protected:
+    // 3行4列，第1列为 2, 6, 10
+    std::vector<int> storage_{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+
+    Array2d_strided_iterator<int> begin() { return {storage_.data() + 1, 4}; }
+    Array2d_strided_iterator<int> end() { return begin() + 3; }
+};
+
+TEST_F(Array2dStridedIteratorTest, Traversal) {
+    std::vector<int> forward(begin(), end());
+    EXPECT_THAT(forward, ElementsAre(2, 6, 10));
+
+    std::vector<int> backward(std::make_reverse_iterator(end()), std::make_reverse_iterator(begin()));
+    EXPECT_THAT(backward, ElementsAre(10, 6, 2));
+}
+
+TEST_F(Array2dStridedIteratorTest, RandomAccess) {
+    auto it = begin();
+    EXPECT_EQ(it[2], 10);
+    EXPECT_EQ(*(end() - 1), 10);
+    EXPECT_EQ(end() - begin(), 3);
+    EXPECT_EQ(begin() - end(), -3);
+    EXPECT_EQ(1 + it, it + 1);
+    EXPECT_TRUE(it < it + 1);
+
+    it += 2;
+    EXPECT_EQ(it.base(), storage_.data() + 9);
+    it -= 1;
+    EXPECT_EQ(*it, 6);
+    EXPECT_EQ(it.stride(), 4);
+}
+
+TEST_F(Array2dStridedIteratorTest, EndStaysInsideStorage) {
+    // 最后一列的尾后位置只记录下标，不计算超出存储的地址
+    array2d_column<int> last(storage_.data() + 3, 3, 4);
+    EXPECT_EQ(last.end().first(), storage_.data() + 3);
+    EXPECT_EQ(last.end().index(), 3);
+    EXPECT_EQ(last.end() - last.begin(), 3);
+    EXPECT_THAT(std::vector<int>(last.begin(), last.end()), ElementsAre(4, 8, 12));
+
+    Array2d_strided_iterator<const int> it = last.end() - 1;
+    EXPECT_EQ(it.base(), storage_.data() + 11);
+    EXPECT_TRUE(it + 1 == last.end());
+}
+
+TEST_F(Array2dStridedIteratorTest, ConceptsAndRanges) {
+    static_assert(std::random_access_iterator<Array2d_strided_iterator<int>>);
+    static_assert(std::random_access_iterator<Array2d_strided_iterator<const int>>);
+    static_assert(!std::contiguous_iterator<Array2d_strided_iterator<int>>);
+    static_assert(std::ranges::random_access_range<array2d_column<int>>);
+    static_assert(std::ranges::sized_range<array2d_column<const int>>);
+
+    array2d_column<int> column(storage_.data() + 1, 3, 4);
+    std::ranges::reverse(column);
+    EXPECT_THAT(storage_, ElementsAre(1, 10, 3, 4, 5, 6, 7, 8, 9, 2, 11, 12));
+
+    array2d_column<const int> const_column = column;
+    EXPECT_EQ(const_column.size(), 3u);
+    EXPECT_EQ(*std::ranges::max_element(const_column), 10);
+}
@@ -0,0 +1,282 @@
+//
+// test_array2d_linalg.cpp
+//
+#include "array2d.hpp"
+#include "array2d_linalg.hpp"
+#include <cmath>
+#include <cstdint>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace qm;
+using ::testing::Each;
+using ::testing::ElementsAre;
+
+// ================================
+// 测试夹具类
+// ================================
+
+/**
+ * @brief 矩阵乘法测试夹具
+ */
+class Array2dMatmulTest : public ::testing::Test {
+protected:
+    /**
+     * @brief 用确定的小整数填充矩阵，使浮点乘加结果精确可比
+     */
+    template<typename M>
+    static void fill_pattern(M &&m, int seed) {
+        for (int i = 0; i < static_cast<int>(m.rows()); ++i) {
+            for (int j = 0; j < static_cast<int>(m.cols()); ++j) {
+                m(i, j) = static_cast<typename std::remove_cvref_t<M>::value_type>((i * 7 + j * 3 + seed) % 11 - 5);
+            }
+        }
+    }
+
+    /**
+     * @brief 朴素三重循环的参考实现
+     */
+    template<typename A, typename B, typename T>
+    static array2d<T> reference(const A &a, const B &b, const array2d<T> &c, T alpha, T beta) {
+        array2d<T> result(c.rows(), c.cols());
+        for (int i = 0; i < static_cast<int>(a.rows()); ++i) {
+            for (int j = 0; j < static_cast<int>(b.cols()); ++j) {
+                T acc{};
+                for (int p = 0; p < static_cast<int>(a.cols()); ++p) acc += a(i, p) * b(p, j);
+                result(i, j) = alpha * acc + beta * c(i, j);
+            }
+        }
+        return result;
+    }
+
+    template<typename T>
+    static void check_shapes(bool parallel) {
+        const int sizes[][3] = {{1, 1, 1},    {3, 5, 7},      {6, 8, 16},   {13, 17, 9},     {16, 16, 16},
+                                {16, 16, 17}, {97, 33, 50}, {100, 300, 45}, {7, 2100, 3}, {130, 70, 2050}};
+        for (const auto &size: sizes) {
+            array2d<T> a(size[0], size[1]);
+            array2d<T> b(size[1], size[2]);
+            array2d<T> c(size[0], size[2]);
+            fill_pattern(a, 1);
+            fill_pattern(b, 2);
+            fill_pattern(c, 3);
+
+            const auto expected = reference(a, b, c, T{2}, T{-1});
+            if (parallel) {
+                matmul_parallel(a, b, c, T{2}, T{-1});
+            } else {
+                matmul(a, b, c, T{2}, T{-1});
+            }
+            ASSERT_EQ(c, expected) << size[0] << "x" << size[1] << "x" << size[2];
+        }
+    }
+};
+
+// ================================
+// 正确性测试
+// ================================
+
+TEST_F(Array2dMatmulTest, SmallProduct) {
+    array2d<double> a{{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}};
+    array2d<double> b{{1.0, 0.0, -1.0}, {2.0, 1.0, 0.5}};
+    auto            c = matmul(a, b);
+    EXPECT_EQ(c.rows(), 3);
+    EXPECT_EQ(c.cols(), 3);
+    EXPECT_THAT(c, ElementsAre(5.0, 2.0, 0.0, 11.0, 4.0, -1.0, 17.0, 6.0, -2.0));
+}
+
+TEST_F(Array2dMatmulTest, AllShapesAndKernelTypes) {
+    check_shapes<double>(false);
+    check_shapes<float>(false);
+    check_shapes<std::int32_t>(false);
+    check_shapes<std::int64_t>(false);
+    check_shapes<std::int16_t>(false);
+}
+
+TEST_F(Array2dMatmulTest, ParallelMatchesSerial) {
+    check_shapes<double>(true);
+    check_shapes<float>(true);
+    check_shapes<std::int32_t>(true);
+}
+
+TEST_F(Array2dMatmulTest, AlphaBetaSemantics) {
+    array2d<double> a(4, 3, 1.0);
+    array2d<double> b(3, 5, 2.0);
+
+    // beta为0时不读取C，其中的NaN不会传播
+    array2d<double> c(4, 5, std::numeric_limits<double>::quiet_NaN());
+    matmul(a, b, c);
+    EXPECT_THAT(c, Each(6.0));
+
+    matmul(a, b, c, 0.5, 2.0);
+    EXPECT_THAT(c, Each(15.0));
+
+    // alpha为0或k为0时只缩放C
+    matmul(a, b, c, 0.0, 2.0);
+    EXPECT_THAT(c, Each(30.0));
+
+    array2d<double> empty_a(4, 0);
+    array2d<double> empty_b(0, 5);
+    matmul(empty_a, empty_b, c, 1.0, 0.0);
+    EXPECT_THAT(c, Each(0.0));
+}
+
+// ================================
+// 布局和视图测试
+// ================================
+
+TEST_F(Array2dMatmulTest, PitchedAndViewOperands) {
+    pitched_array2d<float> a(37, 29);
+    array2d<float>         b(40, 50);
+    fill_pattern(a, 4);
+    fill_pattern(b, 5);
+
+    // 输出写入视图，视图外的元素保持不变
+    array2d<float> c(40, 60, 100.0f);
+    auto           lhs    = a.submatrix(2, 3, 30, 20);
+    auto           rhs    = b.submatrix(10, 5, 20, 41);
+    array2d<float> zeros(30, 41, 0.0f);
+    const auto     expected = reference(lhs, rhs, zeros, 1.0f, 0.0f);
+
+    matmul(lhs, rhs, c.submatrix(5, 7, 30, 41));
+    for (int i = 0; i < c.rows(); ++i) {
+        for (int j = 0; j < c.cols(); ++j) {
+            const bool inside = i >= 5 && i < 35 && j >= 7 && j < 48;
+            ASSERT_EQ(c(i, j), inside ? expected(i - 5, j - 7) : 100.0f) << i << ", " << j;
+        }
+    }
+}
+
+TEST_F(Array2dMatmulTest, InvalidArgumentsThrow) {
+    array2d<double> a(3, 4);
+    array2d<double> b(5, 2);
+    array2d<double> c(3, 2);
+    EXPECT_THROW(matmul(a, b, c), std::invalid_argument);
+    EXPECT_THROW((void) matmul(a, b), std::invalid_argument);
+
+    array2d<double> b2(4, 2);
+    array2d<double> wrong(2, 3);
+    EXPECT_THROW(matmul(a, b2, wrong), std::invalid_argument);
+
+    // 输出与输入重叠
+    array2d<double> square(4, 4, 1.0);
+    EXPECT_THROW(matmul(square, square, square), std::invalid_argument);
+    EXPECT_THROW(matmul(square.submatrix(0, 0, 2, 4), square, square.submatrix(2, 0, 2, 4)), std::invalid_argument);
+}
+
+TEST_F(Array2dMatmulTest, ResultKeepsOperandIndexType) {
+    array2d<double, std::int64_t> a(2, 3, 1.0);
+    array2d<double, std::int64_t> b(3, 4, 2.0);
+    auto                          c = matmul(a, b);
+    static_assert(std::same_as<decltype(c), array2d<double, std::int64_t>>);
+    EXPECT_EQ(c.rows(), 2);
+    EXPECT_THAT(c, Each(6.0));
+
+    // B的列数超出A的索引类型
+    array2d<double, std::int16_t> narrow(2, 1, 1.0);
+    array2d<double, std::int64_t> wide(1, 40000, 1.0);
+    EXPECT_THROW((void) matmul(narrow, wide), std::overflow_error);
+    EXPECT_THROW((void) matmul_parallel(narrow, wide), std::overflow_error);
+}
+
+// ================================
+// 矩阵-向量乘法测试
+// ================================
+
+/**
+ * @brief 矩阵-向量乘法测试夹具
+ */
+class Array2dGemvTest : public ::testing::Test {
+protected:
+    template<typename T>
+    static void check_shapes(bool parallel) {
+        const int sizes[][2] = {{1, 1}, {3, 7}, {17, 33}, {200, 61}, {64, 1500}, {150, 2500}};
+        for (const auto &size: sizes) {
+            array2d<T> a(size[0], size[1]);
+            for (int i = 0; i < a.rows(); ++i) {
+                for (int j = 0; j < a.cols(); ++j) a(i, j) = static_cast<T>((i * 5 + j * 3) % 9 - 4);
+            }
+            std::vector<T> x(static_cast<std::size_t>(a.cols()));
+            std::vector<T> w(static_cast<std::size_t>(a.rows()));
+            for (std::size_t j = 0; j < x.size(); ++j) x[j] = static_cast<T>(j % 5) - T{2};
+            for (std::size_t i = 0; i < w.size(); ++i) w[i] = static_cast<T>(i % 3) + T{1};
+
+            std::vector<T> y(w.size(), T{1});
+            std::vector<T> z(x.size(), T{1});
+            std::vector<T> expected_y(w.size());
+            std::vector<T> expected_z(x.size());
+            for (int i = 0; i < a.rows(); ++i) {
+                for (int j = 0; j < a.cols(); ++j) {
+                    expected_y[i] += a(i, j) * x[j];
+                    expected_z[j] += w[i] * a(i, j);
+                }
+            }
+            for (auto &v: expected_y) v = T{2} * v + T{3};
+            for (auto &v: expected_z) v = T{2} * v + T{3};
+
+            if (parallel) {
+                gemv_parallel(a, std::span<const T>(x), std::span(y), T{2}, T{3});
+                gevm_parallel(std::span<const T>(w), a, std::span(z), T{2}, T{3});
+            } else {
+                gemv(a, std::span<const T>(x), std::span(y), T{2}, T{3});
+                gevm(std::span<const T>(w), a, std::span(z), T{2}, T{3});
+            }
+            ASSERT_EQ(y, expected_y) << size[0] << "x" << size[1];
+            ASSERT_EQ(z, expected_z) << size[0] << "x" << size[1];
+        }
+    }
+};
+
+TEST_F(Array2dGemvTest, SmallProducts) {
+    array2d<double>     a{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+    std::vector<double> x{1.0, 0.0, -1.0};
+    std::vector<double> w{2.0, 1.0};
+
+    EXPECT_THAT(gemv(a, x), ElementsAre(-2.0, -2.0));
+    EXPECT_THAT(gevm(w, a), ElementsAre(6.0, 9.0, 12.0));
+}
+
+TEST_F(Array2dGemvTest, AllShapesAndTypes) {
+    check_shapes<double>(false);
+    check_shapes<float>(false);
+    check_shapes<int>(false);
+}
+
+TEST_F(Array2dGemvTest, ParallelMatchesSerial) {
+    check_shapes<double>(true);
+    check_shapes<float>(true);
+    check_shapes<std::int64_t>(true);
+}
+
+TEST_F(Array2dGemvTest, ViewOperandsAndBetaZero) {
+    pitched_array2d<double> a(6, 20, 1.0);
+    auto                    block = a.submatrix(1, 2, 4, 10);
+    std::vector<double>     x(10, 0.5);
+    std::vector<double>     y(4, std::numeric_limits<double>::quiet_NaN());
+
+    // beta为0时不读取y，其中的NaN不会传播
+    gemv(block, x, y);
+    EXPECT_THAT(y, Each(5.0));
+
+    std::vector<double> z(10, std::numeric_limits<double>::quiet_NaN());
+    gevm(y, block, z);
+    EXPECT_THAT(z, Each(20.0));
+}
+
+TEST_F(Array2dGemvTest, InvalidArgumentsThrow) {
+    array2d<double>     a(3, 4, 1.0);
+    std::vector<double> x(4), y(3), wrong(5);
+    EXPECT_THROW(gemv(a, wrong, y), std::invalid_argument);
+    EXPECT_THROW(gemv(a, x, std::span(wrong)), std::invalid_argument);
+    EXPECT_THROW(gevm(x, a, std::span(y)), std::invalid_argument);
+    EXPECT_THROW((void) gevm(x, a), std::invalid_argument);
+
+    // 输出与输入重叠
+    EXPECT_THROW(gemv(a, x, a.row(0).first(3)), std::invalid_argument);
+    std::vector<double> shared(4, 1.0);
+    array2d<double>     square(4, 4, 1.0);
+    EXPECT_THROW(gemv(square, shared, std::span(shared)), std::invalid_argument);
+}
@@ -0,0 +1,226 @@
+//
+// test_array2d_parallel.cpp
+//
+#include "array2d.hpp"
+#include "array2d_parallel.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace qm;
+using ::testing::Each;
+
+// ================================
+// 测试夹具类
+// ================================
+
+/**
+ * @brief 线程池与并行循环测试夹具
+ */
+class Array2dParallelTest : public ::testing::Test {
+protected:
+    thread_pool pool_{4};
+
+    void TearDown() override { configure_thread_pool(0); }
+};
+
+// ================================
+// thread_pool
+// ================================
+
+TEST_F(Array2dParallelTest, PoolSizeIncludesCaller) {
+    EXPECT_EQ(pool_.size(), 4u);
+    EXPECT_FALSE(pool_.pinned());
+
+    thread_pool single(1);
+    EXPECT_EQ(single.size(), 1u);
+}
+
+TEST_F(Array2dParallelTest, RunExecutesEachTaskOnce) {
+    std::vector<std::atomic<int>> hits(1000);
+    for (int round = 0; round < 20; ++round) {
+        pool_.run(hits.size(), [&](std::size_t task) { hits[task].fetch_add(1, std::memory_order_relaxed); });
+    }
+    for (const auto &hit: hits) EXPECT_EQ(hit.load(), 20);
+
+    pool_.run(0, [](std::size_t) { FAIL(); });
+}
+
+TEST_F(Array2dParallelTest, NestedRunExecutesInline) {
+    std::atomic<int> total{0};
+    pool_.run(8, [&](std::size_t) {
+        pool_.run(8, [&](std::size_t) { total.fetch_add(1, std::memory_order_relaxed); });
+    });
+    EXPECT_EQ(total.load(), 64);
+}
+
+TEST_F(Array2dParallelTest, RunPropagatesFirstException) {
+    EXPECT_THROW(pool_.run(100,
+                           [](std::size_t task) {
+                               if (task == 42) throw std::runtime_error("task failed");
+                           }),
+                 std::runtime_error);
+
+    // 异常之后线程池仍可继续使用
+    std::atomic<int> count{0};
+    pool_.run(100, [&](std::size_t) { count.fetch_add(1, std::memory_order_relaxed); });
+    EXPECT_EQ(count.load(), 100);
+}
+
+TEST_F(Array2dParallelTest, PinnedPoolRuns) {
+    thread_pool pinned(3, true);
+    EXPECT_TRUE(pinned.pinned());
+
+    std::atomic<int> count{0};
+    pinned.run(50, [&](std::size_t) { count.fetch_add(1, std::memory_order_relaxed); });
+    EXPECT_EQ(count.load(), 50);
+}
+
+// ================================
+// 默认线程池
+// ================================
+
+TEST_F(Array2dParallelTest, ConfigureDefaultPool) {
+    configure_thread_pool(3);
+    EXPECT_EQ(default_thread_pool().size(), 3u);
+
+    array2d<double> m(300, 300);
+    m.fill_parallel(2.0);
+    EXPECT_THAT(m, Each(2.0));
+    EXPECT_DOUBLE_EQ(m.sum_parallel(), 2.0 * 300 * 300);
+}
+
+TEST_F(Array2dParallelTest, FillParallelMayThrow) {
+    // 首次使用默认线程池可能因创建线程失败而抛出，不能声明为noexcept
+    array2d<double> m(2, 2);
+    static_assert(!noexcept(m.fill_parallel(0.0)));
+    m.fill_parallel(1.0);
+    EXPECT_THAT(m, Each(1.0));
+}
+
+TEST_F(Array2dParallelTest, SumParallelChunkBoundsPast32Bits) {
+    // 元素数 * 分块数 > 2^32，分块边界必须在64位中计算
+    configure_thread_pool(32);
+    array2d<int> m(6000, 6000, 1);
+    EXPECT_EQ(m.sum_parallel(), 6000 * 6000);
+}
+
+TEST_F(Array2dParallelTest, TransposeParallelRectangularPast32Bits) {
+    // 元素数 * 分块数 > 2^32，跳过的区间会使部分循环未被旋转
+    configure_thread_pool(32);
+    array2d<int> m(5003, 7001);
+    std::iota(m.begin(), m.end(), 0);
+    m.transpose_parallel();
+    ASSERT_EQ(m.rows(), 7001);
+    ASSERT_EQ(m.cols(), 5003);
+    for (int i = 0; i < m.rows(); ++i) {
+        for (int j = 0; j < m.cols(); ++j) ASSERT_EQ(m(i, j), j * 7001 + i);
+    }
+}
+
+// ================================
+// parallel_for_rows / parallel_for_tiles
+// ================================
+
+TEST_F(Array2dParallelTest, ForRowsCoversEachRowOnce) {
+    array2d<int> m(517, 33, 0);
+    parallel_for_rows(m.rows(), [&](int first, int last) {
+        ASSERT_LT(first, last);
+        for (int i = first; i < last; ++i) {
+            for (int j = 0; j < m.cols(); ++j) m(i, j) += i;
+        }
+    });
+    for (int i = 0; i < m.rows(); ++i) {
+        for (int j = 0; j < m.cols(); ++j) ASSERT_EQ(m(i, j), i);
+    }
+
+    parallel_for_rows(0, [](int, int) { FAIL(); });
+}
+
+TEST_F(Array2dParallelTest, ForRowsRespectsGrain) {
+    configure_thread_pool(4);
+
+    std::vector<std::atomic<int>> hits(1001);
+    std::atomic<bool>             oversized{false};
+    parallel_for_rows(1001, [&](int first, int last) {
+        if (last - first > 7) oversized = true;
+        for (int i = first; i < last; ++i) hits[i].fetch_add(1, std::memory_order_relaxed);
+    }, 7);
+    EXPECT_FALSE(oversized.load());
+    for (const auto &hit: hits) EXPECT_EQ(hit.load(), 1);
+}
+
+TEST_F(Array2dParallelTest, ForRowsBalancesIrregularRows) {
+    configure_thread_pool(4);
+
+    // 后1/4的行开销远大于前面的行，静态划分时全部落在同一个线程上
+    array2d<int>     m(256, 8, 0);
+    std::atomic<int> calls{0};
+    parallel_for_rows(m, [&](int first, int last) {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        for (int i = first; i < last; ++i) {
+            if (i >= 192) std::this_thread::sleep_for(std::chrono::microseconds(50));
+            for (int j = 0; j < m.cols(); ++j) m(i, j) = i;
+        }
+    }, 1);
+    EXPECT_EQ(calls.load(), 256);
+    for (int i = 0; i < m.rows(); ++i) EXPECT_THAT(m.row(i), Each(i));
+}
+
+TEST_F(Array2dParallelTest, ForRowsAcceptsUnsignedAndViews) {
+    configure_thread_pool(3);
+
+    std::vector<std::atomic<int>> hits(50);
+    parallel_for_rows(std::size_t{50}, [&](std::size_t first, std::size_t last) {
+        for (auto i = first; i < last; ++i) hits[i].fetch_add(1, std::memory_order_relaxed);
+    });
+    for (const auto &hit: hits) EXPECT_EQ(hit.load(), 1);
+
+    array2d<int> m(40, 40, 0);
+    auto         view = m.submatrix(10, 0, 20, 40);
+    parallel_for_rows(view, [&](int first, int last) {
+        for (int i = first; i < last; ++i) view(i, 0) = 1;
+    });
+    EXPECT_EQ(m.sum(), 20);
+}
+
+TEST_F(Array2dParallelTest, ForTilesCoversEachElementOnce) {
+    array2d<int> m(130, 70, 0);
+    parallel_for_tiles(m.rows(), m.cols(), 32, 16, [&](int r0, int r1, int c0, int c1) {
+        EXPECT_LE(r1 - r0, 32);
+        EXPECT_LE(c1 - c0, 16);
+        for (int i = r0; i < r1; ++i) {
+            for (int j = c0; j < c1; ++j) ++m(i, j);
+        }
+    });
+    EXPECT_THAT(m, Each(1));
+}
+
+TEST_F(Array2dParallelTest, ForTilesRejectsEmptyTile) {
+    EXPECT_THROW(parallel_for_tiles(10, 10, 0, 4, [](int, int, int, int) {}), std::invalid_argument);
+    EXPECT_THROW(parallel_for_tiles(10, 10, 4, -1, [](int, int, int, int) {}), std::invalid_argument);
+}
+
+TEST_F(Array2dParallelTest, ForRowsPropagatesException) {
+    EXPECT_THROW(parallel_for_rows(100000,
+                                   [](int first, int) {
+                                       if (first > 0) throw std::out_of_range("row");
+                                   }),
+                 std::out_of_range);
+
+    configure_thread_pool(4);
+    std::atomic<int> calls{0};
+    EXPECT_THROW(parallel_for_rows(100000,
+                                   [&](int, int) {
+                                       calls.fetch_add(1, std::memory_order_relaxed);
+                                       throw std::out_of_range("row");
+                                   }, 1),
+                 std::out_of_range);
+    EXPECT_LE(calls.load(), 4);
+}
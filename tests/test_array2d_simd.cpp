@@ -0,0 +1,261 @@
+//
+// test_array2d_simd.cpp
+//
+#include "array2d.hpp"
+#include "array2d_simd.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+
+using namespace qm;
+using ::testing::Each;
+
+namespace {
+
+    /**
+     * @brief 16字节的可平凡复制类型
+     */
+    struct Pair {
+        double first;
+        double second;
+
+        bool operator==(const Pair &) const = default;
+    };
+
+    /**
+     * @brief 获取不高于检测结果的所有指令集级别
+     */
+    std::vector<simd::isa> available_isas() {
+        std::vector<simd::isa> result{simd::isa::scalar};
+        for (auto level: {simd::isa::sse2, simd::isa::avx2, simd::isa::avx512}) {
+            if (level <= simd::detected_isa()) result.push_back(level);
+        }
+        return result;
+    }
+
+}  // namespace
+
+// ================================
+// 填充内核测试
+// ================================
+
+class Array2dSimdFillTest : public ::testing::Test {
+protected:
+    static constexpr std::size_t  guard_ = 80;
+    std::vector<unsigned char>    buffer_ = std::vector<unsigned char>(4096, 0xCD);
+    std::array<unsigned char, 16> pattern_{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+    /**
+     * @brief 验证[offset, offset + bytes)按模式写入，且前后guard_字节的保护区未被改动
+     */
+    void expect_filled(std::size_t offset, std::size_t bytes, std::size_t pattern_size) {
+        const auto last = std::min(buffer_.size(), offset + bytes + guard_);
+        for (std::size_t i = offset - guard_; i < last; ++i) {
+            const bool inside   = i >= offset && i < offset + bytes;
+            const auto expected = inside ? pattern_[(i - offset) % pattern_size] : 0xCD;
+            ASSERT_EQ(buffer_[i], expected) << "offset " << offset << ", bytes " << bytes << ", index " << i;
+        }
+    }
+};
+
+TEST_F(Array2dSimdFillTest, AllIsasPatternsOffsetsAndLengths) {
+    for (auto level: available_isas()) {
+        for (std::size_t pattern_size: {1u, 2u, 4u, 8u, 16u}) {
+            for (std::size_t offset = guard_; offset < guard_ + 64; offset += pattern_size) {
+                for (std::size_t count: {0u, 1u, 3u, 17u, 64u, 65u, 200u}) {
+                    for (bool streaming: {false, true}) {
+                        std::ranges::fill(buffer_, 0xCD);
+                        const auto bytes = count * pattern_size;
+                        simd::fill_pattern(level, buffer_.data() + offset, bytes, pattern_.data(), pattern_size,
+                                           streaming);
+                        expect_filled(offset, bytes, pattern_size);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_F(Array2dSimdFillTest, TypedHelpers) {
+    std::vector<std::uint16_t> shorts(333, 0);
+    simd::fill(shorts.data() + 1, 331, std::uint16_t{0xBEEF});
+    EXPECT_EQ(shorts.front(), 0);
+    EXPECT_EQ(shorts.back(), 0);
+    EXPECT_EQ(std::count(shorts.begin(), shorts.end(), 0xBEEF), 331);
+
+    std::vector<int> ints(100, 0);
+    simd::fill_bytes(ints.data(), 0x3F, ints.size() * sizeof(int));
+    EXPECT_THAT(ints, Each(0x3F3F3F3F));
+
+    static_assert(simd::Fill_pattern_type<Pair>);
+    static_assert(!simd::Fill_pattern_type<std::array<char, 3>>);
+}
+
+// ================================
+// array2d 集成测试
+// ================================
+
+TEST_F(Array2dSimdFillTest, ResetOptions) {
+    array2d<int> matrix(37, 29, 5);
+
+    matrix.reset(Array_reset_opt::Safe_max);
+    EXPECT_THAT(matrix, Each(0x3F3F3F3F));
+
+    matrix.reset(Array_reset_opt::All_bits1);
+    EXPECT_THAT(matrix, Each(-1));
+
+    matrix.reset();
+    EXPECT_THAT(matrix, Each(0));
+}
+
+TEST_F(Array2dSimdFillTest, FillPatternTypes) {
+    array2d<Pair> pairs(13, 7);
+    pairs.fill(Pair{1.5, -2.5});
+    EXPECT_THAT(pairs, Each(Pair{1.5, -2.5}));
+
+    array2d<std::int16_t> shorts(5, 11);
+    shorts.fill(-3);
+    EXPECT_THAT(shorts, Each(-3));
+
+    // 超过流式写入阈值
+    array2d<double> large(static_cast<int>(simd::streaming_threshold / sizeof(double) / 1024) + 1, 1024);
+    large.fill(0.25);
+    EXPECT_EQ(std::ranges::count(large, 0.25), static_cast<std::ptrdiff_t>(large.size()));
+    large.reset(Array_reset_opt::Safe_max);
+    double safe_max;
+    std::memset(&safe_max, 0x3F, sizeof(safe_max));
+    EXPECT_THAT(large, Each(safe_max));
+}
+
+TEST_F(Array2dSimdFillTest, ViewFillKeepsOutsideElements) {
+    array2d<float> matrix(6, 40, 1.0f);
+    matrix.submatrix(1, 3, 4, 33).fill(2.0f);
+
+    EXPECT_EQ(std::ranges::count(matrix, 2.0f), 4 * 33);
+    EXPECT_THAT(matrix.row(0), Each(1.0f));
+    EXPECT_EQ(matrix(1, 2), 1.0f);
+    EXPECT_EQ(matrix(1, 36), 1.0f);
+    EXPECT_EQ(matrix(4, 35), 2.0f);
+}
+
+// ================================
+// 归约内核测试
+// ================================
+
+class Array2dSimdReduceTest : public ::testing::Test {};
+
+TEST_F(Array2dSimdReduceTest, KernelsMatchScalarForAllLengths) {
+    std::vector<double> doubles(700);
+    std::vector<float>  floats(700);
+    for (std::size_t i = 0; i < doubles.size(); ++i) {
+        doubles[i] = static_cast<double>((i * 37) % 101) - 50.0;
+        floats[i]  = static_cast<float>(doubles[i]);
+    }
+
+    for (std::size_t offset: {0u, 1u, 3u}) {
+        for (std::size_t n = 1; n + offset <= doubles.size(); n += 13) {
+            const auto *d = doubles.data() + offset;
+            const auto *f = floats.data() + offset;
+            const auto  expected = std::accumulate(d, d + n, 0.0);
+            const auto  minmax   = std::minmax_element(d, d + n);
+
+            EXPECT_EQ(simd::sum(d, n), expected) << n;
+            EXPECT_EQ(simd::sum_kahan(d, n), expected) << n;
+            EXPECT_EQ(simd::sum_pairwise(d, n), expected) << n;
+            EXPECT_EQ(simd::sum(f, n), static_cast<float>(expected)) << n;
+            EXPECT_EQ(simd::sum_kahan(f, n), static_cast<float>(expected)) << n;
+            EXPECT_EQ(simd::min(d, n), *minmax.first) << n;
+            EXPECT_EQ(simd::max(f, n), static_cast<float>(*minmax.second)) << n;
+            EXPECT_EQ(simd::argmin(d, n), static_cast<std::size_t>(minmax.first - d)) << n;
+            EXPECT_EQ(simd::argmax(f, n), static_cast<std::size_t>(std::max_element(f, f + n) - f)) << n;
+        }
+    }
+}
+
+TEST_F(Array2dSimdReduceTest, KahanCompensatesAcrossLanes) {
+    std::vector<float> values(4096, 1e-4f);
+    values[0] = 1e4f;
+    const double expected = 1e4 + 4095 * 1e-4;
+    EXPECT_NEAR(simd::sum_kahan(values.data(), values.size()), expected, 1e-3);
+
+    std::vector<int> ints{5, -2, 7};
+    EXPECT_EQ(simd::sum_kahan(ints.data(), ints.size()), 10);
+    EXPECT_EQ(simd::argmax(ints.data(), ints.size()), 2u);
+}
+
+// ================================
+// 转置内核测试
+// ================================
+
+class Array2dSimdTransposeTest : public ::testing::Test {};
+
+TEST_F(Array2dSimdTransposeTest, StridedBlocks) {
+    // 在带行距的缓冲区中转置子块，验证块外元素不被改动
+    constexpr std::size_t rows = 37, cols = 90, src_stride = 101, dst_stride = 43;
+    std::vector<std::uint32_t> src(rows * src_stride);
+    std::iota(src.begin(), src.end(), 0u);
+    std::vector<std::uint32_t> dst(cols * dst_stride, 0xFFFFFFFFu);
+
+    simd::transpose(src.data(), src_stride, dst.data(), dst_stride, rows, cols);
+    for (std::size_t j = 0; j < cols; ++j) {
+        for (std::size_t i = 0; i < dst_stride; ++i) {
+            const auto expected = i < rows ? src[i * src_stride + j] : 0xFFFFFFFFu;
+            ASSERT_EQ(dst[j * dst_stride + i], expected) << i << ", " << j;
+        }
+    }
+}
+
+// ================================
+// 交换内核测试
+// ================================
+
+class Array2dSimdSwapTest : public ::testing::Test {};
+
+TEST_F(Array2dSimdSwapTest, SwapBytesAllLengths) {
+    for (std::size_t bytes: {0u, 1u, 31u, 32u, 63u, 64u, 65u, 200u}) {
+        std::vector<unsigned char> a(bytes + 2, 0xAA);
+        std::vector<unsigned char> b(bytes + 2, 0xBB);
+        simd::swap_bytes(a.data() + 1, b.data() + 1, bytes);
+        EXPECT_EQ(a.front(), 0xAA);
+        EXPECT_EQ(a.back(), 0xAA);
+        EXPECT_EQ(std::count(a.begin(), a.end(), 0xBB), static_cast<std::ptrdiff_t>(bytes));
+        EXPECT_EQ(std::count(b.begin(), b.end(), 0xAA), static_cast<std::ptrdiff_t>(bytes));
+    }
+}
+
+// ================================
+// 点积和AXPY内核测试
+// ================================
+
+class Array2dSimdDotTest : public ::testing::Test {};
+
+TEST_F(Array2dSimdDotTest, DotAndAxpyAllLengths) {
+    for (std::size_t n = 0; n < 80; n += 7) {
+        std::vector<double> a(n), b(n), y(n + 1, 1.0);
+        std::vector<float>  af(n), yf(n + 1, 1.0f);
+        double              expected = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            a[i]  = static_cast<double>(i % 7) - 3.0;
+            b[i]  = static_cast<double>(i % 5);
+            af[i] = static_cast<float>(a[i]);
+            expected += a[i] * b[i];
+        }
+        EXPECT_EQ(simd::dot(a.data(), b.data(), n), expected) << n;
+
+        simd::axpy(2.0, a.data(), y.data(), n);
+        simd::axpy(2.0f, af.data(), yf.data(), n);
+        for (std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(y[i], 1.0 + 2.0 * a[i]) << i;
+            ASSERT_EQ(yf[i], static_cast<float>(y[i])) << i;
+        }
+        EXPECT_EQ(y[n], 1.0);
+    }
+
+    std::vector<int> ints{1, 2, 3};
+    EXPECT_EQ(simd::dot(ints.data(), ints.data(), ints.size()), 14);
+}
@@ -0,0 +1,245 @@
+//
+// test_array2d_stencil.cpp
+//
+#include "array2d.hpp"
+#include "array2d_stencil.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace qm;
+using ::testing::Each;
+using ::testing::ElementsAre;
+
+// ================================
+// 测试夹具类
+// ================================
+
+/**
+ * @brief 模板运算测试夹具
+ */
+class Array2dStencilTest : public ::testing::Test {
+protected:
+    static constexpr Array_border_opt modes_[] = {Array_border_opt::Clamp, Array_border_opt::Wrap,
+                                                  Array_border_opt::Reflect, Array_border_opt::Constant};
+
+    /**
+     * @brief 按行优先顺序写入0..12的伪随机整数像素
+     *
+     * 像素和抽头都是小整数时，任意核尺寸下的加权和在float中也能精确表示，
+     * 因此结果可以与double参考实现逐位比较，且不受抽头求和顺序的影响。
+     */
+    template<typename M>
+    static void fill_pixels(M &m, int seed) {
+        int state = seed;
+        std::ranges::generate(m, [&state] {
+            state = (state * 5 + 3) % 13;
+            return static_cast<typename M::value_type>(state);
+        });
+    }
+
+    /**
+     * @brief 逐像素映射边界的参考实现
+     */
+    static int reference_index(int i, int n, Array_border_opt mode) {
+        if (i >= 0 && i < n) return i;
+        switch (mode) {
+            case Array_border_opt::Clamp:
+                return i < 0 ? 0 : n - 1;
+            case Array_border_opt::Wrap:
+                return ((i % n) + n) % n;
+            case Array_border_opt::Reflect:
+                if (n == 1) return 0;
+                while (i < 0 || i >= n) i = i < 0 ? -i : 2 * (n - 1) - i;
+                return i;
+            default:
+                return -1;
+        }
+    }
+
+    template<typename S, typename K>
+    static array2d<double> reference(const S &src, const K &kernel, Array_border_opt mode, double border) {
+        const int       rows = static_cast<int>(src.rows()), cols = static_cast<int>(src.cols());
+        const int       kh = static_cast<int>(kernel.rows()), kw = static_cast<int>(kernel.cols());
+        array2d<double> result(rows, cols);
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
+                double acc = 0.0;
+                for (int u = 0; u < kh; ++u) {
+                    for (int v = 0; v < kw; ++v) {
+                        const int r = reference_index(i + u - kh / 2, rows, mode);
+                        const int c = reference_index(j + v - kw / 2, cols, mode);
+                        acc += kernel(u, v) * (r < 0 || c < 0 ? border : static_cast<double>(src(r, c)));
+                    }
+                }
+                result(i, j) = acc;
+            }
+        }
+        return result;
+    }
+
+    template<typename M>
+    static void expect_matches(const M &actual, const array2d<double> &expected, const char *what) {
+        for (int i = 0; i < expected.rows(); ++i) {
+            for (int j = 0; j < expected.cols(); ++j) {
+                ASSERT_EQ(static_cast<double>(actual(i, j)), expected(i, j)) << what << " at " << i << ", " << j;
+            }
+        }
+    }
+};
+
+// ================================
+// 正确性测试
+// ================================
+
+TEST_F(Array2dStencilTest, BoxBlur) {
+    array2d<float> image{{0, 0, 0, 0}, {0, 9, 9, 0}, {0, 9, 9, 0}};
+    array2d<float> box(3, 3, 1.0f / 9.0f);
+    auto           blurred = stencil(image, box, Array_border_opt::Constant);
+    EXPECT_NEAR(blurred(1, 1), 4.0f, 1e-5f);
+    EXPECT_NEAR(blurred(0, 0), 1.0f, 1e-5f);
+    EXPECT_NEAR(blurred(2, 3), 2.0f, 1e-5f);
+}
+
+TEST_F(Array2dStencilTest, ZeroTapPropagatesNaN) {
+    // 零抽头下的NaN也参与乘加，通用内核与FMA内核结果一致
+    const float  nan       = std::numeric_limits<float>::quiet_NaN();
+    const float  row[]     = {1.0f, nan, 1.0f, 1.0f};
+    const float *rows[]    = {row};
+    const float  weights[] = {1.0f, 0.0f, 1.0f};
+    float        out[2];
+    simd::detail::correlate_rows_generic(rows, 1, weights, 3, out, 2, false);
+    EXPECT_TRUE(std::isnan(out[0]));
+    EXPECT_TRUE(std::isnan(out[1]));
+
+    array2d<float> image{{0, 0, 0}, {0, nan, 0}, {0, 0, 0}};
+    array2d<float> sobel{{-1, 0, 1}, {-2, 0, 2}, {-1, 0, 1}};
+    auto           edges = stencil(image, sobel, Array_border_opt::Constant);
+    EXPECT_TRUE(std::isnan(edges(1, 1)));
+}
+
+TEST_F(Array2dStencilTest, AllBorderModesAndKernelShapes) {
+    const int kernel_sizes[][2] = {{1, 1}, {3, 3}, {5, 3}, {1, 7}, {4, 4}, {9, 9}};
+    const int image_sizes[][2]  = {{1, 1}, {2, 5}, {17, 29}, {40, 300}};
+    for (const auto &ks: kernel_sizes) {
+        array2d<double> kernel(ks[0], ks[1]);
+        fill_pixels(kernel, 5);
+        kernel(0, 0) = -3.0;
+        for (const auto &is: image_sizes) {
+            array2d<double> image(is[0], is[1]);
+            fill_pixels(image, 1);
+            for (auto mode: modes_) {
+                array2d<double> out(is[0], is[1]);
+                stencil(image, out, kernel, mode, 2.0);
+                expect_matches(out, reference(image, kernel, mode, 2.0), "dense");
+                if (HasFatalFailure()) return;
+            }
+        }
+    }
+}
+
+TEST_F(Array2dStencilTest, SeparableMatchesOuterProduct) {
+    const std::vector<std::vector<float>> kernels = {{1.0f}, {1.0f, 2.0f, 1.0f}, {-1.0f, 0.0f, 1.0f}, {1, 4, 6, 4, 1}, {2, -1}};
+    pitched_array2d<float>                image(37, 61);
+    fill_pixels(image, 3);
+
+    for (const auto &h: kernels) {
+        for (const auto &v: kernels) {
+            array2d<double> outer(static_cast<int>(v.size()), static_cast<int>(h.size()));
+            for (int u = 0; u < outer.rows(); ++u) {
+                for (int w = 0; w < outer.cols(); ++w) outer(u, w) = v[u] * h[w];
+            }
+            for (auto mode: modes_) {
+                array2d<float> out(37, 61);
+                stencil_separable(image, out, h, v, mode, 1.0f);
+                expect_matches(out, reference(image, outer, mode, 1.0), "separable");
+                if (HasFatalFailure()) return;
+            }
+        }
+    }
+}
+
+TEST_F(Array2dStencilTest, IntegerOutputRoundsAndSaturates) {
+    array2d<std::uint8_t> image{{0, 0, 0}, {0, 200, 0}, {0, 0, 0}};
+
+    // 浮点权重：四舍五入并饱和到[0, 255]
+    array2d<float> gain{{1.5f}};
+    EXPECT_THAT(stencil(image, gain), ElementsAre(0, 0, 0, 0, 255, 0, 0, 0, 0));
+    array2d<float> third{{1.0f / 3.0f}};
+    EXPECT_EQ(stencil(image, third)(1, 1), 67);
+
+    // 整数权重（Sobel）：负值饱和到0
+    array2d<int> sobel_x{{-1, 0, 1}, {-2, 0, 2}, {-1, 0, 1}};
+    auto         gx = stencil(image, sobel_x, Array_border_opt::Constant);
+    EXPECT_THAT(gx.row(1), ElementsAre(255, 0, 0));
+
+    array2d<int> signed_gx(3, 3);
+    array2d<int> as_int(3, 3);
+    std::ranges::copy(image, as_int.begin());
+    stencil(as_int, signed_gx, sobel_x, Array_border_opt::Constant);
+    EXPECT_THAT(signed_gx.row(1), ElementsAre(400, 0, -400));
+
+    // uint8权重：在放宽的类型中累加后再饱和，而不是按uint8回绕
+    array2d<std::uint8_t, std::int64_t> bright(3, 3, 200);
+    array2d<std::uint8_t>               box(3, 3, 1);
+    auto                                sum = stencil(bright, box);
+    static_assert(std::same_as<decltype(sum), array2d<std::uint8_t, std::int64_t>>);
+    EXPECT_THAT(sum, Each(255));
+    std::vector<std::uint8_t> ones{1, 1, 1};
+    array2d<std::uint8_t>     separable(3, 3);
+    stencil_separable(bright, separable, ones, ones);
+    EXPECT_THAT(separable, Each(255));
+}
+
+// ================================
+// 布局、视图和并行测试
+// ================================
+
+TEST_F(Array2dStencilTest, ViewsAndParallel) {
+    array2d<float> image(300, 520);
+    fill_pixels(image, 7);
+    array2d<float> kernel(5, 5);
+    fill_pixels(kernel, 2);
+
+    // 源为视图时，边界模式作用于视图的边界，而不是底层矩阵
+    auto source   = image.submatrix(10, 20, 250, 400);
+    auto expected = reference(source, kernel, Array_border_opt::Reflect, 0.0);
+
+    array2d<float> serial(260, 420, -1.0f);
+    stencil(source, serial.submatrix(5, 10, 250, 400), kernel, Array_border_opt::Reflect);
+    expect_matches(serial.submatrix(5, 10, 250, 400), expected, "view");
+    EXPECT_THAT(serial.row(0), Each(-1.0f));
+    EXPECT_EQ(serial(100, 9), -1.0f);
+    EXPECT_EQ(serial(100, 410), -1.0f);
+
+    array2d<float> parallel(250, 400);
+    stencil_parallel(source, parallel, kernel, Array_border_opt::Reflect);
+    expect_matches(parallel, expected, "parallel");
+
+    std::vector<float> taps{1.0f, 2.0f, 3.0f, 2.0f, 1.0f};
+    array2d<float>     sep_serial(300, 520), sep_parallel(300, 520);
+    stencil_separable(image, sep_serial, taps, taps, Array_border_opt::Wrap);
+    stencil_separable_parallel(image, sep_parallel, taps, taps, Array_border_opt::Wrap);
+    EXPECT_EQ(sep_parallel, sep_serial);
+}
+
+TEST_F(Array2dStencilTest, InvalidArgumentsThrow) {
+    array2d<float> image(4, 4, 1.0f);
+    array2d<float> kernel(3, 3, 1.0f);
+    array2d<float> wrong(4, 5);
+    array2d<float> empty_kernel(0, 3);
+
+    EXPECT_THROW(stencil(image, wrong, kernel), std::invalid_argument);
+    EXPECT_THROW(stencil(image, image, kernel), std::invalid_argument);
+    EXPECT_THROW((void) stencil(image, empty_kernel), std::invalid_argument);
+
+    std::vector<float> taps{1.0f}, none;
+    array2d<float>     out(4, 4);
+    EXPECT_THROW(stencil_separable(image, out, taps, none), std::invalid_argument);
+    EXPECT_THROW(stencil_separable(image, image.submatrix(0, 0, 4, 4), taps, taps), std::invalid_argument);
+}
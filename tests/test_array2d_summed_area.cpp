@@ -0,0 +1,143 @@
+//
+// test_array2d_summed_area.cpp
+//
+#include "array2d.hpp"
+#include "array2d_summed_area.hpp"
+#include <cstdint>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace qm;
+using ::testing::Each;
+
+// ================================
+// 测试夹具类
+// ================================
+
+/**
+ * @brief 求和面积表测试夹具
+ */
+class SummedAreaTableTest : public ::testing::Test {
+protected:
+    array2d<int> grid_{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}};
+
+    /**
+     * @brief 逐元素累加的参考实现
+     */
+    template<typename M>
+    static auto brute_sum(const M &m, int r0, int c0, int r1, int c1) {
+        summed_area_sum_t<typename M::value_type> sum{};
+        for (int i = r0; i < r1; ++i) {
+            for (int j = c0; j < c1; ++j) sum += m(i, j);
+        }
+        return sum;
+    }
+
+    /**
+     * @brief 验证所有以给定步长枚举的矩形
+     */
+    template<typename M, typename Table>
+    static void expect_all_rects(const M &m, const Table &sat, int step) {
+        for (int r0 = 0; r0 <= m.rows(); r0 += step) {
+            for (int r1 = r0; r1 <= m.rows(); r1 += step) {
+                for (int c0 = 0; c0 <= m.cols(); c0 += step) {
+                    for (int c1 = c0; c1 <= m.cols(); c1 += step) {
+                        ASSERT_EQ(sat.rect_sum(r0, c0, r1, c1), brute_sum(m, r0, c0, r1, c1))
+                                << r0 << ", " << c0 << ", " << r1 << ", " << c1;
+                    }
+                }
+            }
+        }
+    }
+};
+
+// ================================
+// 查询测试
+// ================================
+
+TEST_F(SummedAreaTableTest, RectSum) {
+    summed_area_table<int> sat(grid_);
+    EXPECT_EQ(sat.rows(), 3);
+    EXPECT_EQ(sat.cols(), 4);
+    EXPECT_EQ(sat.total(), 78);
+    EXPECT_EQ(sat.rect_sum(1, 1, 3, 3), 6 + 7 + 10 + 11);
+    EXPECT_EQ(sat.rect_sum(0, 3, 3, 4), 4 + 8 + 12);
+    EXPECT_EQ(sat.rect_sum(2, 2, 2, 4), 0);
+    static_assert(std::is_same_v<decltype(sat.rect_sum(0, 0, 1, 1)), std::int64_t>);
+
+    // 首行和首列为0
+    EXPECT_THAT(sat.table().row(0), Each(0));
+    EXPECT_EQ(sat.table()(3, 4), 78);
+    expect_all_rects(grid_, sat, 1);
+}
+
+TEST_F(SummedAreaTableTest, InvalidRectanglesThrow) {
+    summed_area_table<int> sat(grid_);
+    EXPECT_THROW((void) sat.rect_sum(-1, 0, 1, 1), std::out_of_range);
+    EXPECT_THROW((void) sat.rect_sum(2, 0, 1, 1), std::out_of_range);
+    EXPECT_THROW((void) sat.rect_sum(0, 0, 4, 1), std::out_of_range);
+    EXPECT_THROW((void) sat.rect_sum(0, 3, 1, 5), std::out_of_range);
+}
+
+TEST_F(SummedAreaTableTest, SmallTypesDoNotOverflow) {
+    array2d<std::uint8_t> image(300, 300, 255);
+    summed_area_table<std::uint8_t> sat(image);
+    EXPECT_EQ(sat.total(), 255u * 300u * 300u);
+    EXPECT_EQ(sat.rect_sum(10, 10, 13, 13), 255u * 9u);
+}
+
+TEST_F(SummedAreaTableTest, EmptyAndDefault) {
+    summed_area_table<int> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.total(), 0);
+
+    array2d<int>           no_cols(5, 0);
+    summed_area_table<int> sat(no_cols);
+    EXPECT_EQ(sat.rows(), 5);
+    EXPECT_EQ(sat.rect_sum(0, 0, 5, 0), 0);
+}
+
+// ================================
+// 构建测试
+// ================================
+
+TEST_F(SummedAreaTableTest, PitchedViewAndFloatingPoint) {
+    pitched_array2d<float> values(23, 19);
+    for (int i = 0; i < values.rows(); ++i) {
+        for (int j = 0; j < values.cols(); ++j) values(i, j) = static_cast<float>((i * 3 + j) % 7) * 0.5f;
+    }
+    summed_area_table<float> sat(values);
+    static_assert(std::is_same_v<summed_area_table<float>::value_type, double>);
+    expect_all_rects(values, sat, 3);
+
+    auto                     block = values.submatrix(2, 3, 10, 11);
+    summed_area_table<float> block_sat(block);
+    EXPECT_EQ(block_sat.rows(), 10);
+    expect_all_rects(block, block_sat, 2);
+}
+
+TEST_F(SummedAreaTableTest, ParallelMatchesSerialAndReusesStorage) {
+    array2d<int> large(317, 211);
+    for (int i = 0; i < large.rows(); ++i) {
+        for (int j = 0; j < large.cols(); ++j) large(i, j) = (i * 31 + j * 17) % 23 - 11;
+    }
+
+    summed_area_table<int> serial(large);
+    summed_area_table<int> parallel;
+    parallel.assign_parallel(large);
+    EXPECT_EQ(parallel.table(), serial.table());
+    expect_all_rects(large, parallel, 53);
+
+    // 尺寸不变时重建复用存储
+    const auto *storage = parallel.table().data();
+    large.fill(1);
+    parallel.assign_parallel(large);
+    EXPECT_EQ(parallel.table().data(), storage);
+    EXPECT_EQ(parallel.total(), 317 * 211);
+    EXPECT_EQ(parallel.rect_sum(100, 100, 110, 120), 200);
+
+    parallel.assign(grid_);
+    EXPECT_EQ(parallel.total(), 78);
+}
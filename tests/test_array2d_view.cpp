@@ -0,0 +1,289 @@
+//
+// test_array2d_view.cpp
+//
+#include "array2d_view.hpp"
+#include <algorithm>
+#include <functional>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using namespace qm;
+using ::testing::ElementsAre;
+
+// ================================
+// 测试夹具类
+// ================================
+
+/**
+ * @brief array2d_view 基础测试夹具
+ *
+ * 外部缓冲区为3行4列，行距为6，每行末尾两个填充元素为-1。
+ */
+class Array2dViewTest : public ::testing::Test {
+protected:
+    std::vector<int> buffer_{1, 2, 3, 4, -1, -1,
+                             5, 6, 7, 8, -1, -1,
+                             9, 10, 11, 12, -1, -1};
+};
+
+// ================================
+// 构造测试
+// ================================
+
+TEST_F(Array2dViewTest, DefaultConstructor) {
+    array2d_view<int> view;
+    EXPECT_EQ(view.rows(), 0);
+    EXPECT_EQ(view.cols(), 0);
+    EXPECT_TRUE(view.empty());
+    EXPECT_EQ(view.begin(), view.end());
+}
+
+TEST_F(Array2dViewTest, DenseBufferConstructor) {
+    array2d_view view(buffer_.data(), 3, 6);
+    static_assert(std::is_same_v<decltype(view), array2d_view<int, int>>);
+
+    EXPECT_EQ(view.pitch(), 6);
+    EXPECT_TRUE(view.is_contiguous());
+    EXPECT_EQ(view(1, 0), 5);
+    EXPECT_EQ(view.data(), buffer_.data());
+}
+
+TEST_F(Array2dViewTest, PitchedBufferConstructor) {
+    array2d_view view(buffer_.data(), 3, 4, row_pitch{6});
+
+    EXPECT_EQ(view.rows(), 3);
+    EXPECT_EQ(view.cols(), 4);
+    EXPECT_EQ(view.pitch(), 6);
+    EXPECT_EQ(view.size(), 12);
+    EXPECT_FALSE(view.is_contiguous());
+    EXPECT_EQ(view(2, 3), 12);
+
+    EXPECT_THROW((array2d_view<int>(buffer_.data(), 3, 4, row_pitch{3})), std::invalid_argument);
+    EXPECT_THROW((array2d_view<int>(buffer_.data(), -1, 4)), std::invalid_argument);
+}
+
+TEST_F(Array2dViewTest, ImplicitConversionFromArray2d) {
+    array2d<int> matrix{{1, 2}, {3, 4}};
+
+    array2d_view<int> view = matrix;
+    view(0, 1)             = 20;
+    EXPECT_EQ(matrix(0, 1), 20);
+    EXPECT_EQ(view.data(), matrix.data());
+
+    const auto &const_matrix = matrix;
+    array2d_view const_view  = const_matrix;
+    static_assert(std::is_same_v<decltype(const_view), array2d_view<const int, int>>);
+    static_assert(!std::is_constructible_v<array2d_view<int>, const array2d<int> &>);
+    static_assert(!std::is_constructible_v<array2d_view<int>, array2d<int> &&>);
+    EXPECT_EQ(const_view(1, 1), 4);
+
+    array2d_view<const int> from_mutable = view;
+    EXPECT_EQ(from_mutable(0, 1), 20);
+
+    auto sum_all = [](array2d_view<const int> v) { return std::accumulate(v.begin(), v.end(), 0); };
+    EXPECT_EQ(sum_all(matrix), 1 + 20 + 3 + 4);
+}
+
+TEST_F(Array2dViewTest, ViewOfPitchedArray) {
+    pitched_array2d<int> matrix{{1, 2, 3}, {4, 5, 6}};
+    array2d_view<int>    view = matrix;
+
+    EXPECT_EQ(view.pitch(), matrix.pitch());
+    EXPECT_THAT(std::vector<int>(view.begin(), view.end()), ElementsAre(1, 2, 3, 4, 5, 6));
+}
+
+// ================================
+// 元素访问和迭代测试
+// ================================
+
+TEST_F(Array2dViewTest, ElementAccess) {
+    array2d_view<int> view(buffer_.data(), 3, 4, row_pitch{6});
+
+    EXPECT_EQ(view[1][2], 7);
+    EXPECT_EQ(view.at(2, 0), 9);
+    EXPECT_THROW((void) view.at(3, 0), std::out_of_range);
+    EXPECT_THROW((void) view.at(0, 4), std::out_of_range);
+
+    EXPECT_THAT(view.row(1), ElementsAre(5, 6, 7, 8));
+    EXPECT_THAT(view.col(3), ElementsAre(4, 8, 12));
+}
+
+TEST_F(Array2dViewTest, IterationSkipsPadding) {
+    array2d_view<int> view(buffer_.data(), 3, 4, row_pitch{6});
+
+    EXPECT_THAT(std::vector<int>(view.begin(), view.end()), ElementsAre(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12));
+    EXPECT_EQ(std::ranges::count(view, -1), 0);
+    EXPECT_EQ(*view.rbegin(), 12);
+    EXPECT_EQ(*view.crbegin(), 12);
+    EXPECT_EQ(view.cend() - view.cbegin(), 12);
+
+    int sum = 0;
+    for (int elem: view.row_range(2)) sum += elem;
+    EXPECT_EQ(sum, 42);
+
+    std::ranges::sort(view, std::greater<>());
+    EXPECT_EQ(view(0, 0), 12);
+    EXPECT_EQ(buffer_[4], -1);  // 填充元素不受影响
+}
+
+// ================================
+// 数据操作测试
+// ================================
+
+TEST_F(Array2dViewTest, FillAndRowOperations) {
+    array2d_view<int> view(buffer_.data(), 3, 4, row_pitch{6});
+
+    view.copy_row(0, 2);
+    EXPECT_THAT(view.row(2), ElementsAre(1, 2, 3, 4));
+
+    view.swap_rows(0, 1);
+    EXPECT_THAT(view.row(0), ElementsAre(5, 6, 7, 8));
+    EXPECT_THAT(view.row(1), ElementsAre(1, 2, 3, 4));
+
+    view.fill_row(1, 0);
+    EXPECT_THAT(view.row(1), ElementsAre(0, 0, 0, 0));
+
+    view.fill(7);
+    EXPECT_EQ(std::ranges::count(view, 7), 12);
+    EXPECT_EQ(std::count(buffer_.begin(), buffer_.end(), -1), 6);
+}
+
+TEST_F(Array2dViewTest, ResetTransposedAndSpan) {
+    array2d_view<int> view(buffer_.data(), 3, 4, row_pitch{6});
+
+    const auto t = view.transposed();
+    EXPECT_EQ(t.rows(), 4);
+    EXPECT_EQ(t.cols(), 3);
+    EXPECT_THAT(t, ElementsAre(1, 5, 9, 2, 6, 10, 3, 7, 11, 4, 8, 12));
+    EXPECT_EQ(array2d_view<const int>(view).submatrix(1, 1, 2, 2).transposed(), (array2d<int>{{6, 10}, {7, 11}}));
+
+    EXPECT_THROW((void) view.as_span(), std::invalid_argument);
+    EXPECT_EQ(view.submatrix(1, 0, 1, 4).as_span().data(), buffer_.data() + 6);
+
+    view.submatrix(0, 1, 3, 2).reset(Array_reset_opt::All_bits1);
+    EXPECT_THAT(view.col(1), ElementsAre(-1, -1, -1));
+    EXPECT_THAT(view.col(3), ElementsAre(4, 8, 12));
+
+    view.reset();
+    EXPECT_EQ(std::ranges::count(view, 0), 12);
+    EXPECT_EQ(std::count(buffer_.begin(), buffer_.end(), -1), 6);
+
+    std::vector<double> dense(6, 1.5);
+    array2d_view<double> contiguous(dense.data(), 2, 3);
+    EXPECT_EQ(contiguous.as_span().size(), 6u);
+    contiguous.reset();
+    EXPECT_THAT(dense, ::testing::Each(0.0));
+}
+
+TEST_F(Array2dViewTest, ColView) {
+    array2d_view<int> view(buffer_.data(), 3, 4, row_pitch{6});
+
+    auto column = view.col_view(3);
+    EXPECT_THAT(column, ElementsAre(4, 8, 12));
+    std::ranges::sort(column, std::greater<>{});
+    EXPECT_THAT(view.col(3), ElementsAre(12, 8, 4));
+    EXPECT_EQ(std::count(buffer_.begin(), buffer_.end(), -1), 6);
+
+    array2d_view<const int> cview(view);
+    static_assert(std::is_same_v<decltype(cview.col_view(0)), array2d_column<const int>>);
+    EXPECT_THAT(cview.submatrix(1, 1, 2, 2).col_view(0), ElementsAre(6, 10));
+}
+
+TEST_F(Array2dViewTest, NestedSubmatrix) {
+    array2d_view<int> view(buffer_.data(), 3, 4, row_pitch{6});
+
+    auto inner = view.submatrix(1, 1, 2, 3);
+    EXPECT_EQ(inner.pitch(), 6);
+    EXPECT_FALSE(inner.is_contiguous());
+    EXPECT_THAT(std::vector<int>(inner.begin(), inner.end()), ElementsAre(6, 7, 8, 10, 11, 12));
+
+    auto corner = inner.submatrix(1, 2, 1, 1);
+    EXPECT_EQ(corner(0, 0), 12);
+    corner.fill(0);
+    EXPECT_EQ(buffer_[15], 0);
+
+    EXPECT_THROW((void) inner.submatrix(0, 0, 3, 1), std::out_of_range);
+}
+
+TEST_F(Array2dViewTest, CopyFrom) {
+    array2d<int>      matrix(2, 2, 0);
+    array2d_view<int> view(buffer_.data(), 3, 4, row_pitch{6});
+
+    matrix.submatrix(0, 0, 2, 2).copy_from(view.submatrix(1, 2, 2, 2));
+    EXPECT_THAT(matrix.row(0), ElementsAre(7, 8));
+    EXPECT_THAT(matrix.row(1), ElementsAre(11, 12));
+
+    view.submatrix(0, 0, 2, 2).copy_from(matrix);
+    EXPECT_THAT(view.row(0), ElementsAre(7, 8, 3, 4));
+
+    EXPECT_THROW(view.copy_from(matrix), std::invalid_argument);
+}
+
+TEST_F(Array2dViewTest, CopyFromOverlapping) {
+    array2d<int> matrix(4, 4);
+    std::iota(matrix.begin(), matrix.end(), 0);
+    const array2d<int> expected = matrix;
+
+    // 向右下方平移，目标与源重叠
+    matrix.submatrix(1, 1, 3, 3).copy_from(matrix.submatrix(0, 0, 3, 3));
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            EXPECT_EQ(matrix(i + 1, j + 1), expected(i, j));
+        }
+    }
+
+    // 再平移回左上方
+    matrix.submatrix(0, 0, 3, 3).copy_from(matrix.submatrix(1, 1, 3, 3));
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            EXPECT_EQ(matrix(i, j), expected(i, j));
+        }
+    }
+}
+
+TEST_F(Array2dViewTest, CopyFromOverlappingWithDifferentPitch) {
+    // 起始地址相同但行距不同，两个视图指向不同的行
+    std::vector<int> storage(12);
+    std::iota(storage.begin(), storage.end(), 0);
+    array2d_view<int> packed(storage.data(), 3, 2, row_pitch{2});
+    packed.copy_from(array2d_view<const int>(storage.data(), 3, 2, row_pitch{4}));
+    EXPECT_THAT(packed, ElementsAre(0, 1, 4, 5, 8, 9));
+
+    // 行距较小的源位于目标之前
+    std::iota(storage.begin(), storage.end(), 0);
+    array2d_view<int> spread(storage.data() + 1, 3, 2, row_pitch{4});
+    spread.copy_from(array2d_view<const int>(storage.data(), 3, 2, row_pitch{2}));
+    EXPECT_THAT(spread, ElementsAre(0, 1, 2, 3, 4, 5));
+}
+
+TEST_F(Array2dViewTest, TransposeSquareView) {
+    array2d_view<int> view(buffer_.data(), 3, 3, row_pitch{6});
+    view.transpose();
+    EXPECT_THAT(view.row(0), ElementsAre(1, 5, 9));
+    EXPECT_THAT(view.row(2), ElementsAre(3, 7, 11));
+    EXPECT_EQ(buffer_[3], 4);
+
+    array2d_view<int> rect(buffer_.data(), 2, 3);
+    EXPECT_THROW(rect.transpose(), std::invalid_argument);
+}
+
+TEST_F(Array2dViewTest, Equality) {
+    array2d<int>            matrix{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}};
+    array2d_view<const int> pitched(buffer_.data(), 3, 4, row_pitch{6});
+
+    EXPECT_TRUE(pitched == array2d_view<const int>(matrix));
+    matrix(2, 3) = 0;
+    EXPECT_FALSE(pitched == array2d_view<const int>(matrix));
+}
+
+TEST_F(Array2dViewTest, Concepts) {
+    static_assert(std::ranges::random_access_range<array2d_view<int>>);
+    static_assert(std::ranges::random_access_range<array2d_view<const int>>);
+    static_assert(std::is_trivially_copyable_v<array2d_view<int>>);
+    static_assert(array2d_view<const int>::is_read_only);
+    static_assert(!array2d_view<int>::is_read_only);
+}